@@ -88,6 +88,40 @@
 #define	ETRI_StreamInterface	std::ostream
 #endif
 
+#if ETRI_ZEROCOPY_IO
+// ====================================================================================================================
+// Zero-copy IO : The caller registers rings of input frames and output bitstream buffers (ETRI_EncoderRegisterIORing). 
+// The planes are read from the input buffer of the call into the picture to be encoded, and the access units are written 
+// straight into a free output buffer, in place of ptrData and AnnexBData. A buffer goes back to the caller by pfCompletion.
+// ETRI_EncoderMainFunc returns false without encoding when iInputIdx is out of the ring or the caller holds every output buffer.
+// ====================================================================================================================
+#define	ETRI_IORING_MAX_BUFFER		64
+#define	ETRI_IORING_INPUT			0		///< iRing of pfCompletion : The input frame is read, the caller may refill it
+#define	ETRI_IORING_OUTPUT			1		///< iRing of pfCompletion : uiBytes of access units, held by the caller until ETRI_EncoderReturnBuffer. 
+											///< The access units of a call larger than the buffer go on in the next free ones, one completion each
+#define	ETRI_IORING_OVERFLOW		2		///< iRing of pfCompletion : uiBytes at pOverflow no free output buffer could take, valid during the call only (iIdx -1)
+
+typedef void (*ETRI_IOCompletion)(void* pvUser, int iRing, int iIdx, unsigned int uiBytes);
+
+typedef struct ETRI_IORingInfo
+{
+	int					iNumInput;								///< Input frames of FrameSize bytes (to DLL). 0 : ptrData
+	unsigned char*		pInput[ETRI_IORING_MAX_BUFFER];
+	int					iInputIdx;								///< Input frame of the call (to DLL)
+
+	int					iNumOutput;								///< Output bitstream buffers (to DLL). 0 : AnnexBData
+	unsigned char*		pOutput[ETRI_IORING_MAX_BUFFER];
+	unsigned int		uiOutputSize[ETRI_IORING_MAX_BUFFER];
+	int					iOutputIdx;								///< Output buffer of the access units of the call, -1 : None (From DLL)
+	volatile bool		bOutputBusy[ETRI_IORING_MAX_BUFFER];	///< Held by the caller (From DLL)
+	int					iNextOutput;							///< First output buffer searched at the next call (Internal)
+
+	ETRI_IOCompletion	pfCompletion;							///< Called on the encoding thread (to DLL)
+	void*				pvUser;
+	unsigned char*		pOverflow;								///< Bytes of ETRI_IORING_OVERFLOW (From DLL)
+} ETRI_IORing;
+#endif
+
 typedef struct InterfaceInfo
 {
 	int		argc;								///< to DLL
@@ -111,7 +145,7 @@ typedef struct InterfaceInfo
 #endif
 
 	unsigned char *	ptrData;   					///< YUV Data for Interface			(to DLL)	
-	unsigned char *	AnnexBData;   				///< HEVC Bitstream Data for Interface	(From DLL)
+	unsigned char *	AnnexBData;   				///< HEVC Bitstream Data for Interface	(From DLL) : MAX_ANNEXB_BUFFER_SIZE bytes from the caller, FrameSize bytes with bOutBufferOff
 	unsigned char *	ptrRec;						///< HEVC Bitstream Data for Interface (From DLL)
 
 	bool 	is16bit;
@@ -182,7 +216,7 @@ typedef struct InterfaceInfo
 	///............. System Integration  ..... : 2013 10 24 by Seok
 	unsigned int			nFrameCount;		///< Frame Count in GOP
 	unsigned int			nGOPsize;									///< GOP Size from Config
-	unsigned int			nFrameStartOffset[MAX_FRAME_NUM_IN_GOP];	///< Frame Start offset in bitstream (per GOP)
+	unsigned int			nFrameStartOffset[MAX_FRAME_NUM_IN_GOP];	///< Bytes of each frame of the call (per GOP). Frame k starts at the sum of [0..k-1] in the output of the call (ETRI_getAnnexBByte)
 	unsigned int			nFrameTypeInGop[MAX_FRAME_NUM_IN_GOP];		
 	unsigned int			nPicPresentationOrder[MAX_FRAME_NUM_IN_GOP];///< Pic POC
 	unsigned int			nPicDecodingOrder[MAX_FRAME_NUM_IN_GOP];	///< Pic POC
@@ -193,6 +227,13 @@ typedef struct InterfaceInfo
 	char*	UserDefinedParameter; 				///< MAX_HEADER_BUFFER_SIZE Byte   ͸ Ͽ ߰ User Data Ѵ. (From DLL)
 	//............. HeaderCount	
 	unsigned int*	em_HeaderCount; 			///< totalCount	(From DLL)
+#if ETRI_ZEROCOPY_IO
+	ETRI_IORing		IORing;						///< Caller-owned IO buffers (to/From DLL : ETRI_EncoderRegisterIORing)
+#endif
+#if ETRI_STREAM_OUTPUT
+	int 					iNumAnnexBChunk;	///< AnnexBFrameSize bytes in AnnexBChunk[0..iNumAnnexBChunk-1] (From DLL)
+	ETRI_BitstreamChunk*	AnnexBChunk;		///< [0] : AnnexBData, [1..] : Chunks of the DLL when the access units do not fit in it. Valid until the next call (From DLL)
+#endif
 	//unsigned int	em_GOPStartInBuffer;  		///totalCount, two buffer struc.
 
 	/* . . . . . Example  
@@ -207,4 +248,22 @@ typedef struct InterfaceInfo
 
 } ETRI_Interface;
 
+/**
+	Byte uiOffset of the access units of the last call, or -1 past their end. The output is the concatenation of AnnexBChunk[0..iNumAnnexBChunk-1]
+	(AnnexBChunk[0] is AnnexBData or the output buffer of the ring), so an offset summed from nFrameStartOffset is not an index of AnnexBData.
+*/
+static inline int ETRI_getAnnexBByte(const ETRI_Interface* pIF, unsigned int uiOffset)
+{
+#if ETRI_STREAM_OUTPUT
+	for( int k = 0; k < pIF->iNumAnnexBChunk; k++ )
+	{
+		if( uiOffset < pIF->AnnexBChunk[k].uiBytes )	{ return pIF->AnnexBChunk[k].pData[uiOffset]; }
+		uiOffset -= pIF->AnnexBChunk[k].uiBytes;
+	}
+	return -1;
+#else
+	return ( uiOffset < (unsigned int)pIF->AnnexBFrameSize )? pIF->AnnexBData[uiOffset] : -1;
+#endif
+}
+
 #endif
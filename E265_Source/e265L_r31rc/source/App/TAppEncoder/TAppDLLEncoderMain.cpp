@@ -226,7 +226,6 @@ int main(int argc, char* argv[])
 		if( *_MonitorCondition )
 		{
 			bool _dbgkey = false; int _dbgStyle = 1, iIdx = 0;
-			char* _Code;
 			unsigned int  _TotalBits = 0;
 
 
@@ -243,11 +242,11 @@ int main(int argc, char* argv[])
 												m_pEncInterface->nFrameStartOffset[k],
 												m_pEncInterface->nFrameStartOffset[k] << 3 );
 
-				iIdx       +=  k == 0 ? m_pEncInterface->nFrameStartOffset[k-1] : 0;
-				_Code       = (char *)m_pEncInterface->AnnexBData + iIdx;
+				iIdx       +=  k ? m_pEncInterface->nFrameStartOffset[k-1] : 0;
 				_TotalBits += m_pEncInterface->nFrameStartOffset[k] << 3;
 
-				ETRI_dbgMsg(_dbgkey, _dbgStyle, "Code:@%7x %x %x %x %x \n", iIdx, _Code[0], _Code[1], _Code[2], _Code[3]); 				
+				ETRI_dbgMsg(_dbgkey, _dbgStyle, "Code:@%7x %x %x %x %x \n", iIdx, ETRI_getAnnexBByte(m_pEncInterface, iIdx), ETRI_getAnnexBByte(m_pEncInterface, iIdx + 1), 
+																			ETRI_getAnnexBByte(m_pEncInterface, iIdx + 2), ETRI_getAnnexBByte(m_pEncInterface, iIdx + 3)); 				
 			}
 		}
 
@@ -96,6 +96,13 @@ int main( int argc, char* argv[] )
 
 		ETRI_HEVC_GetEncInterface = (ETRI_Interface *(__cdecl *)(void *hTAppEncTop))GetProcAddress(m_hdll, "ETRI_GetEncInterface");
 		DLLNull_ErrorMSG(ETRI_HEVC_GetEncInterface, "ETRI_HEVC_GetEncInterface() not found", 0);
+#if ETRI_ZEROCOPY_IO
+		ETRI_HEVC_RegisterIORing = (bool (__cdecl *)(void *hTAppEncTop, ETRI_IORing *pRing))GetProcAddress(m_hdll, "ETRI_EncoderRegisterIORing");
+		DLLNull_ErrorMSG(ETRI_HEVC_RegisterIORing, "ETRI_HEVC_RegisterIORing() not found", 0);
+
+		ETRI_HEVC_ReturnBuffer = (void (__cdecl *)(void *hTAppEncTop, int iIdx))GetProcAddress(m_hdll, "ETRI_EncoderReturnBuffer");
+		DLLNull_ErrorMSG(ETRI_HEVC_ReturnBuffer, "ETRI_HEVC_ReturnBuffer() not found", 0);
+#endif
 	}
 
 	::SetPriorityClass( GetCurrentProcess(), REALTIME_PRIORITY_CLASS );			// IDLE_PRIORITY_CLASS, NORMAL_, HIGH_, REALTIME_
@@ -125,6 +132,13 @@ int main( int argc, char* argv[] )
 
 		ETRI_HEVC_GetEncInterface = (ETRI_Interface *(__cdecl *)(void *hTAppEncTop))dlsym(m_hdll, "ETRI_GetEncInterface");
 		DLLNull_ErrorMSG(ETRI_HEVC_GetEncInterface, "ETRI_HEVC_GetEncInterface() not found", 0);
+#if ETRI_ZEROCOPY_IO
+		ETRI_HEVC_RegisterIORing = (bool (__cdecl *)(void *hTAppEncTop, ETRI_IORing *pRing))dlsym(m_hdll, "ETRI_EncoderRegisterIORing");
+		DLLNull_ErrorMSG(ETRI_HEVC_RegisterIORing, "ETRI_HEVC_RegisterIORing() not found", 0);
+
+		ETRI_HEVC_ReturnBuffer = (void (__cdecl *)(void *hTAppEncTop, int iIdx))dlsym(m_hdll, "ETRI_EncoderReturnBuffer");
+		DLLNull_ErrorMSG(ETRI_HEVC_ReturnBuffer, "ETRI_HEVC_ReturnBuffer() not found", 0);
+#endif
 	}
 
 	// should be confirmed - shcho, 160524
@@ -202,6 +216,9 @@ int main( int argc, char* argv[] )
 	Memory_Pool_Constructor( m_pEncInterface );
 	Memory_Pool_Initialization( IYUVFile, bitstreamFile, m_pEncInterface ); //File open	
 	Memory_Pool_PushInputData( IYUVFile, bitstreamFile, m_pEncInterface ); //If Full IO is active then this function is also active
+#if ETRI_ZEROCOPY_IO
+	bool	_bIORing = Memory_Pool_RegisterIORing( bitstreamFile, m_hTAppEncTop, m_pEncInterface ); //Output is written to the file at its completion
+#endif
 
 	// --------------------------------------------------------------------------------------------
 	// encoding
@@ -271,7 +288,11 @@ int main( int argc, char* argv[] )
 	while( _bOperation )
 	{
 
+#if ETRI_ZEROCOPY_IO
+		if( *m_pEncInterface->m_piFrameRcvd && !_bIORing )
+#else
 		if( *m_pEncInterface->m_piFrameRcvd )
+#endif
 			Memory_Pool_PutFrame(bitstreamFile, m_pEncInterface); ///< Link OutlockInfo.pBuffPtr to File ptr		
 
 		///<Infinite process stop condition
@@ -285,6 +306,11 @@ int main( int argc, char* argv[] )
 		if( m_pEncInterface->bEos )	
 			continue;
 
+#if ETRI_ZEROCOPY_IO
+		if( _bIORing )
+			Memory_Pool_GetRingFrame( IYUVFile, m_pEncInterface ); ///< read the frame into the next input buffer of the ring
+		else
+#endif
 		Memory_Pool_GetFrame( IYUVFile, m_pEncInterface ); ///< link InblockInfo.pBuffPtr to IYUVFile
 		m_pEncInterface->nTimestamp[_iFrameIndexinIDRGOP] = _inFrames; 
 //		m_pEncInterface->nTimestamp[0] = _inFrames;	
@@ -303,7 +329,6 @@ int main( int argc, char* argv[] )
 		{		
 			bool _dbgkey = false; //false: no print dbgmsg, true: print dbgmsg
 			int _dbgStyle = 1, iIdx = 0;
-			char* _Code;
 
 			ETRI_dbgMsg( _dbgkey, _dbgStyle, "======= EStoTS Param ====\n" );
 			ETRI_dbgMsg( _dbgkey, _dbgStyle, "[LINE:%d %s] m_pEncInterface->iNumEncoded: %d \n", __LINE__, __FUNCTION__, m_pEncInterface->iNumEncoded );
@@ -321,8 +346,8 @@ int main( int argc, char* argv[] )
 																				 m_pEncInterface->nFrameStartOffset[k],
 																				 (m_pEncInterface->nFrameStartOffset[k] << 3) );
 				iIdx += ((k) ? m_pEncInterface->nFrameStartOffset[k-1] : 0);
-				_Code = (char *)m_pEncInterface->AnnexBData + iIdx;
-				ETRI_dbgMsg(_dbgkey, _dbgStyle, "Code @%7x:%x:%x:%x:%x: \n", iIdx, _Code[0], _Code[1], _Code[2], _Code[3]); 
+				ETRI_dbgMsg(_dbgkey, _dbgStyle, "Code @%7x:%x:%x:%x:%x: \n", iIdx, ETRI_getAnnexBByte(m_pEncInterface, iIdx), ETRI_getAnnexBByte(m_pEncInterface, iIdx + 1), 
+																					ETRI_getAnnexBByte(m_pEncInterface, iIdx + 2), ETRI_getAnnexBByte(m_pEncInterface, iIdx + 3)); 
 			}
 		}
 
@@ -350,6 +375,10 @@ int main( int argc, char* argv[] )
 
 	///< Destroy
 	Memory_Pool_Free(m_pEncInterface);
+#if ETRI_ZEROCOPY_IO
+	if( _bIORing )
+		Memory_Pool_FreeIORing();
+#endif
 	ETRI_HEVC_Destroyer( &m_hTAppEncTop );	
 
 	///< Print MainEncodingTime
@@ -140,6 +140,10 @@ bool (*ETRI_HEVC_Encode_func) 	(void *hTAppEncTop);
 void (*ETRI_HEVC_Destroyer)    	(void *hTAppEncTop);
 void (*ETRI_HEVC_Service_func) 	(void *hTAppEncTop);
 ETRI_Interface *(*ETRI_HEVC_GetEncInterface) (void *hTAppEncTop);
+#if ETRI_ZEROCOPY_IO
+bool (*ETRI_HEVC_RegisterIORing)	(void *hTAppEncTop, ETRI_IORing *pRing);
+void (*ETRI_HEVC_ReturnBuffer)		(void *hTAppEncTop, int iIdx);
+#endif
 
 ETRI_TESTIO  	e_TestIO;		///< Simulation of Memory PooL
 
@@ -201,7 +205,8 @@ void Init_Encode (void *hTAppEncTop)
 
 void Encode (void *hTAppEncTop)	//wrapper Function 
 {
-	ETRI_HEVC_Encode_func(hTAppEncTop);	//Execute Encoding Function 
+	if (!ETRI_HEVC_Encode_func(hTAppEncTop))	//Execute Encoding Function 
+		error_dll("ETRI_HEVC_Encode_func() failed \n", 0);
 }
 
 __inline	void 	ETRI_setAnalyzeClear  		(ETRI_Interface* EncoderIF, bool bGoOn)	{ EncoderIF->CTRParam.bAnalyzeClear	= bGoOn; }	// 2014 1 8 by Seok
@@ -461,7 +466,104 @@ void Memory_Pool_PutFrame(std::fstream& bitstreamFile, ETRI_Interface* EncoderIF
 	}
 	else
 	{
+#if ETRI_STREAM_OUTPUT
+		///< The access units larger than AnnexBData are continued in the chunks of the DLL
+		for (int k = 0; k < EncoderIF->iNumAnnexBChunk; k++)
+			bitstreamFile.write((const char *)EncoderIF->AnnexBChunk[k].pData, EncoderIF->AnnexBChunk[k].uiBytes);
+#else
 		bitstreamFile.write((const char *)EncoderIF->AnnexBData, EncoderIF->AnnexBFrameSize);
+#endif
+	}
+}
+
+#if ETRI_ZEROCOPY_IO
+// ====================================================================================================================
+// Zero-copy IO : The input frames are read from the file into a ring the encoder reads in place, and the encoder writes 
+// the access units into a ring of output buffers which are written to the file at their completion
+// ====================================================================================================================
+#define	NUM_IORING_BUFFER			4
+
+typedef struct Test_IORing_Info
+{
+	ETRI_IORing 	sRing;
+	int 			iNextInput;				///< Input frame of the next call
+	std::fstream*	pBitstreamFile;
+	void*			hTAppEncTop;
+	ETRI_Interface*	pEncoderIF;
+} ETRI_TESTIORING;
+
+ETRI_TESTIORING	e_TestIORing;	///< Simulation of caller-owned IO buffers
+
+void Memory_Pool_IOCompletion(void* pvUser, int iRing, int iIdx, unsigned int uiBytes)
+{
+	ETRI_TESTIORING	*Le_TestIORing = (ETRI_TESTIORING *)pvUser;
+
+	///< The input frame may be refilled from now on. The output buffer is given back as soon as it is in the file
+	if (iRing == ETRI_IORING_OUTPUT)
+	{
+		Le_TestIORing->pBitstreamFile->write((const char *)Le_TestIORing->sRing.pOutput[iIdx], uiBytes);
+		ETRI_HEVC_ReturnBuffer(Le_TestIORing->hTAppEncTop, iIdx);
+	}
+	else if (iRing == ETRI_IORING_OVERFLOW)
+	{
+		Le_TestIORing->pBitstreamFile->write((const char *)Le_TestIORing->pEncoderIF->IORing.pOverflow, uiBytes);
+	}
+}
+
+/// Only for the default IO (Buffers of the DLL, no Full RD IO Process). Returns false when the ring is not used
+bool Memory_Pool_RegisterIORing(std::fstream& bitstreamFile, void *hTAppEncTop, ETRI_Interface* EncoderIF)
+{
+	ETRI_TESTIORING	*Le_TestIORing = (ETRI_TESTIORING *)&e_TestIORing;
+
+	memset(&Le_TestIORing->sRing, 0, sizeof(Le_TestIORing->sRing));
+	if (!EncoderIF->CTRParam.bInBufferOff || !EncoderIF->CTRParam.bOutBufferOff || EncoderIF->CTRParam.iFullIORDProcess > 0)	{return false;}
+
+	Le_TestIORing->sRing.iNumInput		= NUM_IORING_BUFFER;
+	Le_TestIORing->sRing.iNumOutput		= NUM_IORING_BUFFER;
+	for (int k = 0; k < NUM_IORING_BUFFER; k++)
+	{
+		Le_TestIORing->sRing.pInput[k]		= (unsigned char *)_aligned_malloc(EncoderIF->FrameSize * sizeof(char), 32);
+		Le_TestIORing->sRing.pOutput[k]		= (unsigned char *)_aligned_malloc(MAX_ANNEXB_BUFFER_SIZE * sizeof(char), 32);
+		Le_TestIORing->sRing.uiOutputSize[k]	= MAX_ANNEXB_BUFFER_SIZE;
+		DLLNull_ErrorMSG (Le_TestIORing->sRing.pInput[k], "IORing Input Allocation Fail \n", 0);
+		DLLNull_ErrorMSG (Le_TestIORing->sRing.pOutput[k], "IORing Output Allocation Fail \n", 0);
 	}
+	Le_TestIORing->sRing.pfCompletion	= Memory_Pool_IOCompletion;
+	Le_TestIORing->sRing.pvUser			= (void *)Le_TestIORing;
+	Le_TestIORing->iNextInput			= 0;
+	Le_TestIORing->pBitstreamFile		= &bitstreamFile;
+	Le_TestIORing->hTAppEncTop			= hTAppEncTop;
+	Le_TestIORing->pEncoderIF			= EncoderIF;
+
+	return ETRI_HEVC_RegisterIORing(hTAppEncTop, &Le_TestIORing->sRing);
 }
+
+void Memory_Pool_GetRingFrame(std::fstream& IYUVFile, ETRI_Interface* EncoderIF)
+{
+	ETRI_TESTIORING	*Le_TestIORing = (ETRI_TESTIORING *)&e_TestIORing;
+	int 			iIdx = Le_TestIORing->iNextInput;
+
+	IYUVFile.read(reinterpret_cast<char*>(Le_TestIORing->sRing.pInput[iIdx]), EncoderIF->FrameSize);
+	if (IYUVFile.eof())
+	{
+		EncoderIF->bEos = true;
+	}
+	else if (IYUVFile.fail())
+	{
+		error_dll("File Read Fail in Memory_Pool_GetRingFrame\n", 0);
+	}
+
+	EncoderIF->IORing.iInputIdx = iIdx;
+	Le_TestIORing->iNextInput = (iIdx + 1) % Le_TestIORing->sRing.iNumInput;
+}
+
+void Memory_Pool_FreeIORing()
+{
+	ETRI_TESTIORING	*Le_TestIORing = (ETRI_TESTIORING *)&e_TestIORing;
+
+	for (int k = 0; k < Le_TestIORing->sRing.iNumInput; k++)	{_aligned_free(Le_TestIORing->sRing.pInput[k]);}
+	for (int k = 0; k < Le_TestIORing->sRing.iNumOutput; k++)	{_aligned_free(Le_TestIORing->sRing.pOutput[k]);}
+	memset(&Le_TestIORing->sRing, 0, sizeof(Le_TestIORing->sRing));
+}
+#endif
 #endif
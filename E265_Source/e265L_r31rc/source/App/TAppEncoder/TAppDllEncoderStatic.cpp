@@ -124,7 +124,6 @@ int main(int argc, char* argv[])
 		{		
 			bool _dbgkey  = true; //false: no print dbgmsg, true: print dbgmsg
 			int _dbgStyle = 1, iIdx = 0;
-			char* _Code;
 
 			ETRI_dbgMsg( _dbgkey, _dbgStyle, "======= EStoTS Param ====\n" );
 			ETRI_dbgMsg( _dbgkey, _dbgStyle, "[LINE:%d %s] m_pEncInterface->iNumEncoded: %d \n", __LINE__, __FUNCTION__, m_pEncInterface->iNumEncoded );
@@ -142,8 +141,8 @@ int main(int argc, char* argv[])
 																				 m_pEncInterface->nFrameStartOffset[k],
 																				 (m_pEncInterface->nFrameStartOffset[k] << 3) );
 				iIdx += ((k) ? m_pEncInterface->nFrameStartOffset[k-1] : 0);
-				_Code = (char *)m_pEncInterface->AnnexBData + iIdx;
-				ETRI_dbgMsg(_dbgkey, _dbgStyle, "Code @%7x:%x:%x:%x:%x: \n", iIdx, _Code[0], _Code[1], _Code[2], _Code[3]); 
+				ETRI_dbgMsg(_dbgkey, _dbgStyle, "Code @%7x:%x:%x:%x:%x: \n", iIdx, ETRI_getAnnexBByte(m_pEncInterface, iIdx), ETRI_getAnnexBByte(m_pEncInterface, iIdx + 1), 
+																					ETRI_getAnnexBByte(m_pEncInterface, iIdx + 2), ETRI_getAnnexBByte(m_pEncInterface, iIdx + 3)); 
 			}
 		}
 
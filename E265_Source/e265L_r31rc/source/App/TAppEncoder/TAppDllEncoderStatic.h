@@ -302,6 +302,12 @@ void Memory_Pool_PutFrame(std::fstream& bitstreamFile, ETRI_Interface* EncoderIF
 	After Encoding, We can get HEVC Stream (EncoderIF->AnnexBData) and \n
 	size of HEVC stream per Frame (EncoderIF->AnnexBFrameSize) 
 	*/
+#if ETRI_STREAM_OUTPUT
+	///< The access units larger than AnnexBData are continued in the chunks of the DLL
+	for (int k = 0; k < EncoderIF->iNumAnnexBChunk; k++)
+		bitstreamFile.write((const char *)EncoderIF->AnnexBChunk[k].pData, EncoderIF->AnnexBChunk[k].uiBytes);
+#else
 	bitstreamFile.write((const char *)EncoderIF->AnnexBData, EncoderIF->AnnexBFrameSize);			
+#endif
 }
 #endif
@@ -728,6 +728,33 @@ Bool TAppEncCfg::parseCfg( Int argc, Char* argv[] )
   ("ETRI_InfiniteProcessing", em_iETRI_InfiniteProcessing, 1, "It represents the Infinite Processing for DLL : Default : 1 (Finite Processing) 0 : (Infinite Processing)")
   ("ETRI_ColorSpaceYV12", em_iETRI_ColorSpaceYV12, 0, "It represents the the color space of YV12 : Default : 0 (I420) 1 : (YV12)")
 #endif
+#if ETRI_SIMD
+  ("ETRI_SIMDLevel", em_iETRI_SIMDLevel, ETRI_SIMD_LEVEL_AUTO, "Maximum SIMD level of the kernels : Default : -1 (Auto by cpuid) 2 : SSE4.2 3 : AVX2 4 : AVX-512 (AVX2 kernels)")
+#endif
+#if ETRI_THREAD_AFFINITY
+  ("ETRI_ThreadAffinity", em_iETRI_ThreadAffinity, ETRI_AFFINITY_OFF, "Placement of the worker threads and picture buffers : Default : 0 (Off) 1 : (In one socket) 2 : (Across all sockets)")
+  ("ETRI_NumaNode", em_iETRI_NumaNode, -1, "NUMA node of ETRI_ThreadAffinity 1 : Default : -1 (Node of the calling CPU)")
+#endif
+#if ETRI_HUGE_PAGE
+  ("ETRI_HugePage", em_iETRI_HugePage, ETRI_HUGEPAGE_OFF, "Pages of the pre-faulted picture buffers : Default : 0 (4KB) 1 : (Transparent huge pages) 2 : (Explicit huge pages of vm.nr_hugepages)")
+#endif
+#if ETRI_SCENECUT
+  ("ETRI_SceneCut", em_iETRI_SceneCut, 0, "Scene-cut threshold : a picture whose lowres inter cost to the previous picture is over N % of its intra cost starts a new scene with an IRAP : Default : 0 (Off)")
+#endif
+#if ETRI_PYRAMID_ME
+  ("ETRI_PyramidME", em_iETRI_PyramidME, -1, "Coarse-to-fine motion pre-search per CTU on 1/4 and 1/16 resolution planes seeds the TZ search : Default : -1 (ETRI_Preset)")
+#endif
+#if ETRI_MV_CACHE
+  ("ETRI_MvCache", em_bETRI_MvCache, true, "Vectors found in a CTU seed the TZ search of its sub-CUs, other partitions and next references, with a local refinement only on a good match : Default : 1 (On)")
+#endif
+  ("ETRI_Preset", em_ETRI_Preset, string(ETRI_DEFAULT_PRESET), "Speed tier of the fast algorithms : ultrafast, superfast, veryfast, faster, fast, medium, slow, slower, veryslow : Default : " ETRI_DEFAULT_PRESET)
+  ("ETRI_FastCU", em_iETRI_FastCU, -1, "Fast CU methods : adaptive CTU size, CU mode inheritance and revised early CU : Default : -1 (ETRI_Preset)")
+  ("ETRI_AdaptiveCTUSize", em_iETRI_AdaptiveCTUSize, -1, "64x64 CU by slice depth and no 16x16 split in high temporal layers, with ETRI_FastCU : Default : -1 (ETRI_Preset)")
+  ("ETRI_Skip64x64LCU", em_iETRI_Skip64x64LCU, -1, "Never test the 64x64 CU : Default : -1 (ETRI_Preset)")
+  ("ETRI_QuarterPelME", em_iETRI_QuarterPelME, -1, "Quarter-pel motion refinement : Default : -1 (ETRI_Preset)")
+  ("ETRI_HalfPelDiamond", em_iETRI_HalfPelDiamond, -1, "Half-pel motion refinement on 4 diamond points instead of 8 neighbours : Default : -1 (ETRI_Preset)")
+  ("ETRI_RDOOffBestMergeCand", em_iETRI_RDOOffBestMergeCand, -1, "Best SKIP/Merge candidate by HAD before the RDO : Default : -1 (ETRI_Preset)")
+  ("ETRI_PostESD", em_iETRI_PostESD, -1, "Early skip decision after the 2Nx2N inter, with ETRI_RDOOffBestMergeCand : Default : -1 (ETRI_Preset)")
 #if ETRI_MultiplePPS
   //ETRI Multiple PPS Option 
   ("NumAdditionalPPS", em_NumAdditionalPPS, 0, "Number of additional PPS")  
@@ -783,9 +810,15 @@ Bool TAppEncCfg::parseCfg( Int argc, Char* argv[] )
   /*
    * Set any derived parameters
    */
+  if (!ETRI_xApplyPreset())
+  {
+    fprintf(stderr, "Unknown ETRI_Preset `%s' : ultrafast, superfast, veryfast, faster, fast, medium, slow, slower or veryslow\n", em_ETRI_Preset.c_str());
+    return false;
+  }
+
   /* convert std::string to c string for compatability */
   m_pchInputFile = cfg_InputFile.empty() ? NULL : strdup(cfg_InputFile.c_str());
-#if KAIST_HARDCODING_QP || KAIST_HARDCODING_TARGETBIT || KAIST_USEPREPS
+#if KAIST_HARDCODING_QP || KAIST_HARDCODING_TARGETBIT || (KAIST_USEPREPS && !ETRI_LOOKAHEAD)
   inputFile = new char[200];
   strcpy(inputFile, m_pchInputFile);
   Int loc = 0;
@@ -1134,6 +1167,53 @@ Bool TAppEncCfg::parseCfg( Int argc, Char* argv[] )
 // Private member functions
 // ====================================================================================================================
 
+/// Switches of the fast algorithms per speed tier, from the fastest to the slowest
+static const struct
+{
+  const Char* pchName;
+  Int iFastCU, iAdaptiveCTUSize, iSkip64x64LCU, iQuarterPelME, iHalfPelDiamond, iRDOOffBestMergeCand, iPostESD, iPyramidME;
+}
+e_ETRIPresets[] =
+{
+  //  name          FastCU AdaptCTU Skip64 QPelME HalfDiamond RDOOffMerge PostESD PyramidME
+  { "ultrafast",      1,     1,       1,     0,      1,          1,          1,      0 },
+  { "superfast",      1,     1,       1,     0,      1,          1,          1,      1 },
+  { "veryfast",       1,     1,       0,     0,      1,          1,          1,      1 },
+  { "faster",         1,     1,       0,     0,      0,          1,          1,      1 },
+  { "fast",           1,     1,       0,     1,      0,          1,          1,      1 },
+  { "medium",         1,     1,       0,     1,      0,          1,          0,      1 },
+  { "slow",           1,     1,       0,     1,      0,          0,          0,      1 },
+  { "slower",         1,     0,       0,     1,      0,          0,          0,      1 },
+  { "veryslow",       0,     0,       0,     1,      0,          0,          0,      1 },
+};
+
+/** Set the switches of the fast algorithms not given on the command line or in the configuration file from em_ETRI_Preset
+ * \returns false for an unknown preset
+ */
+Bool TAppEncCfg::ETRI_xApplyPreset()
+{
+  for (Int i = 0; i < (Int)(sizeof(e_ETRIPresets) / sizeof(e_ETRIPresets[0])); i++)
+  {
+    if (em_ETRI_Preset != e_ETRIPresets[i].pchName)
+    {
+      continue;
+    }
+    if (em_iETRI_FastCU               < 0) em_iETRI_FastCU               = e_ETRIPresets[i].iFastCU;
+    if (em_iETRI_AdaptiveCTUSize      < 0) em_iETRI_AdaptiveCTUSize      = e_ETRIPresets[i].iAdaptiveCTUSize;
+    if (em_iETRI_Skip64x64LCU         < 0) em_iETRI_Skip64x64LCU         = e_ETRIPresets[i].iSkip64x64LCU;
+    if (em_iETRI_QuarterPelME         < 0) em_iETRI_QuarterPelME         = e_ETRIPresets[i].iQuarterPelME;
+    if (em_iETRI_HalfPelDiamond       < 0) em_iETRI_HalfPelDiamond       = e_ETRIPresets[i].iHalfPelDiamond;
+    if (em_iETRI_RDOOffBestMergeCand  < 0) em_iETRI_RDOOffBestMergeCand  = e_ETRIPresets[i].iRDOOffBestMergeCand;
+    if (em_iETRI_PostESD              < 0) em_iETRI_PostESD              = e_ETRIPresets[i].iPostESD;
+#if ETRI_PYRAMID_ME
+    if (em_iETRI_PyramidME            < 0) em_iETRI_PyramidME            = e_ETRIPresets[i].iPyramidME;
+#endif
+    return true;
+  }
+  return false;
+}
+// ====================================================================================================================
+
 Bool confirmPara(Bool bflag, const Char* message);
 
 Void TAppEncCfg::xCheckParameter()
@@ -1182,6 +1262,26 @@ Void TAppEncCfg::xCheckParameter()
   xConfirmPara( m_loopFilterBetaOffsetDiv2 < -6 || m_loopFilterBetaOffsetDiv2 > 6,          "Loop Filter Beta Offset div. 2 exceeds supported range (-6 to 6)");
   xConfirmPara( m_loopFilterTcOffsetDiv2 < -6 || m_loopFilterTcOffsetDiv2 > 6,              "Loop Filter Tc Offset div. 2 exceeds supported range (-6 to 6)");
   xConfirmPara( m_iFastSearch < 0 || m_iFastSearch > 2,                                     "Fast Search Mode is not supported value (0:Full search  1:Diamond  2:PMVFAST)" );
+#if ETRI_SIMD
+  xConfirmPara( em_iETRI_SIMDLevel < ETRI_SIMD_LEVEL_AUTO || em_iETRI_SIMDLevel > ETRI_SIMD_LEVEL_AVX512, "SIMD Level is not supported value (-1:Auto 2:SSE4.2 3:AVX2 4:AVX-512)" );
+  xConfirmPara( em_iETRI_SIMDLevel != ETRI_SIMD_LEVEL_AUTO && em_iETRI_SIMDLevel < ETRI_SIMD_LEVEL_BASE, "SIMD Level is lower than the base ISA of this build (SSE4.2)" );
+#endif
+#if ETRI_THREAD_AFFINITY
+  xConfirmPara( em_iETRI_ThreadAffinity < ETRI_AFFINITY_OFF || em_iETRI_ThreadAffinity > ETRI_AFFINITY_CROSS_SOCKET, "Thread Affinity is not supported value (0:Off 1:In Socket 2:Cross Socket)" );
+  xConfirmPara( em_iETRI_NumaNode < -1,                                                     "NUMA Node must be -1 (Node of the calling CPU) or more" );
+#endif
+#if ETRI_HUGE_PAGE
+  xConfirmPara( em_iETRI_HugePage < ETRI_HUGEPAGE_OFF || em_iETRI_HugePage > ETRI_HUGEPAGE_EXPLICIT, "Huge Page is not supported value (0:Off 1:Transparent 2:Explicit)" );
+#endif
+  xConfirmPara( em_iETRI_FastCU > 1 || em_iETRI_AdaptiveCTUSize > 1 || em_iETRI_Skip64x64LCU > 1 || em_iETRI_QuarterPelME > 1 ||
+                em_iETRI_HalfPelDiamond > 1 || em_iETRI_RDOOffBestMergeCand > 1 || em_iETRI_PostESD > 1, "Switches of the fast algorithms must be -1 (ETRI_Preset), 0 or 1" );
+#if ETRI_PYRAMID_ME
+  xConfirmPara( em_iETRI_PyramidME > 1,                                                     "ETRI_PyramidME must be -1 (ETRI_Preset), 0 or 1" );
+#endif
+#if ETRI_SCENECUT
+  xConfirmPara( em_iETRI_SceneCut < 0 || em_iETRI_SceneCut > 100,                           "Scene Cut threshold must be in the range of 0 to 100" );
+  xConfirmPara( em_iETRI_SceneCut > 0 && m_isField,                                         "Scene Cut detection is not supported for field coding" );
+#endif
   xConfirmPara( m_iSearchRange < 0 ,                                                        "Search Range must be more than 0" );
   xConfirmPara( m_bipredSearchRange < 0 ,                                                   "Search Range must be more than 0" );
   xConfirmPara( m_iMaxDeltaQP > 7,                                                          "Absolute Delta QP exceeds supported range (0 to 7)" );
@@ -1697,6 +1797,7 @@ Void TAppEncCfg::xCheckParameter()
     }
     xConfirmPara( m_uiDeltaQpRD > 0, "Rate control cannot be used together with slice level multiple-QP optimization!\n" );
 #if KAIST_RC
+	xConfirmPara(m_iGOPSize != 8 || m_iIntraPeriod != 32, "Rate control supports only GOPSize 8 with IntraPeriod 32 (the frame bit allocation follows the RA GOP 8 hierarchy)");
 	if ((m_RCCpbSaturationEnabled) && (m_level != Level::NONE) && (m_profile != Profile::NONE))
 	{
 		UInt uiLevelIdx = (m_level / 10) + (UInt)((m_level % 10) / 3);    // (m_level / 30)*3 + ((m_level % 10) / 3);
@@ -1753,6 +1854,26 @@ Void TAppEncCfg::xSetGlobal()
 
   g_uiPCMBitDepthLuma = m_bPCMInputBitDepthFlag ? m_inputBitDepthY : m_internalBitDepthY;
   g_uiPCMBitDepthChroma = m_bPCMInputBitDepthFlag ? m_inputBitDepthC : m_internalBitDepthC;
+
+#if ETRI_SIMD
+  // select SIMD level of kernels before the encoder classes register their function tables
+  em_iETRI_SIMDLevel = ETRI_SetSimdLevel(em_iETRI_SIMDLevel);
+#endif
+#if ETRI_THREAD_AFFINITY
+  // place the worker threads and picture buffers before the encoder creates them. Off keeps the setting of the DLL interface
+  if (em_iETRI_ThreadAffinity != ETRI_AFFINITY_OFF)
+  {
+    em_iETRI_ThreadAffinity = ETRI_SetThreadAffinity(em_iETRI_ThreadAffinity, em_iETRI_NumaNode, 0);
+  }
+  else
+  {
+    em_iETRI_ThreadAffinity = ETRI_GetThreadAffinity();
+  }
+#endif
+#if ETRI_HUGE_PAGE
+  // page kind of the picture buffers before the encoder creates them
+  em_iETRI_HugePage = ETRI_SetHugePage(em_iETRI_HugePage);
+#endif
 }
 
 Void TAppEncCfg::xPrintParameter()
@@ -1761,6 +1882,15 @@ Void TAppEncCfg::xPrintParameter()
   printf("Input          File          : %s\n", m_pchInputFile          );
   printf("Bitstream      File          : %s\n", m_pchBitstreamFile      );
   printf("Reconstruction File          : %s\n", m_pchReconFile          );
+#if ETRI_SIMD
+  printf("SIMD Level                   : %s\n", ETRI_GetSimdLevelName(em_iETRI_SIMDLevel));
+#endif
+#if ETRI_THREAD_AFFINITY
+  printf("Thread Affinity              : %s\n", ETRI_GetThreadAffinityName(em_iETRI_ThreadAffinity));
+#endif
+#if ETRI_HUGE_PAGE
+  printf("Huge Page                    : %s\n", ETRI_GetHugePageName(em_iETRI_HugePage));
+#endif
   //printf("Real     Format              : %dx%d %dHz\n", m_iSourceWidth - m_confWinLeft - m_confWinRight, m_iSourceHeight - m_confWinTop - m_confWinBottom, m_iFrameRate ); // wsseo@2015-08-24. fix fps
   printf("Real     Format              : %dx%d %0.2fHz\n", m_iSourceWidth - m_confWinLeft - m_confWinRight, m_iSourceHeight - m_confWinTop - m_confWinBottom, m_fFrameRate ); // wsseo@2015-08-24. fix fps
   //printf("Internal Format              : %dx%d %dHz\n", m_iSourceWidth, m_iSourceHeight, m_iFrameRate ); // wsseo@2015-08-24. fix fps
@@ -1789,8 +1919,22 @@ Void TAppEncCfg::xPrintParameter()
   printf("Max RQT depth intra          : %d\n", m_uiQuadtreeTUMaxDepthIntra);
   printf("Min PCM size                 : %d\n", 1 << m_uiPCMLog2MinSize);
   printf("Motion search range          : %d\n", m_iSearchRange );
+  printf("Fast algorithm preset        : %s\n", em_ETRI_Preset.c_str() );
+  printf("Fast CU / adaptive CTU size  : %d / %d\n", em_iETRI_FastCU, em_iETRI_AdaptiveCTUSize );
+  printf("Skip 64x64 CU                : %d\n", em_iETRI_Skip64x64LCU );
+  printf("Quarter-pel / half-pel diamond ME : %d / %d\n", em_iETRI_QuarterPelME, em_iETRI_HalfPelDiamond );
+  printf("RDO-off merge cand. / post ESD : %d / %d\n", em_iETRI_RDOOffBestMergeCand, em_iETRI_PostESD );
+#if ETRI_PYRAMID_ME
+  printf("Pyramid motion pre-search    : %d\n", em_iETRI_PyramidME );
+#endif
+#if ETRI_MV_CACHE
+  printf("Motion field cache           : %d\n", em_bETRI_MvCache );
+#endif
   printf("Intra period                 : %d\n", m_iIntraPeriod );
   printf("Decoding refresh type        : %d\n", m_iDecodingRefreshType );
+#if ETRI_SCENECUT
+  printf("Scene cut threshold          : %d\n", em_iETRI_SceneCut );
+#endif
   printf("QP                           : %5.2f\n", m_fQP );
   printf("Max dQP signaling depth      : %d\n", m_iMaxCuDQPDepth);
 
@@ -321,9 +321,37 @@ protected:
   Bool  	em_bETRI_FullReleaseMode;
   short  	em_sETRI_SliceIndex;
 #endif
+#if ETRI_SIMD
+  Int 		em_iETRI_SIMDLevel;                               ///< -1:Auto (cpuid), 2:SSE4.2, 3:AVX2, 4:AVX-512 (AVX2 kernels)
+#endif
+#if ETRI_THREAD_AFFINITY
+  Int 		em_iETRI_ThreadAffinity;                          ///< 0:Off, 1:In a socket, 2:Across sockets
+  Int 		em_iETRI_NumaNode;                                ///< NUMA node of ThreadAffinity 1 (-1:Node of the calling CPU)
+#endif
+#if ETRI_HUGE_PAGE
+  Int 		em_iETRI_HugePage;                                ///< 0:Off, 1:Transparent, 2:Explicit (reserved pool)
+#endif
+#if ETRI_SCENECUT
+  Int 		em_iETRI_SceneCut;                                ///< Scene-cut threshold in percent of the intra cost (0:Off)
+#endif
+#if ETRI_PYRAMID_ME
+  Int 		em_iETRI_PyramidME;                               ///< Coarse-to-fine pre-search per CTU seeds the TZ search (-1:Preset)
+#endif
+#if ETRI_MV_CACHE
+  Bool		em_bETRI_MvCache;                                 ///< Motion field of the CTU seeds the searches of sub-CUs and next references
+#endif
+  std::string	em_ETRI_Preset;                                ///< Speed tier of the fast algorithms : ultrafast ... veryslow
+  Int 		em_iETRI_FastCU;                                  ///< Switches of the fast algorithms (-1:Preset, 0:Off, 1:On)
+  Int 		em_iETRI_AdaptiveCTUSize;
+  Int 		em_iETRI_Skip64x64LCU;
+  Int 		em_iETRI_QuarterPelME;
+  Int 		em_iETRI_HalfPelDiamond;
+  Int 		em_iETRI_RDOOffBestMergeCand;
+  Int 		em_iETRI_PostESD;
   
   // internal member functions
   Void  xSetGlobal      ();                                   ///< set global variables
+  Bool  ETRI_xApplyPreset ();                                 ///< set the switches left to -1 from em_ETRI_Preset
   Void  xCheckParameter ();                                   ///< check validity of configuration values
   Void  xPrintParameter ();                                   ///< print configuration values
   Void  xPrintUsage     ();                                   ///< print usage
@@ -312,6 +312,22 @@ Void TAppEncTop::xInitLibCfg()
   m_cTEncTop.setCpbSize(m_RCCpbSize);
   m_cTEncTop.setInitialCpbFullness(m_RCInitialCpbFullness);
 #endif
+#if ETRI_SCENECUT
+  m_cTEncTop.ETRI_setSceneCut       ( em_iETRI_SceneCut );
+#endif
+#if ETRI_PYRAMID_ME
+  m_cTEncTop.ETRI_setPyramidME      ( em_iETRI_PyramidME > 0 );
+#endif
+#if ETRI_MV_CACHE
+  m_cTEncTop.ETRI_setMvCache        ( em_bETRI_MvCache );
+#endif
+  m_cTEncTop.ETRI_setFastCU                 ( em_iETRI_FastCU > 0 );
+  m_cTEncTop.ETRI_setAdaptiveCTUSize        ( em_iETRI_AdaptiveCTUSize > 0 );
+  m_cTEncTop.ETRI_setSkip64x64LCU           ( em_iETRI_Skip64x64LCU > 0 );
+  m_cTEncTop.ETRI_setQuarterPelME           ( em_iETRI_QuarterPelME > 0 );
+  m_cTEncTop.ETRI_setHalfPelDiamond         ( em_iETRI_HalfPelDiamond > 0 );
+  m_cTEncTop.ETRI_setRDOOffBestMergeCand    ( em_iETRI_RDOOffBestMergeCand > 0 );
+  m_cTEncTop.ETRI_setPostESD                ( em_iETRI_PostESD > 0 );
   m_cTEncTop.setTransquantBypassEnableFlag(m_TransquantBypassEnableFlag);
   m_cTEncTop.setCUTransquantBypassFlagForceValue(m_CUTransquantBypassFlagForce);
   m_cTEncTop.setUseRecalculateQPAccordingToLambda( m_recalculateQPAccordingToLambda );
@@ -454,9 +470,6 @@ Void TAppEncTop::encode(InterfaceInfo& eETRIInterface)
 	}
 #endif
 
-	//GOP Parallel
-	int  iNumPeriod = 0;
-
 #if ETRI_MULTITHREAD_2
 	if (m_pchReconFile)
 #endif
@@ -508,8 +521,8 @@ Void TAppEncTop::encode(InterfaceInfo& eETRIInterface)
 
 		if (eETRIInterface.iNumEncoded >= m_iIntraPeriod)
 		{
-			iNumPeriod++;
-			m_cTEncTop.ETRI_xPocReArrayPicBuffer(&em_cListPic, iNumPeriod*m_iIntraPeriod);
+			//GOP Parallel : the next period starts from the last picture of this one (called once per picture, no period count here)
+			m_cTEncTop.ETRI_xPocReArrayPicBuffer(&em_cListPic, *m_cTEncTop.ETRI_getpiPOCLast());
 		}
 #else
 		ETRI_xWriteOutput(*eETRIInterface.FStream, eETRIInterface.iNumEncoded, em_poutputAccessUnits);
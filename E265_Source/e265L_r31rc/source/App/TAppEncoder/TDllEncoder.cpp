@@ -71,6 +71,61 @@ __inline	int    	ETRI_getNumAllPicCodedIdx 	(ETRI_Interface* EncoderIF)	{ return
 __inline	bool 	ETRI_getAnalyzeClear   	   	(ETRI_Interface* EncoderIF)	{ return EncoderIF->CTRParam.bAnalyzeClear; }
 
 
+#if ETRI_ZEROCOPY_IO
+/// Output buffer of the next call : the first one the caller does not hold from iNextOutput. -1 : The caller holds every buffer
+static int ETRI_getFreeOutput(ETRI_IORing* pRing)
+{
+	for( int k = 0; k < pRing->iNumOutput; k++ )
+	{
+		int iIdx = (pRing->iNextOutput + k) % pRing->iNumOutput;
+		if( !pRing->bOutputBusy[iIdx] )	{ return iIdx; }
+	}
+	return -1;
+}
+
+#if ETRI_STREAM_OUTPUT
+/**
+	The access units of the call go back by the output buffer iOutputIdx the stream was opened on, and the bytes the stream 
+	spilled beyond it are copied into the next free output buffers. What the caller leaves no buffer for is given by 
+	ETRI_IORING_OVERFLOW straight from the chunks of the DLL.
+*/
+static void ETRI_completeOutput(ETRI_IORing* pRing, int iOutputIdx, ETRI_BitstreamChunk* pcChunk, int iNumChunk)
+{
+	int 			iIdx	= iOutputIdx;
+	unsigned int	uiBytes	= pcChunk[0].uiBytes;
+	int 			k		= 1;
+	unsigned int	uiRead	= 0;		///< Bytes of pcChunk[k] already given back
+
+	while( iIdx >= 0 )
+	{
+		while( k < iNumChunk && uiBytes < pRing->uiOutputSize[iIdx] )
+		{
+			unsigned int uiCopy = min( pcChunk[k].uiBytes - uiRead, pRing->uiOutputSize[iIdx] - uiBytes );
+			::memcpy( pRing->pOutput[iIdx] + uiBytes, pcChunk[k].pData + uiRead, uiCopy );
+			uiBytes += uiCopy;	uiRead += uiCopy;
+			if( uiRead == pcChunk[k].uiBytes )	{ k++; uiRead = 0; }
+		}
+
+		pRing->bOutputBusy[iIdx] = true;
+		pRing->iNextOutput = (iIdx + 1) % pRing->iNumOutput;
+		pRing->pfCompletion( pRing->pvUser, ETRI_IORING_OUTPUT, iIdx, uiBytes );
+		if( k == iNumChunk )	{ return; }
+
+		iIdx	= ETRI_getFreeOutput( pRing );
+		uiBytes	= 0;
+	}
+
+	::fprintf_s( stderr, "ETRI_EncoderMainFunc : The access units of the call exceed the free output buffers of the ring \n" );
+	for( ; k < iNumChunk; k++, uiRead = 0 )
+	{
+		pRing->pOverflow = pcChunk[k].pData + uiRead;
+		pRing->pfCompletion( pRing->pvUser, ETRI_IORING_OVERFLOW, -1, pcChunk[k].uiBytes - uiRead );
+	}
+	pRing->pOverflow = NULL;
+}
+#endif
+#endif
+
 #if (_ETRI_WINDOWS_APPLICATION)
 void ETRI_Debug_DLLInterfaceInfo(ETRI_Interface* EncoderIF)
 {
@@ -148,6 +203,10 @@ extern "C" DLL_DECL void *ETRI_EncoderConstruct(int argc, char *argv[])
 	::memset( pcTAppEncTop->e_ETRIInterface.nSliceIndex, 0, MAX_FRAME_NUM_IN_GOP * sizeof(short) );
 
 	::memset( &pcTAppEncTop->e_ETRIInterface.CTRParam, 0, sizeof(pcTAppEncTop->e_ETRIInterface.CTRParam) );
+#if ETRI_ZEROCOPY_IO
+	::memset( &pcTAppEncTop->e_ETRIInterface.IORing, 0, sizeof(pcTAppEncTop->e_ETRIInterface.IORing) );
+	pcTAppEncTop->e_ETRIInterface.IORing.iOutputIdx = -1;
+#endif
 
 	pETRIEncoder = nullptr;
 	eg_uiBits    = 0;
@@ -170,6 +229,16 @@ extern "C" DLL_DECL bool  ETRI_EncoderInitilization	(void *hTAppEncTop)
 	}
 
 	TAppEncTop *pcTAppEncTop = (TAppEncTop *)hTAppEncTop;
+#if ETRI_THREAD_AFFINITY
+	// Linux : The process group is the NUMA node of the encoder. ETRI_ThreadAffinity of the config overrides it
+	if ( pcTAppEncTop->e_ETRIInterface.CTRParam.usUseProcessGroup )
+	{
+		::fprintf( stdout, "[NUMA NODE:%d, AFF:0x%016llX] \n", pcTAppEncTop->e_ETRIInterface.CTRParam.usPorcGroup, 
+			pcTAppEncTop->e_ETRIInterface.CTRParam.ullAffinityMask );
+		ETRI_SetThreadAffinity( ETRI_AFFINITY_IN_SOCKET, pcTAppEncTop->e_ETRIInterface.CTRParam.usPorcGroup, 
+			pcTAppEncTop->e_ETRIInterface.CTRParam.ullAffinityMask );
+	}
+#endif
 	pcTAppEncTop->ETRI_DLLEncoderInitialize( pcTAppEncTop->e_ETRIInterface );
 
 	//--------------------  Print DLL Information ---------------------
@@ -268,9 +337,36 @@ extern "C" DLL_DECL bool  ETRI_EncoderMainFunc(void *hTAppEncTop)
 	}
 
 	TAppEncTop *pcTAppEncTop = (TAppEncTop *)hTAppEncTop;
+	///< AnnexBData of the caller has MAX_ANNEXB_BUFFER_SIZE bytes, the one of the DLL FrameSize bytes
+	int 		iAnnexBSize  = pcTAppEncTop->e_ETRIInterface.CTRParam.bOutBufferOff ? pcTAppEncTop->e_ETRIInterface.FrameSize : MAX_ANNEXB_BUFFER_SIZE;
+
+#if ETRI_ZEROCOPY_IO
+	///< The planes are read from the input frame of the ring and the access units are written into a free output buffer
+	ETRI_IORing*	pRing = &pcTAppEncTop->e_ETRIInterface.IORing;
+	int 			iOutputIdx = ETRI_getFreeOutput( pRing );
+
+	///< Nothing is read or encoded on an error : the caller calls again with the same input after fixing it
+	if( pRing->iNumInput > 0 && (pRing->iInputIdx < 0 || pRing->iInputIdx >= pRing->iNumInput) )
+	{
+		::fprintf_s( stderr, "ETRI_EncoderMainFunc : Input frame %d out of the ring of %d frames \n", pRing->iInputIdx, pRing->iNumInput );
+		return false;
+	}
+	if( pRing->iNumOutput > 0 && iOutputIdx < 0 )
+	{
+		::fprintf_s( stderr, "ETRI_EncoderMainFunc : The caller holds every output buffer of the ring. Return one by ETRI_EncoderReturnBuffer \n" );
+		return false;
+	}
 
+	pcTAppEncTop->e_ETRIInterface.m_pcHandle->open( (pRing->iNumInput > 0)? pRing->pInput[pRing->iInputIdx] : pcTAppEncTop->e_ETRIInterface.ptrData, 
+		pcTAppEncTop->e_ETRIInterface.FrameSize ); 	
+	if( pRing->iNumOutput > 0 )
+		pcTAppEncTop->e_ETRIInterface.FStream->open( pRing->pOutput[iOutputIdx], pRing->uiOutputSize[iOutputIdx] );
+	else
+		pcTAppEncTop->e_ETRIInterface.FStream->open( pcTAppEncTop->e_ETRIInterface.AnnexBData, iAnnexBSize );
+#else
 	pcTAppEncTop->e_ETRIInterface.m_pcHandle->open( pcTAppEncTop->e_ETRIInterface.ptrData, pcTAppEncTop->e_ETRIInterface.FrameSize ); 	
-	pcTAppEncTop->e_ETRIInterface.FStream->open( pcTAppEncTop->e_ETRIInterface.AnnexBData, pcTAppEncTop->e_ETRIInterface.FrameSize );
+	pcTAppEncTop->e_ETRIInterface.FStream->open( pcTAppEncTop->e_ETRIInterface.AnnexBData, iAnnexBSize );
+#endif
 	
 #if ETRI_BUGFIX_DLL_INTERFACE
 	//Check End Of File From Encoder System 
@@ -286,6 +382,29 @@ extern "C" DLL_DECL bool  ETRI_EncoderMainFunc(void *hTAppEncTop)
 
 	//--------------------	Store result of Encoding : 2013 10 23 by Seok ----------
 	pcTAppEncTop->e_ETRIInterface.AnnexBFrameSize = pcTAppEncTop->e_ETRIInterface.FStream->Ftell();	//Size of Output per Frame
+#if ETRI_STREAM_OUTPUT
+	pcTAppEncTop->e_ETRIInterface.AnnexBChunk = pcTAppEncTop->e_ETRIInterface.FStream->getChunkList( pcTAppEncTop->e_ETRIInterface.iNumAnnexBChunk );
+#endif
+
+#if ETRI_ZEROCOPY_IO
+	//--------------------	Ownership of the ring buffers goes back to the caller ----------
+	pRing->iOutputIdx = -1;
+	if( pRing->iNumInput > 0 )
+	{
+		pRing->pfCompletion( pRing->pvUser, ETRI_IORING_INPUT, pRing->iInputIdx, pcTAppEncTop->e_ETRIInterface.FrameSize );
+	}
+	if( pRing->iNumOutput > 0 && pcTAppEncTop->e_ETRIInterface.AnnexBFrameSize > 0 )
+	{
+		pRing->iOutputIdx  = iOutputIdx;
+#if ETRI_STREAM_OUTPUT
+		ETRI_completeOutput( pRing, iOutputIdx, pcTAppEncTop->e_ETRIInterface.AnnexBChunk, pcTAppEncTop->e_ETRIInterface.iNumAnnexBChunk );
+#else
+		pRing->bOutputBusy[iOutputIdx] = true;
+		pRing->iNextOutput = (iOutputIdx + 1) % pRing->iNumOutput;
+		pRing->pfCompletion( pRing->pvUser, ETRI_IORING_OUTPUT, iOutputIdx, pcTAppEncTop->e_ETRIInterface.AnnexBFrameSize );
+#endif
+	}
+#endif
 
 	//// check the TS data
 	//ETRI_dbgMsg( ETRI_DBG_DLL, 2, " ========= 1 GOP ========== \n" );
@@ -407,3 +526,65 @@ extern "C" DLL_DECL ETRI_Interface *ETRI_GetEncInterface(void *hTAppEncTop)
 	TAppEncTop *pcTAppEncTop = (TAppEncTop *)hTAppEncTop;
 	return &pcTAppEncTop->e_ETRIInterface;
 }
+
+#if ETRI_ZEROCOPY_IO
+/**
+	@brief: Registers the rings of input frames and output bitstream buffers of the caller after ETRI_EncoderInitilization. 
+	The buffers are not copied : an input frame is read in place by ETRI_EncoderMainFunc and the planes are swapped into the 
+	picture to be encoded, the access units of a call are written into the next output buffer the caller does not hold. 
+	A ring of 0 buffers keeps ptrData or AnnexBData.
+*/
+#if ETRI_STATIC_DLL
+ENCODERDLL_API bool EncoderMain::EncoderRegisterIORing(ETRI_IORing *pRing)
+#else
+extern "C" DLL_DECL bool  ETRI_EncoderRegisterIORing(void *hTAppEncTop, ETRI_IORing *pRing)
+#endif
+{
+	if( hTAppEncTop == NULL || pRing == NULL ) {
+		return false;
+	}
+
+	TAppEncTop *pcTAppEncTop = (TAppEncTop *)hTAppEncTop;
+	bool	bValid = (pRing->iNumInput >= 0 && pRing->iNumInput <= ETRI_IORING_MAX_BUFFER) && 
+					 (pRing->iNumOutput >= 0 && pRing->iNumOutput <= ETRI_IORING_MAX_BUFFER) && 
+					 (pRing->pfCompletion != NULL || (pRing->iNumInput + pRing->iNumOutput) == 0);
+
+	for( int k = 0; bValid && k < pRing->iNumInput; k++ )	{ bValid = (pRing->pInput[k] != NULL); }
+	for( int k = 0; bValid && k < pRing->iNumOutput; k++ )	{ bValid = (pRing->pOutput[k] != NULL && pRing->uiOutputSize[k] > 0); }
+	if( !bValid || pcTAppEncTop->e_ETRIInterface.FrameSize == 0 )
+	{
+		::fprintf_s( stderr, "ETRI_EncoderRegisterIORing : Invalid ring (Input %d Output %d of %d buffers) or the encoder is not initialized \n", 
+			pRing->iNumInput, pRing->iNumOutput, ETRI_IORING_MAX_BUFFER );
+		return false;
+	}
+
+	pcTAppEncTop->e_ETRIInterface.IORing 			 = *pRing;
+	pcTAppEncTop->e_ETRIInterface.IORing.iInputIdx   = 0;
+	pcTAppEncTop->e_ETRIInterface.IORing.iOutputIdx  = -1;
+	pcTAppEncTop->e_ETRIInterface.IORing.iNextOutput = 0;
+	for( int k = 0; k < ETRI_IORING_MAX_BUFFER; k++ )	{ pcTAppEncTop->e_ETRIInterface.IORing.bOutputBusy[k] = false; }
+
+	pcTAppEncTop->getTEncTop().ETRI_setZeroCopyInput( pRing->iNumInput > 0 );
+	return true;
+}
+
+/**
+	@brief: The caller gives back the output buffer iIdx it got by the completion of ETRI_IORING_OUTPUT.
+*/
+#if ETRI_STATIC_DLL
+ENCODERDLL_API void EncoderMain::EncoderReturnBuffer(int iIdx)
+#else
+extern "C" DLL_DECL void  ETRI_EncoderReturnBuffer(void *hTAppEncTop, int iIdx)
+#endif
+{
+	if( hTAppEncTop == NULL ) {
+		return;
+	}
+
+	ETRI_IORing *pRing = &((TAppEncTop *)hTAppEncTop)->e_ETRIInterface.IORing;
+	if( iIdx >= 0 && iIdx < pRing->iNumOutput )
+	{
+		pRing->bOutputBusy[iIdx] = false;
+	}
+}
+#endif
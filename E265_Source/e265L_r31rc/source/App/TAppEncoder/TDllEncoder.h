@@ -71,6 +71,10 @@ public:
 	ENCODERDLL_API void EncoderPrintSummary();
 
 	ENCODERDLL_API ETRI_Interface *GetEncInterface();
+#if ETRI_ZEROCOPY_IO
+	ENCODERDLL_API bool EncoderRegisterIORing(ETRI_IORing *pRing);
+	ENCODERDLL_API void EncoderReturnBuffer(int iIdx);
+#endif
 
 private:
 	void *hTAppEncTop;
@@ -101,4 +105,8 @@ extern "C" DLL_DECL void  ETRI_EncoderDestroy		(void **hTAppEncTop);
 extern "C" DLL_DECL void  ETRI_printSummary			(void *hTAppEncTop);
 
 extern "C" DLL_DECL ETRI_Interface *ETRI_GetEncInterface(void *hTAppEncTop);
+#if ETRI_ZEROCOPY_IO
+extern "C" DLL_DECL bool  ETRI_EncoderRegisterIORing	(void *hTAppEncTop, ETRI_IORing *pRing);
+extern "C" DLL_DECL void  ETRI_EncoderReturnBuffer	(void *hTAppEncTop, int iIdx);
+#endif
 #endif
@@ -201,6 +201,9 @@ typedef		  unsigned int		  UINT;
 #define ETRI_E265_PH01							1						///< For Version Management of Developing E265 @ 2015 5 26 by Seok
 #define ETRI_MAX_TILES							64 					   ///< 65 is the max num for windows 
 #define ETRI_SIMD_REMAIN_16bit					ETRI_DLL_INTERFACE
+#define ETRI_ZEROCOPY_IO						(1 & ETRI_DLL_INTERFACE)	///< Caller-owned rings of input frames and output bitstream buffers (ETRI_EncoderRegisterIORing)
+#define ETRI_STREAM_OUTPUT						(1 & ETRI_DLL_INTERFACE)	///< One-pass EBSP writer and output spilled into pooled chunks (AnnexBChunk) instead of a fixed buffer
+#define ETRI_STREAM_CHUNK_SIZE					(1 << 20)				///< Bytes of a pooled output chunk
 
 
 // ========================================================================
@@ -225,9 +228,11 @@ typedef		  unsigned int		  UINT;
 #define KAIST_HRD_print		0  // Hypothetical reference decoder with a true decoding order (offline)
 #define KAIST_HARDCODING_QP 0  //for testing quality balance
 #define KAIST_HARDCODING_TARGETBIT 0  //for testing quality balance
-#define KAIST_USEPREPS			0  // use preprocessing for RC
+#define ETRI_LOOKAHEAD			1  // lowres lookahead of the input pictures : frame/CTU costs for RC
+#define ETRI_SCENECUT			(1 & ETRI_LOOKAHEAD)  // scene-cut detection of the lookahead : CRA/IDR at the GOP anchor of the cut (ETRI_SceneCut)
+#define KAIST_USEPREPS			(0 | ETRI_LOOKAHEAD)  // use preprocessing for RC
 #define ETRI_RC_FIX         1
-#if KAIST_USEPREPS
+#if KAIST_USEPREPS && !ETRI_LOOKAHEAD
 #define KAIST_SCENECHANGE	1
 #endif
 #endif
@@ -251,9 +256,15 @@ typedef		  unsigned int		  UINT;
 #define ETRI_THREADPOOL_OPT_MAX_THREAD			64	// max thread of quram threadpool
 #endif
 #define ETRI_TILE_THEAD_OPT						1
+#define ETRI_TILE_DYNAMIC_ASSIGN				(1 & ETRI_TILE_THEAD_OPT)	///< At most MAX_THREAD_TILE tile jobs per picture, each claims the next uncompressed tile until none is left
 #define ETRI_FRAME_THEAD_OPT					1
 #define ETRI_COPYTOPIC_MULTITHREAD				1
-#define ETRI_THREAD_LOAD_BALANCING				(0 & ETRI_SliceFrameEncoding) //only working with slice encoding with mutlpiple PPS option
+#define ETRI_PICTURE_TASK_THREADPOOL			(1 & ETRI_TILE_THEAD_OPT)	///< Picture deblocking and motion compression run as CTU-range jobs of the thread pool instead of OpenMP teams
+#define ETRI_COPYTOPIC_THREADPOOL				(1 & ETRI_COPYTOPIC_MULTITHREAD)	///< The input picture is copied by jobs of the GOP thread pool instead of threads created per frame
+#define ETRI_FRAME_EVENT_SYNC					(1 & ETRI_FRAME_THEAD_OPT)	///< Frame jobs signal slot release and reference-ready POCs instead of usleep polling in ETRI_compressGOP
+#define ETRI_FRAME_ROW_THREADING				(1 & ETRI_FRAME_EVENT_SYNC)	///< A frame may start while its references are still encoded; reconstruction is published per CTU row
+#define ETRI_WPP_PARALLEL						(1 & ETRI_FRAME_ROW_THREADING)	///< WaveFrontSynchro : CTU rows are compressed by wavefront jobs on the thread pool (TEncWPP)
+#define ETRI_THREAD_LOAD_BALANCING				(0 & ETRI_SliceFrameEncoding & !ETRI_TILE_DYNAMIC_ASSIGN) //only working with slice encoding with mutlpiple PPS option. Superseded by ETRI_TILE_DYNAMIC_ASSIGN
 												// When 0, Test for Multiple Slice. When operation of mutiplke Slice is good, it must set 1.
 												// LoadBalancing And Mutiple PPS are Combined. by Yhee
 // ========================================================================
@@ -282,6 +293,7 @@ typedef		  unsigned int		  UINT;
 #define MAX_THREAD_GOP			8   // Frame-thread num
 #define MAX_THREAD_TILE			30	// Tile for frame encoding thread num
 #endif
+#define MAX_THREAD_WPP			16	// CTU-row jobs of a WPP frame
 
 #define ETRI_TILE_ONLY			1   //ThreadPool-based tile ony, If ETRI_MULTITHREAD_2=0, then ETRI_V0 tile_only ver.
 #define ETRI_FRAME_PARALLEL		2  // Frame-parallelization option
@@ -293,6 +305,7 @@ typedef		  unsigned int		  UINT;
 								//for r27 serial option: ETRI_FRAME_PARALLEL && ETRI_SEQ_ARRAY
 #define ETRI_PARALLEL_SEL		ETRI_GOP_PARALLEL //ETRI_FRAME_PARALLEL (for r27 serial woring) //ETRI_TILE_ONLY
 #define ETRI_THREAD_SEL			ETRI_MULTI_ARRAY //ETRI_SEQ_ARRAY (for r27 serial working) 
+#define ETRI_PICTURE_POOL		(ETRI_PARALLEL_SEL == ETRI_GOP_PARALLEL)	///< Pictures of the GOP-parallel encoder allocated once and found by POC in O(1) (TEncPicPool)
 
 #ifdef CABAC_INIT_PRESENT_FLAG
 #undef CABAC_INIT_PRESENT_FLAG
@@ -382,6 +395,16 @@ typedef		  unsigned int		  UINT;
 #define ETRI_SIMD_COPY_TO_PIC                   1
 #endif 
 #define ETRI_SIMD_EXTENEDED_PIC_BORDER          1
+#define ETRI_SIMD_DEBLOCKING                    1   ///< Decision and Filtering of 4-line Luma / Chroma Edge Segments (TComLoopFilter)
+#define ETRI_SIMD_AVX2                          1   ///< AVX2 SAD/SSE/HAD Selected at Run Time by cpuid (TComRdCost::init)
+#if ETRI_SIMD_AVX2
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#define ETRI_TARGET_AVX2                            ///< MSVC accepts AVX2 intrinsics without ISA option
+#else
+#define ETRI_TARGET_AVX2                        __attribute__((target("avx2")))   ///< Base ISA remains -msse4.2
+#endif
+#endif
 #endif
 
 // ========================================================================
@@ -392,6 +415,7 @@ typedef		  unsigned int		  UINT;
 #if ETRI_RDOQ_OPTIMIZATION
 #define ETRI_RDOQ_CODE_OPTIMIZATION 			1
 #define ETRI_RDOQ_SIMD_OPTIMIZATION 			1
+#define ETRI_RDOQ_CG_BATCH						(ETRI_RDOQ_SIMD_OPTIMIZATION)	///< CG-batched distortion of the RDOQ level candidates (AVX2 when available). Decision is identical to xGetCodedLevel
 #define ETRI_Remove_Redundant_EntoropyLoader 	0	///< Now it is inactive. Hoever, for making E265V01:02 it should be active as Lossless Code Optimization @ 2015 5 12 by Seok
 //#define ETRI_RDOQ_ZONAL_CODING   				0
 //#define ETRI_RDOQ_ROUGH_ESTIMATION 			0
@@ -435,6 +459,11 @@ typedef		  unsigned int		  UINT;
 #endif 
 #endif
 
+#define ETRI_CU_ARENA							1	///< Fields of the best, temp and auxiliary CUs of a TEncCu carved from one block (TEncCu::create)
+#if ETRI_CU_ARENA
+#define ETRI_CU_ARENA_ALIGN						64	///< Alignment of each field in the block (cache line)
+#endif
+
 #define ETRI_CODE_CLEANUP     					1
 #if ETRI_CODE_CLEANUP
 #define ETRI_UNNECESSARY_CODE_REMOVAL   		0   
@@ -556,14 +585,10 @@ typedef		  unsigned int		  UINT;
 // ====================================================================================================================
 // Predefinitions for Algorithm 
 // ====================================================================================================================
-#define	ETRI_SKIP_64x64LCU			0								///< Default=1 for V02, FIXME to on/off, SKIP 64x64 LCU @ 2015 9 1 by Seok
 #define	ETRI_ENABLE_2NxNNx2NProc 	0	///< Default=0 for V02, FIXME to on/off, Off Enable 2NxN & Nx2N Processing @ 2015 9 1 by Seok
 #define	ETRI_FIXED_ESDOFF			1	///< Default=1 for V02, Check V1 Option : 2015 0801 by seok
 
-#define	ETRI_RDOOffBestMergeCand	1	///< Default=1, on/off, Choose Best MergeCand based on HAD in SKIP/Merge@ 2015 8 26 by Seok : 
-#define	ETRI_FRDOOffBestMergeCand	(1 && ETRI_RDOOffBestMergeCand)	///< ETRI_SKIP_MergeSkip. Depends on  ETRI_RDOOffBestMergeCand @ 2015 8 26 by Seok : 
-#define	ETRI_POSTESD				(1 && ETRI_RDOOffBestMergeCand)	///< General ESD. Depends on  ETRI_RDOOffBestMergeCand @ 2015 9 3 by Seok
-#define	ETRI_FPOSTESD				(1 && ETRI_POSTESD)				///< Fast ESD Depends on ETRI_POSTESD @ 2015 9 3 by Seok
+/// SKIP 64x64 LCU, best merge candidate by HAD before the RDO (RDOOffBestMergeCand) and post ESD are selected at run time : ETRI_Preset
 
 #define ETRI_GFParallelCompliance 	 1	///1	(Default)	///< Set QpParam Init and Use for ETRI_FRDOOffBestMergeCand for GFParallel, 2015.10.30
 #if (ETRI_GFParallelCompliance && !ETRI_MULTITHREAD_2)
@@ -595,11 +620,24 @@ typedef		  unsigned int		  UINT;
 
 #define ETRI_FAST_MOTION_ESTIMATION 1            ///< Default=1 for V03
 #if ETRI_FAST_MOTION_ESTIMATION
-#define ETRI_NOT_QUARTERPEL_ME		1           ///< Default=1 for V03
-#define ETRI_FME_HALFPEL_DIAMOND_ON	1           ///< Default=1 for V03
-#define ETRI_STATUS_FAST_ME_INFORM	1			
+#define ETRI_STATUS_FAST_ME_INFORM	1			///< Quarter-pel refinement and half-pel diamond are selected at run time : ETRI_Preset
 #endif 
 
+#define ETRI_PYRAMID_ME				1			///< Coarse-to-fine pre-search per CTU on 1/4 and 1/16 planes of the input pictures seeds the TZ search (ETRI_PyramidME)
+#if ETRI_PYRAMID_ME
+#define ETRI_PYRAMID_MARGIN			32			///< Margin of the pyramid planes in samples of the level
+#define ETRI_PYRAMID_RANGE			8			///< Full search range on the 1/16 plane around the zero vector (x4 in full resolution)
+#define ETRI_PYRAMID_DIAMOND		64			///< Largest step of the diamond search on the 1/16 plane
+#define ETRI_PYRAMID_REFINE			2			///< Search range around the left CTU on the 1/16 plane and around the propagated vector on the 1/4 plane
+#endif
+
+#define ETRI_MV_CACHE				1			///< Vectors of the searches in a CTU seed the searches of the sub-CUs, other partitions and next references (ETRI_MvCache)
+#if ETRI_MV_CACHE
+#define ETRI_MV_CACHE_UNITS			256			///< 4x4 units of the largest CTU (64x64)
+#define ETRI_MV_CACHE_SAD			2			///< SAD per sample (8 bit) under which a cached start point only gets a local refinement
+#define ETRI_MV_CACHE_RANGE			2			///< Search range of that local refinement
+#endif
+
 // ====================================================================================================================
 // ETRI FAST CU METHODS
 // ====================================================================================================================
@@ -611,10 +649,6 @@ typedef		  unsigned int		  UINT;
 #define ETRI_ADAPTIVE_MAXCTU_SIZE   1
 #if ETRI_ADAPTIVE_MAXCTU_SIZE
 #define	ETRI_F64SLiceLevel 			1			///< Indicate the Slice Level accommodates to 32x32 [0:3] 0 : GPB, @ 2015 11 16 by Seok	
-#ifdef ETRI_SKIP_64x64LCU
-#define ETRI_SKIP_64x64LCU			0
-#define ETRI_SKIP_64x64LCU_BUGFIX   1
-#endif 
 #endif 
 #define ETRI_ADAPTIVE_MINCTU_SIZE   1
 #define ETRI_ADAPTIVE_CTU_SIZE_BUGFIX 1 
@@ -626,6 +660,10 @@ typedef		  unsigned int		  UINT;
 #define ETRI_REVISE_ECU				1
 #endif
 
+/// The fast CU methods above are compiled in and selected at run time (ETRI_FastCU, ETRI_AdaptiveCTUSize)
+/// together with the fast ME and SKIP/Merge methods by the presets of TAppEncCfg (ETRI_Preset)
+#define ETRI_DEFAULT_PRESET			"veryfast"	///< Preset of the former build defaults
+
 // ====================================================================================================================
 // ETRI FAST PU METHODS
 // ====================================================================================================================
@@ -864,6 +902,73 @@ typedef		  unsigned int		  UINT;
 // ========================================================================
  void ETRI_Service_Init(int iApplicationNameIdx);
 
+#define ETRI_CPU_SSE42			0x01		///< CPU Feature Flags from ETRI_GetCpuFeatures (cpuid + OS support of YMM/ZMM states)
+#define ETRI_CPU_AVX2			0x02
+#define ETRI_CPU_AVX512BW		0x04
+#define ETRI_CPU_SSE41			0x08
+ unsigned int ETRI_GetCpuFeatures();
+
+// ========================================================================
+//	Runtime SIMD Level : Selects the SSE4.2 or AVX2 kernels of TComRdCost::m_afpDistortFunc, TComInterpolationFilter 
+//	and TComTrQuant (transform, RDOQ). Other ETRI_SIMD_XXX kernels are fixed at build time. 
+//	Set once by ETRI_SetSimdLevel before the encoder is created.
+// ========================================================================
+#define ETRI_SIMD_LEVEL_AUTO		-1		///< Highest level supported by the CPU
+#define ETRI_SIMD_LEVEL_C			0
+#define ETRI_SIMD_LEVEL_SSE41		1
+#define ETRI_SIMD_LEVEL_SSE42		2
+#define ETRI_SIMD_LEVEL_AVX2		3
+#define ETRI_SIMD_LEVEL_AVX512		4
+#if ETRI_SIMD
+#define ETRI_SIMD_LEVEL_BASE		ETRI_SIMD_LEVEL_SSE42	///< Kernels under #if ETRI_SIMD_XXX are built with -msse4.2, so lower level is not selectable
+#else
+#define ETRI_SIMD_LEVEL_BASE		ETRI_SIMD_LEVEL_C
+#endif
+#if ETRI_SIMD_AVX2
+#define ETRI_SIMD_LEVEL_TOP		ETRI_SIMD_LEVEL_AVX2	///< Highest level with its own kernels. AVX-512 CPUs run the AVX2 kernels
+#else
+#define ETRI_SIMD_LEVEL_TOP		ETRI_SIMD_LEVEL_BASE
+#endif
+ int			ETRI_SetSimdLevel(int iLevel);
+ int			ETRI_GetSimdLevel();
+ const char*	ETRI_GetSimdLevelName(int iLevel);
+
+// ========================================================================
+//	Thread Affinity (Linux) : Thread pool workers are pinned to the CPUs of NUMA nodes and the picture buffers are 
+//	placed on the same nodes, so reference pictures are not read across sockets. Set once by ETRI_SetThreadAffinity 
+//	before the encoder is created.
+// ========================================================================
+#define ETRI_THREAD_AFFINITY		(1 & !_ETRI_WINDOWS_APPLICATION)
+#define ETRI_AFFINITY_OFF			0		///< No pinning. Pages are placed by the first touch
+#define ETRI_AFFINITY_IN_SOCKET		1		///< Workers and picture buffers on one NUMA node
+#define ETRI_AFFINITY_CROSS_SOCKET	2		///< Workers spread over every NUMA node, picture buffers interleaved over them
+#define ETRI_AFFINITY_MAX_CPU		1024	///< Size of the CPU lists (CPU_SETSIZE)
+ int			ETRI_SetThreadAffinity(int iMode, int iNode, unsigned long long ullCpuMask);
+ int			ETRI_GetThreadAffinity();
+ const char*	ETRI_GetThreadAffinityName(int iMode);
+ int			ETRI_GetAffinityCpus(int iWorker, int iNumWorkers, int* piCpus, int iMaxCpus);
+ void			ETRI_SetCallingThreadAffinity();
+ void			ETRI_BindPictureMemory(void* pvAddr, unsigned long long ullSize);
+
+// ========================================================================
+//	Huge Pages (Linux) : The picture planes (original, reconstruction with the extended borders, lowres planes of ME) are backed 
+//	by 2MB pages and pre-faulted when they are created, so motion compensation over the reference pictures misses less in the dTLB. 
+//	Set once by ETRI_SetHugePage before the encoder is created. Unavailable pages fall back to the next kind down to 4KB pages.
+// ========================================================================
+#define ETRI_HUGE_PAGE				(1 & !_ETRI_WINDOWS_APPLICATION)
+#define ETRI_HUGEPAGE_OFF			0		///< 4KB pages, placed by the first touch
+#define ETRI_HUGEPAGE_TRANSPARENT	1		///< Transparent huge pages (madvise) on 2MB aligned buffers
+#define ETRI_HUGEPAGE_EXPLICIT		2		///< Pages of the reserved pool (MAP_HUGETLB, vm.nr_hugepages)
+#define ETRI_HUGEPAGE_SIZE			(2 << 20)
+ int			ETRI_SetHugePage(int iMode);
+ int			ETRI_GetHugePage();
+ const char*	ETRI_GetHugePageName(int iMode);
+ void*			ETRI_AllocPictureMemory(unsigned long long ullSize);
+ void			ETRI_FreePictureMemory(void* pvAddr);
+ void			ETRI_PrintHugePageStatus();
+ void			ETRI_StartTLBCount();
+ void			ETRI_PrintTLBCount();
+
 
 // ========================================================================
 //	[VUI & SEI] Parameter signaling for HDR/WCG (by Dongsan Jun, 20160124)
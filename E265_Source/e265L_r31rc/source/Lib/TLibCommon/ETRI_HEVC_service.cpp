@@ -40,6 +40,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <atomic>
 
 #if (_ETRI_WINDOWS_APPLICATION)
 #include <io.h>
@@ -47,7 +48,23 @@
 #include <tchar.h>
 #endif
 
+#if defined(__linux__)
+#include <sched.h>
+#include <unistd.h>
+#include <stdint.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <linux/mempolicy.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#endif
+
 #include <emmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
 
 //#ifdef _USRDLL
 //#include "..\..\App\TAppEncoder\TDllEncoder.h"
@@ -58,6 +75,621 @@
 //===========================================================================================
 //	ETRI Service Functions on Orther Memory Area seperated to Encoder Core
 //===========================================================================================
+/**
+	@brief: Read cpuid/xgetbv and return ETRI_CPU_XXX flags. AVX2 and AVX-512BW are reported only when OS saves YMM/ZMM states.
+*/
+static void ETRI_cpuid(int iLeaf, int iSubLeaf, unsigned int* puiReg)	///< puiReg : EAX, EBX, ECX, EDX
+{
+#if defined(_MSC_VER)
+	__cpuidex((int *)puiReg, iLeaf, iSubLeaf);
+#else
+	__cpuid_count(iLeaf, iSubLeaf, puiReg[0], puiReg[1], puiReg[2], puiReg[3]);
+#endif
+}
+
+static unsigned long long ETRI_xgetbv(unsigned int uiIndex)
+{
+#if defined(_MSC_VER)
+	return _xgetbv(uiIndex);
+#else
+	unsigned int uiEAX, uiEDX;
+	__asm__ __volatile__ ("xgetbv" : "=a"(uiEAX), "=d"(uiEDX) : "c"(uiIndex));
+	return ((unsigned long long)uiEDX << 32) | uiEAX;
+#endif
+}
+
+static unsigned int ETRI_DetectCpuFeatures()
+{
+	unsigned int	uiReg[4] = {0, 0, 0, 0};
+	unsigned int	uiFlags  = 0;
+	unsigned int	uiMaxLeaf;
+	unsigned long long	ulXCR0 = 0;
+
+	ETRI_cpuid(0, 0, uiReg);	uiMaxLeaf = uiReg[0];
+	if (uiMaxLeaf < 1) {return uiFlags;}
+
+	ETRI_cpuid(1, 0, uiReg);
+	if (uiReg[2] & (1 << 19)) {uiFlags |= ETRI_CPU_SSE41;}
+	if (uiReg[2] & (1 << 20)) {uiFlags |= ETRI_CPU_SSE42;}
+	if ((uiReg[2] & (1 << 27)) && (uiReg[2] & (1 << 28)))		///< OSXSAVE and AVX
+	{
+		ulXCR0 = ETRI_xgetbv(0);
+	}
+
+	if (uiMaxLeaf < 7 || (ulXCR0 & 0x06) != 0x06) {return uiFlags;}	///< XMM and YMM states
+
+	ETRI_cpuid(7, 0, uiReg);
+	if (uiReg[1] & (1 << 5)) {uiFlags |= ETRI_CPU_AVX2;}
+	if ((uiReg[1] & (1 << 16)) && (uiReg[1] & (1 << 30)) && ((ulXCR0 & 0xE6) == 0xE6))	///< AVX512F, AVX512BW and Opmask/ZMM states
+	{
+		uiFlags |= ETRI_CPU_AVX512BW;
+	}
+	return uiFlags;
+}
+
+unsigned int ETRI_GetCpuFeatures()
+{
+	static unsigned int uiCpuFeatures = ETRI_DetectCpuFeatures();
+	return uiCpuFeatures;
+}
+
+/**
+	@brief: Runtime SIMD Level. TComRdCost, TComInterpolationFilter and TComTrQuant choose their SSE4.2 or AVX2 kernels 
+	by ETRI_GetSimdLevel() at init(). The level is clamped to [ETRI_SIMD_LEVEL_BASE, ETRI_SIMD_LEVEL_TOP] and to the CPU.
+	ETRI_SetSimdLevel should be called before the encoder is created (TAppEncCfg::xSetGlobal).
+*/
+static int	e_iSimdLevel = ETRI_SIMD_LEVEL_AUTO;
+
+static int ETRI_GetCpuSimdLevel()
+{
+	unsigned int uiFlags = ETRI_GetCpuFeatures();
+
+	if (uiFlags & ETRI_CPU_AVX512BW)	{return ETRI_SIMD_LEVEL_AVX512;}
+	if (uiFlags & ETRI_CPU_AVX2)		{return ETRI_SIMD_LEVEL_AVX2;}
+	if (uiFlags & ETRI_CPU_SSE42)		{return ETRI_SIMD_LEVEL_SSE42;}
+	if (uiFlags & ETRI_CPU_SSE41)		{return ETRI_SIMD_LEVEL_SSE41;}
+	return ETRI_SIMD_LEVEL_C;
+}
+
+const char* ETRI_GetSimdLevelName(int iLevel)
+{
+	switch (iLevel)
+	{
+		case ETRI_SIMD_LEVEL_C		: return "C";
+		case ETRI_SIMD_LEVEL_SSE41	: return "SSE4.1";
+		case ETRI_SIMD_LEVEL_SSE42	: return "SSE4.2";
+		case ETRI_SIMD_LEVEL_AVX2	: return "AVX2";
+		case ETRI_SIMD_LEVEL_AVX512	: return "AVX-512";
+		default						: return "Auto";
+	}
+}
+
+int ETRI_SetSimdLevel(int iLevel)
+{
+	int iCpuLevel = ETRI_GetCpuSimdLevel();
+
+	if (iCpuLevel > ETRI_SIMD_LEVEL_TOP)	{iCpuLevel = ETRI_SIMD_LEVEL_TOP;}
+
+	if (iLevel == ETRI_SIMD_LEVEL_AUTO)
+	{
+		iLevel = iCpuLevel;
+	}
+	else if (iLevel > iCpuLevel)
+	{
+		fprintf(stderr, "SIMD Level %s is not supported by this CPU. %s is used \n", ETRI_GetSimdLevelName(iLevel), ETRI_GetSimdLevelName(iCpuLevel));
+		iLevel = iCpuLevel;
+	}
+
+	if (iLevel < ETRI_SIMD_LEVEL_BASE)
+	{
+		fprintf(stderr, "SIMD Level %s is lower than the build base %s. %s is used \n", ETRI_GetSimdLevelName(iLevel), ETRI_GetSimdLevelName(ETRI_SIMD_LEVEL_BASE), ETRI_GetSimdLevelName(ETRI_SIMD_LEVEL_BASE));
+		iLevel = ETRI_SIMD_LEVEL_BASE;
+	}
+
+	e_iSimdLevel = iLevel;
+	return e_iSimdLevel;
+}
+
+int ETRI_GetSimdLevel()
+{
+	if (e_iSimdLevel == ETRI_SIMD_LEVEL_AUTO)
+	{
+		ETRI_SetSimdLevel(ETRI_SIMD_LEVEL_AUTO);
+	}
+	return e_iSimdLevel;
+}
+
+/**
+	@brief: Thread Affinity. NUMA nodes and their CPUs are read from sysfs and restricted to the CPUs the process may run on 
+	and to the CPU mask of the DLL interface (CTRParam.ullAffinityMask). TEncGOP pins the thread pool workers with 
+	ETRI_GetAffinityCpus, and TComPicYuv places the picture buffers with ETRI_BindPictureMemory. 
+	ETRI_SetThreadAffinity should be called before the encoder is created (TAppEncCfg::xSetGlobal).
+*/
+#define ETRI_AFFINITY_MAX_NODE		16
+
+static int	e_iAffinityMode = ETRI_AFFINITY_OFF;
+#if ETRI_THREAD_AFFINITY
+static int	e_iAffinityNumNode = 0;											///< Nodes in use
+static int	e_aiAffinityNode[ETRI_AFFINITY_MAX_NODE];						///< System ID of the nodes in use
+static int	e_aiAffinityNumCpu[ETRI_AFFINITY_MAX_NODE];
+static int	e_aaiAffinityCpu[ETRI_AFFINITY_MAX_NODE][ETRI_AFFINITY_MAX_CPU];
+
+/// CPU list of a NUMA node (e.g. "0-7,16-23"). Returns -1 when the node does not exist
+static int ETRI_ReadNodeCpus(int iNode, int* piCpus, int iMaxCpus)
+{
+	char	acPath[128];
+	char	acList[4096];
+	FILE*	fp;
+	int		iNumCpu = 0;
+
+	sprintf(acPath, "/sys/devices/system/node/node%d/cpulist", iNode);
+	if ((fp = fopen(acPath, "r")) == NULL)		{return -1;}
+	if (fgets(acList, sizeof(acList), fp) == NULL)	{acList[0] = 0;}
+	fclose(fp);
+
+	for (char* pc = acList; *pc >= '0' && *pc <= '9'; )
+	{
+		int iFirst = (int)strtol(pc, &pc, 10);
+		int iLast  = (*pc == '-') ? (int)strtol(pc + 1, &pc, 10) : iFirst;
+		for (int iCpu = iFirst; iCpu <= iLast && iNumCpu < iMaxCpus; iCpu++)	{piCpus[iNumCpu++] = iCpu;}
+		if (*pc == ',')	{pc++;}
+	}
+	return iNumCpu;
+}
+#endif
+
+const char* ETRI_GetThreadAffinityName(int iMode)
+{
+	switch (iMode)
+	{
+		case ETRI_AFFINITY_IN_SOCKET	: return "In Socket";
+		case ETRI_AFFINITY_CROSS_SOCKET	: return "Cross Socket";
+		default							: return "Off";
+	}
+}
+
+/**
+	@brief: iNode is the NUMA node of ETRI_AFFINITY_IN_SOCKET (-1 : The node the caller runs on). 
+	ullCpuMask restricts the CPUs 0..63 (0 : No restriction). Returns the mode actually set.
+*/
+int ETRI_SetThreadAffinity(int iMode, int iNode, unsigned long long ullCpuMask)
+{
+	e_iAffinityMode = ETRI_AFFINITY_OFF;
+#if ETRI_THREAD_AFFINITY
+	e_iAffinityNumNode = 0;
+	if (iMode == ETRI_AFFINITY_OFF)	{return e_iAffinityMode;}
+
+	cpu_set_t	sProcessCpus;
+	int			aiCpu[ETRI_AFFINITY_MAX_CPU];
+	int			iCurrCpu = sched_getcpu();
+	int			iCurrNode = 0;
+	bool		bNodeInfo = (access("/sys/devices/system/node", F_OK) == 0);
+
+	CPU_ZERO(&sProcessCpus);
+	if (sched_getaffinity(0, sizeof(sProcessCpus), &sProcessCpus) != 0)
+	{
+		for (int iCpu = 0; iCpu < ETRI_AFFINITY_MAX_CPU; iCpu++)	{CPU_SET(iCpu, &sProcessCpus);}
+	}
+
+	for (int iSysNode = 0; iSysNode < (bNodeInfo ? ETRI_AFFINITY_MAX_NODE : 1); iSysNode++)
+	{
+		int iNumCpu = 0;
+		if (bNodeInfo)
+		{
+			if ((iNumCpu = ETRI_ReadNodeCpus(iSysNode, aiCpu, ETRI_AFFINITY_MAX_CPU)) < 0)	{continue;}
+		}
+		else
+		{
+			///< No NUMA information : One node of every CPU
+			iNumCpu = (int)sysconf(_SC_NPROCESSORS_CONF);
+			iNumCpu = (iNumCpu < ETRI_AFFINITY_MAX_CPU) ? iNumCpu : ETRI_AFFINITY_MAX_CPU;
+			for (int k = 0; k < iNumCpu; k++)	{aiCpu[k] = k;}
+		}
+		if (iMode == ETRI_AFFINITY_IN_SOCKET && iNode >= 0 && iSysNode != iNode)	{continue;}
+
+		int iNumUsable = 0;
+		for (int k = 0; k < iNumCpu; k++)
+		{
+			if (aiCpu[k] >= ETRI_AFFINITY_MAX_CPU || !CPU_ISSET(aiCpu[k], &sProcessCpus))	{continue;}
+			if (ullCpuMask && (aiCpu[k] >= 64 || !((ullCpuMask >> aiCpu[k]) & 1)))	{continue;}
+			if (aiCpu[k] == iCurrCpu)	{iCurrNode = e_iAffinityNumNode;}
+			e_aaiAffinityCpu[e_iAffinityNumNode][iNumUsable++] = aiCpu[k];
+		}
+		if (iNumUsable == 0)	{continue;}
+
+		e_aiAffinityNode[e_iAffinityNumNode]   = iSysNode;
+		e_aiAffinityNumCpu[e_iAffinityNumNode] = iNumUsable;
+		e_iAffinityNumNode++;
+	}
+
+	if (e_iAffinityNumNode == 0)
+	{
+		fprintf(stderr, "Thread Affinity : No CPU is available on node %d (CPU Mask 0x%016llX). Thread Affinity is Off \n", iNode, ullCpuMask);
+		return e_iAffinityMode;
+	}
+
+	if (iMode == ETRI_AFFINITY_IN_SOCKET && iCurrNode > 0)
+	{
+		///< Keep only the node the caller runs on
+		e_aiAffinityNode[0]   = e_aiAffinityNode[iCurrNode];
+		e_aiAffinityNumCpu[0] = e_aiAffinityNumCpu[iCurrNode];
+		memcpy(e_aaiAffinityCpu[0], e_aaiAffinityCpu[iCurrNode], e_aiAffinityNumCpu[0] * sizeof(int));
+	}
+	if (iMode == ETRI_AFFINITY_IN_SOCKET)	{e_iAffinityNumNode = 1;}
+
+	e_iAffinityMode = iMode;
+#endif
+	return e_iAffinityMode;
+}
+
+int ETRI_GetThreadAffinity()
+{
+	return e_iAffinityMode;
+}
+
+/**
+	@brief: CPUs of a worker of the thread pool. The workers are dealt to the nodes in turn, and a worker gets one core 
+	while the workers on its node do not outnumber the cores, otherwise the workers share the CPUs of their node. 
+	iWorker < 0 gets every CPU in use (threads which are not pool workers). Returns the number of CPUs (0 : No pinning).
+*/
+int ETRI_GetAffinityCpus(int iWorker, int iNumWorkers, int* piCpus, int iMaxCpus)
+{
+	int iNumCpu = 0;
+#if ETRI_THREAD_AFFINITY
+	if (e_iAffinityMode == ETRI_AFFINITY_OFF)	{return 0;}
+
+	if (iWorker < 0)
+	{
+		for (int n = 0; n < e_iAffinityNumNode; n++)
+		{
+			for (int k = 0; k < e_aiAffinityNumCpu[n] && iNumCpu < iMaxCpus; k++)	{piCpus[iNumCpu++] = e_aaiAffinityCpu[n][k];}
+		}
+		return iNumCpu;
+	}
+
+	int iNode = iWorker % e_iAffinityNumNode;
+	int iNumNodeWorker = (iNumWorkers - iNode + e_iAffinityNumNode - 1) / e_iAffinityNumNode;
+
+	if (iNumNodeWorker <= e_aiAffinityNumCpu[iNode])
+	{
+		piCpus[iNumCpu++] = e_aaiAffinityCpu[iNode][iWorker / e_iAffinityNumNode];
+	}
+	else
+	{
+		for (int k = 0; k < e_aiAffinityNumCpu[iNode] && iNumCpu < iMaxCpus; k++)	{piCpus[iNumCpu++] = e_aaiAffinityCpu[iNode][k];}
+	}
+#endif
+	return iNumCpu;
+}
+
+/**
+	@brief: The thread calling the encoder (GOP level processing and job submission) runs on every CPU in use.
+*/
+void ETRI_SetCallingThreadAffinity()
+{
+#if ETRI_THREAD_AFFINITY
+	cpu_set_t	sCpus;
+	int			aiCpu[ETRI_AFFINITY_MAX_CPU];
+	int			iNumCpu = ETRI_GetAffinityCpus(-1, 0, aiCpu, ETRI_AFFINITY_MAX_CPU);
+
+	if (iNumCpu == 0)	{return;}
+
+	CPU_ZERO(&sCpus);
+	for (int k = 0; k < iNumCpu; k++)	{CPU_SET(aiCpu[k], &sCpus);}
+	if (sched_setaffinity(0, sizeof(sCpus), &sCpus) != 0)
+	{
+		fprintf(stderr, "Thread Affinity : sched_setaffinity failed (%s) \n", strerror(errno));
+	}
+#endif
+}
+
+/**
+	@brief: Memory policy of a picture buffer before its pages are touched. ETRI_AFFINITY_IN_SOCKET prefers the node of the workers, 
+	ETRI_AFFINITY_CROSS_SOCKET interleaves the pages over the nodes in use, so no socket serves every reference picture. 
+	Only the pages lying wholly inside the buffer are bound, as the others are shared with the neighbouring heap blocks : 
+	ETRI_AllocPictureMemory gives page aligned buffers of whole pages.
+*/
+void ETRI_BindPictureMemory(void* pvAddr, unsigned long long ullSize)
+{
+#if ETRI_THREAD_AFFINITY
+	static bool	bWarned = false;
+	const int	iBits = 8 * sizeof(unsigned long);
+	unsigned long	aulNodeMask[ETRI_AFFINITY_MAX_NODE / (8 * sizeof(unsigned long)) + 1];
+
+	if (e_iAffinityMode == ETRI_AFFINITY_OFF || pvAddr == NULL || ullSize == 0)	{return;}
+
+	memset(aulNodeMask, 0, sizeof(aulNodeMask));
+	for (int n = 0; n < e_iAffinityNumNode; n++)	{aulNodeMask[e_aiAffinityNode[n] / iBits] |= 1UL << (e_aiAffinityNode[n] % iBits);}
+
+	uintptr_t	uiPage  = (uintptr_t)sysconf(_SC_PAGESIZE);
+	uintptr_t	uiStart = ((uintptr_t)pvAddr + uiPage - 1) & ~(uiPage - 1);
+	uintptr_t	uiEnd   = ((uintptr_t)pvAddr + (uintptr_t)ullSize) & ~(uiPage - 1);
+	int			iPolicy = (e_iAffinityNumNode > 1) ? MPOL_INTERLEAVE : MPOL_PREFERRED;
+
+	if (uiEnd <= uiStart)	{return;}
+	if (syscall(SYS_mbind, uiStart, uiEnd - uiStart, iPolicy, aulNodeMask, (unsigned long)(sizeof(aulNodeMask) * 8), 0) != 0 && !bWarned)
+	{
+		fprintf(stderr, "Thread Affinity : mbind failed (%s). Picture buffers are placed by the first touch \n", strerror(errno));
+		bWarned = true;
+	}
+#endif
+}
+
+/**
+	@brief: Huge Pages. A picture buffer is preceded by ETRI_HUGEPAGE_HEADER bytes recording how it was allocated, so 
+	ETRI_FreePictureMemory releases every kind and the mode may fall back per buffer. The buffers are bound to the NUMA nodes 
+	(ETRI_BindPictureMemory) before they are pre-faulted, and the page kind actually used is counted for ETRI_PrintHugePageStatus.
+*/
+#define ETRI_HUGEPAGE_HEADER		64		///< Keeps the alignment of the planes for SIMD
+
+typedef struct
+{
+	void*				pvBase;			///< Start of the allocation
+	unsigned long long	ullMapSize;		///< Size of the allocation
+	int					iKind;			///< ETRI_HUGEPAGE_XXX actually used
+} ETRI_PictureMemoryHeader;
+
+static int					e_iHugePageMode = ETRI_HUGEPAGE_OFF;
+static int					e_iTLBCounterFd = -1;		///< perf_event_open counter of the dTLB read misses
+static std::atomic<int>					e_aiHugePageBuffers[ETRI_HUGEPAGE_EXPLICIT + 1];	///< Live buffers by the page kind
+static std::atomic<unsigned long long>	e_aullHugePageBytes[ETRI_HUGEPAGE_EXPLICIT + 1];	///< Live bytes by the page kind
+
+const char* ETRI_GetHugePageName(int iMode)
+{
+	switch (iMode)
+	{
+		case ETRI_HUGEPAGE_TRANSPARENT	: return "Transparent";
+		case ETRI_HUGEPAGE_EXPLICIT		: return "Explicit";
+		default							: return "Off";
+	}
+}
+
+#if ETRI_HUGE_PAGE
+/// Transparent huge pages of the kernel are in madvise or always mode. The mode can be changed at any time by the administrator
+static bool ETRI_IsTransparentHugePageOn()
+{
+	char	acLine[256];
+	bool	bOn = false;
+	FILE*	fp = fopen("/sys/kernel/mm/transparent_hugepage/enabled", "r");
+
+	if (fp == NULL)	{return false;}
+	if (fgets(acLine, sizeof(acLine), fp) != NULL)	{bOn = (strstr(acLine, "[never]") == NULL);}
+	fclose(fp);
+	return bOn;
+}
+
+/**
+	@brief: Disabled counter of the dTLB read misses in user mode. It inherits to the threads created afterwards by the calling thread, 
+	so it has to be opened before the encoder creates its thread pool. Hosts without the event (e.g. virtual machines) or with 
+	perf_event_paranoid above 2 do not count.
+*/
+static void ETRI_OpenTLBCounter(bool bWarn)
+{
+	struct perf_event_attr	sAttr;
+
+	if (e_iTLBCounterFd >= 0)	{return;}
+
+	memset(&sAttr, 0, sizeof(sAttr));
+	sAttr.size           = sizeof(sAttr);
+	sAttr.type           = PERF_TYPE_HW_CACHE;
+	sAttr.config         = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+	sAttr.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+	sAttr.disabled       = 1;
+	sAttr.inherit        = 1;
+	sAttr.exclude_kernel = 1;
+	sAttr.exclude_hv     = 1;
+
+	e_iTLBCounterFd = (int)syscall(SYS_perf_event_open, &sAttr, 0, -1, -1, 0);
+	if (e_iTLBCounterFd < 0 && bWarn)
+	{
+		fprintf(stderr, "Huge Page : dTLB misses are not counted (perf_event_open : %s) \n", strerror(errno));
+	}
+}
+#endif
+
+/**
+	@brief: ETRI_HUGEPAGE_TRANSPARENT needs the transparent huge pages of the kernel in madvise or always mode. 
+	ETRI_HUGEPAGE_EXPLICIT is kept when the reserved pool is empty, its buffers then fall back to transparent huge pages. 
+	The dTLB miss counter is opened in every mode, so the runs with and without huge pages can be compared. 
+	Returns the mode actually set.
+*/
+int ETRI_SetHugePage(int iMode)
+{
+	e_iHugePageMode = ETRI_HUGEPAGE_OFF;
+#if ETRI_HUGE_PAGE
+	char	acLine[256];
+	FILE*	fp;
+	bool	bTransparent = ETRI_IsTransparentHugePageOn();
+	long	lNumFree = 0;
+
+	ETRI_OpenTLBCounter(iMode != ETRI_HUGEPAGE_OFF);
+	if (iMode == ETRI_HUGEPAGE_OFF)	{return e_iHugePageMode;}
+
+	if ((fp = fopen("/proc/meminfo", "r")) != NULL)
+	{
+		while (fgets(acLine, sizeof(acLine), fp) != NULL)
+		{
+			if (sscanf(acLine, "HugePages_Free: %ld", &lNumFree) == 1)	{break;}
+		}
+		fclose(fp);
+	}
+
+	if (iMode == ETRI_HUGEPAGE_EXPLICIT && lNumFree == 0)
+	{
+		fprintf(stderr, "Huge Page : No huge page is reserved (vm.nr_hugepages). Picture buffers fall back to %s \n", 
+			bTransparent ? "transparent huge pages" : "4KB pages");
+	}
+	else if (iMode == ETRI_HUGEPAGE_TRANSPARENT && !bTransparent)
+	{
+		fprintf(stderr, "Huge Page : Transparent huge pages are disabled. Huge Page is Off \n");
+		return e_iHugePageMode;
+	}
+
+	e_iHugePageMode = iMode;
+#endif
+	return e_iHugePageMode;
+}
+
+int ETRI_GetHugePage()
+{
+	return e_iHugePageMode;
+}
+
+/**
+	@brief: Picture buffer of ullSize bytes, aligned to ETRI_HUGEPAGE_HEADER. With a huge page mode a buffer of one huge page or more 
+	is rounded up to 2MB pages, smaller buffers (chroma of small pictures, lowres planes) stay in 4KB pages as the rounding would 
+	waste more than it gains. Every page is touched here, so the encoding does not take the page faults.
+*/
+void* ETRI_AllocPictureMemory(unsigned long long ullSize)
+{
+	unsigned long long	ullMapSize = ullSize + ETRI_HUGEPAGE_HEADER;
+	unsigned char*		pucBase = NULL;
+	int					iKind = ETRI_HUGEPAGE_OFF;
+
+#if ETRI_HUGE_PAGE
+	static bool	bWarned = false;
+	bool		bHuge = (e_iHugePageMode != ETRI_HUGEPAGE_OFF && ullMapSize >= ETRI_HUGEPAGE_SIZE);
+
+	if (bHuge)
+	{
+		ullMapSize = (ullMapSize + ETRI_HUGEPAGE_SIZE - 1) & ~(unsigned long long)(ETRI_HUGEPAGE_SIZE - 1);
+	}
+	if (bHuge && e_iHugePageMode == ETRI_HUGEPAGE_EXPLICIT)
+	{
+		void* pvMap = mmap(NULL, ullMapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+		if (pvMap != MAP_FAILED)
+		{
+			pucBase = (unsigned char*)pvMap;
+			iKind   = ETRI_HUGEPAGE_EXPLICIT;
+		}
+		else if (!bWarned)
+		{
+			fprintf(stderr, "Huge Page : The reserved huge pages are exhausted (%s). Picture buffers fall back to transparent huge pages \n", strerror(errno));
+			bWarned = true;
+		}
+	}
+	if (bHuge && pucBase == NULL)
+	{
+		if (posix_memalign((void**)&pucBase, ETRI_HUGEPAGE_SIZE, ullMapSize) != 0)	{pucBase = NULL;}
+		else	{iKind = (ETRI_IsTransparentHugePageOn() && madvise(pucBase, ullMapSize, MADV_HUGEPAGE) == 0) ? ETRI_HUGEPAGE_TRANSPARENT : ETRI_HUGEPAGE_OFF;}
+	}
+	if (pucBase == NULL)
+	{
+		/// Whole 4KB pages, so the memory policy of ETRI_BindPictureMemory does not spill over the neighbouring heap blocks
+		const unsigned long long ullPage = (unsigned long long)sysconf(_SC_PAGESIZE);
+		ullMapSize = (ullMapSize + ullPage - 1) & ~(ullPage - 1);
+		if (posix_memalign((void**)&pucBase, ullPage, ullMapSize) != 0)	{pucBase = NULL;}
+	}
+#endif
+	if (pucBase == NULL && (pucBase = (unsigned char*)malloc(ullMapSize)) == NULL)
+	{
+		return NULL;
+	}
+
+	ETRI_BindPictureMemory(pucBase, ullMapSize);
+
+#if ETRI_HUGE_PAGE
+	if (e_iHugePageMode != ETRI_HUGEPAGE_OFF)
+	{
+		const unsigned long long ullPage = (unsigned long long)sysconf(_SC_PAGESIZE);
+		for (unsigned long long ullPos = 0; ullPos < ullMapSize; ullPos += ullPage)	{((volatile unsigned char*)pucBase)[ullPos] = 0;}
+	}
+#endif
+
+	ETRI_PictureMemoryHeader* psHeader = (ETRI_PictureMemoryHeader*)pucBase;
+	psHeader->pvBase     = pucBase;
+	psHeader->ullMapSize = ullMapSize;
+	psHeader->iKind      = iKind;
+
+	e_aiHugePageBuffers[iKind] += 1;
+	e_aullHugePageBytes[iKind] += ullMapSize;
+
+	return pucBase + ETRI_HUGEPAGE_HEADER;
+}
+
+void ETRI_FreePictureMemory(void* pvAddr)
+{
+	if (pvAddr == NULL)	{return;}
+
+	ETRI_PictureMemoryHeader* psHeader = (ETRI_PictureMemoryHeader*)((unsigned char*)pvAddr - ETRI_HUGEPAGE_HEADER);
+	void*				pvBase     = psHeader->pvBase;
+	unsigned long long	ullMapSize = psHeader->ullMapSize;
+	int					iKind      = psHeader->iKind;
+
+	e_aiHugePageBuffers[iKind] -= 1;
+	e_aullHugePageBytes[iKind] -= ullMapSize;
+
+#if ETRI_HUGE_PAGE
+	if (iKind == ETRI_HUGEPAGE_EXPLICIT)
+	{
+		munmap(pvBase, ullMapSize);
+		return;
+	}
+#endif
+	free(pvBase);
+}
+
+/**
+	@brief: Live picture buffers by the page kind. AnonHugePages of the process shows how much of the transparent huge pages 
+	the kernel actually gave.
+*/
+void ETRI_PrintHugePageStatus()
+{
+	const double		dMB = 1024.0 * 1024.0;
+	int					iTransparent = e_aiHugePageBuffers[ETRI_HUGEPAGE_TRANSPARENT];
+	int					iExplicit    = e_aiHugePageBuffers[ETRI_HUGEPAGE_EXPLICIT];
+	int					iSmall       = e_aiHugePageBuffers[ETRI_HUGEPAGE_OFF];
+	unsigned long long	ullHuge      = e_aullHugePageBytes[ETRI_HUGEPAGE_TRANSPARENT] + e_aullHugePageBytes[ETRI_HUGEPAGE_EXPLICIT];
+	unsigned long long	ullSmall     = e_aullHugePageBytes[ETRI_HUGEPAGE_OFF];
+
+	fprintf(stderr, "Huge Page : %s, %d buffers %.1f MB in 2MB pages (%d Transparent, %d Explicit), %d buffers %.1f MB in 4KB pages \n", 
+		ETRI_GetHugePageName(e_iHugePageMode), iTransparent + iExplicit, ullHuge / dMB, iTransparent, iExplicit, iSmall, ullSmall / dMB);
+
+#if ETRI_HUGE_PAGE
+	char	acLine[256];
+	long	lKB = -1;
+	FILE*	fp = fopen("/proc/self/smaps_rollup", "r");
+
+	if (e_iHugePageMode == ETRI_HUGEPAGE_OFF || fp == NULL)	{if (fp) {fclose(fp);} return;}
+	while (fgets(acLine, sizeof(acLine), fp) != NULL)
+	{
+		if (sscanf(acLine, "AnonHugePages: %ld kB", &lKB) == 1)	{break;}
+	}
+	fclose(fp);
+	if (lKB >= 0)	{fprintf(stderr, "Huge Page : AnonHugePages of the process %.1f MB \n", lKB / 1024.0);}
+#endif
+}
+
+/**
+	@brief: dTLB read misses of the encoder threads. ETRI_StartTLBCount starts the counter once the picture buffers are pre-faulted, 
+	and ETRI_PrintTLBCount reports it to stderr after the thread pool has exited. The count is scaled up when the PMU was shared.
+*/
+void ETRI_StartTLBCount()
+{
+#if ETRI_HUGE_PAGE
+	if (e_iTLBCounterFd < 0)	{return;}
+	ioctl(e_iTLBCounterFd, PERF_EVENT_IOC_RESET, 0);
+	ioctl(e_iTLBCounterFd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+}
+
+void ETRI_PrintTLBCount()
+{
+#if ETRI_HUGE_PAGE
+	unsigned long long	aullValue[3];		///< Count, time enabled, time running
+
+	if (e_iTLBCounterFd < 0)	{return;}
+	ioctl(e_iTLBCounterFd, PERF_EVENT_IOC_DISABLE, 0);
+	if (read(e_iTLBCounterFd, aullValue, sizeof(aullValue)) == (ssize_t)sizeof(aullValue) && aullValue[2] > 0)
+	{
+		double dCount = (double)aullValue[0] * ((double)aullValue[1] / (double)aullValue[2]);
+		fprintf(stderr, "Huge Page : %s, %.0f dTLB read misses of the encoder threads \n", ETRI_GetHugePageName(e_iHugePageMode), dCount);
+	}
+	close(e_iTLBCounterFd);
+	e_iTLBCounterFd = -1;
+#endif
+}
+
 /**
 	@brief: Main Service function. This function is called at Definition of TAppEncTop. i.e. foremost of main Encoder function 
 	@Author: JInwuk Seok                    
@@ -106,6 +738,12 @@ void ETRI_Service_Init(int iApplicationNameIdx)
 	//------------------------------------------------------------------------------------------------------------
 	//	Here, HW Check, High Precision Counter and others ....
 	//------------------------------------------------------------------------------------------------------------
+	unsigned int uiCpuFeatures = ETRI_GetCpuFeatures();
+	fprintf(stderr, "CPU SIMD : SSE4.1 %s SSE4.2 %s AVX2 %s AVX-512BW %s \n", ((uiCpuFeatures & ETRI_CPU_SSE41)? "On":"Off"), ((uiCpuFeatures & ETRI_CPU_SSE42)? "On":"Off"), ((uiCpuFeatures & ETRI_CPU_AVX2)? "On":"Off"), ((uiCpuFeatures & ETRI_CPU_AVX512BW)? "On":"Off"));
+	if (ETRI_GetCpuSimdLevel() < ETRI_SIMD_LEVEL_BASE)
+	{
+		fprintf(stderr, "[Warning] This CPU does not support %s, the base ISA of this build \n", ETRI_GetSimdLevelName(ETRI_SIMD_LEVEL_BASE));
+	}
 
 }
 
@@ -98,9 +98,35 @@ struct OutputNALUnit;
 /**
  * A single NALunit, with complete payload in EBSP format.
  */
+#if ETRI_STREAM_OUTPUT
+/**
+ * EBSP bytes of a NAL unit, written once into reserved storage by the NAL writer
+ * and read in place by the annex-B writer. str() keeps the size queries of the
+ * ostringstream interface without a copy of the payload.
+ */
+class ETRI_EBSPBuffer
+{
+public:
+  Void            reserve ( UInt uiSize )                   { m_cBytes.reserve( uiSize ); }
+  Void            push    ( uint8_t ucByte )                { m_cBytes.push_back( ucByte ); }
+  Void            write   ( const Char* pcData, UInt uiSize ) { m_cBytes.insert( m_cBytes.end(), (const uint8_t*)pcData, (const uint8_t*)pcData + uiSize ); }
+
+  const uint8_t*          data () const { return m_cBytes.empty() ? NULL : &m_cBytes[0]; }
+  size_t                  size () const { return m_cBytes.size(); }
+  const ETRI_EBSPBuffer&  str  () const { return *this; }
+
+private:
+  std::vector<uint8_t>  m_cBytes;
+};
+#endif
+
 struct NALUnitEBSP : public NALUnit
 {
+#if ETRI_STREAM_OUTPUT
+  ETRI_EBSPBuffer m_nalUnitData;
+#else
   std::ostringstream m_nalUnitData;
+#endif
 
   /**
    * convert the OutputNALUnit #nalu# into EBSP format by writing out
@@ -115,6 +115,9 @@ TComDataCU::TComDataCU()
   m_apiMVPNum[1]       = NULL;
 
   m_bDecSubCu          = false;
+#if ETRI_CU_ARENA
+  em_bArena            = false;
+#endif
   m_sliceStartCU        = 0;
   m_sliceSegmentStartCU = 0;
 
@@ -269,6 +272,128 @@ Void TComDataCU::create(UInt uiNumPartition, UInt uiWidth, UInt uiHeight, Bool b
 #endif 
 }
 
+#if ETRI_CU_ARENA
+/// Field of uiNum elements at ruiOffset of the arena, the offset moves to the next cache line
+template <typename T>
+static T* ETRI_xCarve( UChar* pucArena, UInt& ruiOffset, UInt uiNum )
+{
+  T* p = pucArena ? (T*)(pucArena + ruiOffset) : NULL;
+  ruiOffset += (sizeof(T) * uiNum + ETRI_CU_ARENA_ALIGN - 1) & ~(ETRI_CU_ARENA_ALIGN - 1);
+  return p;
+}
+
+/** Lay out the encoder-side fields of create() one after another in pucArena, the per-partition fields first
+ * \param pucArena  ETRI_CU_ARENA_ALIGN aligned block, or NULL to clear the fields
+ * \returns bytes of the layout
+ */
+UInt TComDataCU::ETRI_xLayoutArena( UInt uiNumPartition, UInt uiWidth, UInt uiHeight, UChar* pucArena )
+{
+  UInt uiOffset = 0;
+  UInt uiNumCoeff = uiWidth * uiHeight;
+
+  m_puhDepth           = ETRI_xCarve<UChar> (pucArena, uiOffset, uiNumPartition);
+  m_puhWidth           = ETRI_xCarve<UChar> (pucArena, uiOffset, uiNumPartition);
+  m_puhHeight          = ETRI_xCarve<UChar> (pucArena, uiOffset, uiNumPartition);
+  m_phQP               = ETRI_xCarve<Char>  (pucArena, uiOffset, uiNumPartition);
+  m_skipFlag           = ETRI_xCarve<Bool>  (pucArena, uiOffset, uiNumPartition);
+  m_pePartSize         = ETRI_xCarve<Char>  (pucArena, uiOffset, uiNumPartition);
+  m_pePredMode         = ETRI_xCarve<Char>  (pucArena, uiOffset, uiNumPartition);
+#if !ETRI_MEMSET_FURTHER_OPTIMIZATION
+  m_CUTransquantBypass = ETRI_xCarve<Bool>  (pucArena, uiOffset, uiNumPartition);
+#endif 
+  m_pbMergeFlag        = ETRI_xCarve<Bool>  (pucArena, uiOffset, uiNumPartition);
+  m_puhMergeIndex      = ETRI_xCarve<UChar> (pucArena, uiOffset, uiNumPartition);
+  m_puhLumaIntraDir    = ETRI_xCarve<UChar> (pucArena, uiOffset, uiNumPartition);
+  m_puhChromaIntraDir  = ETRI_xCarve<UChar> (pucArena, uiOffset, uiNumPartition);
+  m_puhInterDir        = ETRI_xCarve<UChar> (pucArena, uiOffset, uiNumPartition);
+  m_puhTrIdx           = ETRI_xCarve<UChar> (pucArena, uiOffset, uiNumPartition);
+#if !ETRI_MEMSET_FURTHER_OPTIMIZATION
+  m_puhTransformSkip[0] = ETRI_xCarve<UChar>(pucArena, uiOffset, uiNumPartition);
+  m_puhTransformSkip[1] = ETRI_xCarve<UChar>(pucArena, uiOffset, uiNumPartition);
+  m_puhTransformSkip[2] = ETRI_xCarve<UChar>(pucArena, uiOffset, uiNumPartition);
+#endif 
+  m_puhCbf[0]          = ETRI_xCarve<UChar> (pucArena, uiOffset, uiNumPartition);
+  m_puhCbf[1]          = ETRI_xCarve<UChar> (pucArena, uiOffset, uiNumPartition);
+  m_puhCbf[2]          = ETRI_xCarve<UChar> (pucArena, uiOffset, uiNumPartition);
+  m_apiMVPIdx[0]       = ETRI_xCarve<Char>  (pucArena, uiOffset, uiNumPartition);
+  m_apiMVPIdx[1]       = ETRI_xCarve<Char>  (pucArena, uiOffset, uiNumPartition);
+  m_apiMVPNum[0]       = ETRI_xCarve<Char>  (pucArena, uiOffset, uiNumPartition);
+  m_apiMVPNum[1]       = ETRI_xCarve<Char>  (pucArena, uiOffset, uiNumPartition);
+  m_pbIPCMFlag         = ETRI_xCarve<Bool>  (pucArena, uiOffset, uiNumPartition);
+
+  for (Int i = 0; i < 2; i++)
+  {
+    TComMv* pcMv       = ETRI_xCarve<TComMv>(pucArena, uiOffset, uiNumPartition);
+    TComMv* pcMvd      = ETRI_xCarve<TComMv>(pucArena, uiOffset, uiNumPartition);
+    Char*   piRefIdx   = ETRI_xCarve<Char>  (pucArena, uiOffset, uiNumPartition);
+    if (pucArena) { m_acCUMvField[i].ETRI_create(uiNumPartition, pcMv, pcMvd, piRefIdx); }
+    else          { m_acCUMvField[i].ETRI_release(); }
+  }
+
+#if !ETRI_SLICE_SEGMENT_OPTIMIZATION
+  m_sliceStartCU        = ETRI_xCarve<UInt> (pucArena, uiOffset, uiNumPartition);
+  m_sliceSegmentStartCU = ETRI_xCarve<UInt> (pucArena, uiOffset, uiNumPartition);
+#endif
+
+  m_pcTrCoeffY         = ETRI_xCarve<TCoeff>(pucArena, uiOffset, uiNumCoeff);
+  m_pcTrCoeffCb        = ETRI_xCarve<TCoeff>(pucArena, uiOffset, uiNumCoeff/4);
+  m_pcTrCoeffCr        = ETRI_xCarve<TCoeff>(pucArena, uiOffset, uiNumCoeff/4);
+#if ADAPTIVE_QP_SELECTION
+  m_pcArlCoeffY        = ETRI_xCarve<Int>   (pucArena, uiOffset, uiNumCoeff);
+  m_pcArlCoeffCb       = ETRI_xCarve<Int>   (pucArena, uiOffset, uiNumCoeff/4);
+  m_pcArlCoeffCr       = ETRI_xCarve<Int>   (pucArena, uiOffset, uiNumCoeff/4);
+  m_ArlCoeffIsAliasedAllocation = false;
+#endif
+#if !ETRI_MEMSET_FURTHER_OPTIMIZATION
+  m_pcIPCMSampleY      = ETRI_xCarve<Pel>   (pucArena, uiOffset, uiNumCoeff);
+  m_pcIPCMSampleCb     = ETRI_xCarve<Pel>   (pucArena, uiOffset, uiNumCoeff/4);
+  m_pcIPCMSampleCr     = ETRI_xCarve<Pel>   (pucArena, uiOffset, uiNumCoeff/4);
+#endif 
+
+  return uiOffset;
+}
+
+/** Bytes of the arena taken by ETRI_createInArena for a CU of the given size
+ */
+UInt TComDataCU::ETRI_getArenaSize( UInt uiNumPartition, UInt uiWidth, UInt uiHeight )
+{
+  TComDataCU cCU;
+  return cCU.ETRI_xLayoutArena(uiNumPartition, uiWidth, uiHeight, NULL);
+}
+
+/** Encoder-side create() without any allocation of the fields : they are carved from rpucArena, which moves past them
+ * \param rpucArena  zero-filled, ETRI_CU_ARENA_ALIGN aligned block of the owner with ETRI_getArenaSize bytes left at least
+ */
+Void TComDataCU::ETRI_createInArena( UInt uiNumPartition, UInt uiWidth, UInt uiHeight, Int unitSize, UChar*& rpucArena )
+{
+  m_bDecSubCu = false;
+  em_bArena   = true;
+
+  m_pcPic              = NULL;
+  m_pcSlice            = NULL;
+  m_uiNumPartition     = uiNumPartition;
+  m_unitSize = unitSize;
+
+  rpucArena += ETRI_xLayoutArena(uiNumPartition, uiWidth, uiHeight, rpucArena);
+
+  memset( m_pePartSize, SIZE_NONE,uiNumPartition * sizeof( *m_pePartSize ) );
+#if !ETRI_MEMSET_OPTIMIZATION
+  memset(m_apiMVPIdx[0], -1, uiNumPartition * sizeof(Char));
+  memset(m_apiMVPIdx[1], -1, uiNumPartition * sizeof(Char));
+#endif
+
+  m_pcPattern            = (TComPattern*)xMalloc(TComPattern, 1);
+
+  m_pcCUAboveLeft      = NULL;
+  m_pcCUAboveRight     = NULL;
+  m_pcCUAbove          = NULL;
+  m_pcCULeft           = NULL;
+
+  m_apcCUColocated[0]  = NULL;
+  m_apcCUColocated[1]  = NULL;
+}
+#endif
+
 Void TComDataCU::destroy()
 {
   m_pcPic              = NULL;
@@ -280,6 +405,21 @@ Void TComDataCU::destroy()
     m_pcPattern = NULL;
   }
   
+#if ETRI_CU_ARENA
+  if ( em_bArena )
+  {
+    ETRI_xLayoutArena(0, 0, 0, NULL);
+    em_bArena = false;
+    m_pcCUAboveLeft       = NULL;
+    m_pcCUAboveRight      = NULL;
+    m_pcCUAbove           = NULL;
+    m_pcCULeft            = NULL;
+    m_apcCUColocated[0]   = NULL;
+    m_apcCUColocated[1]   = NULL;
+    return;
+  }
+#endif
+
   // encoder-side buffer free
   if ( !m_bDecSubCu )
   {
@@ -150,6 +150,9 @@ private:
   // -------------------------------------------------------------------------------------------------------------------
   
   Bool          m_bDecSubCu;          ///< indicates decoder-mode
+#if ETRI_CU_ARENA
+  Bool          em_bArena;            ///< fields carved from the arena of the owner, which frees it
+#endif
   Double        m_dTotalCost;         ///< sum of partition RD costs
   UInt          m_uiTotalDistortion;  ///< sum of partition distortion
   UInt          m_uiTotalBits;        ///< sum of partition bits
@@ -192,6 +195,10 @@ protected:
   
   Void xDeriveCenterIdx( UInt uiPartIdx, UInt& ruiPartIdxCenter );
 
+#if ETRI_CU_ARENA
+  UInt          ETRI_xLayoutArena     ( UInt uiNumPartition, UInt uiWidth, UInt uiHeight, UChar* pucArena );
+#endif
+
 public:
   TComDataCU();
   virtual ~TComDataCU();
@@ -206,6 +213,10 @@ public:
 #endif  
     );
   Void          destroy               ();
+#if ETRI_CU_ARENA
+  static UInt   ETRI_getArenaSize     ( UInt uiNumPartition, UInt uiWidth, UInt uiHeight );
+  Void          ETRI_createInArena    ( UInt uiNumPartition, UInt uiWidth, UInt uiHeight, Int unitSize, UChar*& rpucArena );
+#endif
   
   Void          initCU                ( TComPic* pcPic, UInt uiCUAddr );
   Void          initEstData           ( UInt uiDepth, Int qp, Bool bTransquantBypass );
@@ -149,7 +149,14 @@ Void TComInterpolationFilter::init()
 	em_pfFilterFunc[22] = (FilterFunc)&TComInterpolationFilter::ETRI_FilterH_8T2W;
 	em_pfFilterFunc[23] = (FilterFunc)&TComInterpolationFilter::ETRI_FilterH_8T2WLast;
 
+#if ETRI_SIMD_AVX2
+	em_bUseAVX2 = (ETRI_GetSimdLevel() >= ETRI_SIMD_LEVEL_AVX2);
+#endif
 }
+
+#if ETRI_SIMD_AVX2
+Bool TComInterpolationFilter::em_bUseAVX2 = false;
+#endif
 #else
 #define  ETRI_SIMD_FILTERCOPY  0
 #endif
@@ -1234,8 +1241,156 @@ Void TComInterpolationFilter::ETRI_pFFilterCopy_02(Int bitDepth, const Pel *src,
   xmm[2] = _mm_add_epi32(xmm[2], cmm[1]); \
   xmm[0] = _mm_srai_epi32(xmm[0], shift); \
   xmm[2] = _mm_srai_epi32(xmm[2], shift); \
-  xmm[0] = _mm_packs_epi32(xmm[0], xmm[2]); 
+  xmm[0] = _mm_packs_epi32(xmm[0], xmm[2]);
+
+
+#if ETRI_SIMD_AVX2
+// ====================================================================================================================
+// AVX2 Filter Functions : 16 columns per iteration. The results are identical to the SSE4.2 kernels.
+// ====================================================================================================================
+/// ymm[0..N-1] : tap-shifted source vectors, cmm[0..N/2-1] : coefficient pairs, output in ymm_out
+#define ETRI_AVX2_FILTER_NT(N, ymm, cmm, ymm_out) \
+	{ \
+		__m256i ymm_lo = _mm256_setzero_si256(); \
+		__m256i ymm_hi = _mm256_setzero_si256(); \
+		for (Int k = 0; k < (N); k += 2) \
+		{ \
+			ymm_lo = _mm256_add_epi32(ymm_lo, _mm256_madd_epi16(_mm256_unpacklo_epi16(ymm[k], ymm[k + 1]), cmm[k >> 1])); \
+			ymm_hi = _mm256_add_epi32(ymm_hi, _mm256_madd_epi16(_mm256_unpackhi_epi16(ymm[k], ymm[k + 1]), cmm[k >> 1])); \
+		} \
+		ymm_lo = _mm256_srai_epi32(_mm256_add_epi32(ymm_lo, ymm_offset), shift); \
+		ymm_hi = _mm256_srai_epi32(_mm256_add_epi32(ymm_hi, ymm_offset), shift); \
+		ymm_out = _mm256_packs_epi32(ymm_lo, ymm_hi); \
+		if (isLast) \
+		{ \
+			ymm_out = _mm256_min_epi16(ymm_out, ymm_max); \
+			ymm_out = _mm256_max_epi16(ymm_out, _mm256_setzero_si256()); \
+		} \
+	}
+
+#define ETRI_AVX2_FILTER_COEFF(N, c, cmm) \
+	for (Int k = 0; k < (N); k += 2) \
+	{ \
+		cmm[k >> 1] = _mm256_set1_epi32((Int)(UShort)c[k] | ((Int)c[k + 1] << 16)); \
+	}
+
+template<Bool isLast>
+ETRI_TARGET_AVX2 Void TComInterpolationFilter::ETRI_FilterH_8T16W_AVX2(Int bitDepth, Short const *src, Int srcStride, Short *dst, Int dstStride, Int width, Int height, Int offset, Int shift, Short const *c)
+{
+	__m256i ymm[8], cmm[4], ymm_res;
+	__m256i ymm_offset = _mm256_set1_epi32(offset);
+	__m256i ymm_max = _mm256_set1_epi16((Short)((1 << bitDepth) - 1));
+
+	ETRI_AVX2_FILTER_COEFF(8, c, cmm);
+
+	for (Int row = 0; row < height; row++)
+	{
+		for (Int col = 0; col < width; col += 16)
+		{
+			for (Int k = 0; k < 8; k++)
+			{
+				ymm[k] = _mm256_loadu_si256((__m256i const *)(src + col + k));
+			}
+			ETRI_AVX2_FILTER_NT(8, ymm, cmm, ymm_res);
+			_mm256_storeu_si256((__m256i *)(dst + col), ymm_res);
+		}
+		src += srcStride;
+		dst += dstStride;
+	}
+}
+
+template<Bool isLast>
+ETRI_TARGET_AVX2 Void TComInterpolationFilter::ETRI_FilterH_4T16W_AVX2(Int bitDepth, Short const *src, Int srcStride, Short *dst, Int dstStride, Int width, Int height, Int offset, Int shift, Short const *c)
+{
+	__m256i ymm[4], cmm[2], ymm_res;
+	__m256i ymm_offset = _mm256_set1_epi32(offset);
+	__m256i ymm_max = _mm256_set1_epi16((Short)((1 << bitDepth) - 1));
+
+	ETRI_AVX2_FILTER_COEFF(4, c, cmm);
+
+	for (Int row = 0; row < height; row++)
+	{
+		for (Int col = 0; col < width; col += 16)
+		{
+			for (Int k = 0; k < 4; k++)
+			{
+				ymm[k] = _mm256_loadu_si256((__m256i const *)(src + col + k));
+			}
+			ETRI_AVX2_FILTER_NT(4, ymm, cmm, ymm_res);
+			_mm256_storeu_si256((__m256i *)(dst + col), ymm_res);
+		}
+		src += srcStride;
+		dst += dstStride;
+	}
+}
+
+/// Vertical kernels keep the N source rows in registers, so each output row costs one new load
+template<Bool isLast>
+ETRI_TARGET_AVX2 Void TComInterpolationFilter::ETRI_FilterV_8T16W_AVX2(Int bitDepth, Short const *src, Int srcStride, Short *dst, Int dstStride, Int width, Int height, Int offset, Int shift, Short const *c)
+{
+	__m256i ymm[8], cmm[4], ymm_res;
+	__m256i ymm_offset = _mm256_set1_epi32(offset);
+	__m256i ymm_max = _mm256_set1_epi16((Short)((1 << bitDepth) - 1));
 
+	ETRI_AVX2_FILTER_COEFF(8, c, cmm);
+
+	for (Int col = 0; col < width; col += 16)
+	{
+		Short const *pSrc = src + col;
+		Short       *pDst = dst + col;
+
+		for (Int k = 0; k < 7; k++)
+		{
+			ymm[k] = _mm256_loadu_si256((__m256i const *)(pSrc + k * srcStride));
+		}
+		pSrc += 7 * srcStride;
+
+		for (Int row = 0; row < height; row++)
+		{
+			ymm[7] = _mm256_loadu_si256((__m256i const *)pSrc);
+			ETRI_AVX2_FILTER_NT(8, ymm, cmm, ymm_res);
+			_mm256_storeu_si256((__m256i *)pDst, ymm_res);
+
+			for (Int k = 0; k < 7; k++)	{ymm[k] = ymm[k + 1];}
+			pSrc += srcStride;
+			pDst += dstStride;
+		}
+	}
+}
+
+template<Bool isLast>
+ETRI_TARGET_AVX2 Void TComInterpolationFilter::ETRI_FilterV_4T16W_AVX2(Int bitDepth, Short const *src, Int srcStride, Short *dst, Int dstStride, Int width, Int height, Int offset, Int shift, Short const *c)
+{
+	__m256i ymm[4], cmm[2], ymm_res;
+	__m256i ymm_offset = _mm256_set1_epi32(offset);
+	__m256i ymm_max = _mm256_set1_epi16((Short)((1 << bitDepth) - 1));
+
+	ETRI_AVX2_FILTER_COEFF(4, c, cmm);
+
+	for (Int col = 0; col < width; col += 16)
+	{
+		Short const *pSrc = src + col;
+		Short       *pDst = dst + col;
+
+		for (Int k = 0; k < 3; k++)
+		{
+			ymm[k] = _mm256_loadu_si256((__m256i const *)(pSrc + k * srcStride));
+		}
+		pSrc += 3 * srcStride;
+
+		for (Int row = 0; row < height; row++)
+		{
+			ymm[3] = _mm256_loadu_si256((__m256i const *)pSrc);
+			ETRI_AVX2_FILTER_NT(4, ymm, cmm, ymm_res);
+			_mm256_storeu_si256((__m256i *)pDst, ymm_res);
+
+			for (Int k = 0; k < 3; k++)	{ymm[k] = ymm[k + 1];}
+			pSrc += srcStride;
+			pDst += dstStride;
+		}
+	}
+}
+#endif	// ETRI_SIMD_AVX2
 
 /**
 ====================================================================================================================
@@ -1267,6 +1422,30 @@ Void TComInterpolationFilter::ETRI_filter(Int bitDepth, Short const *src, Int sr
 		offset = (isFirst) ? -IF_INTERNAL_OFFS << shift : 0;
 	}
 
+#if ETRI_SIMD_AVX2
+	/// 16-column blocks by AVX2, the remaining columns (e.g. AMP width 24, 48) by the SSE4.2 kernels below
+	if (em_bUseAVX2 && (width >= 16))
+	{
+		Int iWidthAVX2 = width & ~0x0F;
+
+		if (isVertical)
+		{
+			if (N == 4)	ETRI_FilterV_4T16W_AVX2<isLast>(bitDepth, src - srcStride, srcStride, dst, dstStride, iWidthAVX2, height, offset, shift, coeff);
+			else		ETRI_FilterV_8T16W_AVX2<isLast>(bitDepth, src - 3 * srcStride, srcStride, dst, dstStride, iWidthAVX2, height, offset, shift, coeff);
+		}
+		else
+		{
+			if (N == 4)	ETRI_FilterH_4T16W_AVX2<isLast>(bitDepth, src - 1, srcStride, dst, dstStride, iWidthAVX2, height, offset, shift, coeff);
+			else		ETRI_FilterH_8T16W_AVX2<isLast>(bitDepth, src - 3, srcStride, dst, dstStride, iWidthAVX2, height, offset, shift, coeff);
+		}
+
+		if (width == iWidthAVX2)	{return;}
+		src   += iWidthAVX2;
+		dst   += iWidthAVX2;
+		width -= iWidthAVX2;
+	}
+#endif
+
 	if (isVertical)
 	{
 		if (N == 4)
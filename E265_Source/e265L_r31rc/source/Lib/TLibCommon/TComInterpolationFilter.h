@@ -115,6 +115,18 @@ class TComInterpolationFilter
 	static Void ETRI_FilterH_8T2W  		(Int bitDepth, Short const *src, Int srcStride, Short *dst, Int dstStride, Int width, Int height, Int offset, Int shift, Short *c);
 	static Void ETRI_FilterH_8T2WLast 	(Int bitDepth, Short const *src, Int srcStride, Short *dst, Int dstStride, Int width, Int height, Int offset, Int shift, Short *c);
 
+#if ETRI_SIMD_AVX2
+	static Bool em_bUseAVX2;	///< 16-column blocks are filtered by AVX2 kernels (set in init() from ETRI_GetSimdLevel)
+	template<Bool isLast>
+	static Void ETRI_FilterV_4T16W_AVX2	(Int bitDepth, Short const *src, Int srcStride, Short *dst, Int dstStride, Int width, Int height, Int offset, Int shift, Short const *c);
+	template<Bool isLast>
+	static Void ETRI_FilterV_8T16W_AVX2	(Int bitDepth, Short const *src, Int srcStride, Short *dst, Int dstStride, Int width, Int height, Int offset, Int shift, Short const *c);
+	template<Bool isLast>
+	static Void ETRI_FilterH_4T16W_AVX2	(Int bitDepth, Short const *src, Int srcStride, Short *dst, Int dstStride, Int width, Int height, Int offset, Int shift, Short const *c);
+	template<Bool isLast>
+	static Void ETRI_FilterH_8T16W_AVX2	(Int bitDepth, Short const *src, Int srcStride, Short *dst, Int dstStride, Int width, Int height, Int offset, Int shift, Short const *c);
+#endif
+
 #endif  //#if ETRI_SIMD_INTERPOLATION  //2012 10 by seok
 
 	public:
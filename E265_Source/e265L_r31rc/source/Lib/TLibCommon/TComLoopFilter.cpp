@@ -66,6 +66,259 @@ const UChar TComLoopFilter::sm_betaTable[52] =
   0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,6,7,8,9,10,11,12,13,14,15,16,17,18,20,22,24,26,28,30,32,34,36,38,40,42,44,46,48,50,52,54,56,58,60,62,64
 };
 
+#if ETRI_SIMD_DEBLOCKING
+// ====================================================================================================================
+// SIMD Deblocking (by ETRI)
+//	One 4-line edge segment is loaded as the eight sample vectors m0..m7 (p3..q3) with one 32-bit lane per line,
+//	so that the decision and the strong/weak filters of xPelFilterLuma are evaluated for all four lines at once.
+//	Vertical edges are transposed on load and store. The arithmetic is identical to the scalar functions.
+// ====================================================================================================================
+#define ETRI_CLIP3_EPI32(lo, hi, x)		_mm_min_epi32(_mm_max_epi32(x, lo), hi)
+
+/** Decision and filtering of a 4-line luma edge segment
+ * \param piSrc          pointer to the first line of the segment (sample q0)
+ * \param iOffset        offset across the edge (1 : vertical edge, stride : horizontal edge)
+ * \param iStride        picture stride
+ * \param iMaxVal        maximum sample value ((1 << g_bitDepthY) - 1)
+ */
+static Void ETRI_EdgeFilterLumaSeg_SSE(Pel* piSrc, Int iOffset, Int iStride, Int iTc, Int iBeta, Bool bPartPNoFilter, Bool bPartQNoFilter, Int iMaxVal)
+{
+	const Bool bVerEdge = (iOffset == 1);
+	__m128i m[8];
+
+	if (bVerEdge)
+	{
+		__m128i r0 = _mm_loadu_si128((__m128i*)(piSrc - 4));
+		__m128i r1 = _mm_loadu_si128((__m128i*)(piSrc - 4 + iStride));
+		__m128i r2 = _mm_loadu_si128((__m128i*)(piSrc - 4 + iStride * 2));
+		__m128i r3 = _mm_loadu_si128((__m128i*)(piSrc - 4 + iStride * 3));
+		__m128i t0 = _mm_unpacklo_epi16(r0, r1);
+		__m128i t1 = _mm_unpackhi_epi16(r0, r1);
+		__m128i t2 = _mm_unpacklo_epi16(r2, r3);
+		__m128i t3 = _mm_unpackhi_epi16(r2, r3);
+		__m128i u0 = _mm_unpacklo_epi32(t0, t2);
+		__m128i u1 = _mm_unpackhi_epi32(t0, t2);
+		__m128i u2 = _mm_unpacklo_epi32(t1, t3);
+		__m128i u3 = _mm_unpackhi_epi32(t1, t3);
+		m[0] = _mm_cvtepi16_epi32(u0);	m[1] = _mm_cvtepi16_epi32(_mm_srli_si128(u0, 8));
+		m[2] = _mm_cvtepi16_epi32(u1);	m[3] = _mm_cvtepi16_epi32(_mm_srli_si128(u1, 8));
+		m[4] = _mm_cvtepi16_epi32(u2);	m[5] = _mm_cvtepi16_epi32(_mm_srli_si128(u2, 8));
+		m[6] = _mm_cvtepi16_epi32(u3);	m[7] = _mm_cvtepi16_epi32(_mm_srli_si128(u3, 8));
+	}
+	else
+	{
+		for (Int k = 0; k < 8; k++)
+		{
+			m[k] = _mm_cvtepi16_epi32(_mm_loadl_epi64((__m128i*)(piSrc + (k - 4) * iOffset)));
+		}
+	}
+
+	//===== Decision (lines 0 and 3) =====
+	__m128i dp = _mm_abs_epi32(_mm_sub_epi32(_mm_add_epi32(m[1], m[3]), _mm_slli_epi32(m[2], 1)));
+	__m128i dq = _mm_abs_epi32(_mm_sub_epi32(_mm_add_epi32(m[4], m[6]), _mm_slli_epi32(m[5], 1)));
+	Int dp0 = _mm_cvtsi128_si32(dp), dp3 = _mm_extract_epi32(dp, 3);
+	Int dq0 = _mm_cvtsi128_si32(dq), dq3 = _mm_extract_epi32(dq, 3);
+	Int d0 = dp0 + dq0;
+	Int d3 = dp3 + dq3;
+	if (d0 + d3 >= iBeta)
+	{
+		return;
+	}
+
+	Int iSideThreshold = (iBeta + (iBeta >> 1)) >> 3;
+	Bool bFilterP = (dp0 + dp3 < iSideThreshold);
+	Bool bFilterQ = (dq0 + dq3 < iSideThreshold);
+
+	__m128i dStrong = _mm_add_epi32(_mm_abs_epi32(_mm_sub_epi32(m[0], m[3])), _mm_abs_epi32(_mm_sub_epi32(m[7], m[4])));
+	__m128i dEdge   = _mm_abs_epi32(_mm_sub_epi32(m[3], m[4]));
+	Int iTcStrong   = (iTc * 5 + 1) >> 1;
+	Bool sw = (_mm_cvtsi128_si32(dStrong) < (iBeta >> 3)) && (2 * d0 < (iBeta >> 2)) && (_mm_cvtsi128_si32(dEdge) < iTcStrong)
+		&& (_mm_extract_epi32(dStrong, 3) < (iBeta >> 3)) && (2 * d3 < (iBeta >> 2)) && (_mm_extract_epi32(dEdge, 3) < iTcStrong);
+
+	__m128i n[8];
+	for (Int k = 0; k < 8; k++)
+	{
+		n[k] = m[k];
+	}
+
+	if (sw)
+	{
+		const __m128i c2 = _mm_set1_epi32(2);
+		const __m128i c4 = _mm_set1_epi32(4);
+		const __m128i tc2 = _mm_set1_epi32(2 * iTc);
+		__m128i s34 = _mm_add_epi32(m[3], m[4]);
+
+		// (m1 + 2*m2 + 2*m3 + 2*m4 + m5 + 4) >> 3
+		__m128i x = _mm_add_epi32(_mm_add_epi32(m[1], m[5]), _mm_slli_epi32(_mm_add_epi32(m[2], s34), 1));
+		n[3] = ETRI_CLIP3_EPI32(_mm_sub_epi32(m[3], tc2), _mm_add_epi32(m[3], tc2), _mm_srai_epi32(_mm_add_epi32(x, c4), 3));
+		// (m2 + 2*m3 + 2*m4 + 2*m5 + m6 + 4) >> 3
+		x = _mm_add_epi32(_mm_add_epi32(m[2], m[6]), _mm_slli_epi32(_mm_add_epi32(m[5], s34), 1));
+		n[4] = ETRI_CLIP3_EPI32(_mm_sub_epi32(m[4], tc2), _mm_add_epi32(m[4], tc2), _mm_srai_epi32(_mm_add_epi32(x, c4), 3));
+		// (m1 + m2 + m3 + m4 + 2) >> 2
+		x = _mm_add_epi32(_mm_add_epi32(m[1], m[2]), s34);
+		n[2] = ETRI_CLIP3_EPI32(_mm_sub_epi32(m[2], tc2), _mm_add_epi32(m[2], tc2), _mm_srai_epi32(_mm_add_epi32(x, c2), 2));
+		// (m3 + m4 + m5 + m6 + 2) >> 2
+		x = _mm_add_epi32(_mm_add_epi32(m[5], m[6]), s34);
+		n[5] = ETRI_CLIP3_EPI32(_mm_sub_epi32(m[5], tc2), _mm_add_epi32(m[5], tc2), _mm_srai_epi32(_mm_add_epi32(x, c2), 2));
+		// (2*m0 + 3*m1 + m2 + m3 + m4 + 4) >> 3
+		x = _mm_add_epi32(_mm_add_epi32(_mm_slli_epi32(_mm_add_epi32(m[0], m[1]), 1), m[1]), _mm_add_epi32(m[2], s34));
+		n[1] = ETRI_CLIP3_EPI32(_mm_sub_epi32(m[1], tc2), _mm_add_epi32(m[1], tc2), _mm_srai_epi32(_mm_add_epi32(x, c4), 3));
+		// (m3 + m4 + m5 + 3*m6 + 2*m7 + 4) >> 3
+		x = _mm_add_epi32(_mm_add_epi32(_mm_slli_epi32(_mm_add_epi32(m[7], m[6]), 1), m[6]), _mm_add_epi32(m[5], s34));
+		n[6] = ETRI_CLIP3_EPI32(_mm_sub_epi32(m[6], tc2), _mm_add_epi32(m[6], tc2), _mm_srai_epi32(_mm_add_epi32(x, c4), 3));
+	}
+	else
+	{
+		/* Weak filter */
+		const __m128i zero   = _mm_setzero_si128();
+		const __m128i maxval = _mm_set1_epi32(iMaxVal);
+		const __m128i tc     = _mm_set1_epi32(iTc);
+		const __m128i ntc    = _mm_set1_epi32(-iTc);
+		const __m128i one    = _mm_set1_epi32(1);
+
+		// delta = (9*(m4-m3) - 3*(m5-m2) + 8) >> 4
+		__m128i a = _mm_sub_epi32(m[4], m[3]);
+		__m128i b = _mm_sub_epi32(m[5], m[2]);
+		__m128i delta = _mm_srai_epi32(_mm_add_epi32(_mm_sub_epi32(_mm_add_epi32(_mm_slli_epi32(a, 3), a), _mm_add_epi32(_mm_slli_epi32(b, 1), b)), _mm_set1_epi32(8)), 4);
+		__m128i mask  = _mm_cmplt_epi32(_mm_abs_epi32(delta), _mm_set1_epi32(iTc * 10));
+		if (_mm_testz_si128(mask, mask))
+		{
+			return;
+		}
+
+		delta = ETRI_CLIP3_EPI32(ntc, tc, delta);
+		n[3] = _mm_blendv_epi8(m[3], ETRI_CLIP3_EPI32(zero, maxval, _mm_add_epi32(m[3], delta)), mask);
+		n[4] = _mm_blendv_epi8(m[4], ETRI_CLIP3_EPI32(zero, maxval, _mm_sub_epi32(m[4], delta)), mask);
+
+		const __m128i tc2  = _mm_set1_epi32(iTc >> 1);
+		const __m128i ntc2 = _mm_set1_epi32(-(iTc >> 1));
+		if (bFilterP)
+		{
+			__m128i delta1 = _mm_srai_epi32(_mm_add_epi32(_mm_sub_epi32(_mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(m[1], m[3]), one), 1), m[2]), delta), 1);
+			delta1 = ETRI_CLIP3_EPI32(ntc2, tc2, delta1);
+			n[2] = _mm_blendv_epi8(m[2], ETRI_CLIP3_EPI32(zero, maxval, _mm_add_epi32(m[2], delta1)), mask);
+		}
+		if (bFilterQ)
+		{
+			__m128i delta2 = _mm_srai_epi32(_mm_sub_epi32(_mm_sub_epi32(_mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(m[6], m[4]), one), 1), m[5]), delta), 1);
+			delta2 = ETRI_CLIP3_EPI32(ntc2, tc2, delta2);
+			n[5] = _mm_blendv_epi8(m[5], ETRI_CLIP3_EPI32(zero, maxval, _mm_add_epi32(m[5], delta2)), mask);
+		}
+	}
+
+	if (bPartPNoFilter)
+	{
+		n[1] = m[1];	n[2] = m[2];	n[3] = m[3];
+	}
+	if (bPartQNoFilter)
+	{
+		n[4] = m[4];	n[5] = m[5];	n[6] = m[6];
+	}
+
+	if (bVerEdge)
+	{
+		__m128i v0 = _mm_packs_epi32(n[0], n[1]);
+		__m128i v1 = _mm_packs_epi32(n[2], n[3]);
+		__m128i v2 = _mm_packs_epi32(n[4], n[5]);
+		__m128i v3 = _mm_packs_epi32(n[6], n[7]);
+		__m128i a0 = _mm_unpacklo_epi16(v0, v1);
+		__m128i a1 = _mm_unpackhi_epi16(v0, v1);
+		__m128i a2 = _mm_unpacklo_epi16(v2, v3);
+		__m128i a3 = _mm_unpackhi_epi16(v2, v3);
+		__m128i b0 = _mm_unpacklo_epi16(a0, a1);
+		__m128i b1 = _mm_unpackhi_epi16(a0, a1);
+		__m128i b2 = _mm_unpacklo_epi16(a2, a3);
+		__m128i b3 = _mm_unpackhi_epi16(a2, a3);
+		_mm_storeu_si128((__m128i*)(piSrc - 4),               _mm_unpacklo_epi64(b0, b2));
+		_mm_storeu_si128((__m128i*)(piSrc - 4 + iStride),     _mm_unpackhi_epi64(b0, b2));
+		_mm_storeu_si128((__m128i*)(piSrc - 4 + iStride * 2), _mm_unpacklo_epi64(b1, b3));
+		_mm_storeu_si128((__m128i*)(piSrc - 4 + iStride * 3), _mm_unpackhi_epi64(b1, b3));
+	}
+	else
+	{
+		for (Int k = 1; k < 7; k++)
+		{
+			_mm_storel_epi64((__m128i*)(piSrc + (k - 4) * iOffset), _mm_packs_epi32(n[k], n[k]));
+		}
+	}
+}
+
+/** Filtering of iNumLines (<= 4) chroma lines of one edge partition
+ * \param piSrc          pointer to the first line (sample q0)
+ * \param iOffset        offset across the edge (1 : vertical edge, stride : horizontal edge)
+ * \param iStride        picture stride
+ * \param iMaxVal        maximum sample value ((1 << g_bitDepthC) - 1)
+ */
+static Void ETRI_EdgeFilterChromaSeg_SSE(Pel* piSrc, Int iOffset, Int iStride, Int iNumLines, Int iTc, Bool bPartPNoFilter, Bool bPartQNoFilter, Int iMaxVal)
+{
+	const Bool bVerEdge = (iOffset == 1);
+	__m128i m2, m3, m4, m5;
+
+	if (bVerEdge)
+	{
+		__m128i r[4];
+		for (Int i = 0; i < 4; i++)
+		{
+			r[i] = (i < iNumLines) ? _mm_loadl_epi64((__m128i*)(piSrc - 2 + i * iStride)) : _mm_setzero_si128();
+		}
+		__m128i t0 = _mm_unpacklo_epi16(r[0], r[1]);
+		__m128i t1 = _mm_unpacklo_epi16(r[2], r[3]);
+		__m128i u0 = _mm_unpacklo_epi32(t0, t1);
+		__m128i u1 = _mm_unpackhi_epi32(t0, t1);
+		m2 = _mm_cvtepi16_epi32(u0);	m3 = _mm_cvtepi16_epi32(_mm_srli_si128(u0, 8));
+		m4 = _mm_cvtepi16_epi32(u1);	m5 = _mm_cvtepi16_epi32(_mm_srli_si128(u1, 8));
+	}
+	else
+	{
+		m2 = _mm_cvtepi16_epi32(_mm_loadl_epi64((__m128i*)(piSrc - iOffset * 2)));
+		m3 = _mm_cvtepi16_epi32(_mm_loadl_epi64((__m128i*)(piSrc - iOffset)));
+		m4 = _mm_cvtepi16_epi32(_mm_loadl_epi64((__m128i*)(piSrc)));
+		m5 = _mm_cvtepi16_epi32(_mm_loadl_epi64((__m128i*)(piSrc + iOffset)));
+	}
+
+	// delta = Clip3(-tc, tc, ((((m4 - m3) << 2) + m2 - m5 + 4) >> 3))
+	__m128i delta = _mm_add_epi32(_mm_slli_epi32(_mm_sub_epi32(m4, m3), 2), _mm_sub_epi32(m2, m5));
+	delta = _mm_srai_epi32(_mm_add_epi32(delta, _mm_set1_epi32(4)), 3);
+	delta = ETRI_CLIP3_EPI32(_mm_set1_epi32(-iTc), _mm_set1_epi32(iTc), delta);
+
+	const __m128i zero   = _mm_setzero_si128();
+	const __m128i maxval = _mm_set1_epi32(iMaxVal);
+	__m128i p0 = bPartPNoFilter ? m3 : ETRI_CLIP3_EPI32(zero, maxval, _mm_add_epi32(m3, delta));
+	__m128i q0 = bPartQNoFilter ? m4 : ETRI_CLIP3_EPI32(zero, maxval, _mm_sub_epi32(m4, delta));
+
+	if (bVerEdge)
+	{
+		__m128i v = _mm_packs_epi32(p0, q0);
+		v = _mm_unpacklo_epi16(v, _mm_srli_si128(v, 8));
+		for (Int i = 0; i < iNumLines; i++)
+		{
+			*(Int*)(piSrc - 1 + i * iStride) = _mm_cvtsi128_si32(v);
+			v = _mm_srli_si128(v, 4);
+		}
+	}
+	else
+	{
+		__m128i v = _mm_packs_epi32(p0, q0);
+		if (iNumLines == 4)
+		{
+			_mm_storel_epi64((__m128i*)(piSrc - iOffset), v);
+			_mm_storel_epi64((__m128i*)(piSrc), _mm_srli_si128(v, 8));
+		}
+		else
+		{
+			ALIGNED(16) Pel aiTmp[8];
+			_mm_store_si128((__m128i*)aiTmp, v);
+			for (Int i = 0; i < iNumLines; i++)
+			{
+				piSrc[i - iOffset] = aiTmp[i];
+				piSrc[i]           = aiTmp[i + 4];
+			}
+		}
+	}
+}
+#undef ETRI_CLIP3_EPI32
+#endif
+
 // ====================================================================================================================
 // Constructor / destructor / create / destroy
 // ====================================================================================================================
@@ -243,6 +496,78 @@ Void TComLoopFilter::loopFilterPic( TComPic* pcPic )
 }
 #endif 
 
+#if ETRI_PICTURE_TASK_THREADPOOL && ETRI_OMP_DEBLK
+/**
+ - deblocking of the edges of one direction for a range of CTUs. 
+ The picture is deblocked when all CTUs are filtered with EDGE_VER, then with EDGE_HOR, in any order.
+ */
+Void TComLoopFilter::ETRI_loopFilterCUs( TComPic* pcPic, Bool bHorEdge, UInt uiStartCUAddr, UInt uiEndCUAddr )
+{
+  Int iDir = bHorEdge ? EDGE_HOR : EDGE_VER;
+
+  for ( UInt uiCUAddr = uiStartCUAddr; uiCUAddr < uiEndCUAddr; uiCUAddr++ )
+  {
+    TComDataCU* pcCU = pcPic->getCU( uiCUAddr );
+
+    ::memset( m_aapucBS       [iDir], 0, sizeof( UChar ) * m_uiNumPartitions );
+    ::memset( m_aapbEdgeFilter[iDir], 0, sizeof( Bool  ) * m_uiNumPartitions );
+
+    // CU-based deblocking
+    xDeblockCU( pcCU, 0, 0, iDir, this );
+  }
+}
+#endif
+
+#if ETRI_FRAME_ROW_THREADING
+/**
+ - call deblocking function for every CU of a CTU row
+ .
+ Vertical edges of the row are filtered before its horizontal edges. The horizontal edges on the top CTU boundary
+ modify the last lines of the row above, so a row is final only after the row below has been filtered. 
+ The row below must be reconstructed before this function is called.
+ \param  pcPic   picture class (TComPic) pointer
+ \param  uiCURow  CTU row index
+ */
+Void TComLoopFilter::ETRI_loopFilterCTURow( TComPic* pcPic, UInt uiCURow )
+{
+  UInt uiWidthInCU  = pcPic->getFrameWidthInCU();
+  UInt uiStartAddr  = uiCURow * uiWidthInCU;
+  UInt uiCUAddr;
+
+  // Horizontal filtering
+  for ( uiCUAddr = uiStartAddr; uiCUAddr < uiStartAddr + uiWidthInCU; uiCUAddr++ )
+  {
+    TComDataCU* pcCU = pcPic->getCU( uiCUAddr );
+
+    ::memset( m_aapucBS       [EDGE_VER], 0, sizeof( UChar ) * m_uiNumPartitions );
+    ::memset( m_aapbEdgeFilter[EDGE_VER], 0, sizeof( Bool  ) * m_uiNumPartitions );
+
+    // CU-based deblocking
+#if ETRI_OMP_DEBLK
+    xDeblockCU( pcCU, 0, 0, EDGE_VER, this );
+#else
+    xDeblockCU( pcCU, 0, 0, EDGE_VER );
+#endif
+  }
+
+  // Vertical filtering
+  for ( uiCUAddr = uiStartAddr; uiCUAddr < uiStartAddr + uiWidthInCU; uiCUAddr++ )
+  {
+    TComDataCU* pcCU = pcPic->getCU( uiCUAddr );
+
+    ::memset( m_aapucBS       [EDGE_HOR], 0, sizeof( UChar ) * m_uiNumPartitions );
+    ::memset( m_aapbEdgeFilter[EDGE_HOR], 0, sizeof( Bool  ) * m_uiNumPartitions );
+
+    // CU-based deblocking
+#if ETRI_OMP_DEBLK
+    xDeblockCU( pcCU, 0, 0, EDGE_HOR, this );
+#else
+    xDeblockCU( pcCU, 0, 0, EDGE_HOR );
+#endif
+  }
+}
+#endif
+
 // ====================================================================================================================
 // Protected member functions
 // ====================================================================================================================
@@ -876,12 +1201,15 @@ Void TComLoopFilter::xEdgeFilterLuma( TComDataCU* pcCU, UInt uiAbsZorderIdx, UIn
       
       Int iTc =  sm_tcTable[iIndexTC]*iBitdepthScale;
       Int iBeta = sm_betaTable[iIndexB]*iBitdepthScale;
+#if !ETRI_SIMD_DEBLOCKING
       Int iSideThreshold = (iBeta+(iBeta>>1))>>3;
       Int iThrCut = iTc*10;
+#endif
 
       UInt  uiBlocksInPart = uiPelsInPart / 4 ? uiPelsInPart / 4 : 1;
       for (UInt iBlkIdx = 0; iBlkIdx<uiBlocksInPart; iBlkIdx ++)
       {
+#if !ETRI_SIMD_DEBLOCKING
         Int dp0 = xCalcDP( piTmpSrc+iSrcStep*(iIdx*uiPelsInPart+iBlkIdx*4+0), iOffset);
         Int dq0 = xCalcDQ( piTmpSrc+iSrcStep*(iIdx*uiPelsInPart+iBlkIdx*4+0), iOffset);
         Int dp3 = xCalcDP( piTmpSrc+iSrcStep*(iIdx*uiPelsInPart+iBlkIdx*4+3), iOffset);
@@ -892,6 +1220,7 @@ Void TComLoopFilter::xEdgeFilterLuma( TComDataCU* pcCU, UInt uiAbsZorderIdx, UIn
         Int dp = dp0 + dp3;
         Int dq = dq0 + dq3;
         Int d =  d0 + d3;
+#endif
 
 #if !ETRI_REDUNDANCY_OPTIMIZATION
         if (bPCMFilter || pcCU->getSlice()->getPPS()->getTransquantBypassEnableFlag())
@@ -906,6 +1235,9 @@ Void TComLoopFilter::xEdgeFilterLuma( TComDataCU* pcCU, UInt uiAbsZorderIdx, UIn
         }
 #endif
 
+#if ETRI_SIMD_DEBLOCKING
+        ETRI_EdgeFilterLumaSeg_SSE( piTmpSrc+iSrcStep*(iIdx*uiPelsInPart+iBlkIdx*4), iOffset, iStride, iTc, iBeta, bPartPNoFilter, bPartQNoFilter, (1 << g_bitDepthY) - 1 );
+#else
         if (d < iBeta)
         { 
           Bool bFilterP = (dp < iSideThreshold);
@@ -919,6 +1251,7 @@ Void TComLoopFilter::xEdgeFilterLuma( TComDataCU* pcCU, UInt uiAbsZorderIdx, UIn
             xPelFilterLuma( piTmpSrc+iSrcStep*(iIdx*uiPelsInPart+iBlkIdx*4+i), iOffset, iTc, sw, bPartPNoFilter, bPartQNoFilter, iThrCut, bFilterP, bFilterQ);
           }
         }
+#endif
       }
     }
   }
@@ -1047,10 +1380,17 @@ Void TComLoopFilter::xEdgeFilterChroma( TComDataCU* pcCU, UInt uiAbsZorderIdx, U
         Int iIndexTC = Clip3(0, MAX_QP+DEFAULT_INTRA_TC_OFFSET, iQP + DEFAULT_INTRA_TC_OFFSET*(ucBs - 1) + (tcOffsetDiv2 << 1));
         Int iTc =  sm_tcTable[iIndexTC]*iBitdepthScale;
 
+#if ETRI_SIMD_DEBLOCKING
+        for ( UInt uiStep = 0; uiStep < uiPelsInPartChroma; uiStep += 4 )
+        {
+          ETRI_EdgeFilterChromaSeg_SSE( piTmpSrcChroma + iSrcStep*(uiStep+iIdx*uiPelsInPartChroma), iOffset, iStride, min<Int>(4, uiPelsInPartChroma - uiStep), iTc, bPartPNoFilter, bPartQNoFilter, (1 << g_bitDepthC) - 1 );
+        }
+#else
         for ( UInt uiStep = 0; uiStep < uiPelsInPartChroma; uiStep++ )
         {
           xPelFilterChroma( piTmpSrcChroma + iSrcStep*(uiStep+iIdx*uiPelsInPartChroma), iOffset, iTc , bPartPNoFilter, bPartQNoFilter);
         }
+#endif
       }
     }
   }
@@ -138,6 +138,14 @@ public:
 #else
   Void loopFilterPic( TComPic* pcPic );
 #endif 
+#if ETRI_PICTURE_TASK_THREADPOOL && ETRI_OMP_DEBLK
+  /// vertical (bHorEdge false) or horizontal edges of the CTUs [uiStartCUAddr, uiEndCUAddr) with the buffers of this filter
+  Void ETRI_loopFilterCUs( TComPic* pcPic, Bool bHorEdge, UInt uiStartCUAddr, UInt uiEndCUAddr );
+#endif
+#if ETRI_FRAME_ROW_THREADING
+  /// deblocking filter of one CTU row : same result as loopFilterPic when the rows are filtered in raster order
+  Void ETRI_loopFilterCTURow( TComPic* pcPic, UInt uiCURow );
+#endif
 
   static Int getBeta( Int qp )
   {
@@ -81,6 +81,30 @@ Void TComCUMvField::destroy()
   m_uiNumPartition = 0;
 }
 
+#if ETRI_CU_ARENA
+/** Use the fields laid out by TComDataCU::ETRI_createInArena, nothing is allocated
+ */
+Void TComCUMvField::ETRI_create( UInt uiNumPartition, TComMv* pcMv, TComMv* pcMvd, Char* piRefIdx )
+{
+  m_pcMv     = pcMv;
+  m_pcMvd    = pcMvd;
+  m_piRefIdx = piRefIdx;
+  
+  m_uiNumPartition = uiNumPartition;
+}
+
+/** Forget the fields of the arena, which is freed by its owner
+ */
+Void TComCUMvField::ETRI_release()
+{
+  m_pcMv     = NULL;
+  m_pcMvd    = NULL;
+  m_piRefIdx = NULL;
+  
+  m_uiNumPartition = 0;
+}
+#endif
+
 // --------------------------------------------------------------------------------------------------------------------
 // Clear / copy
 // --------------------------------------------------------------------------------------------------------------------
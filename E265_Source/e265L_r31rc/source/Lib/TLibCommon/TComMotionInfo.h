@@ -110,6 +110,10 @@ public:
   
   Void    create( UInt uiNumPartition );
   Void    destroy();
+#if ETRI_CU_ARENA
+  Void    ETRI_create( UInt uiNumPartition, TComMv* pcMv, TComMv* pcMvd, Char* piRefIdx );  ///< fields in the arena of the owner CU
+  Void    ETRI_release();
+#endif
   
   // ------------------------------------------------------------------------------------------------------------------
   // clear / copy
@@ -136,6 +136,18 @@ Void TComPic::compressMotion()
   } 
 }
 
+#if ETRI_PICTURE_TASK_THREADPOOL
+Void TComPic::compressMotion(UInt uiStartCUAddr, UInt uiEndCUAddr)
+{
+  TComPicSym* pPicSym = getPicSym(); 
+  for ( UInt uiCUAddr = uiStartCUAddr; uiCUAddr < uiEndCUAddr; uiCUAddr++ )
+  {
+    TComDataCU* pcCU = pPicSym->getCU(uiCUAddr);
+    pcCU->compressMV(); 
+  } 
+}
+#endif
+
 Bool  TComPic::getSAOMergeAvailability(Int currAddr, Int mergeAddr)
 {
   Bool mergeCtbInSliceSeg = (mergeAddr >= getPicSym()->getCUOrderMap(getCU(currAddr)->getSlice()->getSliceCurStartCUAddr()/getNumPartInCU()));
@@ -137,6 +137,9 @@ public:
   Int           getNumReorderPics(UInt tlayer)        { return m_numReorderPics[tlayer]; }
 
   Void          compressMotion(); 
+#if ETRI_PICTURE_TASK_THREADPOOL
+  Void          compressMotion(UInt uiStartCUAddr, UInt uiEndCUAddr);		///< CTUs [uiStartCUAddr, uiEndCUAddr) only
+#endif
   UInt          getCurrSliceIdx()            { return m_uiCurrSliceIdx;                }
   Void          setCurrSliceIdx(UInt i)      { m_uiCurrSliceIdx = i;                   }
   UInt          getNumAllocatedSlice()       {return m_apcPicSym->getNumAllocatedSlice();}
@@ -66,10 +66,23 @@ TComPicYuv::TComPicYuv()
 	em_nPoc			= -1;
 	em_bUsed			= false;
 #endif
+#if ETRI_FRAME_ROW_THREADING
+	em_iRowReadyY.store(ETRI_ROW_READY_ALL);
+	pthread_mutex_init(&em_RowMutex, NULL);
+	pthread_cond_init(&em_RowCond, NULL);
+#endif
+#if ETRI_PYRAMID_ME
+	em_apiPyramidBuf[0] = em_apiPyramidBuf[1] = NULL;
+	em_apiPyramidOrg[0] = em_apiPyramidOrg[1] = NULL;
+#endif
 }
 
 TComPicYuv::~TComPicYuv()
 {
+#if ETRI_FRAME_ROW_THREADING
+	pthread_cond_destroy(&em_RowCond);
+	pthread_mutex_destroy(&em_RowMutex);
+#endif
 }
 
 #if ETRI_EM_OPERATION_OPTIMIZATION
@@ -91,9 +104,22 @@ Void TComPicYuv::create(Int iPicWidth, Int iPicHeight, UInt uiMaxCUWidth, UInt u
 	m_iChromaMarginX = m_iLumaMarginX >> 1;
 	m_iChromaMarginY = m_iLumaMarginY >> 1;
 
+#if ETRI_HUGE_PAGE
+	// NUMA placement, huge pages and pre-fault of the planes with their borders
+	m_apiPicBufY = (Pel*)ETRI_AllocPictureMemory(sizeof(Pel) * (m_iPicWidth + (m_iLumaMarginX << 1)) * (m_iPicHeight + (m_iLumaMarginY << 1)));
+	m_apiPicBufU = (Pel*)ETRI_AllocPictureMemory(sizeof(Pel) * ((m_iPicWidth >> 1) + (m_iChromaMarginX << 1)) * ((m_iPicHeight >> 1) + (m_iChromaMarginY << 1)));
+	m_apiPicBufV = (Pel*)ETRI_AllocPictureMemory(sizeof(Pel) * ((m_iPicWidth >> 1) + (m_iChromaMarginX << 1)) * ((m_iPicHeight >> 1) + (m_iChromaMarginY << 1)));
+#else
 	m_apiPicBufY = (Pel*)xMalloc(Pel, (m_iPicWidth + (m_iLumaMarginX << 1)) * (m_iPicHeight + (m_iLumaMarginY << 1)));
 	m_apiPicBufU = (Pel*)xMalloc(Pel, ((m_iPicWidth >> 1) + (m_iChromaMarginX << 1)) * ((m_iPicHeight >> 1) + (m_iChromaMarginY << 1)));
 	m_apiPicBufV = (Pel*)xMalloc(Pel, ((m_iPicWidth >> 1) + (m_iChromaMarginX << 1)) * ((m_iPicHeight >> 1) + (m_iChromaMarginY << 1)));
+#endif
+#if ETRI_THREAD_AFFINITY && !ETRI_HUGE_PAGE
+	// NUMA placement before the first touch of the planes
+	ETRI_BindPictureMemory(m_apiPicBufY, sizeof(Pel) * (m_iPicWidth + (m_iLumaMarginX << 1)) * (m_iPicHeight + (m_iLumaMarginY << 1)));
+	ETRI_BindPictureMemory(m_apiPicBufU, sizeof(Pel) * ((m_iPicWidth >> 1) + (m_iChromaMarginX << 1)) * ((m_iPicHeight >> 1) + (m_iChromaMarginY << 1)));
+	ETRI_BindPictureMemory(m_apiPicBufV, sizeof(Pel) * ((m_iPicWidth >> 1) + (m_iChromaMarginX << 1)) * ((m_iPicHeight >> 1) + (m_iChromaMarginY << 1)));
+#endif
 
 	m_piPicOrgY = m_apiPicBufY + m_iLumaMarginY   * getStride() + m_iLumaMarginX;
 	m_piPicOrgU = m_apiPicBufU + m_iChromaMarginY * getCStride() + m_iChromaMarginX;
@@ -143,9 +169,22 @@ Void TComPicYuv::create( Int iPicWidth, Int iPicHeight, UInt uiMaxCUWidth, UInt
   m_iChromaMarginX  = m_iLumaMarginX>>1;
   m_iChromaMarginY  = m_iLumaMarginY>>1;
   
+#if ETRI_HUGE_PAGE
+  // NUMA placement, huge pages and pre-fault of the planes with their borders
+  m_apiPicBufY      = (Pel*)ETRI_AllocPictureMemory( sizeof(Pel) * ( m_iPicWidth       + (m_iLumaMarginX  <<1)) * ( m_iPicHeight       + (m_iLumaMarginY  <<1)));
+  m_apiPicBufU      = (Pel*)ETRI_AllocPictureMemory( sizeof(Pel) * ((m_iPicWidth >> 1) + (m_iChromaMarginX<<1)) * ((m_iPicHeight >> 1) + (m_iChromaMarginY<<1)));
+  m_apiPicBufV      = (Pel*)ETRI_AllocPictureMemory( sizeof(Pel) * ((m_iPicWidth >> 1) + (m_iChromaMarginX<<1)) * ((m_iPicHeight >> 1) + (m_iChromaMarginY<<1)));
+#else
   m_apiPicBufY      = (Pel*)xMalloc( Pel, ( m_iPicWidth       + (m_iLumaMarginX  <<1)) * ( m_iPicHeight       + (m_iLumaMarginY  <<1)));
   m_apiPicBufU      = (Pel*)xMalloc( Pel, ((m_iPicWidth >> 1) + (m_iChromaMarginX<<1)) * ((m_iPicHeight >> 1) + (m_iChromaMarginY<<1)));
   m_apiPicBufV      = (Pel*)xMalloc( Pel, ((m_iPicWidth >> 1) + (m_iChromaMarginX<<1)) * ((m_iPicHeight >> 1) + (m_iChromaMarginY<<1)));
+#endif
+#if ETRI_THREAD_AFFINITY && !ETRI_HUGE_PAGE
+  // NUMA placement before the first touch of the planes
+  ETRI_BindPictureMemory( m_apiPicBufY, sizeof(Pel) * ( m_iPicWidth       + (m_iLumaMarginX  <<1)) * ( m_iPicHeight       + (m_iLumaMarginY  <<1)));
+  ETRI_BindPictureMemory( m_apiPicBufU, sizeof(Pel) * ((m_iPicWidth >> 1) + (m_iChromaMarginX<<1)) * ((m_iPicHeight >> 1) + (m_iChromaMarginY<<1)));
+  ETRI_BindPictureMemory( m_apiPicBufV, sizeof(Pel) * ((m_iPicWidth >> 1) + (m_iChromaMarginX<<1)) * ((m_iPicHeight >> 1) + (m_iChromaMarginY<<1)));
+#endif
   
   m_piPicOrgY       = m_apiPicBufY + m_iLumaMarginY   * getStride()  + m_iLumaMarginX;
   m_piPicOrgU       = m_apiPicBufU + m_iChromaMarginY * getCStride() + m_iChromaMarginX;
@@ -184,14 +223,23 @@ Void TComPicYuv::destroy()
   m_piPicOrgU       = NULL;
   m_piPicOrgV       = NULL;
   
+#if ETRI_HUGE_PAGE
+  if( m_apiPicBufY ){ ETRI_FreePictureMemory( m_apiPicBufY );    m_apiPicBufY = NULL; }
+  if( m_apiPicBufU ){ ETRI_FreePictureMemory( m_apiPicBufU );    m_apiPicBufU = NULL; }
+  if( m_apiPicBufV ){ ETRI_FreePictureMemory( m_apiPicBufV );    m_apiPicBufV = NULL; }
+#else
   if( m_apiPicBufY ){ xFree( m_apiPicBufY );    m_apiPicBufY = NULL; }
   if( m_apiPicBufU ){ xFree( m_apiPicBufU );    m_apiPicBufU = NULL; }
   if( m_apiPicBufV ){ xFree( m_apiPicBufV );    m_apiPicBufV = NULL; }
+#endif
 
   delete[] m_cuOffsetY;
   delete[] m_cuOffsetC;
   delete[] m_buOffsetY;
   delete[] m_buOffsetC;
+#if ETRI_PYRAMID_ME
+  ETRI_destroyPyramid();
+#endif
 }
 
 Void TComPicYuv::createLuma( Int iPicWidth, Int iPicHeight, UInt uiMaxCUWidth, UInt uiMaxCUHeight, UInt uiMaxCUDepth )
@@ -209,7 +257,11 @@ Void TComPicYuv::createLuma( Int iPicWidth, Int iPicHeight, UInt uiMaxCUWidth, U
   m_iLumaMarginX    = g_uiMaxCUWidth  + 16; // for 16-byte alignment
   m_iLumaMarginY    = g_uiMaxCUHeight + 16;  // margin for 8-tap filter and infinite padding
   
+#if ETRI_HUGE_PAGE
+  m_apiPicBufY      = (Pel*)ETRI_AllocPictureMemory( sizeof(Pel) * ( m_iPicWidth       + (m_iLumaMarginX  <<1)) * ( m_iPicHeight       + (m_iLumaMarginY  <<1)));
+#else
   m_apiPicBufY      = (Pel*)xMalloc( Pel, ( m_iPicWidth       + (m_iLumaMarginX  <<1)) * ( m_iPicHeight       + (m_iLumaMarginY  <<1)));
+#endif
   m_piPicOrgY       = m_apiPicBufY + m_iLumaMarginY   * getStride()  + m_iLumaMarginX;
   
   m_cuOffsetY = new Int[numCuInWidth * numCuInHeight];
@@ -238,7 +290,11 @@ Void TComPicYuv::destroyLuma()
 {
   m_piPicOrgY       = NULL;
   
+#if ETRI_HUGE_PAGE
+  if( m_apiPicBufY ){ ETRI_FreePictureMemory( m_apiPicBufY );    m_apiPicBufY = NULL; }
+#else
   if( m_apiPicBufY ){ xFree( m_apiPicBufY );    m_apiPicBufY = NULL; }
+#endif
   
   delete[] m_cuOffsetY;
   delete[] m_buOffsetY;
@@ -310,9 +366,9 @@ Void TComPicYuv::qrCopyToPic(TComPicYuv*  pcPicYuvDst, int nThread, int index)
 
 
 	UInt startHeight = iHeight / nThread * index;
-	UInt endHeight = iHeight / nThread * (index + 1);
+	UInt endHeight = (index == nThread - 1)? iHeight : iHeight / nThread * (index + 1);		///The last part takes the remaining lines
 	UInt startHeightUV = iHeightUV / nThread * index;
-	UInt endHeightUV = iHeightUV / nThread * (index + 1);
+	UInt endHeightUV = (index == nThread - 1)? iHeightUV : iHeightUV / nThread * (index + 1);
 	
 	DstY += startHeight * StrideY;
 	SrcY += startHeight * StrideY;
@@ -350,6 +406,25 @@ Void TComPicYuv::qrCopyToPic(TComPicYuv*  pcPicYuvDst, int nThread, int index)
 }
 #endif
 
+#if ETRI_ZEROCOPY_IO
+Void  TComPicYuv::ETRI_swapPlanes (TComPicYuv*  pcPicYuv)
+{
+  assert( m_iPicWidth    == pcPicYuv->getWidth()  );
+  assert( m_iPicHeight   == pcPicYuv->getHeight() );
+  assert( m_iLumaMarginX == pcPicYuv->getLumaMargin() );
+
+  std::swap( m_apiPicBufY, pcPicYuv->m_apiPicBufY );
+  std::swap( m_apiPicBufU, pcPicYuv->m_apiPicBufU );
+  std::swap( m_apiPicBufV, pcPicYuv->m_apiPicBufV );
+  std::swap( m_piPicOrgY,  pcPicYuv->m_piPicOrgY  );
+  std::swap( m_piPicOrgU,  pcPicYuv->m_piPicOrgU  );
+  std::swap( m_piPicOrgV,  pcPicYuv->m_piPicOrgV  );
+
+  m_bIsBorderExtended           = false;
+  pcPicYuv->m_bIsBorderExtended = false;
+}
+#endif
+
 Void  TComPicYuv::copyToPicLuma (TComPicYuv*  pcPicYuvDst)
 {
   assert( m_iPicWidth  == pcPicYuvDst->getWidth()  );
@@ -388,6 +463,192 @@ Void TComPicYuv::extendPicBorder ()
   m_bIsBorderExtended = true;
 }
 
+#if ETRI_FRAME_ROW_THREADING
+/**
+------------------------------------------------------------------------------------------------------------------------------------------------
+	@brief: Border extension of the luma lines [iStartY, iEndY) and the corresponding chroma lines.
+			The top and bottom margins are filled when the range touches the first and the last line. 
+			Called in raster order by the frame encoder while the picture is referenced by other frames.
+------------------------------------------------------------------------------------------------------------------------------------------------
+*/
+Void TComPicYuv::ETRI_extendPicBorderRows (Int iStartY, Int iEndY)
+{
+	ETRI_xExtendPicCompBorderRows( getLumaAddr(), getStride(),  getWidth(),      getHeight(),      m_iLumaMarginX,   m_iLumaMarginY,   iStartY,      iEndY      );
+	ETRI_xExtendPicCompBorderRows( getCbAddr()  , getCStride(), getWidth() >> 1, getHeight() >> 1, m_iChromaMarginX, m_iChromaMarginY, iStartY >> 1, iEndY >> 1 );
+	ETRI_xExtendPicCompBorderRows( getCrAddr()  , getCStride(), getWidth() >> 1, getHeight() >> 1, m_iChromaMarginX, m_iChromaMarginY, iStartY >> 1, iEndY >> 1 );
+
+	if (iEndY == getHeight())
+	{
+		m_bIsBorderExtended = true;
+	}
+}
+
+Void TComPicYuv::ETRI_xExtendPicCompBorderRows (Pel* piTxt, Int iStride, Int iWidth, Int iHeight, Int iMarginX, Int iMarginY, Int iStartY, Int iEndY)
+{
+	Int   y;
+	Pel*  pi;
+
+	/// Left and Right Margin of the lines
+	xExtendPicCompBorder(piTxt + iStartY * iStride, iStride, iWidth, iEndY - iStartY, iMarginX, 0);
+
+	if (iStartY == 0)
+	{
+		pi = piTxt - iMarginX;
+		for ( y = 0; y < iMarginY; y++ )
+		{
+			::memcpy( pi - (y+1)*iStride, pi, sizeof(Pel)*(iWidth + (iMarginX<<1)) );
+		}
+	}
+
+	if (iEndY == iHeight)
+	{
+		pi = piTxt + (iHeight - 1) * iStride - iMarginX;
+		for ( y = 0; y < iMarginY; y++ )
+		{
+			::memcpy( pi + (y+1)*iStride, pi, sizeof(Pel)*(iWidth + (iMarginX<<1)) );
+		}
+	}
+}
+
+Void TComPicYuv::ETRI_setRowReady (Int iLumaY)
+{
+	pthread_mutex_lock(&em_RowMutex);
+	em_iRowReadyY.store(iLumaY, std::memory_order_release);
+	pthread_cond_broadcast(&em_RowCond);
+	pthread_mutex_unlock(&em_RowMutex);
+}
+
+Void TComPicYuv::ETRI_xWaitRowReady (Int iLumaY)
+{
+	/// Samples below the picture are the bottom margin, which is extended with the last row
+	if (iLumaY > m_iPicHeight && iLumaY != ETRI_ROW_READY_ALL)
+	{
+		iLumaY = ETRI_getRowReadyAllSamples();
+	}
+
+	pthread_mutex_lock(&em_RowMutex);
+	while (iLumaY > em_iRowReadyY.load(std::memory_order_relaxed))
+	{
+		pthread_cond_wait(&em_RowCond, &em_RowMutex);
+	}
+	pthread_mutex_unlock(&em_RowMutex);
+}
+#endif
+
+#if ETRI_PYRAMID_ME
+Void TComPicYuv::ETRI_createPyramid ()
+{
+	if (em_apiPyramidBuf[0])
+	{
+		return;
+	}
+
+	for (Int iLevel = 0; iLevel < 2; iLevel++)
+	{
+		em_aiPyramidWidth [iLevel] = m_iPicWidth  >> (iLevel + 1);
+		em_aiPyramidHeight[iLevel] = m_iPicHeight >> (iLevel + 1);
+
+#if ETRI_HUGE_PAGE
+		em_apiPyramidBuf[iLevel] = (Pel*)ETRI_AllocPictureMemory(sizeof(Pel) * ETRI_getPyramidStride(iLevel) * (em_aiPyramidHeight[iLevel] + (ETRI_PYRAMID_MARGIN << 1)));
+#else
+		em_apiPyramidBuf[iLevel] = (Pel*)xMalloc(Pel, ETRI_getPyramidStride(iLevel) * (em_aiPyramidHeight[iLevel] + (ETRI_PYRAMID_MARGIN << 1)));
+#endif
+		em_apiPyramidOrg[iLevel] = em_apiPyramidBuf[iLevel] + ETRI_PYRAMID_MARGIN * ETRI_getPyramidStride(iLevel) + ETRI_PYRAMID_MARGIN;
+	}
+}
+
+Void TComPicYuv::ETRI_destroyPyramid ()
+{
+	for (Int iLevel = 0; iLevel < 2; iLevel++)
+	{
+#if ETRI_HUGE_PAGE
+		if (em_apiPyramidBuf[iLevel]){ ETRI_FreePictureMemory(em_apiPyramidBuf[iLevel]); em_apiPyramidBuf[iLevel] = NULL; }
+#else
+		if (em_apiPyramidBuf[iLevel]){ xFree(em_apiPyramidBuf[iLevel]); em_apiPyramidBuf[iLevel] = NULL; }
+#endif
+		em_apiPyramidOrg[iLevel] = NULL;
+	}
+}
+
+/**
+------------------------------------------------------------------------------------------------------------------------------------------------
+	@brief: 2x2 averages of the input luma piSrc into the 1/4 plane and of the 1/4 plane into the 1/16 plane.
+			The parts are split on 1/16 lines, so each part reads only the input lines and writes only the lines of its own,
+			and the parts can be built by the copy jobs of the input picture at the same time.
+------------------------------------------------------------------------------------------------------------------------------------------------
+*/
+Void TComPicYuv::ETRI_buildPyramid (Pel* piSrc, Int iSrcStride, Int nPart, Int iPart)
+{
+	Int iStartY = em_aiPyramidHeight[1] * iPart / nPart;
+	Int iEndY   = em_aiPyramidHeight[1] * (iPart + 1) / nPart;
+	/// The last part also takes the 1/4 line below the 1/16 lines of an odd 1/4 height
+	Int iEndY1  = (iPart == nPart - 1) ? em_aiPyramidHeight[0] : (iEndY << 1);
+
+	for (Int iLevel = 0; iLevel < 2; iLevel++)
+	{
+		Int   iStartLine = iLevel ? iStartY : (iStartY << 1);
+		Int   iEndLine   = iLevel ? iEndY   : iEndY1;
+		Int   iSrcStr    = iLevel ? ETRI_getPyramidStride(0) : iSrcStride;
+		Int   iDstStride = ETRI_getPyramidStride(iLevel);
+		Pel*  piS        = (iLevel ? em_apiPyramidOrg[0] : piSrc) + (iStartLine << 1) * iSrcStr;
+		Pel*  piD        = em_apiPyramidOrg[iLevel] + iStartLine * iDstStride;
+
+		for (Int y = iStartLine; y < iEndLine; y++)
+		{
+			for (Int x = 0; x < em_aiPyramidWidth[iLevel]; x++)
+			{
+				piD[x] = (piS[2*x] + piS[2*x + 1] + piS[2*x + iSrcStr] + piS[2*x + 1 + iSrcStr] + 2) >> 2;
+			}
+			piS += (iSrcStr << 1);
+			piD += iDstStride;
+		}
+
+		ETRI_xExtendPyramidRows(iLevel, iStartLine, iEndLine);
+	}
+}
+
+Void TComPicYuv::ETRI_xExtendPyramidRows (Int iLevel, Int iStartY, Int iEndY)
+{
+	Int   iStride = ETRI_getPyramidStride(iLevel);
+	Int   iWidth  = em_aiPyramidWidth[iLevel];
+	Int   iHeight = em_aiPyramidHeight[iLevel];
+	Pel*  pi;
+
+	if (iStartY >= iEndY)
+	{
+		return;
+	}
+
+	for (Int y = iStartY; y < iEndY; y++)
+	{
+		pi = em_apiPyramidOrg[iLevel] + y * iStride;
+		for (Int x = 0; x < ETRI_PYRAMID_MARGIN; x++)
+		{
+			pi[-1 - x]     = pi[0];
+			pi[iWidth + x] = pi[iWidth - 1];
+		}
+	}
+
+	if (iStartY == 0)
+	{
+		pi = em_apiPyramidOrg[iLevel] - ETRI_PYRAMID_MARGIN;
+		for (Int y = 0; y < ETRI_PYRAMID_MARGIN; y++)
+		{
+			::memcpy( pi - (y+1)*iStride, pi, sizeof(Pel)*iStride );
+		}
+	}
+
+	if (iEndY == iHeight)
+	{
+		pi = em_apiPyramidOrg[iLevel] + (iHeight - 1) * iStride - ETRI_PYRAMID_MARGIN;
+		for (Int y = 0; y < ETRI_PYRAMID_MARGIN; y++)
+		{
+			::memcpy( pi + (y+1)*iStride, pi, sizeof(Pel)*iStride );
+		}
+	}
+}
+#endif
+
 Void TComPicYuv::xExtendPicCompBorder  (Pel* piTxt, Int iStride, Int iWidth, Int iHeight, Int iMarginX, Int iMarginY)
 {
 #if ETRI_SIMD_EXTENEDED_PIC_BORDER
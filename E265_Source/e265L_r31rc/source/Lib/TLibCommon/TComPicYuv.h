@@ -41,6 +41,10 @@
 #include <stdio.h>
 #include "CommonDef.h"
 #include "TComRom.h"
+#if ETRI_FRAME_ROW_THREADING
+#include <pthread.h>
+#include <atomic>
+#endif
 
 //! \ingroup TLibCommon
 //! \{
@@ -49,6 +53,10 @@
 // Class definition
 // ====================================================================================================================
 
+#if ETRI_FRAME_ROW_THREADING
+#define ETRI_ROW_READY_ALL		MAX_INT		///< Row progress of a complete picture (samples and compressed motion)
+#endif
+
 /// picture YUV buffer class
 class TComPicYuv
 {
@@ -86,9 +94,29 @@ private:
   Int   m_iChromaMarginY;
   
   Bool  m_bIsBorderExtended;
+
+#if ETRI_FRAME_ROW_THREADING
+  std::atomic<Int>	em_iRowReadyY;		///< Luma lines from the top which are final and border extended (ETRI_ROW_READY_ALL when the picture is complete)
+  pthread_mutex_t	em_RowMutex;
+  pthread_cond_t	em_RowCond;
+#endif
+
+#if ETRI_PYRAMID_ME
+  Pel*  em_apiPyramidBuf[2];    ///< Luma planes of 1/4 and 1/16 resolution (including margin of ETRI_PYRAMID_MARGIN)
+  Pel*  em_apiPyramidOrg[2];
+  Int   em_aiPyramidWidth[2];
+  Int   em_aiPyramidHeight[2];
+#endif
   
 protected:
   Void  xExtendPicCompBorder (Pel* piTxt, Int iStride, Int iWidth, Int iHeight, Int iMarginX, Int iMarginY);
+#if ETRI_FRAME_ROW_THREADING
+  Void  ETRI_xExtendPicCompBorderRows (Pel* piTxt, Int iStride, Int iWidth, Int iHeight, Int iMarginX, Int iMarginY, Int iStartY, Int iEndY);
+  Void  ETRI_xWaitRowReady   (Int iLumaY);
+#endif
+#if ETRI_PYRAMID_ME
+  Void  ETRI_xExtendPyramidRows (Int iLevel, Int iStartY, Int iEndY);
+#endif
   
 public:
   TComPicYuv         ();
@@ -152,9 +180,37 @@ public:
 #if ETRI_COPYTOPIC_MULTITHREAD
   Void qrCopyToPic(TComPicYuv*  pcPicYuvDst, int nThread, int index);
 #endif
+#if ETRI_ZEROCOPY_IO
+  Void  ETRI_swapPlanes ( TComPicYuv*  pcPicYuv );	///< exchange the planes (with their margins) of two pictures of the same size instead of copyToPic
+#endif
 
   //  Extend function of picture buffer
   Void  extendPicBorder      ();
+
+#if ETRI_FRAME_ROW_THREADING
+  /// Row progress of a reconstruction which is still encoded while other frames reference it.
+  /// -1 : not started, [0, height] : luma lines ready, height + margin : all samples ready, ETRI_ROW_READY_ALL : motion compressed too
+  Void  ETRI_extendPicBorderRows (Int iStartY, Int iEndY);
+  Void  ETRI_setRowReady     (Int iLumaY);
+  Int   ETRI_getRowReady     ()					{ return em_iRowReadyY.load(std::memory_order_acquire); }
+  Int   ETRI_getRowReadyAllSamples ()			{ return m_iPicHeight + m_iLumaMarginY; }
+
+  /// Block until the luma lines [0, iLumaY) can be referenced; lines above and below the picture need the top and bottom margins
+  Void  ETRI_waitRowReady    (Int iLumaY)		{ iLumaY = std::max<Int>(iLumaY, 1); if (iLumaY > em_iRowReadyY.load(std::memory_order_acquire)) ETRI_xWaitRowReady(iLumaY); }
+#endif
+
+#if ETRI_PYRAMID_ME
+  /// Luma planes of 1/4 (iLevel 0) and 1/16 (iLevel 1) resolution for the motion pre-search of TEncSearch.
+  /// Only input pictures have them; they are built from the input samples, so they are complete before the picture is coded.
+  Void  ETRI_createPyramid   ();
+  Void  ETRI_destroyPyramid  ();
+  Void  ETRI_buildPyramid    (Pel* piSrc, Int iSrcStride, Int nPart, Int iPart);	///< 1/16 lines of the part iPart of nPart parts
+  Bool  ETRI_hasPyramid      ()				{ return em_apiPyramidBuf[0] != NULL; }
+  Pel*  ETRI_getPyramidAddr  (Int iLevel)	{ return em_apiPyramidOrg[iLevel]; }
+  Int   ETRI_getPyramidStride(Int iLevel)	{ return em_aiPyramidWidth[iLevel] + (ETRI_PYRAMID_MARGIN << 1); }
+  Int   ETRI_getPyramidWidth (Int iLevel)	{ return em_aiPyramidWidth[iLevel]; }
+  Int   ETRI_getPyramidHeight(Int iLevel)	{ return em_aiPyramidHeight[iLevel]; }
+#endif
   
   //  Dump picture
   Void  dump (Char* pFileName, Bool bAdd = false);
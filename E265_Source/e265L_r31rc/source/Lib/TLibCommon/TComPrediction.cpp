@@ -1292,6 +1292,11 @@ Void TComPrediction::xPredInterLumaBlk( TComDataCU *cu, TComPicYuv *refPic, UInt
   Int refStride = refPic->getStride();  
   Int refOffset = ( mv->getHor() >> 2 ) + ( mv->getVer() >> 2 ) * refStride;
   Pel *ref      = refPic->getLumaAddr( cu->getAddr(), cu->getZorderIdxInCU() + partAddr ) + refOffset;
+
+#if ETRI_FRAME_ROW_THREADING
+  // The reference may still be encoded : wait for the rows under the block and the filter taps
+  refPic->ETRI_waitRowReady( cu->getCUPelY() + g_auiRasterToPelY[g_auiZscanToRaster[cu->getZorderIdxInCU() + partAddr]] + (mv->getVer() >> 2) + height + (NTAPS_LUMA >> 1) );
+#endif
   
   Int dstStride = dstPic->getStride();
   Pel *dst      = dstPic->getLumaAddr( partAddr );
@@ -1341,6 +1346,10 @@ Void TComPrediction::xPredInterChromaBlk( TComDataCU *cu, TComPicYuv *refPic, UI
   
   Pel*    refCb     = refPic->getCbAddr( cu->getAddr(), cu->getZorderIdxInCU() + partAddr ) + refOffset;
   Pel*    refCr     = refPic->getCrAddr( cu->getAddr(), cu->getZorderIdxInCU() + partAddr ) + refOffset;
+
+#if ETRI_FRAME_ROW_THREADING
+  refPic->ETRI_waitRowReady( (((cu->getCUPelY() + g_auiRasterToPelY[g_auiZscanToRaster[cu->getZorderIdxInCU() + partAddr]]) >> 1) + (mv->getVer() >> 3) + (height >> 1) + (NTAPS_CHROMA >> 1)) << 1 );
+#endif
   
   Pel* dstCb = dstPic->getCbAddr( partAddr );
   Pel* dstCr = dstPic->getCrAddr( partAddr );
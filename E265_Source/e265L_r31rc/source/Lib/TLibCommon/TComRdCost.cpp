@@ -279,6 +279,38 @@ Void TComRdCost::init()
   m_afpDistortFunc[27] = TComRdCost::xGetHADs;
   m_afpDistortFunc[28] = TComRdCost::xGetHADs;
 
+#if ETRI_SIMD_AVX2
+  //---------------------------------------------------------------------------
+  //  Runtime Dispatch : Replace SSE4.2 Functions with AVX2 ones by ETRI_GetSimdLevel()
+  //---------------------------------------------------------------------------
+  em_bUseAVX2 = (ETRI_GetSimdLevel() >= ETRI_SIMD_LEVEL_AVX2);
+  if (em_bUseAVX2)
+  {
+    m_afpDistortFunc[2]  = TComRdCost::xGetSSE4_AVX2;
+    m_afpDistortFunc[3]  = TComRdCost::xGetSSE8_AVX2;
+    m_afpDistortFunc[4]  = TComRdCost::xGetSSE16_AVX2;
+    m_afpDistortFunc[5]  = TComRdCost::xGetSSE32_AVX2;
+    m_afpDistortFunc[6]  = TComRdCost::xGetSSE64_AVX2;
+
+    m_afpDistortFunc[9]  = TComRdCost::xGetSAD4_AVX2;
+    m_afpDistortFunc[10] = TComRdCost::xGetSAD8_AVX2;
+    m_afpDistortFunc[11] = TComRdCost::xGetSAD16_AVX2;
+    m_afpDistortFunc[12] = TComRdCost::xGetSAD32_AVX2;
+    m_afpDistortFunc[13] = TComRdCost::xGetSAD64_AVX2;
+
+    m_afpDistortFunc[16] = TComRdCost::xGetSAD4_AVX2;
+    m_afpDistortFunc[17] = TComRdCost::xGetSAD8_AVX2;
+    m_afpDistortFunc[18] = TComRdCost::xGetSAD16_AVX2;
+    m_afpDistortFunc[19] = TComRdCost::xGetSAD32_AVX2;
+    m_afpDistortFunc[20] = TComRdCost::xGetSAD64_AVX2;
+
+    m_afpDistortFunc[25] = TComRdCost::xGetHADs_AVX2;
+    m_afpDistortFunc[26] = TComRdCost::xGetHADs_AVX2;
+    m_afpDistortFunc[27] = TComRdCost::xGetHADs_AVX2;
+    m_afpDistortFunc[28] = TComRdCost::xGetHADs_AVX2;
+  }
+#endif
+
 #if (ETRI_FAST_INTEGERME)
   m_afpDistortFunc[52] = TComRdCost::ETRI_GetSAD;
   m_afpDistortFunc[53] = TComRdCost::ETRI_GetSAD4;
@@ -475,6 +507,22 @@ UInt TComRdCost::calcHAD(Int bitDepth, Pel* pi0, Int iStride0, Pel* pi1, Int iSt
   UInt uiSum = 0, uiHADDC = 0, uiSumHADDC = 0;
   Int x, y;
 
+#if ETRI_SIMD_AVX2
+  if (em_bUseAVX2 && ((iWidth & 0x0F) == 0) && ((iHeight & 0x07) == 0))
+  {
+	  for (y = 0; y<iHeight; y += 8)
+	  {
+		  for (x = 0; x<iWidth; x += 16)
+		  {
+			  uiSum += xCalcHADs16x8_AVX2(&pi0[x], &pi1[x], iStride0, iStride1, uiHADDC);
+		  }
+		  pi0 += iStride0 << 3;
+		  pi1 += iStride1 << 3;
+	  }
+	  return uiSum >> DISTORTION_PRECISION_ADJUSTMENT(bitDepth-8);
+  }
+#endif
+
 #if ETRI_EM_OPERATION_OPTIMIZATION
   if (((iWidth & 0x07) == 0) && ((iHeight & 0x07) == 0))
   {
@@ -3572,4 +3620,483 @@ UInt TComRdCost::ETRI_GetSAD64( DistParam* pcDtParam )
 #endif
 
 
+// ====================================================================================================================
+//   ETRI  Modification :: AVX2 Distortion Functions (SAD, SSE, HAD)
+//   These functions are registered to m_afpDistortFunc in init() only when ETRI_GetCpuFeatures() reports AVX2.
+//   Every function returns the same value as the SSE4.2 version, and block shapes that do not fit the 256-bit
+//   layout are handed back to the SSE4.2 version.
+// ====================================================================================================================
+#if ETRI_SIMD_AVX2
+
+#define	ETRI_AVX2_HSUM32(ymm, uiSum) \
+	{ \
+		__m128i _xmm = _mm_add_epi32(_mm256_castsi256_si128(ymm), _mm256_extracti128_si256(ymm, 1)); \
+		_xmm = _mm_add_epi32(_xmm, _mm_shuffle_epi32(_xmm, 0x4E)); \
+		_xmm = _mm_add_epi32(_xmm, _mm_shuffle_epi32(_xmm, 0xB1)); \
+		uiSum = (UInt)_mm_cvtsi128_si32(_xmm); \
+	}
+
+#define	ETRI_AVX2_LOAD2x128(piSrc, iStride) \
+	_mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((__m128i const *)(piSrc))), _mm_loadu_si128((__m128i const *)((piSrc) + (iStride))), 1)
+
+#define	ETRI_AVX2_LOAD4x64(piSrc, iStride) \
+	_mm256_inserti128_si256(_mm256_castsi128_si256(_mm_unpacklo_epi64(_mm_loadl_epi64((__m128i const *)(piSrc)), _mm_loadl_epi64((__m128i const *)((piSrc) + (iStride))))), \
+	_mm_unpacklo_epi64(_mm_loadl_epi64((__m128i const *)((piSrc) + 2*(iStride))), _mm_loadl_epi64((__m128i const *)((piSrc) + 3*(iStride)))), 1)
+
+// --------------------------------------------------------------------------------------------------------------------
+// SAD (AVX2) : |Org - Cur| is summed to 16bit per row and accumulated to 32bit with _mm256_madd_epi16
+// --------------------------------------------------------------------------------------------------------------------
+ETRI_TARGET_AVX2 UInt TComRdCost::xGetSAD4_AVX2( DistParam* pcDtParam )
+{
+	Int  iSubShift = pcDtParam->iSubShift;
+	Int  iRows     = pcDtParam->iRows >> iSubShift;
+
+	if (pcDtParam->bApplyWeight || (iRows & 0x03))
+	{
+		return xGetSAD4(pcDtParam);
+	}
+
+	Pel* piOrg = pcDtParam->pOrg;
+	Pel* piCur = pcDtParam->pCur;
+	Int  iStrideOrg = pcDtParam->iStrideOrg << iSubShift;
+	Int  iStrideCur = pcDtParam->iStrideCur << iSubShift;
+
+	__m256i ymm_one = _mm256_set1_epi16(1);
+	__m256i ymm_sum = _mm256_setzero_si256();
+	__m256i ymm_abs;
+
+	for (; iRows != 0; iRows -= 4)		///< 4 Rows per Iteration
+	{
+		ymm_abs = _mm256_abs_epi16(_mm256_sub_epi16(ETRI_AVX2_LOAD4x64(piOrg, iStrideOrg), ETRI_AVX2_LOAD4x64(piCur, iStrideCur)));
+		ymm_sum = _mm256_add_epi32(ymm_sum, _mm256_madd_epi16(ymm_abs, ymm_one));
+
+		piOrg += iStrideOrg << 2;
+		piCur += iStrideCur << 2;
+	}
+
+	UInt uiSum;
+	ETRI_AVX2_HSUM32(ymm_sum, uiSum);
+	uiSum <<= iSubShift;
+	return uiSum >> DISTORTION_PRECISION_ADJUSTMENT(pcDtParam->bitDepth-8);
+}
+
+ETRI_TARGET_AVX2 UInt TComRdCost::xGetSAD8_AVX2( DistParam* pcDtParam )
+{
+	Int  iSubShift = pcDtParam->iSubShift;
+	Int  iRows     = pcDtParam->iRows >> iSubShift;
+
+	if (pcDtParam->bApplyWeight || (iRows & 0x01))
+	{
+		return xGetSAD8(pcDtParam);
+	}
+
+	Pel* piOrg = pcDtParam->pOrg;
+	Pel* piCur = pcDtParam->pCur;
+	Int  iStrideOrg = pcDtParam->iStrideOrg << iSubShift;
+	Int  iStrideCur = pcDtParam->iStrideCur << iSubShift;
+
+	__m256i ymm_one = _mm256_set1_epi16(1);
+	__m256i ymm_sum = _mm256_setzero_si256();
+	__m256i ymm_abs;
+
+	for (; iRows != 0; iRows -= 2)		///< 2 Rows per Iteration
+	{
+		ymm_abs = _mm256_abs_epi16(_mm256_sub_epi16(ETRI_AVX2_LOAD2x128(piOrg, iStrideOrg), ETRI_AVX2_LOAD2x128(piCur, iStrideCur)));
+		ymm_sum = _mm256_add_epi32(ymm_sum, _mm256_madd_epi16(ymm_abs, ymm_one));
+
+		piOrg += iStrideOrg << 1;
+		piCur += iStrideCur << 1;
+	}
+
+	UInt uiSum;
+	ETRI_AVX2_HSUM32(ymm_sum, uiSum);
+	uiSum <<= iSubShift;
+	return uiSum >> DISTORTION_PRECISION_ADJUSTMENT(pcDtParam->bitDepth-8);
+}
+
+ETRI_TARGET_AVX2 UInt TComRdCost::xGetSAD16_AVX2( DistParam* pcDtParam )
+{
+	if (pcDtParam->bApplyWeight)
+	{
+		return xGetSADw(pcDtParam);
+	}
+
+	Pel* piOrg = pcDtParam->pOrg;
+	Pel* piCur = pcDtParam->pCur;
+	Int  iRows = pcDtParam->iRows;
+	Int  iSubShift = pcDtParam->iSubShift;
+	Int  iSubStep = (1 << iSubShift);
+	Int  iStrideOrg = pcDtParam->iStrideOrg*iSubStep;
+	Int  iStrideCur = pcDtParam->iStrideCur*iSubStep;
+
+	__m256i ymm_one = _mm256_set1_epi16(1);
+	__m256i ymm_sum = _mm256_setzero_si256();
+	__m256i ymm_abs;
+
+	for (; iRows != 0; iRows -= iSubStep)
+	{
+		ymm_abs = _mm256_abs_epi16(_mm256_sub_epi16(_mm256_loadu_si256((__m256i const *)piOrg), _mm256_loadu_si256((__m256i const *)piCur)));
+		ymm_sum = _mm256_add_epi32(ymm_sum, _mm256_madd_epi16(ymm_abs, ymm_one));
+
+		piOrg += iStrideOrg;
+		piCur += iStrideCur;
+	}
+
+	UInt uiSum;
+	ETRI_AVX2_HSUM32(ymm_sum, uiSum);
+	uiSum <<= iSubShift;
+	return uiSum >> DISTORTION_PRECISION_ADJUSTMENT(pcDtParam->bitDepth-8);
+}
+
+ETRI_TARGET_AVX2 UInt TComRdCost::xGetSAD32_AVX2( DistParam* pcDtParam )
+{
+	if (pcDtParam->bApplyWeight)
+	{
+		return xGetSADw(pcDtParam);
+	}
+
+	Pel* piOrg = pcDtParam->pOrg;
+	Pel* piCur = pcDtParam->pCur;
+	Int  iRows = pcDtParam->iRows;
+	Int  iSubShift = pcDtParam->iSubShift;
+	Int  iSubStep = (1 << iSubShift);
+	Int  iStrideOrg = pcDtParam->iStrideOrg*iSubStep;
+	Int  iStrideCur = pcDtParam->iStrideCur*iSubStep;
+
+	__m256i ymm_one = _mm256_set1_epi16(1);
+	__m256i ymm_sum = _mm256_setzero_si256();
+	__m256i ymm_abs[2];
+
+	for (; iRows != 0; iRows -= iSubStep)
+	{
+		ymm_abs[0] = _mm256_abs_epi16(_mm256_sub_epi16(_mm256_loadu_si256((__m256i const *)piOrg), _mm256_loadu_si256((__m256i const *)piCur)));
+		ymm_abs[1] = _mm256_abs_epi16(_mm256_sub_epi16(_mm256_loadu_si256((__m256i const *)(piOrg + 16)), _mm256_loadu_si256((__m256i const *)(piCur + 16))));
+		ymm_sum = _mm256_add_epi32(ymm_sum, _mm256_madd_epi16(_mm256_add_epi16(ymm_abs[0], ymm_abs[1]), ymm_one));
+
+		piOrg += iStrideOrg;
+		piCur += iStrideCur;
+	}
+
+	UInt uiSum;
+	ETRI_AVX2_HSUM32(ymm_sum, uiSum);
+	uiSum <<= iSubShift;
+	return uiSum >> DISTORTION_PRECISION_ADJUSTMENT(pcDtParam->bitDepth-8);
+}
+
+ETRI_TARGET_AVX2 UInt TComRdCost::xGetSAD64_AVX2( DistParam* pcDtParam )
+{
+	if (pcDtParam->bApplyWeight)
+	{
+		return xGetSADw(pcDtParam);
+	}
+
+	Pel* piOrg = pcDtParam->pOrg;
+	Pel* piCur = pcDtParam->pCur;
+	Int  iRows = pcDtParam->iRows;
+	Int  iSubShift = pcDtParam->iSubShift;
+	Int  iSubStep = (1 << iSubShift);
+	Int  iStrideOrg = pcDtParam->iStrideOrg*iSubStep;
+	Int  iStrideCur = pcDtParam->iStrideCur*iSubStep;
+
+	__m256i ymm_one = _mm256_set1_epi16(1);
+	__m256i ymm_sum = _mm256_setzero_si256();
+	__m256i ymm_abs[4];
+
+	for (; iRows != 0; iRows -= iSubStep)
+	{
+		ymm_abs[0] = _mm256_abs_epi16(_mm256_sub_epi16(_mm256_loadu_si256((__m256i const *)piOrg), _mm256_loadu_si256((__m256i const *)piCur)));
+		ymm_abs[1] = _mm256_abs_epi16(_mm256_sub_epi16(_mm256_loadu_si256((__m256i const *)(piOrg + 16)), _mm256_loadu_si256((__m256i const *)(piCur + 16))));
+		ymm_abs[2] = _mm256_abs_epi16(_mm256_sub_epi16(_mm256_loadu_si256((__m256i const *)(piOrg + 32)), _mm256_loadu_si256((__m256i const *)(piCur + 32))));
+		ymm_abs[3] = _mm256_abs_epi16(_mm256_sub_epi16(_mm256_loadu_si256((__m256i const *)(piOrg + 48)), _mm256_loadu_si256((__m256i const *)(piCur + 48))));
+		ymm_abs[0] = _mm256_add_epi16(_mm256_add_epi16(ymm_abs[0], ymm_abs[1]), _mm256_add_epi16(ymm_abs[2], ymm_abs[3]));
+		ymm_sum = _mm256_add_epi32(ymm_sum, _mm256_madd_epi16(ymm_abs[0], ymm_one));
+
+		piOrg += iStrideOrg;
+		piCur += iStrideCur;
+	}
+
+	UInt uiSum;
+	ETRI_AVX2_HSUM32(ymm_sum, uiSum);
+	uiSum <<= iSubShift;
+	return uiSum >> DISTORTION_PRECISION_ADJUSTMENT(pcDtParam->bitDepth-8);
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// SSE (AVX2) : (Org - Cur)^2 is computed with _mm256_madd_epi16(diff, diff)
+// Weighted prediction and non-zero precision shift are processed by the SSE4.2 functions
+// --------------------------------------------------------------------------------------------------------------------
+#define	ETRI_AVX2_SSE_FALLBACK(pcDtParam, xFunc) \
+	if (pcDtParam->bApplyWeight || DISTORTION_PRECISION_ADJUSTMENT((pcDtParam->bitDepth-8) << 1)) \
+	{ \
+		return xFunc(pcDtParam); \
+	}
+
+ETRI_TARGET_AVX2 UInt TComRdCost::xGetSSE4_AVX2( DistParam* pcDtParam )
+{
+	ETRI_AVX2_SSE_FALLBACK(pcDtParam, xGetSSE4);
+	if (pcDtParam->iRows & 0x03)
+	{
+		return xGetSSE4(pcDtParam);
+	}
+
+	Pel* piOrg = pcDtParam->pOrg;
+	Pel* piCur = pcDtParam->pCur;
+	Int  iRows = pcDtParam->iRows;
+	Int  iStrideOrg = pcDtParam->iStrideOrg;
+	Int  iStrideCur = pcDtParam->iStrideCur;
+
+	__m256i ymm_sum = _mm256_setzero_si256();
+	__m256i ymm_diff;
+
+	for (; iRows != 0; iRows -= 4)
+	{
+		ymm_diff = _mm256_sub_epi16(ETRI_AVX2_LOAD4x64(piOrg, iStrideOrg), ETRI_AVX2_LOAD4x64(piCur, iStrideCur));
+		ymm_sum  = _mm256_add_epi32(ymm_sum, _mm256_madd_epi16(ymm_diff, ymm_diff));
+
+		piOrg += iStrideOrg << 2;
+		piCur += iStrideCur << 2;
+	}
+
+	UInt uiSum;
+	ETRI_AVX2_HSUM32(ymm_sum, uiSum);
+	return uiSum;
+}
+
+ETRI_TARGET_AVX2 UInt TComRdCost::xGetSSE8_AVX2( DistParam* pcDtParam )
+{
+	ETRI_AVX2_SSE_FALLBACK(pcDtParam, xGetSSE8);
+	if (pcDtParam->iRows & 0x01)
+	{
+		return xGetSSE8(pcDtParam);
+	}
+
+	Pel* piOrg = pcDtParam->pOrg;
+	Pel* piCur = pcDtParam->pCur;
+	Int  iRows = pcDtParam->iRows;
+	Int  iStrideOrg = pcDtParam->iStrideOrg;
+	Int  iStrideCur = pcDtParam->iStrideCur;
+
+	__m256i ymm_sum = _mm256_setzero_si256();
+	__m256i ymm_diff;
+
+	for (; iRows != 0; iRows -= 2)
+	{
+		ymm_diff = _mm256_sub_epi16(ETRI_AVX2_LOAD2x128(piOrg, iStrideOrg), ETRI_AVX2_LOAD2x128(piCur, iStrideCur));
+		ymm_sum  = _mm256_add_epi32(ymm_sum, _mm256_madd_epi16(ymm_diff, ymm_diff));
+
+		piOrg += iStrideOrg << 1;
+		piCur += iStrideCur << 1;
+	}
+
+	UInt uiSum;
+	ETRI_AVX2_HSUM32(ymm_sum, uiSum);
+	return uiSum;
+}
+
+ETRI_TARGET_AVX2 UInt TComRdCost::xGetSSE16_AVX2( DistParam* pcDtParam )
+{
+	ETRI_AVX2_SSE_FALLBACK(pcDtParam, xGetSSE16);
+
+	Pel* piOrg = pcDtParam->pOrg;
+	Pel* piCur = pcDtParam->pCur;
+	Int  iRows = pcDtParam->iRows;
+	Int  iStrideOrg = pcDtParam->iStrideOrg;
+	Int  iStrideCur = pcDtParam->iStrideCur;
+
+	__m256i ymm_sum = _mm256_setzero_si256();
+	__m256i ymm_diff;
+
+	for (; iRows != 0; iRows--)
+	{
+		ymm_diff = _mm256_sub_epi16(_mm256_loadu_si256((__m256i const *)piOrg), _mm256_loadu_si256((__m256i const *)piCur));
+		ymm_sum  = _mm256_add_epi32(ymm_sum, _mm256_madd_epi16(ymm_diff, ymm_diff));
+
+		piOrg += iStrideOrg;
+		piCur += iStrideCur;
+	}
+
+	UInt uiSum;
+	ETRI_AVX2_HSUM32(ymm_sum, uiSum);
+	return uiSum;
+}
+
+ETRI_TARGET_AVX2 UInt TComRdCost::xGetSSE32_AVX2( DistParam* pcDtParam )
+{
+	ETRI_AVX2_SSE_FALLBACK(pcDtParam, xGetSSE32);
+
+	Pel* piOrg = pcDtParam->pOrg;
+	Pel* piCur = pcDtParam->pCur;
+	Int  iRows = pcDtParam->iRows;
+	Int  iStrideOrg = pcDtParam->iStrideOrg;
+	Int  iStrideCur = pcDtParam->iStrideCur;
+
+	__m256i ymm_sum = _mm256_setzero_si256();
+	__m256i ymm_diff[2];
+
+	for (; iRows != 0; iRows--)
+	{
+		ymm_diff[0] = _mm256_sub_epi16(_mm256_loadu_si256((__m256i const *)piOrg), _mm256_loadu_si256((__m256i const *)piCur));
+		ymm_diff[1] = _mm256_sub_epi16(_mm256_loadu_si256((__m256i const *)(piOrg + 16)), _mm256_loadu_si256((__m256i const *)(piCur + 16)));
+		ymm_sum = _mm256_add_epi32(ymm_sum, _mm256_madd_epi16(ymm_diff[0], ymm_diff[0]));
+		ymm_sum = _mm256_add_epi32(ymm_sum, _mm256_madd_epi16(ymm_diff[1], ymm_diff[1]));
+
+		piOrg += iStrideOrg;
+		piCur += iStrideCur;
+	}
+
+	UInt uiSum;
+	ETRI_AVX2_HSUM32(ymm_sum, uiSum);
+	return uiSum;
+}
+
+ETRI_TARGET_AVX2 UInt TComRdCost::xGetSSE64_AVX2( DistParam* pcDtParam )
+{
+	ETRI_AVX2_SSE_FALLBACK(pcDtParam, xGetSSE64);
+
+	Pel* piOrg = pcDtParam->pOrg;
+	Pel* piCur = pcDtParam->pCur;
+	Int  iRows = pcDtParam->iRows;
+	Int  iStrideOrg = pcDtParam->iStrideOrg;
+	Int  iStrideCur = pcDtParam->iStrideCur;
+
+	__m256i ymm_sum = _mm256_setzero_si256();
+	__m256i ymm_diff[4];
+
+	for (; iRows != 0; iRows--)
+	{
+		ymm_diff[0] = _mm256_sub_epi16(_mm256_loadu_si256((__m256i const *)piOrg), _mm256_loadu_si256((__m256i const *)piCur));
+		ymm_diff[1] = _mm256_sub_epi16(_mm256_loadu_si256((__m256i const *)(piOrg + 16)), _mm256_loadu_si256((__m256i const *)(piCur + 16)));
+		ymm_diff[2] = _mm256_sub_epi16(_mm256_loadu_si256((__m256i const *)(piOrg + 32)), _mm256_loadu_si256((__m256i const *)(piCur + 32)));
+		ymm_diff[3] = _mm256_sub_epi16(_mm256_loadu_si256((__m256i const *)(piOrg + 48)), _mm256_loadu_si256((__m256i const *)(piCur + 48)));
+		ymm_sum = _mm256_add_epi32(ymm_sum, _mm256_madd_epi16(ymm_diff[0], ymm_diff[0]));
+		ymm_sum = _mm256_add_epi32(ymm_sum, _mm256_madd_epi16(ymm_diff[1], ymm_diff[1]));
+		ymm_sum = _mm256_add_epi32(ymm_sum, _mm256_madd_epi16(ymm_diff[2], ymm_diff[2]));
+		ymm_sum = _mm256_add_epi32(ymm_sum, _mm256_madd_epi16(ymm_diff[3], ymm_diff[3]));
+
+		piOrg += iStrideOrg;
+		piCur += iStrideCur;
+	}
+
+	UInt uiSum;
+	ETRI_AVX2_HSUM32(ymm_sum, uiSum);
+	return uiSum;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// HADAMARD (AVX2) : Two horizontally adjacent 8x8 blocks are transformed at once (one 8x8 block per 128bit lane).
+// Vertical 8-point butterflies -> in-lane transpose -> horizontal butterflies. The last stage is done in 32bit by
+// _mm256_madd_epi16, the same as the SSE4.2 xCalcHADs8x8. SATD and DC are rounded per 8x8 block.
+// --------------------------------------------------------------------------------------------------------------------
+#define	ETRI_AVX2_BUTTERFLY8_EPI16(ymm, tmm) \
+	tmm[0] = _mm256_add_epi16(ymm[0], ymm[4]);	tmm[4] = _mm256_sub_epi16(ymm[0], ymm[4]); \
+	tmm[1] = _mm256_add_epi16(ymm[1], ymm[5]);	tmm[5] = _mm256_sub_epi16(ymm[1], ymm[5]); \
+	tmm[2] = _mm256_add_epi16(ymm[2], ymm[6]);	tmm[6] = _mm256_sub_epi16(ymm[2], ymm[6]); \
+	tmm[3] = _mm256_add_epi16(ymm[3], ymm[7]);	tmm[7] = _mm256_sub_epi16(ymm[3], ymm[7]); \
+	ymm[0] = _mm256_add_epi16(tmm[0], tmm[2]);	ymm[2] = _mm256_sub_epi16(tmm[0], tmm[2]); \
+	ymm[1] = _mm256_add_epi16(tmm[1], tmm[3]);	ymm[3] = _mm256_sub_epi16(tmm[1], tmm[3]); \
+	ymm[4] = _mm256_add_epi16(tmm[4], tmm[6]);	ymm[6] = _mm256_sub_epi16(tmm[4], tmm[6]); \
+	ymm[5] = _mm256_add_epi16(tmm[5], tmm[7]);	ymm[7] = _mm256_sub_epi16(tmm[5], tmm[7]);
+
+ETRI_TARGET_AVX2 UInt TComRdCost::xCalcHADs16x8_AVX2( Pel *piOrg, Pel *piCur, Int iStrideOrg, Int iStrideCur, UInt& uiDCValue )
+{
+	__m256i ymm[8], tmm[8];
+	Int k;
+
+	for (k = 0; k < 8; k++)
+	{
+		ymm[k] = _mm256_sub_epi16(_mm256_loadu_si256((__m256i const *)(piOrg + k*iStrideOrg)), _mm256_loadu_si256((__m256i const *)(piCur + k*iStrideCur)));
+	}
+
+	//------------- Vertical Stage 1, 2 (16bit) and 3 (16bit) ----------
+	ETRI_AVX2_BUTTERFLY8_EPI16(ymm, tmm);
+	tmm[0] = _mm256_add_epi16(ymm[0], ymm[1]);	tmm[1] = _mm256_sub_epi16(ymm[0], ymm[1]);
+	tmm[2] = _mm256_add_epi16(ymm[2], ymm[3]);	tmm[3] = _mm256_sub_epi16(ymm[2], ymm[3]);
+	tmm[4] = _mm256_add_epi16(ymm[4], ymm[5]);	tmm[5] = _mm256_sub_epi16(ymm[4], ymm[5]);
+	tmm[6] = _mm256_add_epi16(ymm[6], ymm[7]);	tmm[7] = _mm256_sub_epi16(ymm[6], ymm[7]);
+
+	//------------- Transpose 8x8 in each 128bit Lane ----------
+	ymm[0] = _mm256_unpacklo_epi16(tmm[0], tmm[1]);	ymm[1] = _mm256_unpackhi_epi16(tmm[0], tmm[1]);
+	ymm[2] = _mm256_unpacklo_epi16(tmm[2], tmm[3]);	ymm[3] = _mm256_unpackhi_epi16(tmm[2], tmm[3]);
+	ymm[4] = _mm256_unpacklo_epi16(tmm[4], tmm[5]);	ymm[5] = _mm256_unpackhi_epi16(tmm[4], tmm[5]);
+	ymm[6] = _mm256_unpacklo_epi16(tmm[6], tmm[7]);	ymm[7] = _mm256_unpackhi_epi16(tmm[6], tmm[7]);
+
+	tmm[0] = _mm256_unpacklo_epi32(ymm[0], ymm[2]);	tmm[1] = _mm256_unpackhi_epi32(ymm[0], ymm[2]);
+	tmm[2] = _mm256_unpacklo_epi32(ymm[1], ymm[3]);	tmm[3] = _mm256_unpackhi_epi32(ymm[1], ymm[3]);
+	tmm[4] = _mm256_unpacklo_epi32(ymm[4], ymm[6]);	tmm[5] = _mm256_unpackhi_epi32(ymm[4], ymm[6]);
+	tmm[6] = _mm256_unpacklo_epi32(ymm[5], ymm[7]);	tmm[7] = _mm256_unpackhi_epi32(ymm[5], ymm[7]);
+
+	ymm[0] = _mm256_unpacklo_epi64(tmm[0], tmm[4]);	ymm[1] = _mm256_unpackhi_epi64(tmm[0], tmm[4]);
+	ymm[2] = _mm256_unpacklo_epi64(tmm[1], tmm[5]);	ymm[3] = _mm256_unpackhi_epi64(tmm[1], tmm[5]);
+	ymm[4] = _mm256_unpacklo_epi64(tmm[2], tmm[6]);	ymm[5] = _mm256_unpackhi_epi64(tmm[2], tmm[6]);
+	ymm[6] = _mm256_unpacklo_epi64(tmm[3], tmm[7]);	ymm[7] = _mm256_unpackhi_epi64(tmm[3], tmm[7]);
+
+	//------------- Horizontal Stage 1, 2 (16bit) ----------
+	ETRI_AVX2_BUTTERFLY8_EPI16(ymm, tmm);
+
+	//------------- Horizontal Stage 3 (32bit) and Sum of Absolute Coefficients ----------
+	__m256i pmm = _mm256_set1_epi16(1);
+	__m256i Mmm = _mm256_set1_epi32(0xFFFF0001);	///< {1, -1, 1, -1, ...}
+	__m256i smm = _mm256_setzero_si256();
+	__m256i dmm = _mm256_setzero_si256();
+
+	for (k = 0; k < 8; k += 2)
+	{
+		tmm[0] = _mm256_unpacklo_epi16(ymm[k], ymm[k+1]);
+		tmm[1] = _mm256_unpackhi_epi16(ymm[k], ymm[k+1]);
+
+		tmm[2] = _mm256_abs_epi32(_mm256_madd_epi16(tmm[0], pmm));
+		if (k == 0) {dmm = tmm[2];}
+
+		smm = _mm256_add_epi32(smm, tmm[2]);
+		smm = _mm256_add_epi32(smm, _mm256_abs_epi32(_mm256_madd_epi16(tmm[1], pmm)));
+		smm = _mm256_add_epi32(smm, _mm256_abs_epi32(_mm256_madd_epi16(tmm[0], Mmm)));
+		smm = _mm256_add_epi32(smm, _mm256_abs_epi32(_mm256_madd_epi16(tmm[1], Mmm)));
+	}
+
+	smm = _mm256_hadd_epi32(smm, smm);
+	smm = _mm256_hadd_epi32(smm, smm);
+
+	uiDCValue  = ((UInt)_mm256_extract_epi32(dmm, 0) + 2) >> 2;
+	uiDCValue += ((UInt)_mm256_extract_epi32(dmm, 4) + 2) >> 2;
+
+	return (((UInt)_mm256_extract_epi32(smm, 0) + 2) >> 2) + (((UInt)_mm256_extract_epi32(smm, 4) + 2) >> 2);
+}
+
+ETRI_TARGET_AVX2 UInt TComRdCost::xGetHADs_AVX2( DistParam* pcDtParam )
+{
+	if (pcDtParam->bApplyWeight || pcDtParam->iStep != 1 || (pcDtParam->iCols & 0x0F) || (pcDtParam->iRows & 0x07))
+	{
+		return xGetHADs(pcDtParam);
+	}
+
+	Pel* piOrg   = pcDtParam->pOrg;
+	Pel* piCur   = pcDtParam->pCur;
+	Int  iRows   = pcDtParam->iRows;
+	Int  iCols   = pcDtParam->iCols;
+	Int  iStrideOrg = pcDtParam->iStrideOrg;
+	Int  iStrideCur = pcDtParam->iStrideCur;
+	Int  iOffsetOrg = iStrideOrg << 3;
+	Int  iOffsetCur = iStrideCur << 3;
+	Int  x, y;
+
+	UInt uiHADDC = 0, uiSumHADDC = 0;
+	UInt uiSum = 0;
+
+	for (y = 0; y < iRows; y += 8)
+	{
+		for (x = 0; x < iCols; x += 16)
+		{
+			uiSum += xCalcHADs16x8_AVX2(&piOrg[x], &piCur[x], iStrideOrg, iStrideCur, uiHADDC);	uiSumHADDC += uiHADDC;
+		}
+		piOrg += iOffsetOrg;
+		piCur += iOffsetCur;
+	}
+
+	pcDtParam->e_uiHADDC = uiSumHADDC;
+	return uiSum >> DISTORTION_PRECISION_ADJUSTMENT(pcDtParam->bitDepth-8);
+}
+
+#endif	// #if ETRI_SIMD_AVX2
+
+
 //! \}
@@ -155,6 +155,9 @@ private:
    UInt**	em_tmm;   // 9x8 Positions for SAD-ME : [ETRI_VER_nSAD][ETRI_HOR_nSAD]
    UInt**	em_smm;   // 9x8 Positions for SAD-ME : [3][ETRI_HOR_nSAD]
 #endif
+#if ETRI_SIMD_AVX2
+   Bool 	em_bUseAVX2;	///< AVX2 Distortion Functions are registered in init() (calcHAD uses it directly)
+#endif
 //======================================================================================
 
 public:
@@ -290,7 +293,24 @@ private:
   static UInt ETRI_GetSAD32		( DistParam* pcDtParam );
   static UInt ETRI_GetSAD64		( DistParam* pcDtParam );
 #endif
-  
+
+#if ETRI_SIMD_AVX2
+  static UInt xGetSAD4_AVX2     ( DistParam* pcDtParam );
+  static UInt xGetSAD8_AVX2     ( DistParam* pcDtParam );
+  static UInt xGetSAD16_AVX2    ( DistParam* pcDtParam );
+  static UInt xGetSAD32_AVX2    ( DistParam* pcDtParam );
+  static UInt xGetSAD64_AVX2    ( DistParam* pcDtParam );
+
+  static UInt xGetSSE4_AVX2     ( DistParam* pcDtParam );
+  static UInt xGetSSE8_AVX2     ( DistParam* pcDtParam );
+  static UInt xGetSSE16_AVX2    ( DistParam* pcDtParam );
+  static UInt xGetSSE32_AVX2    ( DistParam* pcDtParam );
+  static UInt xGetSSE64_AVX2    ( DistParam* pcDtParam );
+
+  static UInt xGetHADs_AVX2     ( DistParam* pcDtParam );
+  static UInt xCalcHADs16x8_AVX2( Pel *piOrg, Pel *piCur, Int iStrideOrg, Int iStrideCur, UInt& uiDCValue );
+#endif
+
 public:
   UInt   getDistPart(Int bitDepth, Pel* piCur, Int iCurStride,  Pel* piOrg, Int iOrgStride, UInt uiBlkWidth, UInt uiBlkHeight, TextType eText = TEXT_LUMA, DFunc eDFunc = DF_SSE );
 
@@ -7,6 +7,8 @@
 #include <windows.h>
 #else
 #include <pthread.h>
+#include <stdio.h>
+#include <errno.h>
 #endif
 
 //! \ingroup TLibEncoder
@@ -80,20 +80,14 @@ QpParam::QpParam()
 #define ALIGN_VAR_16(T, var) ALIGNED(16) T var
 #define ALIGN_VAR_32(T, var) ALIGNED(32) T var
 
-#define SHIFT_32T_1ST  6
-#define ADD_32T_1      32
 #define SHIFT_32T_2ND  11
 #define ADD_32T_2      1024
 
-#define SHIFT_16T_1ST  5
-#define ADD_16T_1      16
 #define SHIFT_16T_2ND  10
 #define ADD_16T_2      512
 
 #define SHIFT_IT_1ST 7
 #define ADD_IT_1     64
-#define SHIFT_IT_2ND 10
-#define ADD_IT_2     512
 
 const Short g_aiIT4[4][4] =
 {
@@ -4576,10 +4570,10 @@ static void DCT8(short* plCoeff, Pel* pResidual, UInt uiDstStride, UInt uiSrcStr
         plCoeff += uiDstStride;
     }
 }
-static void DCT16(const short *src, short *dst, UInt stride)
+static void DCT16(const short *src, short *dst, UInt stride, Int shift)
 {
     // Const
-    __m128i c_4 = _mm_set1_epi32(ADD_16T_1);
+    __m128i c_4 = _mm_set1_epi32(1 << (shift - 1));
     __m128i c_512 = _mm_set1_epi32(ADD_16T_2);
 
     int i;
@@ -4669,29 +4663,29 @@ static void DCT16(const short *src, short *dst, UInt stride)
 
         T60 = _mm_madd_epi16(T50, _mm_load_si128((__m128i*)tab_dct_8[1]));
         T61 = _mm_madd_epi16(T51, _mm_load_si128((__m128i*)tab_dct_8[1]));
-        T60 = _mm_srai_epi32(_mm_add_epi32(T60, c_4), SHIFT_16T_1ST);
-        T61 = _mm_srai_epi32(_mm_add_epi32(T61, c_4), SHIFT_16T_1ST);
+        T60 = _mm_srai_epi32(_mm_add_epi32(T60, c_4), shift);
+        T61 = _mm_srai_epi32(_mm_add_epi32(T61, c_4), shift);
         T70 = _mm_packs_epi32(T60, T61);
         _mm_store_si128((__m128i*)&tmp[0 * 16 + i], T70);
 
         T60 = _mm_madd_epi16(T50, _mm_load_si128((__m128i*)tab_dct_8[2]));
         T61 = _mm_madd_epi16(T51, _mm_load_si128((__m128i*)tab_dct_8[2]));
-        T60 = _mm_srai_epi32(_mm_add_epi32(T60, c_4), SHIFT_16T_1ST);
-        T61 = _mm_srai_epi32(_mm_add_epi32(T61, c_4), SHIFT_16T_1ST);
+        T60 = _mm_srai_epi32(_mm_add_epi32(T60, c_4), shift);
+        T61 = _mm_srai_epi32(_mm_add_epi32(T61, c_4), shift);
         T70 = _mm_packs_epi32(T60, T61);
         _mm_store_si128((__m128i*)&tmp[8 * 16 + i], T70);
 
         T60 = _mm_madd_epi16(T52, _mm_load_si128((__m128i*)tab_dct_8[3]));
         T61 = _mm_madd_epi16(T53, _mm_load_si128((__m128i*)tab_dct_8[3]));
-        T60 = _mm_srai_epi32(_mm_add_epi32(T60, c_4), SHIFT_16T_1ST);
-        T61 = _mm_srai_epi32(_mm_add_epi32(T61, c_4), SHIFT_16T_1ST);
+        T60 = _mm_srai_epi32(_mm_add_epi32(T60, c_4), shift);
+        T61 = _mm_srai_epi32(_mm_add_epi32(T61, c_4), shift);
         T70 = _mm_packs_epi32(T60, T61);
         _mm_store_si128((__m128i*)&tmp[4 * 16 + i], T70);
 
         T60 = _mm_madd_epi16(T52, _mm_load_si128((__m128i*)tab_dct_8[4]));
         T61 = _mm_madd_epi16(T53, _mm_load_si128((__m128i*)tab_dct_8[4]));
-        T60 = _mm_srai_epi32(_mm_add_epi32(T60, c_4), SHIFT_16T_1ST);
-        T61 = _mm_srai_epi32(_mm_add_epi32(T61, c_4), SHIFT_16T_1ST);
+        T60 = _mm_srai_epi32(_mm_add_epi32(T60, c_4), shift);
+        T61 = _mm_srai_epi32(_mm_add_epi32(T61, c_4), shift);
         T70 = _mm_packs_epi32(T60, T61);
         _mm_store_si128((__m128i*)&tmp[12 * 16 + i], T70);
 
@@ -4701,8 +4695,8 @@ static void DCT16(const short *src, short *dst, UInt stride)
         T63 = _mm_madd_epi16(T47, _mm_load_si128((__m128i*)tab_dct_8[5]));
         T60 = _mm_hadd_epi32(T60, T61);
         T61 = _mm_hadd_epi32(T62, T63);
-        T60 = _mm_srai_epi32(_mm_add_epi32(T60, c_4), SHIFT_16T_1ST);
-        T61 = _mm_srai_epi32(_mm_add_epi32(T61, c_4), SHIFT_16T_1ST);
+        T60 = _mm_srai_epi32(_mm_add_epi32(T60, c_4), shift);
+        T61 = _mm_srai_epi32(_mm_add_epi32(T61, c_4), shift);
         T70 = _mm_packs_epi32(T60, T61);
         _mm_store_si128((__m128i*)&tmp[2 * 16 + i], T70);
 
@@ -4712,8 +4706,8 @@ static void DCT16(const short *src, short *dst, UInt stride)
         T63 = _mm_madd_epi16(T47, _mm_load_si128((__m128i*)tab_dct_8[6]));
         T60 = _mm_hadd_epi32(T60, T61);
         T61 = _mm_hadd_epi32(T62, T63);
-        T60 = _mm_srai_epi32(_mm_add_epi32(T60, c_4), SHIFT_16T_1ST);
-        T61 = _mm_srai_epi32(_mm_add_epi32(T61, c_4), SHIFT_16T_1ST);
+        T60 = _mm_srai_epi32(_mm_add_epi32(T60, c_4), shift);
+        T61 = _mm_srai_epi32(_mm_add_epi32(T61, c_4), shift);
         T70 = _mm_packs_epi32(T60, T61);
         _mm_store_si128((__m128i*)&tmp[6 * 16 + i], T70);
 
@@ -4723,8 +4717,8 @@ static void DCT16(const short *src, short *dst, UInt stride)
         T63 = _mm_madd_epi16(T47, _mm_load_si128((__m128i*)tab_dct_8[7]));
         T60 = _mm_hadd_epi32(T60, T61);
         T61 = _mm_hadd_epi32(T62, T63);
-        T60 = _mm_srai_epi32(_mm_add_epi32(T60, c_4), SHIFT_16T_1ST);
-        T61 = _mm_srai_epi32(_mm_add_epi32(T61, c_4), SHIFT_16T_1ST);
+        T60 = _mm_srai_epi32(_mm_add_epi32(T60, c_4), shift);
+        T61 = _mm_srai_epi32(_mm_add_epi32(T61, c_4), shift);
         T70 = _mm_packs_epi32(T60, T61);
         _mm_store_si128((__m128i*)&tmp[10 * 16 + i], T70);
 
@@ -4734,8 +4728,8 @@ static void DCT16(const short *src, short *dst, UInt stride)
         T63 = _mm_madd_epi16(T47, _mm_load_si128((__m128i*)tab_dct_8[8]));
         T60 = _mm_hadd_epi32(T60, T61);
         T61 = _mm_hadd_epi32(T62, T63);
-        T60 = _mm_srai_epi32(_mm_add_epi32(T60, c_4), SHIFT_16T_1ST);
-        T61 = _mm_srai_epi32(_mm_add_epi32(T61, c_4), SHIFT_16T_1ST);
+        T60 = _mm_srai_epi32(_mm_add_epi32(T60, c_4), shift);
+        T61 = _mm_srai_epi32(_mm_add_epi32(T61, c_4), shift);
         T70 = _mm_packs_epi32(T60, T61);
         _mm_store_si128((__m128i*)&tmp[14 * 16 + i], T70);
 
@@ -4754,8 +4748,8 @@ static void DCT16(const short *src, short *dst, UInt stride)
   T63  = _mm_hadd_epi32(T66, T67); \
   T60  = _mm_hadd_epi32(T60, T61); \
   T61  = _mm_hadd_epi32(T62, T63); \
-  T60  = _mm_srai_epi32(_mm_add_epi32(T60, c_4), SHIFT_16T_1ST); \
-  T61  = _mm_srai_epi32(_mm_add_epi32(T61, c_4), SHIFT_16T_1ST); \
+  T60  = _mm_srai_epi32(_mm_add_epi32(T60, c_4), shift); \
+  T61  = _mm_srai_epi32(_mm_add_epi32(T61, c_4), shift); \
   T70  = _mm_packs_epi32(T60, T61); \
   _mm_store_si128((__m128i*)&tmp[(dstPos) * 16 + i], T70);
 
@@ -4992,11 +4986,11 @@ static void DCT16(const short *src, short *dst, UInt stride)
 #undef MAKE_ODD
     }
 }
-static void DCT32(const short *src, short *dst, UInt stride)
+static void DCT32(const short *src, short *dst, UInt stride, Int shift)
 {
 
     // Const
-    __m128i c_8 = _mm_set1_epi32(ADD_32T_1);
+    __m128i c_8 = _mm_set1_epi32(1 << (shift - 1));
     __m128i c_1024 = _mm_set1_epi32(ADD_32T_2);
 
     int i;
@@ -5142,15 +5136,15 @@ static void DCT32(const short *src, short *dst, UInt stride)
 
         T50 = _mm_hadd_epi32(T40, T41);
         T51 = _mm_hadd_epi32(T42, T43);
-        T50 = _mm_srai_epi32(_mm_add_epi32(T50, c_8), SHIFT_32T_1ST);
-        T51 = _mm_srai_epi32(_mm_add_epi32(T51, c_8), SHIFT_32T_1ST);
+        T50 = _mm_srai_epi32(_mm_add_epi32(T50, c_8), shift);
+        T51 = _mm_srai_epi32(_mm_add_epi32(T51, c_8), shift);
         T60 = _mm_packs_epi32(T50, T51);
         im[0][i] = T60;
 
         T50 = _mm_hsub_epi32(T40, T41);
         T51 = _mm_hsub_epi32(T42, T43);
-        T50 = _mm_srai_epi32(_mm_add_epi32(T50, c_8), SHIFT_32T_1ST);
-        T51 = _mm_srai_epi32(_mm_add_epi32(T51, c_8), SHIFT_32T_1ST);
+        T50 = _mm_srai_epi32(_mm_add_epi32(T50, c_8), shift);
+        T51 = _mm_srai_epi32(_mm_add_epi32(T51, c_8), shift);
         T60 = _mm_packs_epi32(T50, T51);
         im[16][i] = T60;
 
@@ -5170,8 +5164,8 @@ static void DCT32(const short *src, short *dst, UInt stride)
 
         T50 = _mm_hadd_epi32(T40, T41);
         T51 = _mm_hadd_epi32(T42, T43);
-        T50 = _mm_srai_epi32(_mm_add_epi32(T50, c_8), SHIFT_32T_1ST);
-        T51 = _mm_srai_epi32(_mm_add_epi32(T51, c_8), SHIFT_32T_1ST);
+        T50 = _mm_srai_epi32(_mm_add_epi32(T50, c_8), shift);
+        T51 = _mm_srai_epi32(_mm_add_epi32(T51, c_8), shift);
         T60 = _mm_packs_epi32(T50, T51);
         im[8][i] = T60;
 
@@ -5191,8 +5185,8 @@ static void DCT32(const short *src, short *dst, UInt stride)
 
         T50 = _mm_hadd_epi32(T40, T41);
         T51 = _mm_hadd_epi32(T42, T43);
-        T50 = _mm_srai_epi32(_mm_add_epi32(T50, c_8), SHIFT_32T_1ST);
-        T51 = _mm_srai_epi32(_mm_add_epi32(T51, c_8), SHIFT_32T_1ST);
+        T50 = _mm_srai_epi32(_mm_add_epi32(T50, c_8), shift);
+        T51 = _mm_srai_epi32(_mm_add_epi32(T51, c_8), shift);
         T60 = _mm_packs_epi32(T50, T51);
         im[24][i] = T60;
 
@@ -5213,8 +5207,8 @@ static void DCT32(const short *src, short *dst, UInt stride)
   \
   T50  = _mm_hadd_epi32(T40, T41); \
   T51  = _mm_hadd_epi32(T42, T43); \
-  T50  = _mm_srai_epi32(_mm_add_epi32(T50, c_8), SHIFT_32T_1ST); \
-  T51  = _mm_srai_epi32(_mm_add_epi32(T51, c_8), SHIFT_32T_1ST); \
+  T50  = _mm_srai_epi32(_mm_add_epi32(T50, c_8), shift); \
+  T51  = _mm_srai_epi32(_mm_add_epi32(T51, c_8), shift); \
   T60  = _mm_packs_epi32(T50, T51); \
   im[(dstPos)][i] = T60;
 
@@ -5276,8 +5270,8 @@ static void DCT32(const short *src, short *dst, UInt stride)
   \
   T50  = _mm_hadd_epi32(T50, T51); \
   T51  = _mm_hadd_epi32(T52, T53); \
-  T50  = _mm_srai_epi32(_mm_add_epi32(T50, c_8), SHIFT_32T_1ST); \
-  T51  = _mm_srai_epi32(_mm_add_epi32(T51, c_8), SHIFT_32T_1ST); \
+  T50  = _mm_srai_epi32(_mm_add_epi32(T50, c_8), shift); \
+  T51  = _mm_srai_epi32(_mm_add_epi32(T51, c_8), shift); \
   T60  = _mm_packs_epi32(T50, T51); \
   im[(dstPos)][i] = T60;
 
@@ -5596,7 +5590,7 @@ static void IDST4(Pel* pResidual, Short* plCoeff, UInt uiDstStride, UInt uiSrcSt
     _mm_storel_epi64((__m128i*)(pResidual + uiDstStride * 3), xmm_t[1]);
 #endif 
 }
-static void IDCT8(const int16_t* src, int16_t* dst, intptr_t stride)
+static void IDCT8(const int16_t* src, int16_t* dst, intptr_t stride, Int shift)
 {
     __m128i m128iS0, m128iS1, m128iS2, m128iS3, m128iS4, m128iS5, m128iS6, m128iS7, m128iAdd, m128Tmp0, m128Tmp1, m128Tmp2, m128Tmp3, E0h, E1h, E2h, E3h, E0l, E1l, E2l, E3l, O0h, O1h, O2h, O3h, O0l, O1l, O2l, O3l, EE0l, EE1l, E00l, E01l, EE0h, EE1h, E00h, E01h;
     __m128i T00, T01, T02, T03, T04, T05, T06, T07;
@@ -5715,7 +5709,7 @@ static void IDCT8(const int16_t* src, int16_t* dst, intptr_t stride)
     m128iS6 = _mm_unpacklo_epi16(m128Tmp2, m128Tmp3);
     m128iS7 = _mm_unpackhi_epi16(m128Tmp2, m128Tmp3);
 
-    m128iAdd = _mm_set1_epi32(ADD_IT_2);
+    m128iAdd = _mm_set1_epi32(1 << (shift - 1));
 
     m128Tmp0 = _mm_unpacklo_epi16(m128iS1, m128iS3);
     E1l = _mm_madd_epi16(m128Tmp0, _mm_load_si128((__m128i*)(tab_idct_8x8[0])));
@@ -5776,14 +5770,14 @@ static void IDCT8(const int16_t* src, int16_t* dst, intptr_t stride)
     E2h = _mm_sub_epi32(EE1h, E01h);
     E2h = _mm_add_epi32(E2h, m128iAdd);
 
-    m128iS0 = _mm_packs_epi32(_mm_srai_epi32(_mm_add_epi32(E0l, O0l), SHIFT_IT_2ND), _mm_srai_epi32(_mm_add_epi32(E0h, O0h), SHIFT_IT_2ND));
-    m128iS1 = _mm_packs_epi32(_mm_srai_epi32(_mm_add_epi32(E1l, O1l), SHIFT_IT_2ND), _mm_srai_epi32(_mm_add_epi32(E1h, O1h), SHIFT_IT_2ND));
-    m128iS2 = _mm_packs_epi32(_mm_srai_epi32(_mm_add_epi32(E2l, O2l), SHIFT_IT_2ND), _mm_srai_epi32(_mm_add_epi32(E2h, O2h), SHIFT_IT_2ND));
-    m128iS3 = _mm_packs_epi32(_mm_srai_epi32(_mm_add_epi32(E3l, O3l), SHIFT_IT_2ND), _mm_srai_epi32(_mm_add_epi32(E3h, O3h), SHIFT_IT_2ND));
-    m128iS4 = _mm_packs_epi32(_mm_srai_epi32(_mm_sub_epi32(E3l, O3l), SHIFT_IT_2ND), _mm_srai_epi32(_mm_sub_epi32(E3h, O3h), SHIFT_IT_2ND));
-    m128iS5 = _mm_packs_epi32(_mm_srai_epi32(_mm_sub_epi32(E2l, O2l), SHIFT_IT_2ND), _mm_srai_epi32(_mm_sub_epi32(E2h, O2h), SHIFT_IT_2ND));
-    m128iS6 = _mm_packs_epi32(_mm_srai_epi32(_mm_sub_epi32(E1l, O1l), SHIFT_IT_2ND), _mm_srai_epi32(_mm_sub_epi32(E1h, O1h), SHIFT_IT_2ND));
-    m128iS7 = _mm_packs_epi32(_mm_srai_epi32(_mm_sub_epi32(E0l, O0l), SHIFT_IT_2ND), _mm_srai_epi32(_mm_sub_epi32(E0h, O0h), SHIFT_IT_2ND));
+    m128iS0 = _mm_packs_epi32(_mm_srai_epi32(_mm_add_epi32(E0l, O0l), shift), _mm_srai_epi32(_mm_add_epi32(E0h, O0h), shift));
+    m128iS1 = _mm_packs_epi32(_mm_srai_epi32(_mm_add_epi32(E1l, O1l), shift), _mm_srai_epi32(_mm_add_epi32(E1h, O1h), shift));
+    m128iS2 = _mm_packs_epi32(_mm_srai_epi32(_mm_add_epi32(E2l, O2l), shift), _mm_srai_epi32(_mm_add_epi32(E2h, O2h), shift));
+    m128iS3 = _mm_packs_epi32(_mm_srai_epi32(_mm_add_epi32(E3l, O3l), shift), _mm_srai_epi32(_mm_add_epi32(E3h, O3h), shift));
+    m128iS4 = _mm_packs_epi32(_mm_srai_epi32(_mm_sub_epi32(E3l, O3l), shift), _mm_srai_epi32(_mm_sub_epi32(E3h, O3h), shift));
+    m128iS5 = _mm_packs_epi32(_mm_srai_epi32(_mm_sub_epi32(E2l, O2l), shift), _mm_srai_epi32(_mm_sub_epi32(E2h, O2h), shift));
+    m128iS6 = _mm_packs_epi32(_mm_srai_epi32(_mm_sub_epi32(E1l, O1l), shift), _mm_srai_epi32(_mm_sub_epi32(E1h, O1h), shift));
+    m128iS7 = _mm_packs_epi32(_mm_srai_epi32(_mm_sub_epi32(E0l, O0l), shift), _mm_srai_epi32(_mm_sub_epi32(E0h, O0h), shift));
 
     // [07 06 05 04 03 02 01 00]
     // [17 16 15 14 13 12 11 10]
@@ -5833,7 +5827,7 @@ static void IDCT8(const int16_t* src, int16_t* dst, intptr_t stride)
     _mm_storeh_pi((__m64*)&dst[7 * stride + 4], _mm_castsi128_ps(T11));
 
 }
-static void IDCT16(const short *src, short *dst, UInt stride)
+static void IDCT16(const short *src, short *dst, UInt stride, Int shift)
 {
 #define READ_UNPACKHILO(offset)\
   const __m128i T_00_00A = _mm_unpacklo_epi16(*(__m128i*)&src[1 * 16 + offset], *(__m128i*)&src[3 * 16 + offset]);\
@@ -6157,11 +6151,11 @@ static void IDCT16(const short *src, short *dst, UInt stride)
 
   {
       UNPACKHILO(0)
-          PROCESS(0, ADD_IT_2, SHIFT_IT_2ND)
+          PROCESS(0, 1 << (shift - 1), shift)
   }
   {
       UNPACKHILO(1)
-          PROCESS(1, ADD_IT_2, SHIFT_IT_2ND)
+          PROCESS(1, 1 << (shift - 1), shift)
   }
 
   {
@@ -6205,7 +6199,7 @@ static void IDCT16(const short *src, short *dst, UInt stride)
       _mm_store_si128((__m128i*)&dst[15 * stride + 8], in15[1]);
   }
 }
-static void IDCT32(const short *src, short *dst, UInt stride)
+static void IDCT32(const short *src, short *dst, UInt stride, Int shift)
 {
 
     //Odd
@@ -6437,8 +6431,8 @@ static void IDCT32(const short *src, short *dst, UInt stride)
     {
         if (pass == 1)
         {
-            c32_rnd = _mm_set1_epi32(ADD_IT_2);
-            nShift = SHIFT_IT_2ND;
+            c32_rnd = _mm_set1_epi32(1 << (shift - 1));
+            nShift = shift;
         }
 
         for (int part = 0; part < 4; part++)
@@ -6947,6 +6941,430 @@ static void IDCT32(const short *src, short *dst, UInt stride)
     }
 }
 #endif 
+
+#if ETRI_SIMD_AVX2
+// ====================================================================================================================
+// AVX2 Transform (by ETRI)
+//	Forward : Y = T * X * T',  Inverse : X = T' * Y * T
+//	Each 1-D stage is a column transform (matrix * 16 columns per iteration) preceded by a transpose,
+//	so that the rounding and the clipping of each stage are identical to partialButterfly / partialButterflyInverse.
+// ====================================================================================================================
+static Bool e_bTrUseAVX2 = false;		///< Set in TComTrQuant::init() from ETRI_GetSimdLevel()
+
+/// Transposed Transform Matrices for the Inverse Transform. The forward transform uses g_aiT directly.
+class ETRI_TrMatrixAVX2
+{
+public:
+	ALIGNED(32) Short	em_aiTT4[4 * 4];
+	ALIGNED(32) Short	em_aiTTDst4[4 * 4];
+	ALIGNED(32) Short	em_aiTT8[8 * 8];
+	ALIGNED(32) Short	em_aiTT16[16 * 16];
+	ALIGNED(32) Short	em_aiTT32[32 * 32];
+
+	ETRI_TrMatrixAVX2()
+	{
+		xTranspose(&g_aiT4[0][0], em_aiTT4, 4);
+		xTranspose(&g_as_DST_MAT_4[0][0], em_aiTTDst4, 4);
+		xTranspose(&g_aiT8[0][0], em_aiTT8, 8);
+		xTranspose(&g_aiT16[0][0], em_aiTT16, 16);
+		xTranspose(&g_aiT32[0][0], em_aiTT32, 32);
+	}
+
+private:
+	static Void xTranspose(const Short *src, Short *dst, Int N)
+	{
+		for (Int i = 0; i < N; i++)
+		for (Int j = 0; j < N; j++)
+		{
+			dst[j * N + i] = src[i * N + j];
+		}
+	}
+};
+
+static ETRI_TrMatrixAVX2 e_cTrMatrixAVX2;
+
+#define ETRI_AVX2_COEFF_PAIR(pM)	_mm_set1_epi32((Int)(UShort)(pM)[0] | ((Int)(pM)[1] << 16))
+
+/**
+	@brief	dst = (M * src + (1 << (shift - 1))) >> shift with 16bit saturation. M, src and dst are N x N matrices.
+			N >= 16 : 16 columns per iteration, N = 8 : two rows per iteration, N = 4 : four rows per iteration
+*/
+template<Int N>
+static ETRI_TARGET_AVX2 Void ETRI_TrColumn_AVX2(const Short *M, const Short *src, Short *dst, Int shift)
+{
+	const Int G = N >> 4;		///< Number of 16 column groups
+	const __m256i ymm_add = _mm256_set1_epi32(1 << (shift - 1));
+	__m256i ymm_pair[N * N / 16], ymm_lo[G], ymm_hi[G], ymm_c;
+	Int k, p, g;
+
+	/// Interleave the rows (2p, 2p+1) for madd
+	for (p = 0; p < (N >> 1); p++)
+	for (g = 0; g < G; g++)
+	{
+		__m256i ymm_a = _mm256_loadu_si256((__m256i const *)(src + (2 * p    ) * N + (g << 4)));
+		__m256i ymm_b = _mm256_loadu_si256((__m256i const *)(src + (2 * p + 1) * N + (g << 4)));
+		ymm_pair[((p * G + g) << 1)    ] = _mm256_unpacklo_epi16(ymm_a, ymm_b);
+		ymm_pair[((p * G + g) << 1) + 1] = _mm256_unpackhi_epi16(ymm_a, ymm_b);
+	}
+
+	for (k = 0; k < N; k++)
+	{
+		const Short *pM = M + k * N;
+		for (g = 0; g < G; g++)	{ymm_lo[g] = ymm_hi[g] = _mm256_setzero_si256();}
+
+		for (p = 0; p < (N >> 1); p++)
+		{
+			ymm_c = _mm256_broadcastsi128_si256(ETRI_AVX2_COEFF_PAIR(pM + 2 * p));
+			for (g = 0; g < G; g++)
+			{
+				ymm_lo[g] = _mm256_add_epi32(ymm_lo[g], _mm256_madd_epi16(ymm_pair[((p * G + g) << 1)    ], ymm_c));
+				ymm_hi[g] = _mm256_add_epi32(ymm_hi[g], _mm256_madd_epi16(ymm_pair[((p * G + g) << 1) + 1], ymm_c));
+			}
+		}
+
+		for (g = 0; g < G; g++)
+		{
+			ymm_lo[g] = _mm256_srai_epi32(_mm256_add_epi32(ymm_lo[g], ymm_add), shift);
+			ymm_hi[g] = _mm256_srai_epi32(_mm256_add_epi32(ymm_hi[g], ymm_add), shift);
+			_mm256_storeu_si256((__m256i *)(dst + k * N + (g << 4)), _mm256_packs_epi32(ymm_lo[g], ymm_hi[g]));
+		}
+	}
+}
+
+/// Both lanes have the same 8 columns, lane 0 is for row k and lane 1 for row k+1
+template<>
+ETRI_TARGET_AVX2 Void ETRI_TrColumn_AVX2<8>(const Short *M, const Short *src, Short *dst, Int shift)
+{
+	const __m256i ymm_add = _mm256_set1_epi32(1 << (shift - 1));
+	__m256i ymm_pair[8], ymm_lo, ymm_hi, ymm_c;
+	Int k, p;
+
+	for (p = 0; p < 4; p++)
+	{
+		__m128i xmm_a = _mm_loadu_si128((__m128i const *)(src + (2 * p    ) * 8));
+		__m128i xmm_b = _mm_loadu_si128((__m128i const *)(src + (2 * p + 1) * 8));
+		ymm_pair[(p << 1)    ] = _mm256_broadcastsi128_si256(_mm_unpacklo_epi16(xmm_a, xmm_b));
+		ymm_pair[(p << 1) + 1] = _mm256_broadcastsi128_si256(_mm_unpackhi_epi16(xmm_a, xmm_b));
+	}
+
+	for (k = 0; k < 8; k += 2)
+	{
+		ymm_lo = ymm_hi = _mm256_setzero_si256();
+		for (p = 0; p < 4; p++)
+		{
+			ymm_c  = _mm256_inserti128_si256(_mm256_castsi128_si256(ETRI_AVX2_COEFF_PAIR(M + k * 8 + 2 * p)), ETRI_AVX2_COEFF_PAIR(M + (k + 1) * 8 + 2 * p), 1);
+			ymm_lo = _mm256_add_epi32(ymm_lo, _mm256_madd_epi16(ymm_pair[(p << 1)    ], ymm_c));
+			ymm_hi = _mm256_add_epi32(ymm_hi, _mm256_madd_epi16(ymm_pair[(p << 1) + 1], ymm_c));
+		}
+		ymm_lo = _mm256_srai_epi32(_mm256_add_epi32(ymm_lo, ymm_add), shift);
+		ymm_hi = _mm256_srai_epi32(_mm256_add_epi32(ymm_hi, ymm_add), shift);
+		_mm256_storeu_si256((__m256i *)(dst + k * 8), _mm256_packs_epi32(ymm_lo, ymm_hi));
+	}
+}
+
+/// Both lanes have the same 4 columns, ymm_r[0] has rows (0, 1) and ymm_r[1] has rows (2, 3) in lane (0, 1)
+template<>
+ETRI_TARGET_AVX2 Void ETRI_TrColumn_AVX2<4>(const Short *M, const Short *src, Short *dst, Int shift)
+{
+	const __m256i ymm_add = _mm256_set1_epi32(1 << (shift - 1));
+	__m256i ymm_pair[2], ymm_r[2], ymm_c;
+	Int k, p;
+
+	for (p = 0; p < 2; p++)
+	{
+		__m128i xmm_a = _mm_loadl_epi64((__m128i const *)(src + (2 * p    ) * 4));
+		__m128i xmm_b = _mm_loadl_epi64((__m128i const *)(src + (2 * p + 1) * 4));
+		ymm_pair[p] = _mm256_broadcastsi128_si256(_mm_unpacklo_epi16(xmm_a, xmm_b));
+	}
+
+	for (k = 0; k < 2; k++)
+	{
+		ymm_r[k] = _mm256_setzero_si256();
+		for (p = 0; p < 2; p++)
+		{
+			ymm_c    = _mm256_inserti128_si256(_mm256_castsi128_si256(ETRI_AVX2_COEFF_PAIR(M + (2 * k) * 4 + 2 * p)), ETRI_AVX2_COEFF_PAIR(M + (2 * k + 1) * 4 + 2 * p), 1);
+			ymm_r[k] = _mm256_add_epi32(ymm_r[k], _mm256_madd_epi16(ymm_pair[p], ymm_c));
+		}
+		ymm_r[k] = _mm256_srai_epi32(_mm256_add_epi32(ymm_r[k], ymm_add), shift);
+	}
+	/// packs gives the rows (0, 2 | 1, 3)
+	ymm_c = _mm256_permute4x64_epi64(_mm256_packs_epi32(ymm_r[0], ymm_r[1]), _MM_SHUFFLE(3, 1, 2, 0));
+	_mm256_storeu_si256((__m256i *)dst, ymm_c);
+}
+
+/**
+	@brief	Forward column transform using the even/odd symmetry of the DCT basis : T[k][N-1-n] = (-1)^k T[k][n]
+			E = src[n] + src[N-1-n] and O = src[n] - src[N-1-n] are computed in 16bit, so src must be a residual.
+*/
+template<Int N>
+static ETRI_TARGET_AVX2 Void ETRI_TrColumnEO_AVX2(const Short *M, const Short *src, Short *dst, Int shift)
+{
+	const Int G = N >> 4;		///< Number of 16 column groups
+	const Int P = N >> 2;		///< Number of row pairs in E (or O)
+	const __m256i ymm_add = _mm256_set1_epi32(1 << (shift - 1));
+	__m256i ymm_e[N * N / 32], ymm_o[N * N / 32], ymm_lo[G], ymm_hi[G], ymm_c;
+	Int k, j, g;
+
+	for (j = 0; j < P; j++)
+	for (g = 0; g < G; g++)
+	{
+		__m256i ymm_a0 = _mm256_loadu_si256((__m256i const *)(src + (2 * j        ) * N + (g << 4)));
+		__m256i ymm_a1 = _mm256_loadu_si256((__m256i const *)(src + (2 * j + 1    ) * N + (g << 4)));
+		__m256i ymm_b0 = _mm256_loadu_si256((__m256i const *)(src + (N - 1 - 2 * j) * N + (g << 4)));
+		__m256i ymm_b1 = _mm256_loadu_si256((__m256i const *)(src + (N - 2 - 2 * j) * N + (g << 4)));
+		__m256i ymm_e0 = _mm256_add_epi16(ymm_a0, ymm_b0), ymm_e1 = _mm256_add_epi16(ymm_a1, ymm_b1);
+		__m256i ymm_o0 = _mm256_sub_epi16(ymm_a0, ymm_b0), ymm_o1 = _mm256_sub_epi16(ymm_a1, ymm_b1);
+
+		ymm_e[((j * G + g) << 1)    ] = _mm256_unpacklo_epi16(ymm_e0, ymm_e1);
+		ymm_e[((j * G + g) << 1) + 1] = _mm256_unpackhi_epi16(ymm_e0, ymm_e1);
+		ymm_o[((j * G + g) << 1)    ] = _mm256_unpacklo_epi16(ymm_o0, ymm_o1);
+		ymm_o[((j * G + g) << 1) + 1] = _mm256_unpackhi_epi16(ymm_o0, ymm_o1);
+	}
+
+	for (k = 0; k < N; k++)
+	{
+		const Short   *pM    = M + k * N;
+		const __m256i *pData = (k & 1) ? ymm_o : ymm_e;
+		for (g = 0; g < G; g++)	{ymm_lo[g] = ymm_hi[g] = _mm256_setzero_si256();}
+
+		for (j = 0; j < P; j++)
+		{
+			ymm_c = _mm256_broadcastsi128_si256(ETRI_AVX2_COEFF_PAIR(pM + 2 * j));
+			for (g = 0; g < G; g++)
+			{
+				ymm_lo[g] = _mm256_add_epi32(ymm_lo[g], _mm256_madd_epi16(pData[((j * G + g) << 1)    ], ymm_c));
+				ymm_hi[g] = _mm256_add_epi32(ymm_hi[g], _mm256_madd_epi16(pData[((j * G + g) << 1) + 1], ymm_c));
+			}
+		}
+
+		for (g = 0; g < G; g++)
+		{
+			ymm_lo[g] = _mm256_srai_epi32(_mm256_add_epi32(ymm_lo[g], ymm_add), shift);
+			ymm_hi[g] = _mm256_srai_epi32(_mm256_add_epi32(ymm_hi[g], ymm_add), shift);
+			_mm256_storeu_si256((__m256i *)(dst + k * N + (g << 4)), _mm256_packs_epi32(ymm_lo[g], ymm_hi[g]));
+		}
+	}
+}
+
+template<>
+ETRI_TARGET_AVX2 Void ETRI_TrColumnEO_AVX2<8>(const Short *M, const Short *src, Short *dst, Int shift)	{ETRI_TrColumn_AVX2<8>(M, src, dst, shift);}
+template<>
+ETRI_TARGET_AVX2 Void ETRI_TrColumnEO_AVX2<4>(const Short *M, const Short *src, Short *dst, Int shift)	{ETRI_TrColumn_AVX2<4>(M, src, dst, shift);}
+
+/**
+	@brief	Inverse column transform using the symmetry on the output side : T[n][N-1-k] = (-1)^n T[n][k]
+			Rows k and N-1-k are given by (E + O) and (E - O) in 32bit, where E (O) is the sum over even (odd) n.
+			MT is the transposed matrix (MT[k][n] = T[n][k]).
+*/
+template<Int N>
+static ETRI_TARGET_AVX2 Void ETRI_TrColumnInv_AVX2(const Short *MT, const Short *src, Short *dst, Int shift)
+{
+	const Int G = N >> 4;		///< Number of 16 column groups
+	const Int P = N >> 2;		///< Number of row pairs for even (or odd) n
+	const __m256i ymm_add = _mm256_set1_epi32(1 << (shift - 1));
+	__m256i ymm_e[N * N / 32], ymm_o[N * N / 32];
+	__m256i ymm_elo[G], ymm_ehi[G], ymm_olo[G], ymm_ohi[G], ymm_ce, ymm_co, ymm_lo, ymm_hi;
+	Int k, j, g;
+
+	/// Even rows (4j, 4j+2) and odd rows (4j+1, 4j+3) are interleaved for madd
+	for (j = 0; j < P; j++)
+	for (g = 0; g < G; g++)
+	{
+		__m256i ymm_a0 = _mm256_loadu_si256((__m256i const *)(src + (4 * j    ) * N + (g << 4)));
+		__m256i ymm_a1 = _mm256_loadu_si256((__m256i const *)(src + (4 * j + 1) * N + (g << 4)));
+		__m256i ymm_a2 = _mm256_loadu_si256((__m256i const *)(src + (4 * j + 2) * N + (g << 4)));
+		__m256i ymm_a3 = _mm256_loadu_si256((__m256i const *)(src + (4 * j + 3) * N + (g << 4)));
+
+		ymm_e[((j * G + g) << 1)    ] = _mm256_unpacklo_epi16(ymm_a0, ymm_a2);
+		ymm_e[((j * G + g) << 1) + 1] = _mm256_unpackhi_epi16(ymm_a0, ymm_a2);
+		ymm_o[((j * G + g) << 1)    ] = _mm256_unpacklo_epi16(ymm_a1, ymm_a3);
+		ymm_o[((j * G + g) << 1) + 1] = _mm256_unpackhi_epi16(ymm_a1, ymm_a3);
+	}
+
+	for (k = 0; k < (N >> 1); k++)
+	{
+		const Short *pM = MT + k * N;
+		for (g = 0; g < G; g++)	{ymm_elo[g] = ymm_ehi[g] = ymm_olo[g] = ymm_ohi[g] = _mm256_setzero_si256();}
+
+		for (j = 0; j < P; j++)
+		{
+			ymm_ce = _mm256_set1_epi32((Int)(UShort)pM[4 * j    ] | ((Int)pM[4 * j + 2] << 16));
+			ymm_co = _mm256_set1_epi32((Int)(UShort)pM[4 * j + 1] | ((Int)pM[4 * j + 3] << 16));
+			for (g = 0; g < G; g++)
+			{
+				ymm_elo[g] = _mm256_add_epi32(ymm_elo[g], _mm256_madd_epi16(ymm_e[((j * G + g) << 1)    ], ymm_ce));
+				ymm_ehi[g] = _mm256_add_epi32(ymm_ehi[g], _mm256_madd_epi16(ymm_e[((j * G + g) << 1) + 1], ymm_ce));
+				ymm_olo[g] = _mm256_add_epi32(ymm_olo[g], _mm256_madd_epi16(ymm_o[((j * G + g) << 1)    ], ymm_co));
+				ymm_ohi[g] = _mm256_add_epi32(ymm_ohi[g], _mm256_madd_epi16(ymm_o[((j * G + g) << 1) + 1], ymm_co));
+			}
+		}
+
+		for (g = 0; g < G; g++)
+		{
+			ymm_elo[g] = _mm256_add_epi32(ymm_elo[g], ymm_add);
+			ymm_ehi[g] = _mm256_add_epi32(ymm_ehi[g], ymm_add);
+
+			ymm_lo = _mm256_srai_epi32(_mm256_add_epi32(ymm_elo[g], ymm_olo[g]), shift);
+			ymm_hi = _mm256_srai_epi32(_mm256_add_epi32(ymm_ehi[g], ymm_ohi[g]), shift);
+			_mm256_storeu_si256((__m256i *)(dst + k * N + (g << 4)), _mm256_packs_epi32(ymm_lo, ymm_hi));
+
+			ymm_lo = _mm256_srai_epi32(_mm256_sub_epi32(ymm_elo[g], ymm_olo[g]), shift);
+			ymm_hi = _mm256_srai_epi32(_mm256_sub_epi32(ymm_ehi[g], ymm_ohi[g]), shift);
+			_mm256_storeu_si256((__m256i *)(dst + (N - 1 - k) * N + (g << 4)), _mm256_packs_epi32(ymm_lo, ymm_hi));
+		}
+	}
+}
+
+template<>
+ETRI_TARGET_AVX2 Void ETRI_TrColumnInv_AVX2<8>(const Short *MT, const Short *src, Short *dst, Int shift)	{ETRI_TrColumn_AVX2<8>(MT, src, dst, shift);}
+template<>
+ETRI_TARGET_AVX2 Void ETRI_TrColumnInv_AVX2<4>(const Short *MT, const Short *src, Short *dst, Int shift)	{ETRI_TrColumn_AVX2<4>(MT, src, dst, shift);}
+
+/// N x N transpose of 16bit data by 8x8 blocks. dst is written with dstStride.
+template<Int N>
+static ETRI_TARGET_AVX2 Void ETRI_TrTranspose_AVX2(const Short *src, Short *dst, Int dstStride)
+{
+	__m128i a[8], b[8], c[8];
+
+	for (Int bi = 0; bi < N; bi += 8)
+	for (Int bj = 0; bj < N; bj += 8)
+	{
+		for (Int r = 0; r < 8; r++)	{a[r] = _mm_loadu_si128((__m128i const *)(src + (bi + r) * N + bj));}
+
+		b[0] = _mm_unpacklo_epi16(a[0], a[1]);	b[1] = _mm_unpackhi_epi16(a[0], a[1]);
+		b[2] = _mm_unpacklo_epi16(a[2], a[3]);	b[3] = _mm_unpackhi_epi16(a[2], a[3]);
+		b[4] = _mm_unpacklo_epi16(a[4], a[5]);	b[5] = _mm_unpackhi_epi16(a[4], a[5]);
+		b[6] = _mm_unpacklo_epi16(a[6], a[7]);	b[7] = _mm_unpackhi_epi16(a[6], a[7]);
+
+		c[0] = _mm_unpacklo_epi32(b[0], b[2]);	c[1] = _mm_unpackhi_epi32(b[0], b[2]);
+		c[2] = _mm_unpacklo_epi32(b[1], b[3]);	c[3] = _mm_unpackhi_epi32(b[1], b[3]);
+		c[4] = _mm_unpacklo_epi32(b[4], b[6]);	c[5] = _mm_unpackhi_epi32(b[4], b[6]);
+		c[6] = _mm_unpacklo_epi32(b[5], b[7]);	c[7] = _mm_unpackhi_epi32(b[5], b[7]);
+
+		for (Int r = 0; r < 4; r++)
+		{
+			_mm_storeu_si128((__m128i *)(dst + (bj + 2 * r    ) * dstStride + bi), _mm_unpacklo_epi64(c[r], c[r + 4]));
+			_mm_storeu_si128((__m128i *)(dst + (bj + 2 * r + 1) * dstStride + bi), _mm_unpackhi_epi64(c[r], c[r + 4]));
+		}
+	}
+}
+
+template<>
+ETRI_TARGET_AVX2 Void ETRI_TrTranspose_AVX2<4>(const Short *src, Short *dst, Int dstStride)
+{
+	__m128i xmm_t0 = _mm_unpacklo_epi16(_mm_loadl_epi64((__m128i const *)(src    )), _mm_loadl_epi64((__m128i const *)(src + 4)));
+	__m128i xmm_t1 = _mm_unpacklo_epi16(_mm_loadl_epi64((__m128i const *)(src + 8)), _mm_loadl_epi64((__m128i const *)(src + 12)));
+	__m128i xmm_u0 = _mm_unpacklo_epi32(xmm_t0, xmm_t1);
+	__m128i xmm_u1 = _mm_unpackhi_epi32(xmm_t0, xmm_t1);
+
+	_mm_storel_epi64((__m128i *)(dst                ), xmm_u0);
+	_mm_storel_epi64((__m128i *)(dst +     dstStride), _mm_srli_si128(xmm_u0, 8));
+	_mm_storel_epi64((__m128i *)(dst + 2 * dstStride), xmm_u1);
+	_mm_storel_epi64((__m128i *)(dst + 3 * dstStride), _mm_srli_si128(xmm_u1, 8));
+}
+
+/// Forward : coeff = T * block * T'
+template<Int N>
+static ETRI_TARGET_AVX2 Void ETRI_xTr2D_AVX2(const Short *M, Short *block, Short *coeff, Int shift_1st, Int shift_2nd)
+{
+	ALIGNED(32) Short aiTmp[N * N], aiTmpT[N * N];
+
+	ETRI_TrTranspose_AVX2<N>(block, aiTmpT, N);
+	ETRI_TrColumnEO_AVX2<N>(M, aiTmpT, aiTmp, shift_1st);
+	ETRI_TrTranspose_AVX2<N>(aiTmp, aiTmpT, N);
+	ETRI_TrColumn_AVX2<N>(M, aiTmpT, coeff, shift_2nd);
+}
+
+/// Inverse : block = T' * coeff * T, written with uiStride
+template<Int N>
+static ETRI_TARGET_AVX2 Void ETRI_xITr2D_AVX2(const Short *MT, Short *coeff, Short *block, Int iStride, Int shift_1st, Int shift_2nd)
+{
+	ALIGNED(32) Short aiTmp[N * N], aiTmpT[N * N];
+
+	ETRI_TrColumnInv_AVX2<N>(MT, coeff, aiTmp, shift_1st);
+	ETRI_TrTranspose_AVX2<N>(aiTmp, aiTmpT, N);
+	ETRI_TrColumnInv_AVX2<N>(MT, aiTmpT, aiTmp, shift_2nd);
+	ETRI_TrTranspose_AVX2<N>(aiTmp, block, iStride);
+}
+
+static Void ETRI_xTrMxN_AVX2(Int bitDepth, Short *block, Short *coeff, Int iWidth, UInt uiMode)
+{
+	Int shift_1st = g_aucConvertToBit[iWidth] + 1 + bitDepth - 8;
+	Int shift_2nd = g_aucConvertToBit[iWidth] + 8;
+
+	switch (iWidth)
+	{
+		case 32:	ETRI_xTr2D_AVX2<32>(&g_aiT32[0][0], block, coeff, shift_1st, shift_2nd);	break;
+		case 16:	ETRI_xTr2D_AVX2<16>(&g_aiT16[0][0], block, coeff, shift_1st, shift_2nd);	break;
+		case  8:	ETRI_xTr2D_AVX2< 8>(&g_aiT8[0][0],  block, coeff, shift_1st, shift_2nd);	break;
+		case  4:	ETRI_xTr2D_AVX2< 4>((uiMode != REG_DCT) ? &g_as_DST_MAT_4[0][0] : &g_aiT4[0][0], block, coeff, shift_1st, shift_2nd);	break;
+	}
+}
+
+static Void ETRI_xITrMxN_AVX2(Int bitDepth, Short *coeff, Short *block, Int iStride, Int iWidth, UInt uiMode)
+{
+	Int shift_1st = SHIFT_INV_1ST;
+	Int shift_2nd = SHIFT_INV_2ND - (bitDepth - 8);
+
+	switch (iWidth)
+	{
+		case 32:	ETRI_xITr2D_AVX2<32>(e_cTrMatrixAVX2.em_aiTT32, coeff, block, iStride, shift_1st, shift_2nd);	break;
+		case 16:	ETRI_xITr2D_AVX2<16>(e_cTrMatrixAVX2.em_aiTT16, coeff, block, iStride, shift_1st, shift_2nd);	break;
+		case  8:	ETRI_xITr2D_AVX2< 8>(e_cTrMatrixAVX2.em_aiTT8,  coeff, block, iStride, shift_1st, shift_2nd);	break;
+		case  4:	ETRI_xITr2D_AVX2< 4>((uiMode != REG_DCT) ? e_cTrMatrixAVX2.em_aiTTDst4 : e_cTrMatrixAVX2.em_aiTT4, coeff, block, iStride, shift_1st, shift_2nd);	break;
+	}
+}
+
+/// Reconstruction : pReco = Clip(pPred + IT(coeff)) without writing the residual
+static ETRI_TARGET_AVX2 Void ETRI_xITrAddClip_AVX2(Int bitDepth, Short *coeff, Int iWidth, UInt uiMode, Pel *pPred, UInt uiPredStride, Pel *pReco, UInt uiRecoStride)
+{
+	ALIGNED(32) Short aiResi[32 * 32];
+	const __m256i ymm_max = _mm256_set1_epi16((Short)((1 << bitDepth) - 1));
+	const __m256i ymm_min = _mm256_setzero_si256();
+	__m256i ymm_r;
+	Int x, y;
+
+	ETRI_xITrMxN_AVX2(bitDepth, coeff, aiResi, iWidth, iWidth, uiMode);
+
+	if (iWidth >= 16)
+	{
+		for (y = 0; y < iWidth; y++)
+		{
+			for (x = 0; x < iWidth; x += 16)
+			{
+				ymm_r = _mm256_add_epi16(_mm256_loadu_si256((__m256i const *)(pPred + x)), _mm256_load_si256((__m256i const *)(aiResi + y * iWidth + x)));
+				ymm_r = _mm256_max_epi16(_mm256_min_epi16(ymm_r, ymm_max), ymm_min);
+				_mm256_storeu_si256((__m256i *)(pReco + x), ymm_r);
+			}
+			pPred += uiPredStride;
+			pReco += uiRecoStride;
+		}
+	}
+	else
+	{
+		const __m128i xmm_max = _mm256_castsi256_si128(ymm_max);
+		const __m128i xmm_min = _mm_setzero_si128();
+		__m128i xmm_r;
+
+		for (y = 0; y < iWidth; y++)
+		{
+			if (iWidth == 8)
+			{
+				xmm_r = _mm_add_epi16(_mm_loadu_si128((__m128i const *)pPred), _mm_load_si128((__m128i const *)(aiResi + y * 8)));
+				_mm_storeu_si128((__m128i *)pReco, _mm_max_epi16(_mm_min_epi16(xmm_r, xmm_max), xmm_min));
+			}
+			else
+			{
+				xmm_r = _mm_add_epi16(_mm_loadl_epi64((__m128i const *)pPred), _mm_loadl_epi64((__m128i const *)(aiResi + y * 4)));
+				_mm_storel_epi64((__m128i *)pReco, _mm_max_epi16(_mm_min_epi16(xmm_r, xmm_max), xmm_min));
+			}
+			pPred += uiPredStride;
+			pReco += uiRecoStride;
+		}
+	}
+}
+#endif	// ETRI_SIMD_AVX2
+
 void xTrMxN(Int bitDepth, Short *block,Short *coeff, Int iWidth, Int iHeight, UInt uiMode)
 {
   Int shift_1st = g_aucConvertToBit[iWidth]  + 1 + bitDepth-8; // log2(iWidth) - 1 + g_bitDepth - 8
@@ -6954,15 +7372,22 @@ void xTrMxN(Int bitDepth, Short *block,Short *coeff, Int iWidth, Int iHeight, UI
 
   Short tmp[ 64 * 64 ];
 
+#if ETRI_SIMD_AVX2
+  if (e_bTrUseAVX2)
+  {
+      ETRI_xTrMxN_AVX2(bitDepth, block, coeff, iWidth, uiMode);
+      return;
+  }
+#endif
 #if ETRI_SIMD_MATRIX_TRANSFORM
   switch(iWidth)
   {
       case 32:
-          DCT32(block, coeff, iWidth);
+          DCT32(block, coeff, iWidth, shift_1st);
          break;
 
       case 16:
-          DCT16(block, coeff, iWidth);
+          DCT16(block, coeff, iWidth, shift_1st);
           break;
 
       case  8:
@@ -7027,19 +7452,26 @@ void xITrMxN(Int bitDepth, Short *coeff,Short *block, Int iWidth, Int iHeight, U
   Int shift_2nd = SHIFT_INV_2ND - (bitDepth-8);
 
   Short tmp[ 64*64];
+#if ETRI_SIMD_AVX2
+  if (e_bTrUseAVX2)
+  {
+      ETRI_xITrMxN_AVX2(bitDepth, coeff, block, iWidth, iWidth, uiMode);
+      return;
+  }
+#endif
 #if ETRI_SIMD_MATRIX_TRANSFORM
   switch (iWidth)
   {
       case 32:
-          IDCT32(coeff, block, iWidth);
+          IDCT32(coeff, block, iWidth, shift_2nd);
           break;
 
       case 16:
-          IDCT16(coeff, block, iWidth);
+          IDCT16(coeff, block, iWidth, shift_2nd);
           break;
 
       case  8:
-          IDCT8(coeff, block, iWidth);
+          IDCT8(coeff, block, iWidth, shift_2nd);
           break;
 
       case  4:
@@ -7594,6 +8026,104 @@ Void TComTrQuant::xDeQuant(Int bitDepth, const TCoeff* pSrc, Int* pDes, Int iWid
 }
 #endif
 
+#if ETRI_RDOQ_CG_BATCH
+// ====================================================================================================================
+// CG-Batched RDOQ (by ETRI)
+//	The quantization errors of the level candidates {0, MaxAbsLevel, MaxAbsLevel-1} do not depend on the context state,
+//	so they are evaluated for the 16 coefficients of a CG before the sequential level decision in xRateDistOptQuant.
+//	Each distortion is computed with the same Double operations as xGetCodedLevel, so that the RD decision is unchanged.
+// ====================================================================================================================
+static Bool e_bRdoqUseAVX2 = false;		///< Set in TComTrQuant::init() from ETRI_GetSimdLevel()
+
+typedef struct
+{
+	ALIGNED(32) Double	adCost0[16];			///< Distortion of level 0
+	ALIGNED(32) Double	adDistMax[16];			///< Distortion of MaxAbsLevel
+	ALIGNED(32) Double	adDistMaxM1[16];		///< Distortion of MaxAbsLevel - 1
+	ALIGNED(32) Double	adErrScale[16];
+	ALIGNED(32) Int		aiLevel[16];			///< Scaled level (lLevelDouble)
+	ALIGNED(32) Int		aiMaxAbsLevel[16];
+	UInt				auiBlkPos[16];
+} ETRI_RDOQCGData;
+
+static Void ETRI_xGetCGDistortion_C(ETRI_RDOQCGData& rcCG, Int iQBits)
+{
+	for (Int i = 0; i < 16; i++)
+	{
+		Double dErr0 = Double(rcCG.aiLevel[i]);
+		Double dErr1 = Double(rcCG.aiLevel[i] - (rcCG.aiMaxAbsLevel[i] << iQBits));
+		Double dErr2 = Double(rcCG.aiLevel[i] - (Int64)(rcCG.aiMaxAbsLevel[i] - 1) * ((Int64)1 << iQBits));	///< MaxAbsLevel - 1 is -1 for a zero level, so no left shift
+		rcCG.adCost0[i]     = dErr0 * dErr0 * rcCG.adErrScale[i];
+		rcCG.adDistMax[i]   = dErr1 * dErr1 * rcCG.adErrScale[i];
+		rcCG.adDistMaxM1[i] = dErr2 * dErr2 * rcCG.adErrScale[i];
+	}
+}
+
+#if ETRI_SIMD_AVX2
+#define ETRI_AVX2_RDOQ_DIST(dst, err32, scale)	\
+	{	__m256d dErr = _mm256_cvtepi32_pd(err32);	_mm256_store_pd(dst, _mm256_mul_pd(_mm256_mul_pd(dErr, dErr), scale));	}
+
+ETRI_TARGET_AVX2 static Void ETRI_xGetCGDistortion_AVX2(ETRI_RDOQCGData& rcCG, Int iQBits)
+{
+	const __m128i	xmmShift = _mm_cvtsi32_si128(iQBits);
+	const __m256i	ymmOne   = _mm256_set1_epi32(1);
+
+	for (Int i = 0; i < 16; i += 8)
+	{
+		__m256i ymmLevel = _mm256_load_si256((const __m256i*)&rcCG.aiLevel[i]);
+		__m256i ymmMax   = _mm256_load_si256((const __m256i*)&rcCG.aiMaxAbsLevel[i]);
+		__m256i ymmErr1  = _mm256_sub_epi32(ymmLevel, _mm256_sll_epi32(ymmMax, xmmShift));
+		__m256i ymmErr2  = _mm256_sub_epi32(ymmLevel, _mm256_sll_epi32(_mm256_sub_epi32(ymmMax, ymmOne), xmmShift));
+
+		for (Int j = 0; j < 2; j++)
+		{
+			const Int	k     = i + (j << 2);
+			__m256d		scale = _mm256_load_pd(&rcCG.adErrScale[k]);
+			__m128i		xmmLevel = j ? _mm256_extracti128_si256(ymmLevel, 1) : _mm256_castsi256_si128(ymmLevel);
+			__m128i		xmmErr1  = j ? _mm256_extracti128_si256(ymmErr1, 1)  : _mm256_castsi256_si128(ymmErr1);
+			__m128i		xmmErr2  = j ? _mm256_extracti128_si256(ymmErr2, 1)  : _mm256_castsi256_si128(ymmErr2);
+
+			ETRI_AVX2_RDOQ_DIST(&rcCG.adCost0[k],     xmmLevel, scale);
+			ETRI_AVX2_RDOQ_DIST(&rcCG.adDistMax[k],   xmmErr1,  scale);
+			ETRI_AVX2_RDOQ_DIST(&rcCG.adDistMaxM1[k], xmmErr2,  scale);
+		}
+	}
+}
+#undef ETRI_AVX2_RDOQ_DIST
+#endif
+
+/** Gather the scaled levels of a CG in scan order and evaluate the distortions of the level candidates.
+ * \returns bit mask of the coefficients (scan position in CG) whose MaxAbsLevel is not zero
+ */
+static UInt ETRI_xGetCGDistortion(ETRI_RDOQCGData& rcCG, const UInt* puiScan, const Int* plLevel, const Int* piMaxAbsLevel, const Double* pdErrScale, Int iQBits)
+{
+	UInt uiNZMask = 0;
+	for (Int i = 0; i < 16; i++)
+	{
+		UInt uiBlkPos = puiScan[i];
+		rcCG.auiBlkPos[i]     = uiBlkPos;
+		rcCG.aiLevel[i]       = plLevel[uiBlkPos];
+		rcCG.aiMaxAbsLevel[i] = piMaxAbsLevel[uiBlkPos];
+#if ETRI_SCALING_LIST_OPTIMIZATION
+		rcCG.adErrScale[i]    = *pdErrScale;
+#else
+		rcCG.adErrScale[i]    = pdErrScale[uiBlkPos];
+#endif
+		uiNZMask |= (UInt)(rcCG.aiMaxAbsLevel[i] > 0) << i;
+	}
+
+#if ETRI_SIMD_AVX2
+	if (e_bRdoqUseAVX2)
+	{
+		ETRI_xGetCGDistortion_AVX2(rcCG, iQBits);
+		return uiNZMask;
+	}
+#endif
+	ETRI_xGetCGDistortion_C(rcCG, iQBits);
+	return uiNZMask;
+}
+#endif
+
 Void TComTrQuant::init( UInt uiMaxTrSize,
                        Bool bUseRDOQ,  
                        Bool bUseRDOQTS,
@@ -7611,6 +8141,12 @@ Void TComTrQuant::init( UInt uiMaxTrSize,
   m_bUseAdaptQpSelect = bUseAdaptQpSelect;
 #endif
   m_useTransformSkipFast = useTransformSkipFast;
+#if ETRI_SIMD_AVX2 && !MATRIX_MULT
+  e_bTrUseAVX2 = (ETRI_GetSimdLevel() >= ETRI_SIMD_LEVEL_AVX2);
+#endif
+#if ETRI_RDOQ_CG_BATCH && ETRI_SIMD_AVX2
+  e_bRdoqUseAVX2 = (ETRI_GetSimdLevel() >= ETRI_SIMD_LEVEL_AVX2);
+#endif
 }
 
 Void TComTrQuant::transformNxN( TComDataCU* pcCU, 
@@ -7698,6 +8234,34 @@ Void TComTrQuant::invtransformNxN( Bool transQuantBypass, TextType eText, UInt u
   }
 }
 
+#if ETRI_SIMD_AVX2 && !MATRIX_MULT
+/** Inverse transform with the addition of the prediction and the clipping (reconstruction) in one function
+ *  The residual is not written. Transquant bypass and transform skip are not supported (use invtransformNxN).
+ *  AVX2 only: call it only when ETRI_getTrUseAVX2() is true.
+ *  \param pcPred prediction, pcReco reconstruction (may be the same as pcPred)
+ */
+Void TComTrQuant::ETRI_invtransformNxNAddClip( TextType eText, UInt uiMode, TCoeff* pcCoeff, UInt uiWidth, UInt uiHeight, Int scalingListType, Pel* pcPred, UInt uiPredStride, Pel* pcReco, UInt uiRecoStride )
+{
+  Int bitDepth = eText == TEXT_LUMA ? g_bitDepthY : g_bitDepthC;
+  ALIGNED(32) Short coeff[ 32 * 32 ];
+  UInt j;
+
+  assert(e_bTrUseAVX2);
+  xDeQuant(bitDepth, pcCoeff, m_plTempCoeff, uiWidth, uiHeight, scalingListType);
+  for (j = 0; j < uiWidth * uiHeight; j += 4)
+  {
+    _mm_storel_epi64((__m128i *)&coeff[j], _mm_packs_epi32(_mm_loadu_si128((__m128i *)&m_plTempCoeff[j]), _mm_setzero_si128()));
+  }
+
+  ETRI_xITrAddClip_AVX2(bitDepth, coeff, uiWidth, uiMode, pcPred, uiPredStride, pcReco, uiRecoStride);
+}
+
+Bool TComTrQuant::ETRI_getTrUseAVX2()
+{
+  return e_bTrUseAVX2;
+}
+#endif
+
 Void TComTrQuant::invRecurTransformNxN( TComDataCU* pcCU, UInt uiAbsPartIdx, TextType eTxt, Pel* rpcResidual, UInt uiAddr, UInt uiStride, UInt uiWidth, UInt uiHeight, UInt uiMaxTrMode, UInt uiTrMode, TCoeff* rpcCoeff )
 {
   if( !pcCU->getCbf(uiAbsPartIdx, eTxt, uiTrMode) )
@@ -7822,6 +8386,13 @@ Void TComTrQuant::xIT(Int bitDepth, UInt uiMode, Int* plCoef, Pel* pResidual, UI
       coeff[j] = (Short)plCoef[j];
     }
 #endif 
+#if ETRI_SIMD_AVX2
+    if (e_bTrUseAVX2)
+    {
+      ETRI_xITrMxN_AVX2(bitDepth, coeff, pResidual, uiStride, iWidth, uiMode);	///< The residual is written without the intermediate block
+      return;
+    }
+#endif
     xITrMxN(bitDepth, coeff, block, iWidth, iHeight, uiMode );
     {
       for ( j = 0; j < iHeight; j++ )
@@ -8065,6 +8636,10 @@ Void TComTrQuant::xRateDistOptQuant                 ( TComDataCU*
 		_mm_storeu_si128((__m128i *)&euiMaxAbsLevel[i], _mm_srai_epi32(_mm_add_epi32(xmm0, xmm3), iQBits));
 	}
 #endif
+#if ETRI_RDOQ_CG_BATCH
+	ETRI_RDOQCGData cCG;
+	Int iRateNow = 0;
+#endif
 
 #if ETRI_RDOQ_ZONAL_CODING
 	::memset(piDstCoeff, 0, sizeof(TCoeff)*uiWidth*uiHeight);
@@ -8097,11 +8672,33 @@ Void TComTrQuant::xRateDistOptQuant                 ( TComDataCU*
 		::memset( &rdStats, 0, sizeof (coeffGroupRDStats));
 
 		const Int patternSigCtx = TComTrQuant::calcPatternSigCtx(uiSigCoeffGroupFlag, uiCGPosX, uiCGPosY, uiWidth, uiHeight);
+#if ETRI_RDOQ_CG_BATCH
+		UInt uiCGNZMask = ETRI_xGetCGDistortion(cCG, &scan[iCGScanPos*uiCGSize], elLevelDouble, euiMaxAbsLevel, pdErrScale, iQBits);
+		if (uiCGNZMask == 0 && iLastScanPos < 0)
+		{
+			/// No coded coefficient yet and every level of the CG is zero : Only the uncoded costs are accumulated
+			for (Int iScanPosinCG = uiCGSize-1; iScanPosinCG >= 0; iScanPosinCG--)
+			{
+				iScanPos = iCGScanPos*uiCGSize + iScanPosinCG;
+				pdCostCoeff0[ iScanPos ]  = cCG.adCost0[iScanPosinCG];
+				d64BlockUncodedCost      += pdCostCoeff0[ iScanPos ];
+				d64BaseCost              += pdCostCoeff0[ iScanPos ];
+				piDstCoeff[ cCG.auiBlkPos[iScanPosinCG] ] = 0;
+			}
+			continue;
+		}
+#endif
 		for (Int iScanPosinCG = uiCGSize-1; iScanPosinCG >= 0; iScanPosinCG--)
 		{
 			iScanPos = iCGScanPos*uiCGSize + iScanPosinCG;
 
 			//===== quantization =====
+#if ETRI_RDOQ_CG_BATCH
+			UInt	uiBlkPos		= cCG.auiBlkPos[iScanPosinCG];
+			Int		lLevelDouble	= cCG.aiLevel[iScanPosinCG];
+			UInt	uiMaxAbsLevel	= cCG.aiMaxAbsLevel[iScanPosinCG];
+			pdCostCoeff0[ iScanPos ]  = cCG.adCost0[iScanPosinCG];
+#else
 			UInt    uiBlkPos          = scan[iScanPos];
 			// set coeff
 #if ETRI_SCALING_LIST_OPTIMIZATION
@@ -8135,6 +8732,7 @@ Void TComTrQuant::xRateDistOptQuant                 ( TComDataCU*
 #endif
 			Double dErr               = Double( lLevelDouble );
 			pdCostCoeff0[ iScanPos ]  = dErr * dErr * dTemp;
+#endif
 			d64BlockUncodedCost      += pdCostCoeff0[ iScanPos ];
 			piDstCoeff[ uiBlkPos ]    = uiMaxAbsLevel;
 
@@ -8154,8 +8752,13 @@ Void TComTrQuant::xRateDistOptQuant                 ( TComDataCU*
 
 				if( iScanPos == iLastScanPos )
 				{
+#if ETRI_RDOQ_CG_BATCH
+					uiLevel = ETRI_xGetCodedLevelBatch( pdCostCoeff[ iScanPos ], pdCostCoeff0[ iScanPos ], pdCostSig[ iScanPos ], 
+								cCG.adDistMax[iScanPosinCG], cCG.adDistMaxM1[iScanPosinCG], uiMaxAbsLevel, 0, uiOneCtx, uiAbsCtx, uiGoRiceParam, c1Idx, c2Idx, 1, iRateNow );
+#else
 					uiLevel = xGetCodedLevel( pdCostCoeff[ iScanPos ], pdCostCoeff0[ iScanPos ], pdCostSig[ iScanPos ], 
 				            	lLevelDouble, uiMaxAbsLevel, 0, uiOneCtx, uiAbsCtx, uiGoRiceParam, c1Idx, c2Idx, iQBits, dTemp, 1 );
+#endif
 				}
 				else
 				{
@@ -8166,14 +8769,23 @@ Void TComTrQuant::xRateDistOptQuant                 ( TComDataCU*
 					UInt   uiPosX        = uiBlkPos - ( uiPosY << uiLog2BlkSize );
 					UShort uiCtxSig      = getSigCtxInc( patternSigCtx, uiScanIdx, uiPosX, uiPosY, uiLog2BlkSize, eTType );
 #endif
+#if ETRI_RDOQ_CG_BATCH
+					uiLevel  = ETRI_xGetCodedLevelBatch( pdCostCoeff[ iScanPos ], pdCostCoeff0[ iScanPos ], pdCostSig[ iScanPos ],
+								cCG.adDistMax[iScanPosinCG], cCG.adDistMaxM1[iScanPosinCG], uiMaxAbsLevel, uiCtxSig, uiOneCtx, uiAbsCtx, uiGoRiceParam, c1Idx, c2Idx, 0, iRateNow );
+#else
 					uiLevel  = xGetCodedLevel( pdCostCoeff[ iScanPos ], pdCostCoeff0[ iScanPos ], pdCostSig[ iScanPos ],
 					            lLevelDouble, uiMaxAbsLevel, uiCtxSig, uiOneCtx, uiAbsCtx, uiGoRiceParam, c1Idx, c2Idx, iQBits, dTemp, 0 );
+#endif
 					sigRateDelta[ uiBlkPos ] = m_pcEstBitsSbac->significantBits[ uiCtxSig ][ 1 ] - m_pcEstBitsSbac->significantBits[ uiCtxSig ][ 0 ];
 				}
 				deltaU[ uiBlkPos ] = (lLevelDouble - ((Int)uiLevel << iQBits)) >> (iQBits-8);
 				if( uiLevel > 0 )
 				{
+#if ETRI_RDOQ_CG_BATCH
+					Int rateNow = iRateNow;		///< Already evaluated in ETRI_xGetCodedLevelBatch
+#else
 					Int rateNow = xGetICRate( uiLevel, uiOneCtx, uiAbsCtx, uiGoRiceParam, c1Idx, c2Idx );
+#endif
 					rateIncUp   [ uiBlkPos ] = xGetICRate( uiLevel+1, uiOneCtx, uiAbsCtx, uiGoRiceParam, c1Idx, c2Idx ) - rateNow;
 					rateIncDown [ uiBlkPos ] = xGetICRate( uiLevel-1, uiOneCtx, uiAbsCtx, uiGoRiceParam, c1Idx, c2Idx ) - rateNow;
 				}
@@ -9011,6 +9623,80 @@ __inline Int TComTrQuant::xGetICRate  ( UInt                            uiAbsLev
 
 #endif	/// ENd of  #if ETRI_FAST_xGetICRateFUNCTIONS @ 2016 1 30 by Seok 
 
+#if ETRI_RDOQ_CG_BATCH
+/** Get the best level in RD sense with the distortions pre-evaluated by ETRI_xGetCGDistortion
+ * \param dDistMax distortion of uiMaxAbsLevel
+ * \param dDistMaxM1 distortion of uiMaxAbsLevel - 1
+ * \param riRateBest rate of the returned level (valid when the returned level is not zero)
+ * \returns best quantized transform level for given scan position
+ * The comparison order and the cost arithmetic are those of xGetCodedLevel.
+ */
+__inline UInt TComTrQuant::ETRI_xGetCodedLevelBatch ( Double&                 rd64CodedCost,
+                                            Double&                         rd64CodedCost0,
+                                            Double&                         rd64CodedCostSig,
+                                            Double                          dDistMax,
+                                            Double                          dDistMaxM1,
+                                            UInt                            uiMaxAbsLevel,
+                                            UShort                          ui16CtxNumSig,
+                                            UShort                          ui16CtxNumOne,
+                                            UShort                          ui16CtxNumAbs,
+                                            UShort                          ui16AbsGoRice,
+                                            UInt                            c1Idx,
+                                            UInt                            c2Idx,
+                                            Bool                            bLast,
+                                            Int&                            riRateBest   ) const
+{
+	Double dCurrCostSig   = 0; 
+	UInt   uiBestAbsLevel = 0;
+
+	if( !bLast && uiMaxAbsLevel < 3 )
+	{
+		rd64CodedCostSig    = xGetRateSigCoef( 0, ui16CtxNumSig ); 
+		rd64CodedCost       = rd64CodedCost0 + rd64CodedCostSig;
+		if( uiMaxAbsLevel == 0 )
+		{
+			return uiBestAbsLevel;
+		}
+	}
+	else
+	{
+		rd64CodedCost       = MAX_DOUBLE;
+	}
+
+	if( !bLast )
+	{
+		dCurrCostSig        = xGetRateSigCoef( 1, ui16CtxNumSig );
+	}
+
+	Int    iRate      = xGetICRate( uiMaxAbsLevel, ui16CtxNumOne, ui16CtxNumAbs, ui16AbsGoRice, c1Idx, c2Idx );
+	Double dCurrCost  = dDistMax + xGetICost( iRate );
+	dCurrCost        += dCurrCostSig;
+	if( dCurrCost < rd64CodedCost )
+	{
+		uiBestAbsLevel    = uiMaxAbsLevel;
+		rd64CodedCost     = dCurrCost;
+		rd64CodedCostSig  = dCurrCostSig;
+		riRateBest        = iRate;
+	}
+
+	if( uiMaxAbsLevel > 1 )
+	{
+		iRate      = xGetICRate( uiMaxAbsLevel - 1, ui16CtxNumOne, ui16CtxNumAbs, ui16AbsGoRice, c1Idx, c2Idx );
+		dCurrCost  = dDistMaxM1 + xGetICost( iRate );
+		dCurrCost += dCurrCostSig;
+		if( dCurrCost < rd64CodedCost )
+		{
+			uiBestAbsLevel    = uiMaxAbsLevel - 1;
+			rd64CodedCost     = dCurrCost;
+			rd64CodedCostSig  = dCurrCostSig;
+			riRateBest        = iRate;
+		}
+	}
+
+	return uiBestAbsLevel;
+}
+#endif
+
 __inline Double TComTrQuant::xGetRateSigCoeffGroup  ( UShort                    uiSignificanceCoeffGroup,
                                                 UShort                          ui16CtxNumSig ) const
 {
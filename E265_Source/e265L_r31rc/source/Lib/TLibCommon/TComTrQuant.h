@@ -142,6 +142,10 @@ public:
                      Bool        useTransformSkip = false );
 
   Void invtransformNxN( Bool transQuantBypass, TextType eText, UInt uiMode,Pel* rpcResidual, UInt uiStride, TCoeff*   pcCoeff, UInt uiWidth, UInt uiHeight,  Int scalingListType, Bool useTransformSkip = false );
+#if ETRI_SIMD_AVX2 && !MATRIX_MULT
+  Void ETRI_invtransformNxNAddClip( TextType eText, UInt uiMode, TCoeff* pcCoeff, UInt uiWidth, UInt uiHeight, Int scalingListType, Pel* pcPred, UInt uiPredStride, Pel* pcReco, UInt uiRecoStride );
+  Bool ETRI_getTrUseAVX2();		///< True when the SIMD level selects the AVX2 transforms (ETRI_invtransformNxNAddClip is usable)
+#endif
   Void invRecurTransformNxN ( TComDataCU* pcCU, UInt uiAbsPartIdx, TextType eTxt, Pel* rpcResidual, UInt uiAddr,   UInt uiStride, UInt uiWidth, UInt uiHeight,
                              UInt uiMaxTrMode,  UInt uiTrMode, TCoeff* rpcCoeff );
   
@@ -296,6 +300,22 @@ __inline UInt              xGetCodedLevel  ( Double&                         rd6
                                              Int                             iQBits,
                                              Double                          dTemp,
                                              Bool                            bLast        ) const;
+#if ETRI_RDOQ_CG_BATCH
+__inline UInt              ETRI_xGetCodedLevelBatch( Double&                 rd64CodedCost,
+                                             Double&                         rd64CodedCost0,
+                                             Double&                         rd64CodedCostSig,
+                                             Double                          dDistMax,
+                                             Double                          dDistMaxM1,
+                                             UInt                            uiMaxAbsLevel,
+                                             UShort                          ui16CtxNumSig,
+                                             UShort                          ui16CtxNumOne,
+                                             UShort                          ui16CtxNumAbs,
+                                             UShort                          ui16AbsGoRice,
+                                             UInt                            c1Idx,
+                                             UInt                            c2Idx,
+                                             Bool                            bLast,
+                                             Int&                            riRateBest   ) const;
+#endif
 
 #if ETRI_FAST_xGetICRateFUNCTIONS
 __inline Double xGetICRateCost	 ( UInt 						   uiAbsLevel,
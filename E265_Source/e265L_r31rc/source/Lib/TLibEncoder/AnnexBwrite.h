@@ -114,9 +114,14 @@ static std::vector<UInt> ETRI_writeAnnexB(ETRI_StreamInterface& out, const Acces
       size += 3;
     }
 
+#if ETRI_STREAM_OUTPUT
+    out.write((Char *)nalu.m_nalUnitData.data(), UInt(nalu.m_nalUnitData.size()));
+    size += UInt(nalu.m_nalUnitData.size());
+#else
     std::string tmp = nalu.m_nalUnitData.str();
     out.write((Char *)tmp.c_str(), tmp.size());
     size += UInt(nalu.m_nalUnitData.str().size());
+#endif
 
     annexBsizes.push_back(size);
   }
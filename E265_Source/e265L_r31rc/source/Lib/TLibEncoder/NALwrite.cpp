@@ -46,7 +46,12 @@ using namespace std;
 
 static const Char emulation_prevention_three_byte[] = {3};
 
+#if ETRI_STREAM_OUTPUT
+template <class TOutput>
+Void writeNalUnitHeader(TOutput& out, OutputNALUnit& nalu)       // nal_unit_header() to an ostream or an ETRI_EBSPBuffer
+#else
 Void writeNalUnitHeader(ostream& out, OutputNALUnit& nalu)       // nal_unit_header()
+#endif
 {
 TComOutputBitstream bsNALUHeader;
 
@@ -131,6 +136,49 @@ void write(ostream& out, OutputNALUnit& nalu)
   }
 }
 
+#if ETRI_STREAM_OUTPUT
+/**
+ * write nalu into the EBSP buffer out in one pass over the rbsp_bytes.
+ * The emulation_prevention_three_byte's are written on the way instead of being
+ * inserted into the FIFO, which moved the rest of the payload at each insertion.
+ * The output is the same as that of write(ostream&, OutputNALUnit&).
+ */
+void write(ETRI_EBSPBuffer& out, OutputNALUnit& nalu)
+{
+  vector<uint8_t>& rbsp   = nalu.m_Bitstream.getFIFO();
+  UInt  uiNumBytes = UInt(rbsp.size());
+
+  /* header, payload and the usual few emulation_prevention_three_byte's */
+  out.reserve(2 + uiNumBytes + (uiNumBytes >> 6) + 1);
+  writeNalUnitHeader(out, nalu);
+
+  if (uiNumBytes == 0)
+  {
+    return;
+  }
+
+  UInt  uiNumZeros = 0;
+  for (UInt i = 0; i < uiNumBytes; i++)
+  {
+    uint8_t ucByte = rbsp[i];
+    /* 00 00 {00,01,02,03} : the third byte is preceded by 0x03 */
+    if (uiNumZeros == 2 && ucByte <= 3)
+    {
+      out.push(emulation_prevention_three_byte[0]);
+      uiNumZeros = 0;
+    }
+    out.push(ucByte);
+    uiNumZeros = (ucByte == 0) ? (uiNumZeros + 1) : 0;
+  }
+
+  /* 7.4.1.1 : a final 0x03 when the RBSP ends in a cabac_zero_word */
+  if (rbsp.back() == 0x00)
+  {
+    out.push(emulation_prevention_three_byte[0]);
+  }
+}
+#endif
+
 /**
  * Write rbsp_trailing_bits to bs causing it to become byte-aligned
  */
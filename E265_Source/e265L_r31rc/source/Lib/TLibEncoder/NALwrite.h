@@ -72,6 +72,9 @@ struct OutputNALUnit : public NALUnit
 };
 
 void write(std::ostream& out, OutputNALUnit& nalu);
+#if ETRI_STREAM_OUTPUT
+void write(ETRI_EBSPBuffer& out, OutputNALUnit& nalu);
+#endif
 void writeRBSPTrailingBits(TComOutputBitstream& bs);
 
 inline NALUnitEBSP::NALUnitEBSP(OutputNALUnit& nalu)
@@ -348,6 +348,22 @@ protected:
   Bool  	em_bETRI_FullReleaseMode;
   short  	em_sETRI_SliceIndex;
 #endif
+#if ETRI_SCENECUT
+  Int 		em_iETRI_SceneCut;                                ///< Scene-cut threshold in percent of the intra cost (0:Off)
+#endif
+#if ETRI_PYRAMID_ME
+  Bool		em_bETRI_PyramidME;                               ///< Coarse-to-fine pre-search per CTU seeds the TZ search
+#endif
+#if ETRI_MV_CACHE
+  Bool		em_bETRI_MvCache;                                 ///< Motion field of the CTU seeds the searches of sub-CUs and next references
+#endif
+  Bool		em_bETRI_FastCU;                                  ///< Fast CU methods : adaptive CTU size, CU mode inheritance, revised early CU
+  Bool		em_bETRI_AdaptiveCTUSize;                         ///< 64x64 CU by slice depth and no 16x16 split in high layers (with em_bETRI_FastCU)
+  Bool		em_bETRI_Skip64x64LCU;                            ///< Never test the 64x64 CU
+  Bool		em_bETRI_QuarterPelME;                            ///< Quarter-pel refinement after the half-pel one
+  Bool		em_bETRI_HalfPelDiamond;                          ///< Half-pel refinement on 4 diamond points instead of 8 neighbours
+  Bool		em_bETRI_RDOOffBestMergeCand;                     ///< Best merge candidate by HAD before the RDO of SKIP/Merge
+  Bool		em_bETRI_PostESD;                                 ///< Early skip decision after the 2Nx2N inter (with em_bETRI_RDOOffBestMergeCand)
 
 public:
   TEncCfg()
@@ -789,6 +805,32 @@ public:
 #if ETRI_MULTITHREAD_2 || KAIST_RC
 	GOPEntry*  ETRI_getGOPEntry()      { return m_GOPList; }
 #endif
+#if ETRI_SCENECUT
+	Void	ETRI_setSceneCut(Int i)		{ em_iETRI_SceneCut = i; }
+	Int 	ETRI_getSceneCut()			{ return em_iETRI_SceneCut; }
+#endif
+#if ETRI_PYRAMID_ME
+	Void	ETRI_setPyramidME(Bool b)	{ em_bETRI_PyramidME = b; }
+	Bool	ETRI_getPyramidME()			{ return em_bETRI_PyramidME; }
+#endif
+#if ETRI_MV_CACHE
+	Void	ETRI_setMvCache(Bool b)		{ em_bETRI_MvCache = b; }
+	Bool	ETRI_getMvCache()			{ return em_bETRI_MvCache; }
+#endif
+	Void	ETRI_setFastCU(Bool b)				{ em_bETRI_FastCU = b; }
+	Bool	ETRI_getFastCU()					{ return em_bETRI_FastCU; }
+	Void	ETRI_setAdaptiveCTUSize(Bool b)		{ em_bETRI_AdaptiveCTUSize = b; }
+	Bool	ETRI_getAdaptiveCTUSize()			{ return em_bETRI_FastCU && em_bETRI_AdaptiveCTUSize; }
+	Void	ETRI_setSkip64x64LCU(Bool b)		{ em_bETRI_Skip64x64LCU = b; }
+	Bool	ETRI_getSkip64x64LCU()				{ return em_bETRI_Skip64x64LCU; }
+	Void	ETRI_setQuarterPelME(Bool b)		{ em_bETRI_QuarterPelME = b; }
+	Bool	ETRI_getQuarterPelME()				{ return em_bETRI_QuarterPelME; }
+	Void	ETRI_setHalfPelDiamond(Bool b)		{ em_bETRI_HalfPelDiamond = b; }
+	Bool	ETRI_getHalfPelDiamond()			{ return em_bETRI_HalfPelDiamond; }
+	Void	ETRI_setRDOOffBestMergeCand(Bool b)	{ em_bETRI_RDOOffBestMergeCand = b; }
+	Bool	ETRI_getRDOOffBestMergeCand()		{ return em_bETRI_RDOOffBestMergeCand; }
+	Void	ETRI_setPostESD(Bool b)				{ em_bETRI_PostESD = b; }
+	Bool	ETRI_getPostESD()					{ return em_bETRI_RDOOffBestMergeCand && em_bETRI_PostESD; }
 
 	//====== Multiple Tile ========
 #if ETRI_MultiplePPS
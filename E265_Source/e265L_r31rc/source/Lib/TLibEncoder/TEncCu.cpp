@@ -52,6 +52,14 @@ using namespace std;
 // Constructor / destructor / create / destroy
 // ====================================================================================================================
 
+TEncCu::TEncCu()
+{
+#if ETRI_CU_ARENA
+	em_pucCUArena     = NULL;
+	em_pucCUArenaFree = NULL;
+#endif
+}
+
 /**
  \param    uiTotalDepth  total number of allowable depth
  \param    uiMaxWidth    largest CU width
@@ -74,14 +82,33 @@ Void TEncCu::create(UChar uhTotalDepth, UInt uiMaxWidth, UInt uiMaxHeight)
 	m_ppcOrigYuv     = new TComYuv*[m_uhTotalDepth-1];
 
 	UInt uiNumPartitions;
+#if ETRI_CU_ARENA
+	//--------------------------------------------------------------------------------
+	//	One block for the fields of the best, temp and auxiliary CUs (ETRI_createCU) instead of dozens of arrays per CU
+	//--------------------------------------------------------------------------------
+	UInt uiArenaSize = 0;
+	for( i=0 ; i<m_uhTotalDepth-1 ; i++)
+	{
+		uiNumPartitions = 1<<( ( m_uhTotalDepth - i - 1 )<<1 );
+		uiArenaSize += (2 + ETRI_nAXTempCU) * TComDataCU::ETRI_getArenaSize( uiNumPartitions, uiMaxWidth >> i, uiMaxHeight >> i );
+	}
+	em_pucCUArena = (UChar*)_aligned_malloc( uiArenaSize, ETRI_CU_ARENA_ALIGN );
+	memset( em_pucCUArena, 0, uiArenaSize );
+	em_pucCUArenaFree = em_pucCUArena;
+#endif
 	for( i=0 ; i<m_uhTotalDepth-1 ; i++)
 	{
 		uiNumPartitions = 1<<( ( m_uhTotalDepth - i - 1 )<<1 );
 		UInt uiWidth  = uiMaxWidth  >> i;
 		UInt uiHeight = uiMaxHeight >> i;
 
+#if ETRI_CU_ARENA
+		m_ppcBestCU[i] = new TComDataCU; m_ppcBestCU[i]->ETRI_createInArena( uiNumPartitions, uiWidth, uiHeight, uiMaxWidth >> (m_uhTotalDepth - 1), em_pucCUArenaFree );
+		m_ppcTempCU[i] = new TComDataCU; m_ppcTempCU[i]->ETRI_createInArena( uiNumPartitions, uiWidth, uiHeight, uiMaxWidth >> (m_uhTotalDepth - 1), em_pucCUArenaFree );
+#else
 		m_ppcBestCU[i] = new TComDataCU; m_ppcBestCU[i]->create( uiNumPartitions, uiWidth, uiHeight, false, uiMaxWidth >> (m_uhTotalDepth - 1) );
 		m_ppcTempCU[i] = new TComDataCU; m_ppcTempCU[i]->create( uiNumPartitions, uiWidth, uiHeight, false, uiMaxWidth >> (m_uhTotalDepth - 1) );
+#endif
 
 		m_ppcPredYuvBest[i] = new TComYuv; m_ppcPredYuvBest[i]->create(uiWidth, uiHeight);
 		m_ppcResiYuvBest[i] = new TComYuv; m_ppcResiYuvBest[i]->create(uiWidth, uiHeight);
@@ -164,6 +191,12 @@ Void TEncCu::destroy()
 	{
 		delete [] m_ppcTempCU;	m_ppcTempCU = NULL;
 	}
+#if ETRI_CU_ARENA
+	if(em_pucCUArena)
+	{
+		_aligned_free(em_pucCUArena);	em_pucCUArena = NULL;
+	}
+#endif
 	if(m_ppcPredYuvBest)
 	{
 		delete [] m_ppcPredYuvBest;	m_ppcPredYuvBest = NULL;
@@ -284,7 +317,11 @@ void TEncCu::ETRI_createCU 	( UChar uhTotalDepth, UInt uiMaxWidth, UInt uiMaxHei
 			uiWidth  = uiMaxWidth  >> i;
 			uiHeight = uiMaxHeight >> i;
 
+#if ETRI_CU_ARENA
+			m_pppcAxTempCU[j][i]	   	= new TComDataCU; m_pppcAxTempCU[j][i]->ETRI_createInArena( uiNumPartitions, uiWidth, uiHeight, uiMaxWidth >> (m_uhTotalDepth - 1), em_pucCUArenaFree ); 
+#else
 			m_pppcAxTempCU[j][i]	   	= new TComDataCU; m_pppcAxTempCU[j][i]->create( uiNumPartitions, uiWidth, uiHeight, false, uiMaxWidth >> (m_uhTotalDepth - 1) ); 
+#endif
 			m_pppcAxPredYuvTemp[j][i]	= new TComYuv; m_pppcAxPredYuvTemp[j][i]->create(uiWidth, uiHeight);
 		}
 	}
@@ -631,10 +668,10 @@ __inline Void TEncCu::ETRI_Init_CUTopLevel	(TComDataCU*& rpcCU)
 	m_pppcAxTempCU[ETRI_IdAxTempCU_Inter2NxN][0]->initCU( rpcCU->getPic(), rpcCU->getAddr() );
 	m_pppcAxTempCU[ETRI_IdAxTempCU_InterNx2N][0]->initCU( rpcCU->getPic(), rpcCU->getAddr() );
 #endif 
+	em_bLCUSkipFlag |= m_pcEncCfg->ETRI_getSkip64x64LCU();  	///< [TRUE] SKIP 64x64 LCU [FALSE:Original] No SKIP
 #if ETRI_ADAPTIVE_MAXCTU_SIZE
-	em_bLCUSkipFlag |= !(rpcCU->getSlice()->getSliceType() != I_SLICE && rpcCU->getSlice()->getDepth() > ETRI_F64SLiceLevel); 
-#else
-	em_bLCUSkipFlag = ETRI_SKIP_64x64LCU;  	///< [TRUE] SKIP 64x64 LCU [FALSE:Original] No SKIP
+	if (m_pcEncCfg->ETRI_getAdaptiveCTUSize())
+		em_bLCUSkipFlag |= !(rpcCU->getSlice()->getSliceType() != I_SLICE && rpcCU->getSlice()->getDepth() > ETRI_F64SLiceLevel); 
 #endif	
 #endif
 #if	ETRI_MODIFICATION_V03
@@ -646,6 +683,9 @@ __inline Void TEncCu::ETRI_Init_CUTopLevel	(TComDataCU*& rpcCU)
 	em_pcBestUpCU[i] = nullptr;
 
 #endif
+#if ETRI_MV_CACHE
+	m_pcPredSearch->ETRI_resetMvCache();	///< Vectors of the previous CTU must not seed the searches of this one
+#endif
 }
 
 
@@ -716,7 +756,7 @@ __inline	Void TEncCu::ETRI_Init_CUPartitionLevel (TComDataCU*& rpcCU, UInt uiDep
 	memset(em_bControlParam, 	false, ETRI_nControlParam * sizeof(Bool));
 	em_bControlParam[ETRI_Id2NxNProcessing] = ETRI_ENABLE_2NxNNx2NProc;	/// [TRUE:Original] Turn ON Turn 2NxN Processing [FALSE] Turn off 2NxN Processing 
 #if ETRI_ADAPTIVE_MAXCTU_SIZE
-	em_bControlParam[ETRI_IdxMAXCTUSIZE]   = (pcSlice->getSliceType() != I_SLICE && uiDepth == 0 && pcSlice->getDepth() > ETRI_F64SLiceLevel);
+	em_bControlParam[ETRI_IdxMAXCTUSIZE]   = (m_pcEncCfg->ETRI_getAdaptiveCTUSize() && pcSlice->getSliceType() != I_SLICE && uiDepth == 0 && pcSlice->getDepth() > ETRI_F64SLiceLevel);
 #endif
 	//--------------------------------------------------------------------------------
 	//	Initilization em_bSkipMode
@@ -2182,7 +2222,7 @@ __inline Void TEncCu::ETRI_xControlPUProcessing(TComDataCU*& pcCU, UChar uhDepth
 */
 __inline Void TEncCu::ETRI_xCheckEarlySkipDecision(TComDataCU*& rpcBestCU, Bool* earlyDetectionSkipMode, UInt bOP)
 {
-if (!ETRI_FIXED_ESDOFF || !ETRI_POSTESD || !bOP){return;}
+if (!ETRI_FIXED_ESDOFF || !m_pcEncCfg->ETRI_getPostESD() || !bOP){return;}
 
 	UInt uiDepth = rpcBestCU->getDepth(0);
 
@@ -2336,179 +2376,182 @@ __inline Void TEncCu::ETRI_xCheckSkipMerge_PRED( TComDataCU*& rpcBestCU, TComDat
 	for( UInt ui = 0; ui < numValidMergeCand; ++ui )
 	mergeCandBuffer[ui] = 0;
 
-#if ETRI_RDOOffBestMergeCand
-	//--------------------------------------------------------------------
-	//	Check Pseudo SKIP
-	//--------------------------------------------------------------------
-	UInt  	uiWidth = rpcTempCU->getWidth(0);
-	UInt  	uiHeight = rpcTempCU->getHeight(0);
-
-	Int  	uiRDOOffBestMergeCand 	= -1; //To indicate noBestMergCand, set uiRDOOffBestMergeCand to -1
-	double 	dRDOOffBestCost  		= MAX_DOUBLE;  				
-
-	UInt*   	puiLevelInfo = em_uiLevelInfo;
-	puiLevelInfo[ETRI_IdWidTh]   		= m_ppcOrigYuv[uhDepth]->getWidth();		/// Per each Depth ?? 2015 9 2 by Seok
-	puiLevelInfo[ETRI_IdSliceDepth] 	= rpcTempCU->getSlice()->getDepth();
-	puiLevelInfo[ETRI_IdCUDepth]  	= uhDepth;
-	puiLevelInfo[ETRI_IdLevelLuma] 	= puiLevelInfo[ETRI_IdLevelCb] = puiLevelInfo[ETRI_IdLevelCr] = 0;
-
-	for( UInt uiMergeCand = 0; uiMergeCand < numValidMergeCand; ++uiMergeCand )
+	if (m_pcEncCfg->ETRI_getRDOOffBestMergeCand())
 	{
-		ETRI_CheckMergeCandidateonBoundary(rpcTempCU, uiMergeCand, ETRI_SliceEncoder_MVClip);
+		//--------------------------------------------------------------------
+		//	Check Pseudo SKIP
+		//--------------------------------------------------------------------
+		UInt  	uiWidth = rpcTempCU->getWidth(0);
+		UInt  	uiHeight = rpcTempCU->getHeight(0);
 
-		if(mergeCandBuffer[uiMergeCand]==0)
-		{
-			// set MC parameters
-			rpcTempCU->setPredModeSubParts( MODE_INTER, 0, uhDepth ); // interprets depth relative to LCU level
-			rpcTempCU->setPartSizeSubParts( SIZE_2Nx2N, 0, uhDepth ); // interprets depth relative to LCU level
-			rpcTempCU->setMergeFlagSubParts( true, 0, 0, uhDepth ); // interprets depth relative to LCU level
-			rpcTempCU->setMergeIndexSubParts( uiMergeCand, 0, 0, uhDepth ); // interprets depth relative to LCU level
-			rpcTempCU->setInterDirSubParts( uhInterDirNeighbours[uiMergeCand], 0, 0, uhDepth ); // interprets depth relative to LCU level
-			rpcTempCU->getCUMvField( REF_PIC_LIST_0 )->setAllMvField( cMvFieldNeighbours[0 + 2*uiMergeCand], SIZE_2Nx2N, 0, 0 ); // interprets depth relative to rpcTempCU level
-			rpcTempCU->getCUMvField( REF_PIC_LIST_1 )->setAllMvField( cMvFieldNeighbours[1 + 2*uiMergeCand], SIZE_2Nx2N, 0, 0 ); // interprets depth relative to rpcTempCU level
+		Int  	uiRDOOffBestMergeCand 	= -1; //To indicate noBestMergCand, set uiRDOOffBestMergeCand to -1
+		double 	dRDOOffBestCost  		= MAX_DOUBLE;  				
 
-			// do MC
-			m_pcPredSearch->ETRI_SM_motionCompensation(rpcTempCU, m_ppcPredYuvTemp[uhDepth], m_ppcOrigYuv[uhDepth], m_pcRdCost, uiDistortion);
+		UInt*   	puiLevelInfo = em_uiLevelInfo;
+		puiLevelInfo[ETRI_IdWidTh]   		= m_ppcOrigYuv[uhDepth]->getWidth();		/// Per each Depth ?? 2015 9 2 by Seok
+		puiLevelInfo[ETRI_IdSliceDepth] 	= rpcTempCU->getSlice()->getDepth();
+		puiLevelInfo[ETRI_IdCUDepth]  	= uhDepth;
+		puiLevelInfo[ETRI_IdLevelLuma] 	= puiLevelInfo[ETRI_IdLevelCb] = puiLevelInfo[ETRI_IdLevelCr] = 0;
 
-			/// 2014 7 12 by Seok Double Version
-			if( uiDistortion < dRDOOffBestCost )
-			{						 
-				dRDOOffBestCost = uiDistortion;
-				uiRDOOffBestMergeCand = uiMergeCand;			
-				em_uiSMHADDistortion = uiDistortion;
-				em_uiSKLevel[uhDepth] = ETRI_EvalLevel(rpcTempCU, ETRI_IdAxTempCU_Skip, puiLevelInfo);	  /// 2015 3 30 by Seok : Debug for QP Selection between Luma and Chroma
+		for( UInt uiMergeCand = 0; uiMergeCand < numValidMergeCand; ++uiMergeCand )
+		{
+			ETRI_CheckMergeCandidateonBoundary(rpcTempCU, uiMergeCand, ETRI_SliceEncoder_MVClip);
 
-				// Store Best Prediction to Temporal Prediction Buffer
-				m_ppcPredYuvTemp[uhDepth]->copyPartToPartYuv(m_pppcAxPredYuvTemp[ETRI_IdAxTempCU_Skip][uhDepth], 0, uiWidth, uiHeight);
+			if(mergeCandBuffer[uiMergeCand]==0)
+			{
+				// set MC parameters
+				rpcTempCU->setPredModeSubParts( MODE_INTER, 0, uhDepth ); // interprets depth relative to LCU level
+				rpcTempCU->setPartSizeSubParts( SIZE_2Nx2N, 0, uhDepth ); // interprets depth relative to LCU level
+				rpcTempCU->setMergeFlagSubParts( true, 0, 0, uhDepth ); // interprets depth relative to LCU level
+				rpcTempCU->setMergeIndexSubParts( uiMergeCand, 0, 0, uhDepth ); // interprets depth relative to LCU level
+				rpcTempCU->setInterDirSubParts( uhInterDirNeighbours[uiMergeCand], 0, 0, uhDepth ); // interprets depth relative to LCU level
+				rpcTempCU->getCUMvField( REF_PIC_LIST_0 )->setAllMvField( cMvFieldNeighbours[0 + 2*uiMergeCand], SIZE_2Nx2N, 0, 0 ); // interprets depth relative to rpcTempCU level
+				rpcTempCU->getCUMvField( REF_PIC_LIST_1 )->setAllMvField( cMvFieldNeighbours[1 + 2*uiMergeCand], SIZE_2Nx2N, 0, 0 ); // interprets depth relative to rpcTempCU level
+
+				// do MC
+				m_pcPredSearch->ETRI_SM_motionCompensation(rpcTempCU, m_ppcPredYuvTemp[uhDepth], m_ppcOrigYuv[uhDepth], m_pcRdCost, uiDistortion);
+
+				/// 2014 7 12 by Seok Double Version
+				if( uiDistortion < dRDOOffBestCost )
+				{						 
+					dRDOOffBestCost = uiDistortion;
+					uiRDOOffBestMergeCand = uiMergeCand;			
+					em_uiSMHADDistortion = uiDistortion;
+					em_uiSKLevel[uhDepth] = ETRI_EvalLevel(rpcTempCU, ETRI_IdAxTempCU_Skip, puiLevelInfo);	  /// 2015 3 30 by Seok : Debug for QP Selection between Luma and Chroma
+
+					// Store Best Prediction to Temporal Prediction Buffer
+					m_ppcPredYuvTemp[uhDepth]->copyPartToPartYuv(m_pppcAxPredYuvTemp[ETRI_IdAxTempCU_Skip][uhDepth], 0, uiWidth, uiHeight);
+				}
 			}
-		}
 		
-		//setting  mergeCandBuffer[uiMergeCand] for duplicated candidate
-		if(uiMergeCand+1 < numValidMergeCand)
-		{
-			for(UInt ui = 0; ui < uiMergeCand+1;  ui++ )
+			//setting  mergeCandBuffer[uiMergeCand] for duplicated candidate
+			if(uiMergeCand+1 < numValidMergeCand)
 			{
-				UInt uj = uiMergeCand+1;
-				if( (!mergeCandBuffer[ui]) && uhInterDirNeighbours[ui] == uhInterDirNeighbours[uj] &&
-				cMvFieldNeighbours[0 + 2*ui].getRefIdx()	== cMvFieldNeighbours[0 + 2*uj].getRefIdx()  &&
-				cMvFieldNeighbours[0 + 2*ui].getHor()		== cMvFieldNeighbours[0 + 2*uj].getHor() &&
-				cMvFieldNeighbours[0 + 2*ui].getVer()		== cMvFieldNeighbours[0 + 2*uj].getVer() &&
-				cMvFieldNeighbours[1 + 2*ui].getRefIdx()	== cMvFieldNeighbours[1 + 2*uj].getRefIdx() &&
-				cMvFieldNeighbours[1 + 2*ui].getHor()		== cMvFieldNeighbours[1 + 2*uj].getHor() &&
-				cMvFieldNeighbours[1 + 2*ui].getVer()		== cMvFieldNeighbours[1 + 2*uj].getVer() )
+				for(UInt ui = 0; ui < uiMergeCand+1;  ui++ )
 				{
-					mergeCandBuffer[uj]=1;	break;
+					UInt uj = uiMergeCand+1;
+					if( (!mergeCandBuffer[ui]) && uhInterDirNeighbours[ui] == uhInterDirNeighbours[uj] &&
+					cMvFieldNeighbours[0 + 2*ui].getRefIdx()	== cMvFieldNeighbours[0 + 2*uj].getRefIdx()  &&
+					cMvFieldNeighbours[0 + 2*ui].getHor()		== cMvFieldNeighbours[0 + 2*uj].getHor() &&
+					cMvFieldNeighbours[0 + 2*ui].getVer()		== cMvFieldNeighbours[0 + 2*uj].getVer() &&
+					cMvFieldNeighbours[1 + 2*ui].getRefIdx()	== cMvFieldNeighbours[1 + 2*uj].getRefIdx() &&
+					cMvFieldNeighbours[1 + 2*ui].getHor()		== cMvFieldNeighbours[1 + 2*uj].getHor() &&
+					cMvFieldNeighbours[1 + 2*ui].getVer()		== cMvFieldNeighbours[1 + 2*uj].getVer() )
+					{
+						mergeCandBuffer[uj]=1;	break;
+					}
 				}
-			}
-		}	///  if(uiMergeCand+1 < numValidMergeCand)
-	}
+			}	///  if(uiMergeCand+1 < numValidMergeCand)
+		}
 
-	//For Post Processing
-	em_inumValidMergeCand = numValidMergeCand;
-	em_iRDOOffBestMergeCand = uiRDOOffBestMergeCand; 
-	m_pcPredSearch->ETRI_HAD_SetParamforGetLevel(puiLevelInfo[ETRI_IdHADLuma], puiLevelInfo[ETRI_IdHADCb], puiLevelInfo[ETRI_IdHADCr]);		/// 2015 3 31 by Seok : Set Correct HADmard Value for Best Candidate.
-	em_uiHADInfo[ETRI_IdAxTempCU_Skip][ETRI_IdLuma] 	= puiLevelInfo[ETRI_IdHADLuma];
-	em_uiHADInfo[ETRI_IdAxTempCU_Skip][ETRI_IdChromaU] 	= puiLevelInfo[ETRI_IdHADCb];
-	em_uiHADInfo[ETRI_IdAxTempCU_Skip][ETRI_IdChromaV] 	= puiLevelInfo[ETRI_IdHADCr];
+		//For Post Processing
+		em_inumValidMergeCand = numValidMergeCand;
+		em_iRDOOffBestMergeCand = uiRDOOffBestMergeCand; 
+		m_pcPredSearch->ETRI_HAD_SetParamforGetLevel(puiLevelInfo[ETRI_IdHADLuma], puiLevelInfo[ETRI_IdHADCb], puiLevelInfo[ETRI_IdHADCr]);		/// 2015 3 31 by Seok : Set Correct HADmard Value for Best Candidate.
+		em_uiHADInfo[ETRI_IdAxTempCU_Skip][ETRI_IdLuma] 	= puiLevelInfo[ETRI_IdHADLuma];
+		em_uiHADInfo[ETRI_IdAxTempCU_Skip][ETRI_IdChromaU] 	= puiLevelInfo[ETRI_IdHADCb];
+		em_uiHADInfo[ETRI_IdAxTempCU_Skip][ETRI_IdChromaV] 	= puiLevelInfo[ETRI_IdHADCr];
 
 #if ETRI_DEBUG_CODE_CLEANUP
-	if (em_DbgInfo[ETRI_nDBGInfo_ChkPoint])
-	{
-		EDPRINTF(stdout, "puiLevelInfo[ETRI_IdHADLuma] : %d \n", puiLevelInfo[ETRI_IdHADLuma]);
-		EDPRINTF(stdout, "puiLevelInfo[ETRI_IdHADCb] : %d \n", puiLevelInfo[ETRI_IdHADCb]);
-		EDPRINTF(stdout, "puiLevelInfo[ETRI_IdHADCr] : %d \n", puiLevelInfo[ETRI_IdHADCr]);
-	}
+		if (em_DbgInfo[ETRI_nDBGInfo_ChkPoint])
+		{
+			EDPRINTF(stdout, "puiLevelInfo[ETRI_IdHADLuma] : %d \n", puiLevelInfo[ETRI_IdHADLuma]);
+			EDPRINTF(stdout, "puiLevelInfo[ETRI_IdHADCb] : %d \n", puiLevelInfo[ETRI_IdHADCb]);
+			EDPRINTF(stdout, "puiLevelInfo[ETRI_IdHADCr] : %d \n", puiLevelInfo[ETRI_IdHADCr]);
+		}
 #endif 
 
-	//if found the BestMergeCand
-	if (em_iRDOOffBestMergeCand >= 0){
-	//Store Best Estimated Pred YUV to m_ppcPredYuvTemp :: For Merge Processing 
-	m_pppcAxPredYuvTemp[ETRI_IdAxTempCU_Skip][uhDepth]->copyPartToPartYuv(m_ppcPredYuvTemp[uhDepth], 0, rpcTempCU->getWidth(0), rpcTempCU->getHeight(0));
+		//if found the BestMergeCand
+		if (em_iRDOOffBestMergeCand >= 0){
+		//Store Best Estimated Pred YUV to m_ppcPredYuvTemp :: For Merge Processing 
+		m_pppcAxPredYuvTemp[ETRI_IdAxTempCU_Skip][uhDepth]->copyPartToPartYuv(m_ppcPredYuvTemp[uhDepth], 0, rpcTempCU->getWidth(0), rpcTempCU->getHeight(0));
 
-	// Prediction Data in Temp/BestCU and m_ppcPredYuvTemp Copy TO Buffer
-	TComDataCU* rpcSKTempCU = m_pppcAxTempCU[ETRI_IdAxTempCU_Skip][uhDepth];
-	TComDataCU* rpcSMTempCU = m_pppcAxTempCU[ETRI_IdAxTempCU_Merge][uhDepth];	
+		// Prediction Data in Temp/BestCU and m_ppcPredYuvTemp Copy TO Buffer
+		TComDataCU* rpcSKTempCU = m_pppcAxTempCU[ETRI_IdAxTempCU_Skip][uhDepth];
+		TComDataCU* rpcSMTempCU = m_pppcAxTempCU[ETRI_IdAxTempCU_Merge][uhDepth];	
 
-	ETRI_xStoreModeData(rpcSKTempCU, rpcTempCU, uhDepth, ETRI_IdAxTempCU_Skip, SIZE_2Nx2N, true);		
-	ETRI_xStoreModeData(rpcSMTempCU, rpcTempCU, uhDepth, ETRI_IdAxTempCU_Merge, SIZE_2Nx2N, true);		
-	}
+		ETRI_xStoreModeData(rpcSKTempCU, rpcTempCU, uhDepth, ETRI_IdAxTempCU_Skip, SIZE_2Nx2N, true);		
+		ETRI_xStoreModeData(rpcSMTempCU, rpcTempCU, uhDepth, ETRI_IdAxTempCU_Merge, SIZE_2Nx2N, true);		
+		}
 
-	// Clear MergeFlags For other Processing 
-	rpcTempCU->setMergeFlagSubParts( 0, 0, 0, uhDepth ); 
+		// Clear MergeFlags For other Processing 
+		rpcTempCU->setMergeFlagSubParts( 0, 0, 0, uhDepth ); 
 
-#else
-	//--------------------------------------------------------------------
-	//	Check Real SKIP
-	//--------------------------------------------------------------------	
-	
-	UInt	e_uiNumBoundaryCand = 0;// number of invalid cand,  yhee
-	em_iRDOOffBestMergeCand = 0; //orginal 
-	for( UInt uiMergeCand = 0; uiMergeCand < numValidMergeCand; ++uiMergeCand )
+	}
+	else
 	{
+		//--------------------------------------------------------------------
+		//	Check Real SKIP
+		//--------------------------------------------------------------------	
+	
+		UInt	e_uiNumBoundaryCand = 0;// number of invalid cand,  yhee
+		em_iRDOOffBestMergeCand = 0; //orginal 
+		for( UInt uiMergeCand = 0; uiMergeCand < numValidMergeCand; ++uiMergeCand )
+		{
 #if ETRI_SliceEncoder_MVClip
-		//Check the candidate's mv boundary
-		Int iSourceHeight = m_pcEncCfg->getSourceHeight();				
-		TComMv temp = cMvFieldNeighbours[0 + 2 * uiMergeCand].getMv();
-		Bool bBoundary = temp.ETRI_DetectVerMVBoundary(rpcTempCU->getCUPelY(), rpcTempCU->getHeight(0),iSourceHeight);
-		if (bBoundary){
-			mergeCandBuffer[uiMergeCand] = 1; e_uiNumBoundaryCand++; continue;
-		}			
-		else{
-			temp = cMvFieldNeighbours[1 + 2 * uiMergeCand].getMv();			
-			bBoundary = temp.ETRI_DetectVerMVBoundary(rpcTempCU->getCUPelY(), rpcTempCU->getHeight(0), iSourceHeight);
+			//Check the candidate's mv boundary
+			Int iSourceHeight = m_pcEncCfg->getSourceHeight();				
+			TComMv temp = cMvFieldNeighbours[0 + 2 * uiMergeCand].getMv();
+			Bool bBoundary = temp.ETRI_DetectVerMVBoundary(rpcTempCU->getCUPelY(), rpcTempCU->getHeight(0),iSourceHeight);
 			if (bBoundary){
 				mergeCandBuffer[uiMergeCand] = 1; e_uiNumBoundaryCand++; continue;
-			}
-		}		
+			}			
+			else{
+				temp = cMvFieldNeighbours[1 + 2 * uiMergeCand].getMv();			
+				bBoundary = temp.ETRI_DetectVerMVBoundary(rpcTempCU->getCUPelY(), rpcTempCU->getHeight(0), iSourceHeight);
+				if (bBoundary){
+					mergeCandBuffer[uiMergeCand] = 1; e_uiNumBoundaryCand++; continue;
+				}
+			}		
 #endif
-		// set MC parameters
-		rpcTempCU->setPredModeSubParts( MODE_INTER, 0, uhDepth ); // interprets depth relative to LCU level
-		rpcTempCU->setPartSizeSubParts( SIZE_2Nx2N, 0, uhDepth ); // interprets depth relative to LCU level
-		rpcTempCU->setMergeFlagSubParts( true, 0, 0, uhDepth ); // interprets depth relative to LCU level
-		rpcTempCU->setMergeIndexSubParts( uiMergeCand, 0, 0, uhDepth ); // interprets depth relative to LCU level
-		rpcTempCU->setInterDirSubParts( uhInterDirNeighbours[uiMergeCand], 0, 0, uhDepth ); // interprets depth relative to LCU level
-		rpcTempCU->getCUMvField( REF_PIC_LIST_0 )->setAllMvField( cMvFieldNeighbours[0 + 2*uiMergeCand], SIZE_2Nx2N, 0, 0 ); // interprets depth relative to rpcTempCU level
-		rpcTempCU->getCUMvField( REF_PIC_LIST_1 )->setAllMvField( cMvFieldNeighbours[1 + 2*uiMergeCand], SIZE_2Nx2N, 0, 0 ); // interprets depth relative to rpcTempCU level
-
-		// do MC
-		m_pcPredSearch->ETRI_SM_motionCompensation(rpcTempCU, m_ppcPredYuvTemp[uhDepth], m_ppcOrigYuv[uhDepth], m_pcRdCost, uiDistortion);
-
-		// estimate residual and encode everything
-		m_pcPredSearch->encodeResAndCalcRdInterCU( rpcTempCU,
-		m_ppcOrigYuv    [uhDepth],
-		m_ppcPredYuvTemp[uhDepth],
-		m_ppcResiYuvTemp[uhDepth],
-		m_ppcResiYuvBest[uhDepth],
-		m_ppcRecoYuvTemp[uhDepth],
-		false);
-
-		rpcTempCU->setSkipFlagSubParts( rpcTempCU->getQtRootCbf(0) == 0, 0, uhDepth );
-		Int orgQP = rpcTempCU->getQP( 0 );
-		xCheckDQP( rpcTempCU );
-		xCheckBestMode(rpcBestCU, rpcTempCU, uhDepth);
-		rpcTempCU->initEstData( uhDepth, orgQP, false );
-
-		// If no residual when allowing for one, then set mark to not try case where residual is forced to 0
-		if (rpcBestCU->getQtRootCbf(0) == 0 )	{mergeCandBuffer[uiMergeCand] = 1;	em_iRDOOffBestMergeCand = uiMergeCand; break;}
+			// set MC parameters
+			rpcTempCU->setPredModeSubParts( MODE_INTER, 0, uhDepth ); // interprets depth relative to LCU level
+			rpcTempCU->setPartSizeSubParts( SIZE_2Nx2N, 0, uhDepth ); // interprets depth relative to LCU level
+			rpcTempCU->setMergeFlagSubParts( true, 0, 0, uhDepth ); // interprets depth relative to LCU level
+			rpcTempCU->setMergeIndexSubParts( uiMergeCand, 0, 0, uhDepth ); // interprets depth relative to LCU level
+			rpcTempCU->setInterDirSubParts( uhInterDirNeighbours[uiMergeCand], 0, 0, uhDepth ); // interprets depth relative to LCU level
+			rpcTempCU->getCUMvField( REF_PIC_LIST_0 )->setAllMvField( cMvFieldNeighbours[0 + 2*uiMergeCand], SIZE_2Nx2N, 0, 0 ); // interprets depth relative to rpcTempCU level
+			rpcTempCU->getCUMvField( REF_PIC_LIST_1 )->setAllMvField( cMvFieldNeighbours[1 + 2*uiMergeCand], SIZE_2Nx2N, 0, 0 ); // interprets depth relative to rpcTempCU level
 
-	}
+			// do MC
+			m_pcPredSearch->ETRI_SM_motionCompensation(rpcTempCU, m_ppcPredYuvTemp[uhDepth], m_ppcOrigYuv[uhDepth], m_pcRdCost, uiDistortion);
+
+			// estimate residual and encode everything
+			m_pcPredSearch->encodeResAndCalcRdInterCU( rpcTempCU,
+			m_ppcOrigYuv    [uhDepth],
+			m_ppcPredYuvTemp[uhDepth],
+			m_ppcResiYuvTemp[uhDepth],
+			m_ppcResiYuvBest[uhDepth],
+			m_ppcRecoYuvTemp[uhDepth],
+			false);
+
+			rpcTempCU->setSkipFlagSubParts( rpcTempCU->getQtRootCbf(0) == 0, 0, uhDepth );
+			Int orgQP = rpcTempCU->getQP( 0 );
+			xCheckDQP( rpcTempCU );
+			xCheckBestMode(rpcBestCU, rpcTempCU, uhDepth);
+			rpcTempCU->initEstData( uhDepth, orgQP, false );
+
+			// If no residual when allowing for one, then set mark to not try case where residual is forced to 0
+			if (rpcBestCU->getQtRootCbf(0) == 0 )	{mergeCandBuffer[uiMergeCand] = 1;	em_iRDOOffBestMergeCand = uiMergeCand; break;}
+
+		}
 
-	em_inumValidMergeCand = numValidMergeCand;
+		em_inumValidMergeCand = numValidMergeCand;
 
 #if ETRI_SliceEncoder_MVClip		
-	if (e_uiNumBoundaryCand == numValidMergeCand)
-		em_iRDOOffBestMergeCand = -1;
-	else
+		if (e_uiNumBoundaryCand == numValidMergeCand)
+			em_iRDOOffBestMergeCand = -1;
+		else
 #endif
-	{
-		// Prediction Data in Temp/BestCU and m_ppcPredYuvTemp Copy TO Buffer
-		TComDataCU* rpcSKTempCU = m_pppcAxTempCU[ETRI_IdAxTempCU_Skip][uhDepth];
-		TComDataCU* rpcSMTempCU = m_pppcAxTempCU[ETRI_IdAxTempCU_Merge][uhDepth];
+		{
+			// Prediction Data in Temp/BestCU and m_ppcPredYuvTemp Copy TO Buffer
+			TComDataCU* rpcSKTempCU = m_pppcAxTempCU[ETRI_IdAxTempCU_Skip][uhDepth];
+			TComDataCU* rpcSMTempCU = m_pppcAxTempCU[ETRI_IdAxTempCU_Merge][uhDepth];
 
-		ETRI_xStoreModeData(rpcSKTempCU, rpcBestCU, uhDepth, ETRI_IdAxTempCU_Skip, SIZE_2Nx2N, true);
-		ETRI_xStoreModeData(rpcSMTempCU, rpcBestCU, uhDepth, ETRI_IdAxTempCU_Merge, SIZE_2Nx2N, true);
+			ETRI_xStoreModeData(rpcSKTempCU, rpcBestCU, uhDepth, ETRI_IdAxTempCU_Skip, SIZE_2Nx2N, true);
+			ETRI_xStoreModeData(rpcSMTempCU, rpcBestCU, uhDepth, ETRI_IdAxTempCU_Merge, SIZE_2Nx2N, true);
+		}
 	}
-#endif
 
 }
 /**
@@ -2522,13 +2565,14 @@ __inline Void TEncCu::ETRI_xCheckSkipMerge_PRED( TComDataCU*& rpcBestCU, TComDat
 */
 __inline Void TEncCu::ETRI_xCheckSkipMerge_RDOQ( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, UInt uhDepth)
 {
+	/// Without RDOOffBestMergeCand the SKIP/Merge RDO is done by ETRI_xCheckSkipMerge_PRED
+	if (!m_pcEncCfg->ETRI_getRDOOffBestMergeCand()) { return; }
 
-#if ETRI_RDOOffBestMergeCand
 	//------------------------------------------------------------------------------------------------------------
 	//	Control Logic : Fast ESD is not perfectly operated owing to the QP range. 
 	//	Therefore, in spite of logical inconsistency, we use the em_bSkipMode[ETRI_IdAxTempCU_Merge]= false : always to control this function.
 	//------------------------------------------------------------------------------------------------------------
-	if ((ETRI_FRDOOffBestMergeCand || ETRI_SliceEncoder_MVClip) && em_bSkipMode[ETRI_IdAxTempCU_Merge]) { return; }
+	if (em_bSkipMode[ETRI_IdAxTempCU_Merge]) { return; }
 
 	Int*			mergeCandBuffer 		= em_pimergeCandBuffer;
 
@@ -2573,7 +2617,6 @@ __inline Void TEncCu::ETRI_xCheckSkipMerge_RDOQ( TComDataCU*& rpcBestCU, TComDat
 	if (em_uiSKLevel[uhDepth] >  ETRI_TH_MERGEMODE && !em_bControlParam[ETRI_IdEarlyMerge])
 	EDPRINTF(stderr, "Merge Logical Error SK Level > 5 : %d \n", em_uiSKLevel[uhDepth]); 
 #endif 
-#endif
 }
 
 /**
@@ -2677,7 +2720,7 @@ __inline Void TEncCu::ETRI_xCheckOnlySKIP_RDOQ( TComDataCU*& rpcBestCU, TComData
 	//--------------------------------------------------------------------
 	//	Standard Processing in HM 
 	//--------------------------------------------------------------------
-	if ((ETRI_FRDOOffBestMergeCand || ETRI_SliceEncoder_MVClip) && em_bSkipMode[ETRI_IdAxTempCU_Skip]) { return; }
+	if ((m_pcEncCfg->ETRI_getRDOOffBestMergeCand() || ETRI_SliceEncoder_MVClip) && em_bSkipMode[ETRI_IdAxTempCU_Skip]) { return; }
 
 	TComMvField* 	cMvFieldNeighbours		= em_pcMvFieldNeighbours;
 	UChar*			uhInterDirNeighbours	= em_puhInterDirNeighbours;
@@ -2898,7 +2941,7 @@ __inline void TEncCu::ETRI_Normal_INTERProcess( TComDataCU*& rpcBestCU, TComData
 	//	Prediction Stage 
 	//	Jinwuk Seok 2015 0801
 	//--------------------------------------------------------------------------------
-	UInt 	uiFastESDId = (( ETRI_FPOSTESD ) << 1);	///< SKIP/Merge Prediction  ESD   Check ϴ  @ 2015 9 3 by Seok
+	UInt 	uiFastESDId = (( (UInt)m_pcEncCfg->ETRI_getPostESD() ) << 1);	///< SKIP/Merge Prediction  ESD   Check ϴ  @ 2015 9 3 by Seok
 
 	// do inter modes, SKIP and 2Nx2N
 	if( rpcBestCU->getSlice()->getSliceType() != I_SLICE )
@@ -2989,7 +3032,7 @@ __inline void TEncCu::ETRI_Normal_INTERProcess( TComDataCU*& rpcBestCU, TComData
 #endif 
 
 		// POST ESD :: Fast ESD is operated the above : following the SKIPMerge Prediction (ETRI_xCheckSkipMerge_PRED)
-		ETRI_xCheckEarlySkipDecision(rpcBestCU, &earlyDetectionSkipMode, ETRI_POSTESD);
+		ETRI_xCheckEarlySkipDecision(rpcBestCU, &earlyDetectionSkipMode, m_pcEncCfg->ETRI_getPostESD());
 
 #if !ETRI_PU_2NxN_Nx2N_CODE_CLEANUP
 		// Inter[2NxN][Nx2N] RDOQ : Including ETRI_xControlPUProcessing :: ETRI_MODIFICATION_V03 Only
@@ -3770,25 +3813,32 @@ Void TEncCu::ETRI_xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, U
 #endif 
 		// Early CU determination :: ECU : TRUE
 #if ETRI_REVISE_ECU
+		if (m_pcEncCfg->ETRI_getFastCU())
+		{
 #if ETRI_REVISE_ECU_INTRA_CHECKING
-        bSubBranch = !(( m_pcEncCfg->getUseEarlyCU() && rpcBestCU->getCbf( 0, TEXT_LUMA ) == 0 && rpcBestCU->getPredictionMode(0) != (PredMode)SIZE_NONE )||
-            (rpcBestCU->getPredictionMode(0) == MODE_INTRA && rpcBestCU->getSlice()->getDepth()==0 && rpcBestCU->getSlice()->getSliceType()!=I_SLICE && uiDepth==2)); 
+			bSubBranch = !(( m_pcEncCfg->getUseEarlyCU() && rpcBestCU->getCbf( 0, TEXT_LUMA ) == 0 && rpcBestCU->getPredictionMode(0) != (PredMode)SIZE_NONE )||
+				(rpcBestCU->getPredictionMode(0) == MODE_INTRA && rpcBestCU->getSlice()->getDepth()==0 && rpcBestCU->getSlice()->getSliceType()!=I_SLICE && uiDepth==2)); 
 #else 
-		bSubBranch = !( m_pcEncCfg->getUseEarlyCU() && rpcBestCU->getCbf( 0, TEXT_LUMA ) == 0 && rpcBestCU->getPredictionMode(0) != (PredMode)SIZE_NONE ); 
+			bSubBranch = !( m_pcEncCfg->getUseEarlyCU() && rpcBestCU->getCbf( 0, TEXT_LUMA ) == 0 && rpcBestCU->getPredictionMode(0) != (PredMode)SIZE_NONE ); 
 #endif 
+		}
+		else
+		{
+			bSubBranch = !( m_pcEncCfg->getUseEarlyCU() && rpcBestCU->isSkipped(0) ); 
+		}
 #else 
 		bSubBranch = !( m_pcEncCfg->getUseEarlyCU() && rpcBestCU->isSkipped(0) ); 
 #endif 
 #if ETRI_ADAPTIVE_MINCTU_SIZE
 #if ETRI_ADAPTIVE_CTU_SIZE_BUGFIX
-		if (rpcBestCU->getSlice()->getDepth() > 1 && (rpcBestCU->getWidth(0) == 16 && uiDepth == 2))
+		if (m_pcEncCfg->ETRI_getAdaptiveCTUSize() && rpcBestCU->getSlice()->getDepth() > 1 && (rpcBestCU->getWidth(0) == 16 && uiDepth == 2))
 #else 
-		if (rpcBestCU->getSlice()->getDepth() > 1 && (rpcBestCU->getWidth(uiDepth) == 16 && uiDepth == 2))
+		if (m_pcEncCfg->ETRI_getAdaptiveCTUSize() && rpcBestCU->getSlice()->getDepth() > 1 && (rpcBestCU->getWidth(uiDepth) == 16 && uiDepth == 2))
 #endif 
 			bSubBranch = false;
 #endif 
 #if ETRI_CU_INTRA_MODE_INHERITANCE
-		if (uiDepth == 1 && rpcBestCU->getPredictionMode(0) == MODE_INTRA && bSubBranch == true)
+		if (m_pcEncCfg->ETRI_getFastCU() && uiDepth == 1 && rpcBestCU->getPredictionMode(0) == MODE_INTRA && bSubBranch == true)
 		{
 			em_bDoInterModeFlag = false;
 		}
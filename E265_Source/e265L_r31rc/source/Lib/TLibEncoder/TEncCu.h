@@ -72,6 +72,10 @@ private:
 
   TComDataCU**  			m_ppcBestCU;  		///< Best CUs in each depth
   TComDataCU**  			m_ppcTempCU; 		///< Temporary CUs in each depth
+#if ETRI_CU_ARENA
+  UChar*					em_pucCUArena;		///< Fields of the best, temp and auxiliary CUs
+  UChar*					em_pucCUArenaFree;	///< Next free byte of em_pucCUArena during create()
+#endif
   UChar  					m_uhTotalDepth;
 
   TComYuv**     			m_ppcPredYuvBest; 	///< Best Prediction Yuv for each depth
@@ -168,6 +172,8 @@ private:
   // ====================================================================================================================
 
 public:
+  TEncCu();
+
   /// copy parameters from encoder class
 #if ETRI_MULTITHREAD_2
   Void  init(TEncTop* pcEncTop, TEncFrame* pcEncFrame);	// gplusplus
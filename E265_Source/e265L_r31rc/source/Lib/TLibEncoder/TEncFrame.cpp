@@ -40,6 +40,7 @@
 #include "NALwrite.h"
 
 #include <time.h>
+#include <math.h>
 
 //! \ingroup TLibEncoder
 //! \{
@@ -92,6 +93,9 @@ TEncFrame::TEncFrame()
 	accumNalsDU 		= nullptr;
 
 	em_dEncTime  		= 0.0;
+#if ETRI_FRAME_ROW_THREADING
+	em_bRowSync			= false;
+#endif
 #if ETRI_DLL_INTERFACE	// 2013 10 23 by Seok
 	FrameTypeInGOP		= 0;
 	FramePOC			= 0;
@@ -212,6 +216,9 @@ Void TEncFrame::create(TEncTop* pcEncTop)
 		em_pcTileEncoder[uiTileIdx].ETRI_getTotalNumbetOfTile() = uiNumTile;
 		em_pcTileEncoder[uiTileIdx].create();
 	}
+#if ETRI_WPP_PARALLEL
+	em_cWPPEncoder.create(e_pcEncTop);
+#endif
 }
 #else
 Void 	TEncFrame::create()
@@ -231,6 +238,9 @@ Void TEncFrame::destroy()
 		em_pcTileEncoder[uiTileIdx].destroy(ETRI_MODIFICATION_V00);
 		//EDPRINTF(stderr, "em_pcTileEncoder[%d].destroy	OK \n", uiTileIdx);
 	}
+#if ETRI_WPP_PARALLEL
+	em_cWPPEncoder.destroy();
+#endif
 
 	em_cSliceEncoder.destroy();
 	em_cCuEncoder.destroy();
@@ -351,6 +361,9 @@ Void TEncFrame::init(TEncGOP* pcGOPEncoder)
 	{
 		em_pcTileEncoder[uiTileIdx].init(em_pcEncTop, uiTileIdx, ETRI_MODIFICATION_V00);
 	}
+#if ETRI_WPP_PARALLEL
+	em_cWPPEncoder.init(em_pcEncTop);
+#endif
 
 #if 0 //ETRI_E265_PH01
 	EDPRINTF(stderr, "------------------------------------------ \n");
@@ -548,6 +561,9 @@ void TEncFrame::ETRI_SetReferencePictureSetforSlice(TComPic* pcPic, TComSlice* p
 	pcSlice->decodingRefreshMarking(em_pocCRA, em_bRefreshPending, rcListPic);
 	em_pcEncTop->selectReferencePictureSet(pcSlice, pocCurr, iGOPid);
 	pcSlice->getRPS()->setNumberOfLongtermPictures(0);
+#if ETRI_SCENECUT
+	em_pcGOPEncoder->ETRI_trimSceneCutRPS(pcSlice);
+#endif
 #if EFFICIENT_FIELD_IRAP
 #else
 #if FIX1172
@@ -829,7 +845,7 @@ Void TEncFrame::ETRI_RateControlSlice(Int pocCurr, TComPic* pcPic, TComSlice* pc
 	tRCPic->m_POC = pocCurr;
 	tRCPic->m_frameLevel = frameLevel;
 
-#if !KAIST_USEPREPS
+#if !KAIST_USEPREPS || ETRI_LOOKAHEAD
 	Int targetBits = tRCPic->calcFrameTargetBit(pocCurr);
 	if (targetBits < 200)
 		targetBits = 200;   // at least allocate 200 bits for picture data
@@ -967,7 +983,7 @@ Void TEncFrame::ETRI_RateControlSlice(Int pocCurr, TComPic* pcPic, TComSlice* pc
 	tRCPic->m_POC = pocCurr;
 	tRCPic->m_frameLevel = frameLevel;
 
-#if !KAIST_USEPREPS
+#if !KAIST_USEPREPS || ETRI_LOOKAHEAD
 	Int targetBits = tRCPic->calcFrameTargetBit(pocCurr);
 	if (targetBits < 200)
 		targetBits = 200;   // at least allocate 200 bits for picture data
@@ -1304,6 +1320,121 @@ void TEncFrame::ETRI_SetNextSlice_with_IF(TComPic* pcPic, TComSlice*& pcSlice, E
 }
 
 
+#if ETRI_FRAME_ROW_THREADING
+/**
+------------------------------------------------------------------------------------------------------------------------------------------------
+	@brief: When frames may start before their references are complete (TEncGOP::ETRI_getRowThreading), 
+			the tile encoders report every compressed CTU to em_cRowSync, which deblocks the CTU rows in raster order 
+			and publishes them in the reconstructed picture. Then ETRI_LoopFilter has nothing left to filter.
+------------------------------------------------------------------------------------------------------------------------------------------------
+*/
+Void TEncFrame::ETRI_InitRowSync(TComPic* pcPic, TComSlice* pcSlice)
+{
+	UInt uiNumTile = em_pcTileEncoder[0].ETRI_getTotalNumbetOfTile();
+
+	em_bRowSync = em_pcGOPEncoder->ETRI_getRowThreading();
+	if (em_bRowSync)
+	{
+		Bool bLFCrossTileBoundary = pcSlice->getPPS()->getLoopFilterAcrossTilesEnabledFlag();
+#if ETRI_OMP_DEBLK_FOR_MULTITHREAD_2
+		em_cLoopFilter[0].setCfg(bLFCrossTileBoundary);
+		em_cRowSync.init(pcPic, &em_cLoopFilter[0]);
+#else
+		em_cLoopFilter.setCfg(bLFCrossTileBoundary);
+		em_cRowSync.init(pcPic, &em_cLoopFilter);
+#endif
+	}
+
+	for (UInt uiTileIdx = 0; uiTileIdx < uiNumTile; uiTileIdx++)
+	{
+		em_pcTileEncoder[uiTileIdx].ETRI_setRowSync(em_bRowSync ? &em_cRowSync : NULL);
+	}
+#if ETRI_WPP_PARALLEL
+	em_cWPPEncoder.ETRI_setRowSync(em_bRowSync ? &em_cRowSync : NULL);
+#endif
+}
+#endif
+
+#if ETRI_PICTURE_TASK_THREADPOOL
+/**
+------------------------------------------------------------------------------------------------------------------------------------------------
+	@brief: A picture-level process (EncPicTask) is split into MAX_NUM_THREAD CTU ranges processed by jobs of the GOP thread pool, 
+			instead of an OpenMP team per frame thread. The threads of all frames are bounded by the pool.
+			Each deblocking job uses its own em_cLoopFilter[] buffers.
+------------------------------------------------------------------------------------------------------------------------------------------------
+*/
+Void TEncFrame::ETRI_runPictureTask(TComPic* pcPic, Int iTask)
+{
+	const int nJob = MAX_NUM_THREAD;
+
+	pthread_mutex_t taskMutex = PTHREAD_MUTEX_INITIALIZER;
+	pthread_cond_t  taskCond = PTHREAD_COND_INITIALIZER;
+	int iEndCount = 0;
+
+	EncTileInfo taskInfo;
+	taskInfo.endCount = &iEndCount;
+	taskInfo.mutex = &taskMutex;
+	taskInfo.cond = &taskCond;
+	taskInfo.nTile = nJob;
+
+	for (int i = 0; i < nJob; i++)
+	{
+		taskInfo.id = i;
+#if ETRI_OMP_DEBLK_FOR_MULTITHREAD_2
+		em_pcGOPEncoder->m_qrThreadpool->run(EncPicTaskJob::createJob(pcPic, &em_cLoopFilter[i], iTask, taskInfo));
+#else
+		em_pcGOPEncoder->m_qrThreadpool->run(EncPicTaskJob::createJob(pcPic, &em_cLoopFilter, iTask, taskInfo));
+#endif
+	}
+
+	pthread_mutex_lock(&taskMutex);
+	while (iEndCount < nJob)
+	{
+		pthread_cond_wait(&taskCond, &taskMutex);
+	}
+	pthread_mutex_unlock(&taskMutex);
+}
+
+EncPicTaskJob::EncPicTaskJob(TComPic *pcPic, TComLoopFilter *pcLoopFilter, int iTask, EncTileInfo info)
+{
+	m_encInfo = info;
+	m_pcPic = pcPic;
+	m_pcLoopFilter = pcLoopFilter;
+	m_iTask = iTask;
+}
+
+void EncPicTaskJob::run(void *)
+{
+	EncTileInfo info = m_encInfo;
+	UInt uiNumCU = m_pcPic->getNumCUsInFrame();
+	UInt uiStartCUAddr = uiNumCU * info.id / info.nTile;
+	UInt uiEndCUAddr = uiNumCU * (info.id + 1) / info.nTile;
+
+	switch (m_iTask)
+	{
+#if ETRI_OMP_DEBLK
+	case ETRI_PICTASK_DEBLOCK_VER:		m_pcLoopFilter->ETRI_loopFilterCUs(m_pcPic, false, uiStartCUAddr, uiEndCUAddr);	break;
+	case ETRI_PICTASK_DEBLOCK_HOR:		m_pcLoopFilter->ETRI_loopFilterCUs(m_pcPic, true,  uiStartCUAddr, uiEndCUAddr);	break;
+#endif
+	case ETRI_PICTASK_COMPRESS_MOTION:	m_pcPic->compressMotion(uiStartCUAddr, uiEndCUAddr);	break;
+	default: assert(0);
+	}
+
+	pthread_mutex_lock(info.mutex);
+	if (++(*(info.endCount)) == info.nTile)
+	{
+		pthread_cond_broadcast(info.cond);
+	}
+	pthread_mutex_unlock(info.mutex);
+}
+
+EncPicTaskJob* EncPicTaskJob::createJob(TComPic *pcPic, TComLoopFilter *pcLoopFilter, int iTask, EncTileInfo info)
+{
+	EncPicTaskJob *job = new EncPicTaskJob(pcPic, pcLoopFilter, iTask, info);
+	return job;
+}
+#endif
+
 /**
 ------------------------------------------------------------------------------------------------------------------------------------------------
 	@brief: Loop Filter and Gather the statistical Information of SAO Process
@@ -1315,6 +1446,13 @@ void TEncFrame::ETRI_SetNextSlice_with_IF(TComPic* pcPic, TComSlice*& pcSlice, E
 void TEncFrame::ETRI_LoopFilter(TComPic* pcPic, TComSlice*& pcSlice, ETRI_SliceInfo& ReturnValue)
 {
 #if ETRI_MULTITHREAD_2
+#if ETRI_FRAME_ROW_THREADING
+	if (em_bRowSync)
+	{
+		em_cRowSync.finish();		///CTU rows are deblocked during the compression. Remaining rows only.
+		return;
+	}
+#endif
 	// SAO parameter estimation using non-deblocked pixels for LCU bottom and right boundary areas
 	if( pcSlice->getSPS()->getUseSAO() && em_pcEncTop->getSaoLcuBoundary()){
 		em_cEncSAO.getPreDBFStatistics(pcPic);
@@ -1332,7 +1470,10 @@ void TEncFrame::ETRI_LoopFilter(TComPic* pcPic, TComSlice*& pcSlice, ETRI_SliceI
 	{
 		em_pcGOPEncoder->dblMetric(pcPic, *ReturnValue.uiNumSlices);
 	}
-#if ETRI_OMP_DEBLK_FOR_MULTITHREAD_2
+#if ETRI_PICTURE_TASK_THREADPOOL && ETRI_OMP_DEBLK_FOR_MULTITHREAD_2
+	ETRI_runPictureTask(pcPic, ETRI_PICTASK_DEBLOCK_VER);
+	ETRI_runPictureTask(pcPic, ETRI_PICTASK_DEBLOCK_HOR);
+#elif ETRI_OMP_DEBLK_FOR_MULTITHREAD_2
 	em_cLoopFilter[0].loopFilterPic(pcPic, em_cLoopFilter);
 #else 
 	em_cLoopFilter.loopFilterPic( pcPic );
@@ -3443,7 +3584,9 @@ __inline Void TEncFrame::ETRI_UpdateSliceAfterCompression(TComPic*& pcPic, TComS
 ------------------------------------------------------------------------------------------------------------------------------------------------
 */
 #if ETRI_MULTITHREAD_2
-#if ETRI_THREADPOOL_OPT
+#if ETRI_THREADPOOL_OPT && ETRI_FRAME_EVENT_SYNC
+Void TEncFrame::ETRI_CompressFrame(Int pocCurr, TComPic* pcPic, TComPicYuv* pcPicYuvRecOut, TComList<TComPic*>& rcListPic, std::list<AccessUnit>& accessUnitsInGOP, Bool bFirst, EncFrameSync *frameSync, QphotoThreadPool *threadpool, Bool bDefault)
+#elif ETRI_THREADPOOL_OPT
 Void TEncFrame::ETRI_CompressFrame(Int pocCurr, TComPic* pcPic, TComPicYuv* pcPicYuvRecOut, TComList<TComPic*>& rcListPic, std::list<AccessUnit>& accessUnitsInGOP, Bool bFirst, pthread_mutex_t *mutex, pthread_cond_t *cond, int *bRefPicAvailable, QphotoThreadPool *threadpool, Bool bDefault)
 #else
 Void TEncFrame::ETRI_CompressFrame(Int pocCurr, TComPic* pcPic, TComPicYuv* pcPicYuvRecOut, TComList<TComPic*>& rcListPic, std::list<AccessUnit>& accessUnitsInGOP, Bool bFirst, Bool bDefault)
@@ -3548,6 +3691,15 @@ Void TEncFrame::ETRI_CompressFrame(Int iTimeOffset, Int pocCurr, TComPic* pcPic,
 	}
 
 	pcSlice->setRefPicBorder(rcListPic);  // gplusplus
+
+#if ETRI_FRAME_ROW_THREADING
+	/// References may still be encoded. Samples are waited per CTU row in the prediction, 
+	/// but the collocated motion is compressed after the entropy coding, so the collocated picture must be complete. 
+	if (em_pcGOPEncoder->ETRI_getRowThreading() && pcSlice->getEnableTMVPFlag() && !pcSlice->isIntra())
+	{
+		pcSlice->getRefPic(RefPicList(pcSlice->isInterB() ? 1 - pcSlice->getColFromL0Flag() : 0), pcSlice->getColRefIdx())->getPicYuvRec()->ETRI_waitRowReady(ETRI_ROW_READY_ALL);
+	}
+#endif
 #else
 	//	Slice data initialization
 	pcPic->clearSliceBuffer();
@@ -3689,6 +3841,10 @@ Void TEncFrame::ETRI_CompressFrame(Int iTimeOffset, Int pocCurr, TComPic* pcPic,
 	FrameEncodingOrder = em_iGOPid;
 #endif
 
+#if ETRI_FRAME_ROW_THREADING
+	ETRI_InitRowSync(pcPic, pcSlice);												///Deblock CTU rows during the compression when referenced by frames in flight
+#endif
+
 	while(nextCUAddr<uiRealEndAddress)   	    					     		///determine slice boundaries : Multiple Slice Encoding is somewhat difficult @ 2015 5 14 by Seok
 	{
 		pcSlice->setNextSlice		( false );
@@ -3784,7 +3940,13 @@ Void TEncFrame::ETRI_CompressFrame(Int iTimeOffset, Int pocCurr, TComPic* pcPic,
 
 #if ETRI_MOTION_COMORESSION
     if (pcSlice->getSliceType() != I_SLICE && pcPic->getSlice(0)->getDepth() != 3)
+#if ETRI_PICTURE_TASK_THREADPOOL
+        ETRI_runPictureTask(pcPic, ETRI_PICTASK_COMPRESS_MOTION);
+#else
         pcPic->compressMotion();
+#endif
+#elif ETRI_PICTURE_TASK_THREADPOOL
+	ETRI_runPictureTask(pcPic, ETRI_PICTASK_COMPRESS_MOTION);
 #else 
 	pcPic->compressMotion();
 #endif 
@@ -3818,10 +3980,18 @@ Void TEncFrame::ETRI_CompressFrame(Int iTimeOffset, Int pocCurr, TComPic* pcPic,
 	}
 #else
 	pcPic->getPicYuvRec()->copyToPic(pcPicYuvRecOut);
+#endif
+#if ETRI_FRAME_ROW_THREADING
+	pcPic->getPicYuvRec()->ETRI_setRowReady(ETRI_ROW_READY_ALL);				///Samples and compressed motion are final for the frames in flight
 #endif
 	pcPic->setReconMark   ( true );
 
-#if ETRI_FRAME_THEAD_OPT
+#if ETRI_FRAME_EVENT_SYNC
+	if (frameSync != NULL)
+	{
+		frameSync->setReconReady(pocCurr);
+	}
+#elif ETRI_FRAME_THEAD_OPT
 	if (mutex != NULL && cond != NULL)
 	{
 		pthread_mutex_lock(mutex);
@@ -3978,7 +4148,12 @@ Void TEncFrame::ETRI_preLoopFilterPicAll( TComPic* pcPic, UInt64& ruiDist, UInt6
 	{
 		em_cLoopFilter[i].setCfg(em_pcEncTop->getLFCrossTileBoundaryFlag());
 	}
+#if ETRI_PICTURE_TASK_THREADPOOL
+	ETRI_runPictureTask(pcPic, ETRI_PICTASK_DEBLOCK_VER);
+	ETRI_runPictureTask(pcPic, ETRI_PICTASK_DEBLOCK_HOR);
+#else
 	em_cLoopFilter[0].loopFilterPic(pcPic, em_cLoopFilter);
+#endif
 #else 
 	em_cLoopFilter.setCfg(em_pcEncTop->getLFCrossTileBoundaryFlag());
 	em_cLoopFilter.loopFilterPic( pcPic );
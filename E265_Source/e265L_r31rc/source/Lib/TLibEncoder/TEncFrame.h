@@ -50,6 +50,9 @@
 #include "TLibCommon/AccessUnit.h"
 #include "TEncSampleAdaptiveOffset.h"
 #include "TEncSlice.h"
+#if ETRI_WPP_PARALLEL
+#include "TEncWPP.h"
+#endif
 #include "TEncEntropy.h"
 #include "TEncCavlc.h"
 #include "TEncSbac.h"
@@ -209,6 +212,13 @@ private:
 		SEIWriter		em_cseiWriter;
 
 		TEncTile*    	em_pcTileEncoder;				///< Tile Encoder @ 2015 5 17 by Seok
+#if ETRI_WPP_PARALLEL
+		TEncWPP			em_cWPPEncoder;					///< Wavefront CTU-row encoder, used when WaveFrontSynchro is on
+#endif
+#if ETRI_FRAME_ROW_THREADING
+		EncCTURowSync	em_cRowSync;					///< CTU row deblocking and publishing while the tiles are compressed
+		Bool			em_bRowSync;					///< em_cRowSync is used for the current frame
+#endif
 
 //--------------------------------------------------------------------------------------------------------
 //	For WPP Coders
@@ -279,7 +289,13 @@ public:
 	Void ETRI_EvalCodingOrderMAPandInverseCOMAP(TComPic* pcPic);
 	void ETRI_setStartCUAddr(TComSlice* pcSlice, ETRI_SliceInfo& ReturnValue);
 	void ETRI_SetNextSlice_with_IF(TComPic* pcPic, TComSlice*& pcSlice, ETRI_SliceInfo& ReturnValue);
+#if ETRI_FRAME_ROW_THREADING
+	Void ETRI_InitRowSync(TComPic* pcPic, TComSlice* pcSlice);
+#endif
 	void ETRI_LoopFilter(TComPic* pcPic, TComSlice*& pcSlice, ETRI_SliceInfo& ReturnValue);
+#if ETRI_PICTURE_TASK_THREADPOOL
+	Void ETRI_runPictureTask(TComPic* pcPic, Int iTask);		///< EncPicTask on MAX_NUM_THREAD CTU ranges with jobs of the thread pool
+#endif
 #if ETRI_MULTITHREAD_2
 	void ETRI_WriteSeqHeader(TComPic* pcPic, TComSlice*& pcSlice, AccessUnit& accessUnit, Int& actualTotalBits, Bool bFirst);
 #else
@@ -309,7 +325,9 @@ public:
 	// Compression functions
 	// -------------------------------------------------------------------------------------------------------------------
 #if ETRI_MULTITHREAD_2
-#if ETRI_THREADPOOL_OPT
+#if ETRI_THREADPOOL_OPT && ETRI_FRAME_EVENT_SYNC
+	Void ETRI_CompressFrame(Int pocCurr, TComPic* pcPic, TComPicYuv* pcPicYuvRecOut, TComList<TComPic*>& rcListPic, std::list<AccessUnit>& accessUnitsInGOP, Bool bFirst, EncFrameSync *frameSync, QphotoThreadPool *threadpool, Bool bDefault = true);
+#elif ETRI_THREADPOOL_OPT
 	Void ETRI_CompressFrame(Int pocCurr, TComPic* pcPic, TComPicYuv* pcPicYuvRecOut, TComList<TComPic*>& rcListPic, std::list<AccessUnit>& accessUnitsInGOP, Bool bFirst, pthread_mutex_t *mutex, pthread_cond_t *cond, int *bRefPicAvailable, QphotoThreadPool *threadpool, Bool bDefault = true);
 #else
 	Void ETRI_CompressFrame(Int pocCurr, TComPic* pcPic, TComPicYuv* pcPicYuvRecOut, TComList<TComPic*>& rcListPic, std::list<AccessUnit>& accessUnitsInGOP, Bool bFirst, Bool bDefault = true);
@@ -358,6 +376,9 @@ public:
 #endif
 
 	TEncTile*   			ETRI_getTileEncoder    	()	{return em_pcTileEncoder;  		}
+#if ETRI_WPP_PARALLEL
+	TEncWPP*   				ETRI_getWPPEncoder    	()	{return &em_cWPPEncoder;  		}
+#endif
 	Void ETRI_createWPPCoders(Int iNumSubstreams);
 	Void ETRI_xAttachSliceDataToNalUnit (OutputNALUnit& rNalu, TComOutputBitstream*& codedSliceData);
 	Void ETRI_preLoopFilterPicAll( TComPic* pcPic, UInt64& ruiDist, UInt64& ruiBits );
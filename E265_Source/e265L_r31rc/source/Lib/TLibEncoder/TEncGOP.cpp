@@ -114,6 +114,10 @@ TEncGOP::TEncGOP()
 #if ETRI_THREADPOOL_OPT
 	m_qrThreadpool = NULL;
 #endif
+#if ETRI_FRAME_ROW_THREADING
+	m_bRowThreading = false;
+	m_iNumFrameSlot = MAX_THREAD_GOP;
+#endif
 
 #if ALLOW_RECOVERY_POINT_AS_RAP
   m_iLastRecoveryPicPOC = 0;
@@ -223,8 +227,57 @@ Void  TEncGOP::create()
 
 #if ETRI_THREADPOOL_OPT
 	if (!m_qrThreadpool)
+	{
 		m_qrThreadpool = QphotoThreadPool::createQphotoThreadPool(ETRI_THREADPOOL_OPT_MAX_THREAD);
+#if ETRI_THREAD_AFFINITY
+		if (m_qrThreadpool && ETRI_GetThreadAffinity() != ETRI_AFFINITY_OFF)
+		{
+			/// Every GOP, frame, tile and WPP row job runs on a pool worker, so pinning the workers places the whole encoder
+			Int aiCpu[ETRI_AFFINITY_MAX_CPU];
+			Int iNumWorker = m_qrThreadpool->threadpool_get_num_of_threads();
+			for (Int i = 0; i < iNumWorker; i++)
+			{
+				Int iNumCpu = ETRI_GetAffinityCpus(i, iNumWorker, aiCpu, ETRI_AFFINITY_MAX_CPU);
+				if (iNumCpu > 0)	{m_qrThreadpool->threadpool_set_affinity(i, aiCpu, iNumCpu);}
+			}
+			ETRI_SetCallingThreadAffinity();
+		}
+#endif
+	}
 	memset(m_bThreadRunning, 0, sizeof(m_bThreadRunning));
+
+#if ETRI_FRAME_ROW_THREADING
+	{
+		/// A frame job blocks on its tile jobs, and a tile job may block on a reference row of a frame in flight. 
+		/// Every job of the frames in flight must get a pool thread, otherwise the referenced rows are never produced.
+		Int iNumTile = (pcEncTop->getNumColumnsMinus1() + 1) * (pcEncTop->getNumRowsMinus1() + 1);
+#if ETRI_TILE_DYNAMIC_ASSIGN
+		iNumTile = std::min<Int>(iNumTile, MAX_THREAD_TILE);		///< Tile jobs per frame
+#endif
+#if ETRI_WPP_PARALLEL
+		/// Wavefront jobs block on the CTU row above, so they need a pool thread each even without the row threading.
+		UInt uiNumWPPJob = TEncWPP::ETRI_getNumRowEncoder(pcEncTop);
+		if (uiNumWPPJob)
+		{
+			iNumTile = uiNumWPPJob;
+		}
+#endif
+
+		m_iNumFrameSlot = std::min<Int>(MAX_THREAD_GOP, ETRI_THREADPOOL_OPT_MAX_THREAD / (1 + iNumTile));
+		m_bRowThreading = (m_iNumFrameSlot > 1)
+						&& pcEncTop->getSliceMode() == 0 && pcEncTop->getSliceSegmentMode() == 0	///< Single slice : CTU rows are deblocked across the picture
+						&& !pcEncTop->getUseSAO() && !pcEncTop->getDeblockingFilterMetric()		///< No picture-level process between the compression and the deblocking
+						&& !pcEncTop->getUseWP() && !pcEncTop->getWPBiPred();					///< Weighted prediction analysis reads whole reference pictures
+		if (!m_bRowThreading
+#if ETRI_WPP_PARALLEL
+			&& !uiNumWPPJob
+#endif
+			)
+		{
+			m_iNumFrameSlot = MAX_THREAD_GOP;
+		}
+	}
+#endif
 #else
   em_hThreadPoolGOP.Create(threadProcessingGOP, MAX_THREAD_GOP);
 #endif
@@ -324,26 +377,25 @@ Void TEncGOP::init ( TEncTop* pcTEncTop )
 #if ETRI_MODIFICATION_V02 
 	EDPRINTF(stderr, "         Status of Fast Algorithms  \n");
 	EDPRINTF(stderr, " ETRI_DEV_0731            :%s \n", GetBoolVal(ETRI_DEV_0731));
-	EDPRINTF(stderr, " ETRI_SKIP_64x64LCU       :%s \n", GetBoolVal(ETRI_SKIP_64x64LCU));
+	EDPRINTF(stderr, " ETRI_SKIP_64x64LCU       :%s \n", GetBoolVal(pcTEncTop->ETRI_getSkip64x64LCU()));
 	EDPRINTF(stderr, " ETRI_ENABLE_2NxNNx2NProc :%s \n", GetBoolVal(ETRI_ENABLE_2NxNNx2NProc));	
 	EDPRINTF(stderr, " ETRI_FIXED_ESDOFF        :%s \n", GetBoolVal(ETRI_FIXED_ESDOFF));	
-	EDPRINTF(stderr, " ETRI_RDOOffBestMergeCand :%s \n", GetBoolVal(ETRI_RDOOffBestMergeCand));	
-	EDPRINTF(stderr, " ETRI_FRDOOffBestMergeCand:%s \n", GetBoolVal(ETRI_FRDOOffBestMergeCand));
-	EDPRINTF(stderr, " ETRI_POSTESD             :%s \n", GetBoolVal(ETRI_POSTESD));
-	EDPRINTF(stderr, " ETRI_FPOSTESD            :%s \n", GetBoolVal(ETRI_FPOSTESD));
+	EDPRINTF(stderr, " ETRI_RDOOffBestMergeCand :%s \n", GetBoolVal(pcTEncTop->ETRI_getRDOOffBestMergeCand()));	
+	EDPRINTF(stderr, " ETRI_POSTESD             :%s \n", GetBoolVal(pcTEncTop->ETRI_getPostESD()));
 #if ETRI_STATUS_FAST_ME_INFORM
 	EDPRINTF(stderr, " ETRI_FAST_INTEGER_ME     :%s [Method: %s Range: %d] ETRI_INC_RASTER : %s\n", 
 				GetBoolVal(ETRI_FAST_MOTION_ESTIMATION), 
 				((pcTEncTop->getFastSearch() == 2)? "ETRI_Fast_IME" : "HM TZSearch"), 
 				pcTEncTop->getSearchRange(), 
 				GetBoolVal(ETRI_INC_RASTER));
-	EDPRINTF(stderr, "    ETRI_NOT_QPEL_ME      :%s \n", GetBoolVal(ETRI_NOT_QUARTERPEL_ME));
-	EDPRINTF(stderr, "    ETRI_HALF_DIAMOND_ME  :%s \n", GetBoolVal(ETRI_FME_HALFPEL_DIAMOND_ON));
+	EDPRINTF(stderr, "    ETRI_NOT_QPEL_ME      :%s \n", GetBoolVal(!pcTEncTop->ETRI_getQuarterPelME()));
+	EDPRINTF(stderr, "    ETRI_HALF_DIAMOND_ME  :%s \n", GetBoolVal(pcTEncTop->ETRI_getHalfPelDiamond()));
 	EDPRINTF(stderr, " ETRI_SliceEncoder_MVClip :%s \n", GetBoolVal(ETRI_SliceEncoder_MVClip));
 #endif 
 #if ETRI_FAST_CU_METHODS
-	EDPRINTF(stderr, " ETRI_ADPTIVE_MAXCTU_SIZE :%s \n", GetBoolVal(ETRI_ADAPTIVE_MAXCTU_SIZE));
-	EDPRINTF(stderr, " ETRI_ADPTIVE_MINCTU_SIZE :%s \n", GetBoolVal(ETRI_ADAPTIVE_MINCTU_SIZE));
+	EDPRINTF(stderr, " ETRI_FAST_CU_METHODS     :%s \n", GetBoolVal(pcTEncTop->ETRI_getFastCU()));
+	EDPRINTF(stderr, " ETRI_ADPTIVE_MAXCTU_SIZE :%s \n", GetBoolVal(ETRI_ADAPTIVE_MAXCTU_SIZE && pcTEncTop->ETRI_getAdaptiveCTUSize()));
+	EDPRINTF(stderr, " ETRI_ADPTIVE_MINCTU_SIZE :%s \n", GetBoolVal(ETRI_ADAPTIVE_MINCTU_SIZE && pcTEncTop->ETRI_getAdaptiveCTUSize()));
 #endif 
 #if ETRI_FAST_PU_METHODS
 	EDPRINTF(stderr, " ETRI_INTRA_LUMA_MODE_DEC :%s \n", GetBoolVal(ETRI_INTRA_LUMA_MODE_DECS));
@@ -1333,10 +1385,24 @@ Void TEncGOP::ETRI_compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*
 		
 		// Read One Picture for Frame Compression from INput Picture Buffer
 		ETRI_xGetBuffer(rcListPic, rcListPicYuvRecOut, pcPic, pcPicYuvRecOut, pocCurr, iPos, isTff);
+#if ETRI_FRAME_ROW_THREADING
+		if (m_bRowThreading)
+		{
+			pcPic->getPicYuvRec()->ETRI_setRowReady(-1);		///Not dispatched : frames referencing this picture cannot start
+		}
+#endif
 
 		// Set Parameter for Frame Compression 
 		em_pcFrameEncoder[iPos].ETRI_setFrameParameter(iGOPid, iPOCLast, iNumPicRcvd, IRAPGOPid, m_iLastIDR, accumBitsDU, accumNalsDU, isField, isTff);
 		em_pcFrameEncoder[iPos].ETRI_GetRefPic(&em_refPic[nRefCnt++], pocCurr, pcPic, rcListPic, iGOPid, isField, iPOCLast, iNumPicRcvd, m_iLastIDR);
+#if ETRI_PICTURE_POOL
+		///< The references of the picture stay out of the free list until the frames of the batch are done
+		for (Int j = 0; j < em_refPic[nRefCnt - 1].nRefNum; j++)
+		{
+			if (m_pcEncTop->ETRI_getPicPool()->ETRI_getPic(em_refPic[nRefCnt - 1].pRefPOC[j]))
+				m_pcEncTop->ETRI_getPicPool()->ETRI_addRef(em_refPic[nRefCnt - 1].pRefPOC[j]);
+		}
+#endif
 
 #if ETRI_DLL_INTERFACE //write DLL TS data, 2015 06 15 by yhee		
 		UInt eFrameType = pcPic->getSlice(0)->getSliceType();
@@ -1355,9 +1421,16 @@ Void TEncGOP::ETRI_compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*
 	bool bStart[nJob] = { 0, };
 	bool bEnd[nJob] = { 0, };
 
+#if ETRI_FRAME_EVENT_SYNC
+	std::vector<int> waitPOC;		// first missing reference of every frame still blocked
+	int iMissingPOC = 0;
+
+	m_cFrameSync.reset();
+#else
 	pthread_mutex_t quramMutex = PTHREAD_MUTEX_INITIALIZER;
 	pthread_cond_t  quramCond  = PTHREAD_COND_INITIALIZER;
 	int bRefPicAvailable = 0;
+#endif
 
 	struct timeval tv;
 	tv.tv_sec = 0;
@@ -1368,7 +1441,9 @@ Void TEncGOP::ETRI_compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*
 
 	while (nCount < Size)
 	{
-#if ETRI_THREADPOOL_OPT
+#if ETRI_FRAME_EVENT_SYNC
+		waitPOC.clear();
+#elif ETRI_THREADPOOL_OPT
 		bRefPicAvailable = 0;
 #endif
 		for (Int iPos = 0; iPos < Size; iPos++)
@@ -1394,14 +1469,28 @@ Void TEncGOP::ETRI_compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*
 				continue;
 			}
 
+#if ETRI_FRAME_EVENT_SYNC
+			if (!ETRI_RefPicCheck(pocCurr, &rcListPic, nRefCnt, &iMissingPOC))
+			{
+				waitPOC.push_back(iMissingPOC);
+				continue;
+			}
+#else
 			if (!ETRI_RefPicCheck(pocCurr, &rcListPic, nRefCnt))
 			{
 				//Sleep(1); //yhee, 2015116
 				continue;
 			}
+#endif
 
 			// Read One Picture for Frame Compression from INput Picture Buffer
 			ETRI_xGetBuffer(rcListPic, rcListPicYuvRecOut, pcPic, pcPicYuvRecOut, pocCurr, iPos, isTff);
+#if ETRI_FRAME_ROW_THREADING
+			if (m_bRowThreading)
+			{
+				pcPic->getPicYuvRec()->ETRI_setRowReady(0);		///Dispatched : frames referencing this picture wait for its CTU rows
+			}
+#endif
 
 			if (Size == 1)
 			{
@@ -1417,7 +1506,11 @@ Void TEncGOP::ETRI_compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*
 				accessUnitsInGOP[iPos].pos = iPos;
 
 #if ETRI_THREADPOOL_OPT
+#if ETRI_FRAME_EVENT_SYNC
+				em_pcFrameEncoder[iPos].ETRI_CompressFrame(pocCurr, pcPic, pcPicYuvRecOut, rcListPic, accessUnitsInGOP[iPos].outputAccessUnits, m_bFirst, NULL, m_qrThreadpool, false);
+#else
 				em_pcFrameEncoder[iPos].ETRI_CompressFrame(pocCurr, pcPic, pcPicYuvRecOut, rcListPic, accessUnitsInGOP[iPos].outputAccessUnits, m_bFirst, NULL, NULL, NULL, m_qrThreadpool, false);
+#endif
 #else
 				em_pcFrameEncoder[iPos].ETRI_CompressFrame(pocCurr, pcPic, pcPicYuvRecOut, rcListPic, accessUnitsInGOP[iPos].outputAccessUnits, m_bFirst, false);
 #endif
@@ -1442,6 +1535,13 @@ Void TEncGOP::ETRI_compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*
 #if ETRI_THREADPOOL_OPT
 			else
 			{
+#if ETRI_FRAME_EVENT_SYNC
+#if ETRI_FRAME_ROW_THREADING
+				int index = m_cFrameSync.acquireSlot(m_bThreadRunning, m_iNumFrameSlot);
+#else
+				int index = m_cFrameSync.acquireSlot(m_bThreadRunning, MAX_THREAD_GOP);
+#endif
+#else
 				bool b = false;
 				int index = 0;
 
@@ -1470,6 +1570,7 @@ Void TEncGOP::ETRI_compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*
 #endif
 					}
 				}
+#endif
 
 				//gplusplus_151124 Thread Function -> Local Function
 				em_pcFrameEncoder[iPos].ETRI_setFrameParameter(iGOPid, iPOCLast, iNumPicRcvd, IRAPGOPid, m_iLastIDR, accumBitsDU, accumNalsDU, isField, isTff);
@@ -1489,10 +1590,15 @@ Void TEncGOP::ETRI_compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*
 				em_cThreadGOP[index].em_isField = isField;
 				em_cThreadGOP[index].em_isTff = isTff;
 
+#if ETRI_FRAME_EVENT_SYNC
+				job[jobIndex] = EncGopJob::createJob(this, index, &m_cFrameSync, m_qrThreadpool, m_bThreadRunning);
+				m_qrThreadpool->run(job[jobIndex]);
+#else
 				job[jobIndex] = EncGopJob::createJob(this, index, &quramMutex, &quramCond, &bRefPicAvailable, m_qrThreadpool, m_bThreadRunning);
 				m_qrThreadpool->run(job[jobIndex]);
 
 				m_bThreadRunning[index] = true;
+#endif
 				jobIndex++;
 			}
 #else
@@ -1525,7 +1631,12 @@ Void TEncGOP::ETRI_compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*
 			nCount++;
 			nThreadCnt++;
 		}	// for()
-#if ETRI_FRAME_THEAD_OPT
+#if ETRI_FRAME_EVENT_SYNC
+		if (Size != 1 && nCount < Size)
+		{
+			m_cFrameSync.waitReconReady(waitPOC);
+		}
+#elif ETRI_FRAME_THEAD_OPT
 		if (Size != 1)
 		{
 			pthread_mutex_lock(&quramMutex);
@@ -1537,7 +1648,9 @@ Void TEncGOP::ETRI_compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*
 		}
 #endif
 	}
-#if ETRI_THREADPOOL_OPT
+#if ETRI_FRAME_EVENT_SYNC
+	m_cFrameSync.waitAllDone();
+#elif ETRI_THREADPOOL_OPT
 	int cnt = 0;
 	while (1)
 	{
@@ -1704,6 +1817,13 @@ Void TEncGOP::ETRI_compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*
 #endif
 	for (int i = 0; i < nRefCnt; i++)
 	{
+#if ETRI_PICTURE_POOL
+		for (Int j = 0; j < em_refPic[i].nRefNum; j++)
+		{
+			if (m_pcEncTop->ETRI_getPicPool()->ETRI_getPic(em_refPic[i].pRefPOC[j]))
+				m_pcEncTop->ETRI_getPicPool()->ETRI_release(em_refPic[i].pRefPOC[j]);
+		}
+#endif
 		delete em_refPic[i].pRefPOC;
 	}	
 
@@ -2332,6 +2452,123 @@ Void TEncGOP::xCalculateInterlacedAddPSNR( TComPic* pcPicOrgTop, TComPic* pcPicO
 
 
 
+#if ETRI_SCENECUT
+/**
+	For each GOP of the batch with a scene cut, the picture of the new scene coded first is coded as an IRAP 
+	(the GOP anchor with a random access GOP, the cut picture itself with a low delay GOP). 
+	The pictures of the old scene coded after it become its leading pictures, the pictures of the new scene 
+	predict from it. The periodic IRAPs are kept : the batches and the rate control follow the intra period.
+*/
+Void TEncGOP::ETRI_setSceneCutIRAP(TEncLookahead* pcLookahead, Int iPOCLast, Int iNumPicRcvd)
+{
+	em_viSceneCutIRAP.clear();
+	em_viSceneCutLeading.clear();
+
+	Int iGOPSize = m_pcCfg->getGOPSize();			///< m_iGopSize is set by the batch being compressed
+	if (iGOPSize <= 0 || m_pcCfg->getIntraPeriod() <= 0)	{return;}
+
+	Int iFirstPOC = std::max(1, iPOCLast - iNumPicRcvd + 1);
+	for (Int iGOPStart = ((iFirstPOC - 1) / iGOPSize) * iGOPSize; iGOPStart < iPOCLast; iGOPStart += iGOPSize)
+	{
+		Int iCutPOC = -1;
+		for (Int iPOC = std::max(iGOPStart + 1, iFirstPOC); iPOC <= std::min(iGOPStart + iGOPSize, iPOCLast) && iCutPOC < 0; iPOC++)
+		{
+			if (pcLookahead->ETRI_isSceneCut(iPOC))	{iCutPOC = iPOC;}
+		}
+		if (iCutPOC < 0)	{continue;}
+
+		Int iIRAPGOPid = -1;
+		for (Int iGOPid = 0; iGOPid < iGOPSize; iGOPid++)
+		{
+			Int iPOC = iGOPStart + m_pcCfg->getGOPEntry(iGOPid).m_POC;
+			if (iIRAPGOPid < 0)
+			{
+				if (iPOC >= iCutPOC && iPOC <= iPOCLast && iPOC < m_pcCfg->getFramesToBeEncoded())
+				{
+					iIRAPGOPid = iGOPid;
+					if (iPOC % m_pcCfg->getIntraPeriod() == 0)	{break;}	///< Periodic IRAP
+					em_viSceneCutIRAP.push_back(iPOC);
+				}
+			}
+			else if (iPOC < em_viSceneCutIRAP.back())
+			{
+				em_viSceneCutLeading.push_back(iPOC);
+			}
+		}
+	}
+}
+
+Bool TEncGOP::ETRI_isSceneCutIRAP(Int iPOC)
+{
+	return std::find(em_viSceneCutIRAP.begin(), em_viSceneCutIRAP.end(), iPOC) != em_viSceneCutIRAP.end();
+}
+
+/**
+	Scene-cut IRAP a picture of the batch is coded after : the IRAP of its leading picture list, else the last IRAP before it. 
+	-1 : none.
+*/
+Int TEncGOP::ETRI_getSceneCutIRAP(Int iPOC)
+{
+	Int iIRAPPOC = -1;
+	Bool bLeading = std::find(em_viSceneCutLeading.begin(), em_viSceneCutLeading.end(), iPOC) != em_viSceneCutLeading.end();
+	for (std::vector<Int>::iterator it = em_viSceneCutIRAP.begin(); it != em_viSceneCutIRAP.end(); it++)
+	{
+		if (bLeading)
+		{
+			if (*it > iPOC && (iIRAPPOC < 0 || *it < iIRAPPOC))	{iIRAPPOC = *it;}
+		}
+		else if (*it < iPOC && *it > iIRAPPOC)	{iIRAPPOC = *it;}
+	}
+	return iIRAPPOC;
+}
+
+/**
+	The periodic IRAPs start a batch, so m_pocCRA and m_bRefreshPending are never moved inside a batch, and the frames of 
+	the batch take copies of them. The RPS of a picture coded after a scene-cut IRAP is trimmed here instead : 
+	a trailing picture drops the pictures before the IRAP, a RADL picture of an IDR keeps the IDR and its other RADL pictures. 
+	RASL pictures of a CRA keep the old scene.
+*/
+Void TEncGOP::ETRI_trimSceneCutRPS(TComSlice* pcSlice)
+{
+	if (em_viSceneCutIRAP.empty() || pcSlice->isIRAP())	{return;}
+
+	Int iPOC = pcSlice->getPOC();
+	Int iIRAPPOC = ETRI_getSceneCutIRAP(iPOC);
+	if (iIRAPPOC < 0)	{return;}
+	Bool bLeading = (iPOC < iIRAPPOC);
+	if (bLeading && m_pcCfg->getDecodingRefreshType() != 2)	{return;}
+
+	TComReferencePictureSet* pcRPS = pcSlice->getRPS();
+	TComReferencePictureSet* pcLocalRPS = pcSlice->getLocalRPS();
+	Int iNumNegative = 0, iNumPositive = 0, k = 0;
+	for (Int i = 0; i < pcRPS->getNumberOfPictures(); i++)
+	{
+		Int iRefPOC = iPOC + pcRPS->getDeltaPOC(i);
+		Bool bKeep = (iRefPOC >= iIRAPPOC) || (bLeading && ETRI_getSceneCutIRAP(iRefPOC) == iIRAPPOC 
+					 && std::find(em_viSceneCutLeading.begin(), em_viSceneCutLeading.end(), iRefPOC) != em_viSceneCutLeading.end());
+		if (!bKeep)	{continue;}
+
+		Int  iDeltaPOC = pcRPS->getDeltaPOC(i);			///< k <= i : pcRPS may be pcLocalRPS
+		Bool bUsed = pcRPS->getUsed(i);
+		pcLocalRPS->setDeltaPOC(k, iDeltaPOC);
+		pcLocalRPS->setUsed(k, bUsed);
+		if (iDeltaPOC < 0)	{iNumNegative++;}
+		else 				{iNumPositive++;}
+		k++;
+	}
+	if (k == pcRPS->getNumberOfPictures())	{return;}
+
+	pcLocalRPS->setNumberOfNegativePictures(iNumNegative);
+	pcLocalRPS->setNumberOfPositivePictures(iNumPositive);
+	pcLocalRPS->setNumberOfPictures(k);
+	pcLocalRPS->setNumberOfLongtermPictures(0);
+	pcLocalRPS->setInterRPSPrediction(false);
+	pcLocalRPS->setNumRefIdc(0);
+	pcSlice->setRPS(pcLocalRPS);
+	pcSlice->setRPSidx(-1);
+}
+#endif
+
 /** Function for deciding the nal_unit_type.
  * \param pocCurr POC of the current picture
  * \returns the nal unit type of the picture
@@ -2366,6 +2603,23 @@ NalUnitType TEncGOP::getNalUnitType(Int pocCurr, Int lastIDR, Bool isField)
       return NAL_UNIT_CODED_SLICE_IDR_W_RADL;
     }
   }
+#if ETRI_SCENECUT
+  if (ETRI_isSceneCutIRAP(pocCurr))
+  {
+    if (m_pcCfg->getDecodingRefreshType() == 1)
+    {
+      return NAL_UNIT_CODED_SLICE_CRA;
+    }
+    else if (m_pcCfg->getDecodingRefreshType() == 2)
+    {
+      return NAL_UNIT_CODED_SLICE_IDR_W_RADL;
+    }
+  }
+  if (m_pcCfg->getDecodingRefreshType() == 1 && std::find(em_viSceneCutLeading.begin(), em_viSceneCutLeading.end(), pocCurr) != em_viSceneCutLeading.end())
+  {
+    return NAL_UNIT_CODED_SLICE_RASL_R;
+  }
+#endif
   if(m_pocCRA>0)
   {
     if(pocCurr<m_pocCRA)
@@ -4421,7 +4675,11 @@ void TEncGOP::threadProcessingGOP(void *param, int num)
 #if ETRI_THREADPOOL_OPT
 	// original code starts_yjc
 	pcGOP->em_pcFrameEncoder[num].ETRI_CompressFrame(pcThreadGOP->em_pocCurr, pcThreadGOP->em_pcPic, pcThreadGOP->em_pcPicYuvRecOut,
+#if ETRI_FRAME_EVENT_SYNC
+		*pcThreadGOP->em_rpcListPic, *pcThreadGOP->em_paccessUnitsInGOP, pcThreadGOP->em_bFirst, NULL, NULL, false);
+#else
 		*pcThreadGOP->em_rpcListPic, *pcThreadGOP->em_paccessUnitsInGOP, pcThreadGOP->em_bFirst, NULL, NULL, NULL, NULL, false);
+#endif
 #else
 
 	pcGOP->em_pcFrameEncoder[num].ETRI_CompressFrame(pcThreadGOP->em_pocCurr, pcThreadGOP->em_pcPic, pcThreadGOP->em_pcPicYuvRecOut,
@@ -4449,7 +4707,7 @@ void TEncGOP::threadProcessingGOP(void *param, int num)
 //#endif
 }
 
-bool TEncGOP::ETRI_RefPicCheck(int curPOC, TComList<TComPic*>* rpcListPic, int RefSize)
+bool TEncGOP::ETRI_RefPicCheck(int curPOC, TComList<TComPic*>* rpcListPic, int RefSize, int *pMissingPOC)
 {
 	int refPoc;
 	TComList<TComPic*>::iterator iterPic;
@@ -4479,8 +4737,17 @@ bool TEncGOP::ETRI_RefPicCheck(int curPOC, TComList<TComPic*>* rpcListPic, int R
 					iterPic++;
 				}
 
+#if ETRI_FRAME_ROW_THREADING
+				/// A dispatched reference is enough : its CTU rows are waited for during the prediction
+				if(rpcPic->getReconMark() == false && !(m_bRowThreading && rpcPic->getPicYuvRec()->ETRI_getRowReady() >= 0))
+#else
 				if(rpcPic->getReconMark() == false)
+#endif
+				{
+					if (pMissingPOC != NULL)
+						*pMissingPOC = refPoc;
 					return false;
+				}
 			}
 			break;
 		}
@@ -4497,6 +4764,22 @@ Void TEncGOP::ETRI_xGetBuffer( TComList<TComPic*>& rcListPic, TComList<TComPicYu
   //  Current pic.
   TComList<TComPic*>::iterator iterPic = rcListPic.begin();
 
+#if ETRI_PICTURE_POOL
+  rpcPic = m_pcEncTop->ETRI_getPicPool()->ETRI_getPic(pocCurr);
+  if (rpcPic)
+  {
+	  rpcPic->setCurrSliceIdx(0);
+	  if (m_pcEncTop->ETRI_getReconFileOk())
+	  {
+		  //  Rec. outputs pair with the list positions
+		  rpcPicYuvRecOut = m_pcEncTop->ETRI_getPicPool()->ETRI_getRec(pocCurr);
+		  assert(rpcPicYuvRecOut);
+		  rpcPicYuvRecOut->setPoc(pocCurr);
+		  rpcPicYuvRecOut->setbUsed(true);
+	  }
+	  return;
+  }
+#endif
 
 #if ETRI_MULTITHREAD_2
   if (m_pcEncTop->ETRI_getReconFileOk())
@@ -4547,6 +4830,115 @@ Void TEncGOP::ETRI_xGetBuffer( TComList<TComPic*>& rcListPic, TComList<TComPicYu
 
 #if ETRI_THREADPOOL_OPT && ETRI_MULTITHREAD_2
 
+#if ETRI_FRAME_EVENT_SYNC
+EncFrameSync::EncFrameSync()
+{
+	pthread_mutex_init(&m_mutex, NULL);
+	pthread_cond_init(&m_cond, NULL);
+	m_nRunning = 0;
+}
+
+EncFrameSync::~EncFrameSync()
+{
+	pthread_cond_destroy(&m_cond);
+	pthread_mutex_destroy(&m_mutex);
+}
+
+void EncFrameSync::reset()
+{
+	pthread_mutex_lock(&m_mutex);
+	assert(m_nRunning == 0);
+	m_readyPOC.clear();
+	pthread_mutex_unlock(&m_mutex);
+}
+
+int EncFrameSync::acquireSlot(bool *bThreadRunning, int nSlot)
+{
+	int index = -1;
+
+	pthread_mutex_lock(&m_mutex);
+	while (index < 0)
+	{
+		for (int i = 0; i < nSlot; i++)
+		{
+			if (bThreadRunning[i] == false)
+			{
+				index = i;
+				break;
+			}
+		}
+		if (index < 0)
+			pthread_cond_wait(&m_cond, &m_mutex);
+	}
+	bThreadRunning[index] = true;
+	m_nRunning++;
+	pthread_mutex_unlock(&m_mutex);
+
+	return index;
+}
+
+void EncFrameSync::releaseSlot(bool *bThreadRunning, int id)
+{
+	pthread_mutex_lock(&m_mutex);
+	bThreadRunning[id] = false;
+	m_nRunning--;
+	pthread_cond_broadcast(&m_cond);
+	pthread_mutex_unlock(&m_mutex);
+}
+
+void EncFrameSync::setReconReady(int poc)
+{
+	pthread_mutex_lock(&m_mutex);
+	m_readyPOC.insert(poc);
+	pthread_cond_broadcast(&m_cond);
+	pthread_mutex_unlock(&m_mutex);
+}
+
+void EncFrameSync::waitReconReady(const std::vector<int>& waitPOC)
+{
+	pthread_mutex_lock(&m_mutex);
+	// No running job means nothing can become ready any more: return and let the caller rescan
+	while (m_nRunning > 0)
+	{
+		bool bReady = false;
+		for (size_t i = 0; i < waitPOC.size() && !bReady; i++)
+			bReady = (m_readyPOC.count(waitPOC[i]) != 0);
+		if (bReady)
+			break;
+		pthread_cond_wait(&m_cond, &m_mutex);
+	}
+	pthread_mutex_unlock(&m_mutex);
+}
+
+void EncFrameSync::waitAllDone()
+{
+	pthread_mutex_lock(&m_mutex);
+	while (m_nRunning > 0)
+		pthread_cond_wait(&m_cond, &m_mutex);
+	pthread_mutex_unlock(&m_mutex);
+}
+
+EncGopJob* EncGopJob::createJob(void *param, int id, EncFrameSync *frameSync, QphotoThreadPool *threadpool, bool *bThreadRunning)
+{
+	EncGopJob *job = new EncGopJob(param, id, frameSync, threadpool, bThreadRunning);
+	return job;
+}
+
+EncGopJob::EncGopJob(void *param, int id, EncFrameSync *frameSync, QphotoThreadPool *threadpool, bool *bThreadRunning)
+{
+	m_encGOP = (TEncGOP *)param;
+
+	m_threadpool = threadpool;
+	m_bThreadRunning = bThreadRunning;
+	m_frameSync = frameSync;
+	m_id = id;
+}
+
+EncGopJob::~EncGopJob()
+{
+	m_frameSync->releaseSlot(m_bThreadRunning, m_id);
+}
+#else
 EncGopJob* EncGopJob::createJob(void *param, int id, pthread_mutex_t *mutex, pthread_cond_t *cond, int *bRefPicAvailable, QphotoThreadPool *threadpool, bool *bThreadRunning)
 {
 	EncGopJob *job = new EncGopJob(param, id, mutex, cond, bRefPicAvailable, threadpool, bThreadRunning);
@@ -4569,6 +4961,7 @@ EncGopJob::~EncGopJob()
 {
 	m_bThreadRunning[m_id] = false;
 }
+#endif
 
 void EncGopJob::run(void *)
 {
@@ -4605,7 +4998,11 @@ void EncGopJob::run(void *)
 #if ETRI_THREADPOOL_OPT
 	// original code starts_yjc
 pcGOP->em_pcFrameEncoder[num].ETRI_CompressFrame(pcThreadGOP->em_pocCurr, pcThreadGOP->em_pcPic, pcThreadGOP->em_pcPicYuvRecOut,
+#if ETRI_FRAME_EVENT_SYNC
+	*pcThreadGOP->em_rpcListPic, *pcThreadGOP->em_paccessUnitsInGOP, pcThreadGOP->em_bFirst, m_frameSync, m_threadpool, false);
+#else
 	*pcThreadGOP->em_rpcListPic, *pcThreadGOP->em_paccessUnitsInGOP, pcThreadGOP->em_bFirst, m_mutex, m_cond, m_bRefPicAvailable, m_threadpool, false);
+#endif
 #else
 
 	pcGOP->em_pcFrameEncoder[num].ETRI_CompressFrame(pcThreadGOP->em_pocCurr, pcThreadGOP->em_pcPic, pcThreadGOP->em_pcPicYuvRecOut,
@@ -71,6 +71,9 @@ class EncGopJob;
 //! \{
 
 class TEncTop;
+#if ETRI_SCENECUT
+class TEncLookahead;
+#endif
 
 #if ETRI_MULTITHREAD_2
 // gplusplus [[
@@ -161,6 +164,10 @@ private:
   // clean decoding refresh
   Bool                    m_bRefreshPending;
   Int                     m_pocCRA;
+#if ETRI_SCENECUT
+  std::vector<Int>        em_viSceneCutIRAP;            ///< Pictures of the batch coded as IRAP for a scene cut
+  std::vector<Int>        em_viSceneCutLeading;         ///< Leading pictures of em_viSceneCutIRAP
+#endif
   std::vector<Int>        m_storedStartCUAddrForEncodingSlice;
   std::vector<Int>        m_storedStartCUAddrForEncodingSliceSegment;
 #if FIX1172
@@ -251,6 +258,12 @@ Void    ETRI_setbFirst					(bool isFirst){ m_bFirst = isFirst; }//< For ETRI_ref
 
 Void 	ETRI_setpocCRA					(Int ipocCRA) 			{m_pocCRA = ipocCRA;}	///< For ETRI_SetReferencePictureSetforSlice : Is it necessary to a member variable ??	@ 2015 5 24 by Seok 
 Void 	ETRI_setbRefreshPending			(Bool bRefreshPending)	{m_bRefreshPending = bRefreshPending;}	///< For ETRI_SetReferencePictureSetforSlice : Is it necessary to a member variable ??	@ 2015 5 24 by Seok
+#if ETRI_SCENECUT
+Void 	ETRI_setSceneCutIRAP			(TEncLookahead* pcLookahead, Int iPOCLast, Int iNumPicRcvd);	///< Before the batch is compressed
+Bool 	ETRI_isSceneCutIRAP 			(Int iPOC);
+Int 	ETRI_getSceneCutIRAP			(Int iPOC);
+Void 	ETRI_trimSceneCutRPS			(TComSlice* pcSlice);						///< After the RPS of the GOP structure is selected
+#endif
 
 NalUnitType ETRI_getassociatedIRAPType	()	{return m_associatedIRAPType;}	///Is it necessary to a member variable ??	@ 2015 5 24 by Seok
 
@@ -364,6 +377,13 @@ public:
 #if ETRI_THREADPOOL_OPT
   QphotoThreadPool			*m_qrThreadpool;
   bool						m_bThreadRunning[MAX_THREAD_GOP];
+#if ETRI_FRAME_EVENT_SYNC
+  EncFrameSync				m_cFrameSync;
+#endif
+#if ETRI_FRAME_ROW_THREADING
+  bool						m_bRowThreading;		///< Frames start when their references are dispatched, not complete
+  int						m_iNumFrameSlot;		///< Frame jobs in flight : every frame and tile job must fit in the pool
+#endif
 #endif
 public:
   Int     ETRI_getnumPicCoded				()  {return m_iNumPicCoded;}
@@ -373,7 +393,10 @@ public:
   TEncFrame*		ETRI_getFrameEncoder()	{return em_pcFrameEncoder;}
 
   static void threadProcessingGOP(void *param, int num);
-  bool ETRI_RefPicCheck(int curPOC, TComList<TComPic*>* rpcListPic, int RefSize);
+#if ETRI_FRAME_ROW_THREADING
+  bool ETRI_getRowThreading				()	{return m_bRowThreading;}
+#endif
+  bool ETRI_RefPicCheck(int curPOC, TComList<TComPic*>* rpcListPic, int RefSize, int *pMissingPOC = NULL);
   Void ETRI_xGetBuffer( TComList<TComPic*>& rcListPic, TComList<TComPicYuv*>& rcListPicYuvRecOut, TComPic*& rpcPic, TComPicYuv*& rpcPicYuvRecOut, Int pocCurr, int num, bool isField);
 
 #endif 
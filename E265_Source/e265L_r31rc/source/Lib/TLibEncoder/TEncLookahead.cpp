@@ -0,0 +1,707 @@
+/*
+*********************************************************************************************
+
+   Copyright (c) 2015 Electronics and Telecommunications Research Institute (ETRI) All Rights Reserved.
+
+   Following acts are STRICTLY PROHIBITED except when a specific prior written permission is obtained from 
+   ETRI or a separate written agreement with ETRI stipulates such permission specifically:
+
+      a) Selling, distributing, sublicensing, renting, leasing, transmitting, redistributing or otherwise transferring 
+          this software to a third party;
+      b) Copying, transforming, modifying, creating any derivatives of, reverse engineering, decompiling, 
+          disassembling, translating, making any attempt to discover the source code of, the whole or part of 
+          this software in source or binary form; 
+      c) Making any copy of the whole or part of this software other than one copy for backup purposes only; and 
+      d) Using the name, trademark or logo of ETRI or the names of contributors in order to endorse or promote 
+          products derived from this software.
+
+   This software is provided "AS IS," without a warranty of any kind. ALL EXPRESS OR IMPLIED CONDITIONS, 
+   REPRESENTATIONS AND WARRANTIES, INCLUDING ANY IMPLIED WARRANTY OF MERCHANTABILITY, FITNESS 
+   FOR A PARTICULAR PURPOSE OR NON-INFRINGEMENT, ARE HEREBY EXCLUDED. IN NO EVENT WILL ETRI 
+   (OR ITS LICENSORS, IF ANY) BE LIABLE FOR ANY LOST REVENUE, PROFIT OR DATA, OR FOR DIRECT, 
+   INDIRECT, SPECIAL, CONSEQUENTIAL, INCIDENTAL OR PUNITIVE DAMAGES, HOWEVER CAUSED AND 
+   REGARDLESS OF THE THEORY OF LIABILITY, ARISING FROM, OUT OF OR IN CONNECTION WITH THE USE 
+   OF OR INABILITY TO USE THIS SOFTWARE, EVEN IF ETRI HAS BEEN ADVISED OF THE POSSIBILITY OF 
+   SUCH DAMAGES.
+
+   Any permitted redistribution of this software must retain the copyright notice, conditions, and disclaimer 
+   as specified above.
+
+*********************************************************************************************
+*/
+/** 
+	\file   	TEncLookahead.cpp
+   	\brief    	Frame lookahead class
+*/
+
+#include "TEncTop.h"
+#include "TEncLookahead.h"
+#include "../Threadpool/Quram.h"
+
+#include <vector>
+
+#if ETRI_LOOKAHEAD
+//! \ingroup TLibEncoder
+//! \{
+
+// ====================================================================================================================
+// Constructor / destructor / create / destroy
+// ====================================================================================================================
+
+TEncLookahead::TEncLookahead()
+{
+	em_bActive		= false;
+	em_pcFrame		= nullptr;
+	em_iNumFrame	= 0;
+	em_iGOPSize		= 0;
+	em_piRefOffset	= nullptr;
+#if ETRI_SCENECUT
+	em_iSceneCut	= 0;
+#endif
+
+	em_iWidth		= em_iHeight = em_iStride = 0;
+	em_iWidthInBlk	= em_iHeightInBlk = 0;
+	em_iWidthInCU	= em_iHeightInCU = 0;
+	em_iBlkInCU		= 0;
+
+	em_iLastPOC		= -1;
+	em_iNumPending	= 0;
+
+	pthread_mutex_init(&em_mutex, NULL);
+	pthread_cond_init(&em_cond, NULL);
+}
+
+TEncLookahead::~TEncLookahead()
+{
+	pthread_mutex_destroy(&em_mutex);
+	pthread_cond_destroy(&em_cond);
+}
+
+/**
+	The lookahead runs when a consumer of the costs is enabled (rate control, scene-cut detection). 
+	The ring holds the received batch (an intra period) and the references within a GOP before and after it.
+*/
+Void TEncLookahead::create(TEncTop* pcEncTop)
+{
+	em_bActive = pcEncTop->getUseRateCtrl();
+#if ETRI_SCENECUT
+	em_iSceneCut = pcEncTop->ETRI_getSceneCut();
+	em_bActive = em_bActive || (em_iSceneCut > 0);
+#endif
+	if (!em_bActive)	{return;}
+
+	//-------------------------------------------------------------
+	//	Nearest reference of each GOP position
+	//-------------------------------------------------------------
+	em_iGOPSize 	= pcEncTop->getGOPSize();
+	em_piRefOffset	= new Int[em_iGOPSize];
+	::memset(em_piRefOffset, 0, sizeof(Int) * em_iGOPSize);
+
+	GOPEntry* pcGOPList = pcEncTop->ETRI_getGOPEntry();
+	for (Int i = 0; i < em_iGOPSize; i++)
+	{
+		Int iBest = 0;
+		for (Int j = 0; j < pcGOPList[i].m_numRefPics; j++)
+		{
+			Int iDelta = pcGOPList[i].m_referencePics[j];
+			if (iBest == 0 || abs(iDelta) < abs(iBest) || (abs(iDelta) == abs(iBest) && iDelta < 0))
+			{
+				iBest = iDelta;
+			}
+		}
+		em_piRefOffset[pcGOPList[i].m_POC % em_iGOPSize] = iBest;
+	}
+
+	//-------------------------------------------------------------
+	//	Lowres geometry
+	//-------------------------------------------------------------
+	Int iSrcWidth	= pcEncTop->getSourceWidth();
+	Int iSrcHeight	= pcEncTop->getSourceHeight();
+
+	em_iWidthInBlk	= ((iSrcWidth  + 1) / 2 + ETRI_LOOKAHEAD_BLK - 1) / ETRI_LOOKAHEAD_BLK;
+	em_iHeightInBlk	= ((iSrcHeight + 1) / 2 + ETRI_LOOKAHEAD_BLK - 1) / ETRI_LOOKAHEAD_BLK;
+	em_iWidth		= em_iWidthInBlk  * ETRI_LOOKAHEAD_BLK;
+	em_iHeight		= em_iHeightInBlk * ETRI_LOOKAHEAD_BLK;
+	em_iStride		= em_iWidth + (ETRI_LOOKAHEAD_MARGIN << 1);
+
+	em_iWidthInCU	= (iSrcWidth  + g_uiMaxCUWidth  - 1) / g_uiMaxCUWidth;
+	em_iHeightInCU	= (iSrcHeight + g_uiMaxCUHeight - 1) / g_uiMaxCUHeight;
+	em_iBlkInCU 	= std::max<Int>(1, g_uiMaxCUWidth / (ETRI_LOOKAHEAD_BLK << 1));
+
+	//-------------------------------------------------------------
+	//	Ring of the lowres pictures
+	//-------------------------------------------------------------
+	em_iNumFrame	= std::max<Int>((Int)pcEncTop->getIntraPeriod(), em_iGOPSize) + (em_iGOPSize << 1) + 1;
+	em_pcFrame		= new LookaheadFrame[em_iNumFrame];
+
+	Int iNumBlk 	= em_iWidthInBlk * em_iHeightInBlk;
+	Int iNumCU		= em_iWidthInCU * em_iHeightInCU;
+	for (Int i = 0; i < em_iNumFrame; i++)
+	{
+		LookaheadFrame* pcFrame = &em_pcFrame[i];
+
+		pcFrame->iPOC				= -1;
+		pcFrame->iRefPOC			= -1;
+		pcFrame->bLowres			= false;
+		pcFrame->bClaimed			= false;
+		pcFrame->bDone				= false;
+
+#if ETRI_HUGE_PAGE
+		pcFrame->pLowresBuf 		= (Pel*)ETRI_AllocPictureMemory(sizeof(Pel) * em_iStride * (em_iHeight + (ETRI_LOOKAHEAD_MARGIN << 1)));
+#else
+		pcFrame->pLowresBuf 		= (Pel*)xMalloc(Pel, em_iStride * (em_iHeight + (ETRI_LOOKAHEAD_MARGIN << 1)));
+#endif
+		pcFrame->pLowres			= pcFrame->pLowresBuf + ETRI_LOOKAHEAD_MARGIN * em_iStride + ETRI_LOOKAHEAD_MARGIN;
+		pcFrame->puiIntraCost		= new UInt[iNumBlk];
+		pcFrame->puiInterCost		= new UInt[iNumBlk];
+		pcFrame->pcMv				= new TComMv[iNumBlk];
+		pcFrame->puiCTUIntraCost	= new UInt64[iNumCU];
+		pcFrame->puiCTUInterCost	= new UInt64[iNumCU];
+		pcFrame->uiIntraCost		= 0;
+		pcFrame->uiInterCost		= 0;
+#if ETRI_SCENECUT
+		pcFrame->iPrevPOC			= -1;
+		pcFrame->bPrevClaimed		= false;
+		pcFrame->bPrevDone			= false;
+		pcFrame->puiPrevCost		= (em_iSceneCut > 0)? new UInt[iNumBlk] : nullptr;
+		pcFrame->pcPrevMv			= (em_iSceneCut > 0)? new TComMv[iNumBlk] : nullptr;
+		pcFrame->uiPrevCost 		= 0;
+#endif
+	}
+
+	em_iLastPOC		= -1;
+	em_iNumPending	= 0;
+}
+
+/// Jobs of a batch which is not compressed (end of the sequence) are finished first
+Void TEncLookahead::destroy()
+{
+	if (em_pcFrame)
+	{
+		ETRI_waitAll();
+
+		for (Int i = 0; i < em_iNumFrame; i++)
+		{
+#if ETRI_HUGE_PAGE
+			ETRI_FreePictureMemory(em_pcFrame[i].pLowresBuf);
+#else
+			xFree(em_pcFrame[i].pLowresBuf);
+#endif
+			delete[] em_pcFrame[i].puiIntraCost;
+			delete[] em_pcFrame[i].puiInterCost;
+			delete[] em_pcFrame[i].pcMv;
+			delete[] em_pcFrame[i].puiCTUIntraCost;
+			delete[] em_pcFrame[i].puiCTUInterCost;
+#if ETRI_SCENECUT
+			delete[] em_pcFrame[i].puiPrevCost;
+			delete[] em_pcFrame[i].pcPrevMv;
+#endif
+		}
+		delete[] em_pcFrame;
+		em_pcFrame = nullptr;
+	}
+
+	delete[] em_piRefOffset;
+	em_piRefOffset	= nullptr;
+	em_iNumFrame	= 0;
+	em_bActive		= false;
+}
+
+/// Register the distortion functions with the SIMD level set by the configuration
+Void TEncLookahead::init()
+{
+	if (!em_bActive)	{return;}
+
+	em_cRdCost.init();
+}
+
+// ====================================================================================================================
+// member access functions
+// ====================================================================================================================
+
+LookaheadFrame* TEncLookahead::xGetFrame(Int iPOC)
+{
+	if (iPOC < 0)	{return nullptr;}
+
+	LookaheadFrame* pcFrame = &em_pcFrame[iPOC % em_iNumFrame];
+	return (pcFrame->iPOC == iPOC)? pcFrame : nullptr;
+}
+
+/// Costs are valid after ETRI_waitAll of the batch of the picture and until the slot is reused
+Bool TEncLookahead::ETRI_getFrameCost(Int iPOC, Bool bIntra, Double& rdCost)
+{
+	if (!em_bActive)	{return false;}
+
+	LookaheadFrame* pcFrame = xGetFrame(iPOC);
+	if (!pcFrame || !pcFrame->bDone)	{return false;}
+
+	rdCost = (Double)(bIntra? pcFrame->uiIntraCost : pcFrame->uiInterCost);
+	return true;
+}
+
+Bool TEncLookahead::ETRI_getCTUCost(Int iPOC, Int iCUAddr, Bool bIntra, Double& rdCost)
+{
+	if (!em_bActive || iCUAddr >= ETRI_getNumCTU())	{return false;}
+
+	LookaheadFrame* pcFrame = xGetFrame(iPOC);
+	if (!pcFrame || !pcFrame->bDone)	{return false;}
+
+	rdCost = (Double)(bIntra? pcFrame->puiCTUIntraCost[iCUAddr] : pcFrame->puiCTUInterCost[iCUAddr]);
+	return true;
+}
+
+#if ETRI_SCENECUT
+/**
+	A cut : the cost against the previous picture exceeds em_iSceneCut % of the intra cost, and this ratio is more than 
+	twice the ratio of the previous picture. 
+	The second condition keeps noisy or fast scenes, where every picture is almost intra, from cutting at each picture. 
+	Flat pictures (mean intra cost of a block under ETRI_SCENECUT_MIN_COST) never cut : both costs are near 0 there.
+*/
+Bool TEncLookahead::ETRI_isSceneCut(Int iPOC)
+{
+	if (!em_bActive || em_iSceneCut <= 0)	{return false;}
+
+	LookaheadFrame* pcFrame = xGetFrame(iPOC);
+	if (!pcFrame || !pcFrame->bDone || !pcFrame->bPrevDone || pcFrame->iPrevPOC < 0)	{return false;}
+
+	if (pcFrame->uiIntraCost == 0 || pcFrame->uiIntraCost < (UInt64)ETRI_SCENECUT_MIN_COST * em_iWidthInBlk * em_iHeightInBlk)	{return false;}
+	if (pcFrame->uiPrevCost * 100 <= (UInt64)em_iSceneCut * pcFrame->uiIntraCost)	{return false;}
+
+	LookaheadFrame* pcPrev = xGetFrame(pcFrame->iPrevPOC);
+	if (pcPrev && pcPrev->bDone && pcPrev->bPrevDone && pcPrev->iPrevPOC >= 0 && pcPrev->uiIntraCost > 0)
+	{
+		return ((Double)pcFrame->uiPrevCost * pcPrev->uiIntraCost > 2.0 * pcPrev->uiPrevCost * pcFrame->uiIntraCost);
+	}
+	return true;
+}
+#endif
+
+// ====================================================================================================================
+// Lookahead functions
+// ====================================================================================================================
+
+Void TEncLookahead::ETRI_submit(TComPic* pcPic, QphotoThreadPool* pcThreadPool)
+{
+	Int iPOC = pcPic->getPOC();
+	Int iRefOffset = em_piRefOffset[iPOC % em_iGOPSize];
+
+	pthread_mutex_lock(&em_mutex);
+	LookaheadFrame* pcFrame = &em_pcFrame[iPOC % em_iNumFrame];
+	pcFrame->iPOC		= iPOC;
+	pcFrame->iRefPOC	= (iRefOffset != 0 && iPOC + iRefOffset >= 0)? iPOC + iRefOffset : -1;
+	pcFrame->bLowres	= false;
+	pcFrame->bClaimed	= false;
+	pcFrame->bDone		= false;
+#if ETRI_SCENECUT
+	pcFrame->iPrevPOC		= (em_iSceneCut > 0 && iPOC > 0)? iPOC - 1 : -1;
+	pcFrame->bPrevClaimed	= false;
+	pcFrame->bPrevDone		= false;
+	pcFrame->uiPrevCost 	= 0;
+	if (pcFrame->iPrevPOC >= 0)
+	{
+		em_iNumPending++;
+	}
+#endif
+
+	em_iLastPOC = iPOC;
+	em_iNumPending++;
+	pthread_mutex_unlock(&em_mutex);
+
+	pcThreadPool->run(EncLookaheadJob::createJob(this, pcPic, iPOC));
+}
+
+/**
+	Pictures whose future reference is not in the batch (end of the sequence) are estimated with the intra costs. 
+*/
+Void TEncLookahead::ETRI_waitAll()
+{
+	if (!em_bActive)	{return;}
+
+	std::vector<LookaheadFrame*> vpcIntraOnly;
+
+	pthread_mutex_lock(&em_mutex);
+	for (Int i = 0; i < em_iNumFrame; i++)
+	{
+		LookaheadFrame* pcFrame = &em_pcFrame[i];
+		if (pcFrame->iPOC >= 0 && !pcFrame->bClaimed && pcFrame->iRefPOC > em_iLastPOC)
+		{
+			pcFrame->iRefPOC = -1;
+			if (pcFrame->bLowres)
+			{
+				pcFrame->bClaimed = true;
+				vpcIntraOnly.push_back(pcFrame);
+			}
+		}
+	}
+	pthread_mutex_unlock(&em_mutex);
+
+	for (size_t i = 0; i < vpcIntraOnly.size(); i++)
+	{
+		xEstimateInter(vpcIntraOnly[i], nullptr, vpcIntraOnly[i]->puiInterCost, vpcIntraOnly[i]->pcMv);
+		xFinish(vpcIntraOnly[i]);
+	}
+
+	pthread_mutex_lock(&em_mutex);
+	while (em_iNumPending > 0)
+	{
+		pthread_cond_wait(&em_cond, &em_mutex);
+	}
+	pthread_mutex_unlock(&em_mutex);
+}
+
+/**
+	Lowres picture and intra costs of pcPic, then the inter costs of every picture whose pair of lowres 
+	pictures is completed by pcPic (pcPic itself and the pictures referring to it). 
+	The scene-cut costs against the previous picture are paired the same way (pcPic and the next picture).
+*/
+Void TEncLookahead::ETRI_CompressUnit(TComPic* pcPic, Int iPOC)
+{
+	LookaheadFrame* pcFrame = &em_pcFrame[iPOC % em_iNumFrame];
+
+	xDownsample(pcPic->getPicYuvOrg(), pcFrame);
+	xEstimateIntra(pcFrame);
+
+	std::vector<LookaheadFrame*> vpcCur, vpcRef;
+
+	pthread_mutex_lock(&em_mutex);
+	pcFrame->bLowres = true;
+
+	LookaheadFrame* pcRef = xGetFrame(pcFrame->iRefPOC);
+	if (pcFrame->iRefPOC < 0 || (!pcRef && pcFrame->iRefPOC < iPOC))
+	{
+		pcFrame->bClaimed = true;									///< No reference, or it left the lookahead
+		vpcCur.push_back(pcFrame);	vpcRef.push_back(nullptr);
+	}
+	else if (pcRef && pcRef->bLowres)
+	{
+		pcFrame->bClaimed = true;
+		vpcCur.push_back(pcFrame);	vpcRef.push_back(pcRef);
+	}
+
+	for (Int i = 0; i < em_iNumFrame; i++)
+	{
+		LookaheadFrame* pcOther = &em_pcFrame[i];
+		if (pcOther->iPOC >= 0 && pcOther->iRefPOC == iPOC && pcOther->bLowres && !pcOther->bClaimed)
+		{
+			pcOther->bClaimed = true;
+			vpcCur.push_back(pcOther);	vpcRef.push_back(pcFrame);
+		}
+	}
+
+#if ETRI_SCENECUT
+	std::vector<LookaheadFrame*> vpcPrevCur, vpcPrevRef;
+	if (pcFrame->iPrevPOC >= 0)
+	{
+		LookaheadFrame* pcPrev = xGetFrame(pcFrame->iPrevPOC);
+		if (!pcPrev || pcPrev->bLowres)
+		{
+			pcFrame->bPrevClaimed = true;								///< A previous picture which left the lookahead is no cut
+			vpcPrevCur.push_back(pcFrame);	vpcPrevRef.push_back(pcPrev);
+		}
+	}
+
+	LookaheadFrame* pcNext = xGetFrame(iPOC + 1);
+	if (pcNext && pcNext->iPrevPOC == iPOC && pcNext->bLowres && !pcNext->bPrevClaimed)
+	{
+		pcNext->bPrevClaimed = true;
+		vpcPrevCur.push_back(pcNext);	vpcPrevRef.push_back(pcFrame);
+	}
+#endif
+	pthread_mutex_unlock(&em_mutex);
+
+	for (size_t i = 0; i < vpcCur.size(); i++)
+	{
+		xEstimateInter(vpcCur[i], vpcRef[i], vpcCur[i]->puiInterCost, vpcCur[i]->pcMv);
+		xFinish(vpcCur[i]);
+	}
+
+#if ETRI_SCENECUT
+	for (size_t i = 0; i < vpcPrevCur.size(); i++)
+	{
+		if (vpcPrevRef[i])
+		{
+			xEstimateInter(vpcPrevCur[i], vpcPrevRef[i], vpcPrevCur[i]->puiPrevCost, vpcPrevCur[i]->pcPrevMv);
+		}
+		else
+		{
+			::memset(vpcPrevCur[i]->puiPrevCost, 0, sizeof(UInt) * em_iWidthInBlk * em_iHeightInBlk);
+		}
+		xFinishPrev(vpcPrevCur[i]);
+	}
+#endif
+}
+
+/// 2x2 average of the luma with the edge samples repeated into the margin
+Void TEncLookahead::xDownsample(TComPicYuv* pcPicYuv, LookaheadFrame* pcFrame)
+{
+	Pel*	piSrc		= pcPicYuv->getLumaAddr();
+	Int 	iSrcStride	= pcPicYuv->getStride();
+	Int 	iSrcWidth	= pcPicYuv->getWidth();
+	Int 	iSrcHeight	= pcPicYuv->getHeight();
+	Pel*	piDst		= pcFrame->pLowres;
+
+	for (Int y = 0; y < em_iHeight; y++)
+	{
+		Pel* piRow0 = piSrc + std::min(2 * y,     iSrcHeight - 1) * iSrcStride;
+		Pel* piRow1 = piSrc + std::min(2 * y + 1, iSrcHeight - 1) * iSrcStride;
+
+		for (Int x = 0; x < em_iWidth; x++)
+		{
+			Int iX0 = std::min(2 * x,     iSrcWidth - 1);
+			Int iX1 = std::min(2 * x + 1, iSrcWidth - 1);
+			piDst[x] = (Pel)((piRow0[iX0] + piRow0[iX1] + piRow1[iX0] + piRow1[iX1] + 2) >> 2);
+		}
+		for (Int x = 1; x <= ETRI_LOOKAHEAD_MARGIN; x++)
+		{
+			piDst[-x] = piDst[0];
+			piDst[em_iWidth - 1 + x] = piDst[em_iWidth - 1];
+		}
+		piDst += em_iStride;
+	}
+
+	Pel* piFirst = pcFrame->pLowres - ETRI_LOOKAHEAD_MARGIN;
+	Pel* piLast  = piFirst + (em_iHeight - 1) * em_iStride;
+	for (Int y = 1; y <= ETRI_LOOKAHEAD_MARGIN; y++)
+	{
+		::memcpy(piFirst - y * em_iStride, piFirst, sizeof(Pel) * em_iStride);
+		::memcpy(piLast  + y * em_iStride, piLast,  sizeof(Pel) * em_iStride);
+	}
+}
+
+/// Minimum SATD of the DC, vertical and horizontal predictions from the lowres neighbours of each block
+Void TEncLookahead::xEstimateIntra(LookaheadFrame* pcFrame)
+{
+	Pel 	aiPred[ETRI_LOOKAHEAD_BLK * ETRI_LOOKAHEAD_BLK];
+	Int 	iBitDepth = g_bitDepthY;
+
+	for (Int by = 0; by < em_iHeightInBlk; by++)
+	{
+		for (Int bx = 0; bx < em_iWidthInBlk; bx++)
+		{
+			Pel*	piOrg	= pcFrame->pLowres + by * ETRI_LOOKAHEAD_BLK * em_iStride + bx * ETRI_LOOKAHEAD_BLK;
+			Pel*	piTop	= piOrg - em_iStride;
+			Bool	bTop	= (by > 0);
+			Bool	bLeft	= (bx > 0);
+
+			Int iSum = 0, iNum = 0;
+			if (bTop)	{for (Int i = 0; i < ETRI_LOOKAHEAD_BLK; i++)	{iSum += piTop[i];}					iNum += ETRI_LOOKAHEAD_BLK;}
+			if (bLeft)	{for (Int i = 0; i < ETRI_LOOKAHEAD_BLK; i++)	{iSum += piOrg[i * em_iStride - 1];}	iNum += ETRI_LOOKAHEAD_BLK;}
+			Pel iDC = (Pel)(iNum? (iSum + (iNum >> 1)) / iNum : 1 << (iBitDepth - 1));
+
+			for (Int i = 0; i < ETRI_LOOKAHEAD_BLK * ETRI_LOOKAHEAD_BLK; i++)	{aiPred[i] = iDC;}
+			UInt uiCost = em_cRdCost.calcHAD(iBitDepth, piOrg, em_iStride, aiPred, ETRI_LOOKAHEAD_BLK, ETRI_LOOKAHEAD_BLK, ETRI_LOOKAHEAD_BLK);
+
+			if (bTop)
+			{
+				for (Int y = 0; y < ETRI_LOOKAHEAD_BLK; y++)
+					for (Int x = 0; x < ETRI_LOOKAHEAD_BLK; x++)	{aiPred[y * ETRI_LOOKAHEAD_BLK + x] = piTop[x];}
+				uiCost = std::min(uiCost, em_cRdCost.calcHAD(iBitDepth, piOrg, em_iStride, aiPred, ETRI_LOOKAHEAD_BLK, ETRI_LOOKAHEAD_BLK, ETRI_LOOKAHEAD_BLK));
+			}
+			if (bLeft)
+			{
+				for (Int y = 0; y < ETRI_LOOKAHEAD_BLK; y++)
+					for (Int x = 0; x < ETRI_LOOKAHEAD_BLK; x++)	{aiPred[y * ETRI_LOOKAHEAD_BLK + x] = piOrg[y * em_iStride - 1];}
+				uiCost = std::min(uiCost, em_cRdCost.calcHAD(iBitDepth, piOrg, em_iStride, aiPred, ETRI_LOOKAHEAD_BLK, ETRI_LOOKAHEAD_BLK, ETRI_LOOKAHEAD_BLK));
+			}
+
+			pcFrame->puiIntraCost[by * em_iWidthInBlk + bx] = uiCost;
+		}
+	}
+}
+
+UInt TEncLookahead::xGetSAD(Pel* piOrg, Pel* piRef, Int iRefStride)
+{
+	DistParam cDistParam;
+	em_cRdCost.setDistParam(cDistParam, g_bitDepthY, piOrg, em_iStride, piRef, iRefStride, ETRI_LOOKAHEAD_BLK, ETRI_LOOKAHEAD_BLK);
+	cDistParam.bApplyWeight = false;
+
+	return cDistParam.DistFunc(&cDistParam);
+}
+
+/**
+	SAD search from the zero, left, top and top-right predictors followed by a diamond refinement (step 4, 2, 1) 
+	and a half-pel refinement (average of the two nearest integer positions), then the SATD at the best position. 
+	A lowres half-pel is a full-pel of the input picture, so slow motions are not mistaken for complexity. 
+	The costs and MVs are written to puiCost and pcMv of pcFrame. pcRef == nullptr : the inter costs are the intra costs.
+*/
+Void TEncLookahead::xEstimateInter(LookaheadFrame* pcFrame, LookaheadFrame* pcRef, UInt* puiCost, TComMv* pcMv)
+{
+	Int iNumBlk = em_iWidthInBlk * em_iHeightInBlk;
+	if (!pcRef)
+	{
+		::memcpy(puiCost, pcFrame->puiIntraCost, sizeof(UInt) * iNumBlk);
+		for (Int i = 0; i < iNumBlk; i++)	{pcMv[i].setZero();}
+		return;
+	}
+
+	static const Int aiDiamond[4][2] = {{0, -1}, {-1, 0}, {1, 0}, {0, 1}};
+	Pel aiHalfPred[ETRI_LOOKAHEAD_BLK * ETRI_LOOKAHEAD_BLK];
+	Pel aiHalfBest[ETRI_LOOKAHEAD_BLK * ETRI_LOOKAHEAD_BLK];
+
+	for (Int by = 0; by < em_iHeightInBlk; by++)
+	{
+		for (Int bx = 0; bx < em_iWidthInBlk; bx++)
+		{
+			Int 	iIdx	= by * em_iWidthInBlk + bx;
+			Int 	iOffset = by * ETRI_LOOKAHEAD_BLK * em_iStride + bx * ETRI_LOOKAHEAD_BLK;
+			Pel*	piOrg	= pcFrame->pLowres + iOffset;
+			Pel*	piRef	= pcRef->pLowres + iOffset;
+
+			//-------------------------------------------------------------
+			//	Predictors
+			//-------------------------------------------------------------
+			TComMv	acCand[4];
+			Int 	iNumCand = 1;
+			acCand[0].setZero();
+			if (bx > 0)								{acCand[iNumCand++] = pcMv[iIdx - 1];}
+			if (by > 0)								{acCand[iNumCand++] = pcMv[iIdx - em_iWidthInBlk];}
+			if (by > 0 && bx < em_iWidthInBlk - 1)	{acCand[iNumCand++] = pcMv[iIdx - em_iWidthInBlk + 1];}
+
+			Int 	iBestX = 0, iBestY = 0;
+			UInt	uiBestSAD = MAX_UINT;
+			for (Int i = 0; i < iNumCand; i++)
+			{
+				Int iX = Clip3(-ETRI_LOOKAHEAD_SEARCH, ETRI_LOOKAHEAD_SEARCH, (Int)acCand[i].getHor());
+				Int iY = Clip3(-ETRI_LOOKAHEAD_SEARCH, ETRI_LOOKAHEAD_SEARCH, (Int)acCand[i].getVer());
+				UInt uiSAD = xGetSAD(piOrg, piRef + iY * em_iStride + iX, em_iStride);
+				if (uiSAD < uiBestSAD)	{uiBestSAD = uiSAD; iBestX = iX; iBestY = iY;}
+			}
+
+			//-------------------------------------------------------------
+			//	Diamond refinement
+			//-------------------------------------------------------------
+			for (Int iStep = 4; iStep > 0; iStep >>= 1)
+			{
+				Bool bMoved = true;
+				for (Int iIter = 0; bMoved && iIter < 8; iIter++)
+				{
+					bMoved = false;
+					Int iCenterX = iBestX, iCenterY = iBestY;
+					for (Int i = 0; i < 4; i++)
+					{
+						Int iX = iCenterX + aiDiamond[i][0] * iStep;
+						Int iY = iCenterY + aiDiamond[i][1] * iStep;
+						if (abs(iX) > ETRI_LOOKAHEAD_SEARCH || abs(iY) > ETRI_LOOKAHEAD_SEARCH)	{continue;}
+
+						UInt uiSAD = xGetSAD(piOrg, piRef + iY * em_iStride + iX, em_iStride);
+						if (uiSAD < uiBestSAD)	{uiBestSAD = uiSAD; iBestX = iX; iBestY = iY; bMoved = true;}
+					}
+				}
+			}
+
+			//-------------------------------------------------------------
+			//	Half-pel refinement
+			//-------------------------------------------------------------
+			Pel*	piBest	= piRef + iBestY * em_iStride + iBestX;
+			Pel*	piPred	= piBest;
+			Int 	iPredStride = em_iStride;
+			for (Int iDir = 0; iDir < 8; iDir++)
+			{
+				static const Int aiHalf[8][2] = {{-1, -1}, {0, -1}, {1, -1}, {-1, 0}, {1, 0}, {-1, 1}, {0, 1}, {1, 1}};
+				Pel* piNext = piBest + aiHalf[iDir][1] * em_iStride + aiHalf[iDir][0];
+				Pel* piHalf = aiHalfPred;
+				for (Int y = 0; y < ETRI_LOOKAHEAD_BLK; y++)
+				{
+					for (Int x = 0; x < ETRI_LOOKAHEAD_BLK; x++)
+					{
+						piHalf[y * ETRI_LOOKAHEAD_BLK + x] = (Pel)((piBest[y * em_iStride + x] + piNext[y * em_iStride + x] + 1) >> 1);
+					}
+				}
+
+				UInt uiSAD = xGetSAD(piOrg, piHalf, ETRI_LOOKAHEAD_BLK);
+				if (uiSAD < uiBestSAD)
+				{
+					uiBestSAD = uiSAD;
+					::memcpy(aiHalfBest, aiHalfPred, sizeof(aiHalfBest));
+					piPred = aiHalfBest;	iPredStride = ETRI_LOOKAHEAD_BLK;
+				}
+			}
+
+			UInt uiInter = em_cRdCost.calcHAD(g_bitDepthY, piOrg, em_iStride, piPred, iPredStride, ETRI_LOOKAHEAD_BLK, ETRI_LOOKAHEAD_BLK);
+
+			pcMv[iIdx].set(iBestX, iBestY);
+			puiCost[iIdx] = std::min(uiInter, pcFrame->puiIntraCost[iIdx]);
+		}
+	}
+}
+
+/// CTU and picture sums, then the picture is released to the consumers
+Void TEncLookahead::xFinish(LookaheadFrame* pcFrame)
+{
+	Int iNumCU = em_iWidthInCU * em_iHeightInCU;
+	::memset(pcFrame->puiCTUIntraCost, 0, sizeof(UInt64) * iNumCU);
+	::memset(pcFrame->puiCTUInterCost, 0, sizeof(UInt64) * iNumCU);
+
+	for (Int by = 0; by < em_iHeightInBlk; by++)
+	{
+		Int iCURow = std::min(by / em_iBlkInCU, em_iHeightInCU - 1);
+		for (Int bx = 0; bx < em_iWidthInBlk; bx++)
+		{
+			Int iCUAddr = iCURow * em_iWidthInCU + std::min(bx / em_iBlkInCU, em_iWidthInCU - 1);
+			pcFrame->puiCTUIntraCost[iCUAddr] += pcFrame->puiIntraCost[by * em_iWidthInBlk + bx];
+			pcFrame->puiCTUInterCost[iCUAddr] += pcFrame->puiInterCost[by * em_iWidthInBlk + bx];
+		}
+	}
+
+	pcFrame->uiIntraCost = 0;
+	pcFrame->uiInterCost = 0;
+	for (Int i = 0; i < iNumCU; i++)
+	{
+		pcFrame->uiIntraCost += pcFrame->puiCTUIntraCost[i];
+		pcFrame->uiInterCost += pcFrame->puiCTUInterCost[i];
+	}
+
+	pthread_mutex_lock(&em_mutex);
+	pcFrame->bDone = true;
+	if (--em_iNumPending == 0)
+	{
+		pthread_cond_broadcast(&em_cond);
+	}
+	pthread_mutex_unlock(&em_mutex);
+}
+
+#if ETRI_SCENECUT
+/// Picture sum of the scene-cut costs
+Void TEncLookahead::xFinishPrev(LookaheadFrame* pcFrame)
+{
+	Int iNumBlk = em_iWidthInBlk * em_iHeightInBlk;
+
+	pcFrame->uiPrevCost = 0;
+	for (Int i = 0; i < iNumBlk; i++)
+	{
+		pcFrame->uiPrevCost += pcFrame->puiPrevCost[i];
+	}
+
+	pthread_mutex_lock(&em_mutex);
+	pcFrame->bPrevDone = true;
+	if (--em_iNumPending == 0)
+	{
+		pthread_cond_broadcast(&em_cond);
+	}
+	pthread_mutex_unlock(&em_mutex);
+}
+#endif
+
+// ====================================================================================================================
+// Lookahead job
+// ====================================================================================================================
+EncLookaheadJob::EncLookaheadJob(TEncLookahead *pcLookahead, TComPic *pcPic, int iPOC)
+{
+	m_pcLookahead = pcLookahead;
+	m_pcPic = pcPic;
+	m_iPOC = iPOC;
+}
+
+void EncLookaheadJob::run(void *)
+{
+	m_pcLookahead->ETRI_CompressUnit(m_pcPic, m_iPOC);
+}
+
+EncLookaheadJob* EncLookaheadJob::createJob(TEncLookahead *pcLookahead, TComPic *pcPic, int iPOC)
+{
+	EncLookaheadJob *job = new EncLookaheadJob(pcLookahead, pcPic, iPOC);
+	return job;
+}
+
+//! \}
+#endif
@@ -0,0 +1,171 @@
+/*
+*********************************************************************************************
+
+   Copyright (c) 2015 Electronics and Telecommunications Research Institute (ETRI) All Rights Reserved.
+
+   Following acts are STRICTLY PROHIBITED except when a specific prior written permission is obtained from 
+   ETRI or a separate written agreement with ETRI stipulates such permission specifically:
+
+      a) Selling, distributing, sublicensing, renting, leasing, transmitting, redistributing or otherwise transferring 
+          this software to a third party;
+      b) Copying, transforming, modifying, creating any derivatives of, reverse engineering, decompiling, 
+          disassembling, translating, making any attempt to discover the source code of, the whole or part of 
+          this software in source or binary form; 
+      c) Making any copy of the whole or part of this software other than one copy for backup purposes only; and 
+      d) Using the name, trademark or logo of ETRI or the names of contributors in order to endorse or promote 
+          products derived from this software.
+
+   This software is provided "AS IS," without a warranty of any kind. ALL EXPRESS OR IMPLIED CONDITIONS, 
+   REPRESENTATIONS AND WARRANTIES, INCLUDING ANY IMPLIED WARRANTY OF MERCHANTABILITY, FITNESS 
+   FOR A PARTICULAR PURPOSE OR NON-INFRINGEMENT, ARE HEREBY EXCLUDED. IN NO EVENT WILL ETRI 
+   (OR ITS LICENSORS, IF ANY) BE LIABLE FOR ANY LOST REVENUE, PROFIT OR DATA, OR FOR DIRECT, 
+   INDIRECT, SPECIAL, CONSEQUENTIAL, INCIDENTAL OR PUNITIVE DAMAGES, HOWEVER CAUSED AND 
+   REGARDLESS OF THE THEORY OF LIABILITY, ARISING FROM, OUT OF OR IN CONNECTION WITH THE USE 
+   OF OR INABILITY TO USE THIS SOFTWARE, EVEN IF ETRI HAS BEEN ADVISED OF THE POSSIBILITY OF 
+   SUCH DAMAGES.
+
+   Any permitted redistribution of this software must retain the copyright notice, conditions, and disclaimer 
+   as specified above.
+
+*********************************************************************************************
+*/
+/** 
+	\file   	TEncLookahead.h
+   	\brief    	Frame lookahead class (header)
+*/
+
+#ifndef __TENCLOOKAHEAD__
+#define __TENCLOOKAHEAD__
+
+// Include files
+#include "TLibCommon/CommonDef.h"
+#include "TLibCommon/TComPic.h"
+#include "TLibCommon/TComPicYuv.h"
+#include "TLibCommon/TComRdCost.h"
+#include "TLibCommon/TComMv.h"
+
+#include <pthread.h>
+
+//! \ingroup TLibEncoder
+//! \{
+
+class TEncTop;
+class QphotoThreadPool;
+
+#define	ETRI_LOOKAHEAD_BLK			8		///< Cost block of the lowres picture (16x16 of the input picture)
+#define	ETRI_LOOKAHEAD_MARGIN		32		///< Padding of the lowres picture for the motion search
+#define	ETRI_LOOKAHEAD_SEARCH		16		///< Lowres search range (32 pels of the input picture)
+#if ETRI_SCENECUT
+#define	ETRI_SCENECUT_MIN_COST		16		///< Mean intra SATD of a block below which a picture is flat and never a scene cut
+#endif
+
+/// Lowres picture and estimated costs of an input picture
+struct LookaheadFrame
+{
+	Int			iPOC;					///< -1 : empty slot
+	Int			iRefPOC;				///< Reference of the inter cost (nearest reference of the GOP structure). -1 : intra only
+	Bool		bLowres;				///< Lowres picture and intra costs are ready
+	Bool		bClaimed;				///< A job took the inter cost estimation
+	Bool		bDone;					///< Every cost is ready
+
+	Pel*		pLowresBuf;
+	Pel*		pLowres;				///< Origin of the lowres picture in pLowresBuf
+	UInt*		puiIntraCost;			///< Intra SATD of each block
+	UInt*		puiInterCost;			///< min(intra, inter) SATD of each block
+	TComMv*		pcMv;					///< Lowres MV of each block
+	UInt64*		puiCTUIntraCost;		///< Sums over the blocks of each CTU
+	UInt64*		puiCTUInterCost;
+	UInt64		uiIntraCost;			///< Sums over the picture
+	UInt64		uiInterCost;
+#if ETRI_SCENECUT
+	Int 		iPrevPOC;				///< Previous picture for the scene-cut cost. -1 : none
+	Bool		bPrevClaimed;
+	Bool		bPrevDone;
+	UInt*		puiPrevCost;			///< min(intra, inter) SATD of each block against the previous picture
+	TComMv*		pcPrevMv;
+	UInt64		uiPrevCost;
+#endif
+};
+
+// ====================================================================================================================
+// Class definition  
+// ====================================================================================================================
+/**
+	Lookahead of the input pictures received for a GOP batch. 
+	Each picture is half-sampled as soon as it is received, and its intra SATD and its SATD against the nearest 
+	reference of the GOP structure (min with the intra cost, per 16x16 block) are estimated by a pool job. 
+	The inter cost of a picture is estimated by the job which finishes the second of the two lowres pictures, 
+	so no job waits for another. The costs are kept in a ring of slots indexed by POC for the rate control 
+	until the next intra period overwrites them. 
+	With the scene-cut detection, the cost against the previous picture is estimated the same way, and a picture 
+	whose previous-picture cost is close to its intra cost starts a new scene.
+*/
+class TEncLookahead
+{
+
+private:
+	Bool					em_bActive;
+	TComRdCost				em_cRdCost;					///< SATD/SAD functions of the lowres pictures
+	LookaheadFrame*			em_pcFrame;					///< Ring of the input pictures : [em_iNumFrame], POC % em_iNumFrame
+	Int						em_iNumFrame;
+	Int						em_iGOPSize;
+	Int*					em_piRefOffset;				///< Nearest reference offset for POC % GOPSize : [em_iGOPSize]
+#if ETRI_SCENECUT
+	Int						em_iSceneCut;				///< Scene-cut threshold in percent of the intra cost (0:Off)
+#endif
+
+	Int						em_iWidth;					///< Lowres size, multiple of ETRI_LOOKAHEAD_BLK
+	Int						em_iHeight;
+	Int						em_iStride;
+	Int						em_iWidthInBlk;
+	Int						em_iHeightInBlk;
+	Int						em_iWidthInCU;
+	Int						em_iHeightInCU;
+	Int						em_iBlkInCU;				///< Blocks in a CTU row/column
+
+	Int						em_iLastPOC;				///< Latest submitted picture
+	Int						em_iNumPending;				///< Submitted pictures whose costs are not ready
+	pthread_mutex_t			em_mutex;
+	pthread_cond_t			em_cond;
+
+	LookaheadFrame*	xGetFrame				(Int iPOC);
+	Void	xDownsample				(TComPicYuv* pcPicYuv, LookaheadFrame* pcFrame);
+	Void	xEstimateIntra			(LookaheadFrame* pcFrame);
+	Void	xEstimateInter			(LookaheadFrame* pcFrame, LookaheadFrame* pcRef, UInt* puiCost, TComMv* pcMv);
+	UInt	xGetSAD					(Pel* piOrg, Pel* piRef, Int iRefStride);
+	Void	xFinish					(LookaheadFrame* pcFrame);
+#if ETRI_SCENECUT
+	Void	xFinishPrev				(LookaheadFrame* pcFrame);
+#endif
+
+public:
+	TEncLookahead();
+	virtual ~TEncLookahead();
+
+	// -------------------------------------------------------------------------------------------------------------------
+	// Creation and Initilization 
+	// -------------------------------------------------------------------------------------------------------------------
+	Void	create					(TEncTop* pcEncTop);
+	Void	destroy 				();
+	Void	init  					();
+
+	// -------------------------------------------------------------------------------------------------------------------
+	// member access functions
+	// -------------------------------------------------------------------------------------------------------------------
+	Bool	ETRI_isActive			()		{return em_bActive;}
+	Int		ETRI_getNumCTU			()		{return em_iWidthInCU * em_iHeightInCU;}
+	Bool	ETRI_getFrameCost		(Int iPOC, Bool bIntra, Double& rdCost);					///< false : the picture is not in the lookahead
+	Bool	ETRI_getCTUCost 		(Int iPOC, Int iCUAddr, Bool bIntra, Double& rdCost);
+#if ETRI_SCENECUT
+	Bool	ETRI_isSceneCut 		(Int iPOC);													///< false : no cut or the picture is not in the lookahead
+#endif
+
+	// -------------------------------------------------------------------------------------------------------------------
+	// Lookahead functions
+	// -------------------------------------------------------------------------------------------------------------------
+	Void	ETRI_submit 			(TComPic* pcPic, QphotoThreadPool* pcThreadPool);			///< After the input picture is copied
+	Void	ETRI_waitAll			();															///< Before the batch is compressed
+	Void  	ETRI_CompressUnit   	(TComPic* pcPic, Int iPOC);									///< Job body
+};
+//! \}
+#endif
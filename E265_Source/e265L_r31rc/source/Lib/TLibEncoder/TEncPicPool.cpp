@@ -0,0 +1,210 @@
+/*
+*********************************************************************************************
+
+   Copyright (c) 2015 Electronics and Telecommunications Research Institute (ETRI) All Rights Reserved.
+
+   Following acts are STRICTLY PROHIBITED except when a specific prior written permission is obtained from 
+   ETRI or a separate written agreement with ETRI stipulates such permission specifically:
+
+      a) Selling, distributing, sublicensing, renting, leasing, transmitting, redistributing or otherwise transferring 
+          this software to a third party;
+      b) Copying, transforming, modifying, creating any derivatives of, reverse engineering, decompiling, 
+          disassembling, translating, making any attempt to discover the source code of, the whole or part of 
+          this software in source or binary form; 
+      c) Making any copy of the whole or part of this software other than one copy for backup purposes only; and 
+      d) Using the name, trademark or logo of ETRI or the names of contributors in order to endorse or promote 
+          products derived from this software.
+
+   This software is provided "AS IS," without a warranty of any kind. ALL EXPRESS OR IMPLIED CONDITIONS, 
+   REPRESENTATIONS AND WARRANTIES, INCLUDING ANY IMPLIED WARRANTY OF MERCHANTABILITY, FITNESS 
+   FOR A PARTICULAR PURPOSE OR NON-INFRINGEMENT, ARE HEREBY EXCLUDED. IN NO EVENT WILL ETRI 
+   (OR ITS LICENSORS, IF ANY) BE LIABLE FOR ANY LOST REVENUE, PROFIT OR DATA, OR FOR DIRECT, 
+   INDIRECT, SPECIAL, CONSEQUENTIAL, INCIDENTAL OR PUNITIVE DAMAGES, HOWEVER CAUSED AND 
+   REGARDLESS OF THE THEORY OF LIABILITY, ARISING FROM, OUT OF OR IN CONNECTION WITH THE USE 
+   OF OR INABILITY TO USE THIS SOFTWARE, EVEN IF ETRI HAS BEEN ADVISED OF THE POSSIBILITY OF 
+   SUCH DAMAGES.
+
+   Any permitted redistribution of this software must retain the copyright notice, conditions, and disclaimer 
+   as specified above.
+
+*********************************************************************************************
+*/
+/** 
+	\file   	TEncPicPool.cpp
+   	\brief    	Picture pool of the GOP-parallel encoder
+*/
+
+#include "TEncPicPool.h"
+
+//! \ingroup TLibEncoder
+//! \{
+
+// ====================================================================================================================
+// Constructor / create / destroy
+// ====================================================================================================================
+
+TEncPicPool::TEncPicPool()
+{
+	em_iNumPic		= 0;
+	em_iPOCBase		= 0;
+	em_apcPic		= nullptr;
+	em_apcPicOfPOC	= nullptr;
+	em_aiRefCount	= nullptr;
+	em_apcFree		= nullptr;
+	em_iFreeHead	= 0;
+	em_iNumFree		= 0;
+	em_apcRec		= nullptr;
+	em_iNumRec		= 0;
+}
+
+/**
+	@brief	Allocate every picture once and fill pcListPic with the POCs 0 ... iNumPic-1
+*/
+Void TEncPicPool::ETRI_create(Int iNumPic, Int iWidth, Int iHeight, UInt uiMaxWidth, UInt uiMaxHeight, UInt uiMaxDepth,
+							  Window &conformanceWindow, Window &defaultDisplayWindow, Int *numReorderPics, TComList<TComPic*>* pcListPic)
+{
+	assert(iNumPic > 0);
+
+	em_iNumPic		= iNumPic;
+	em_apcPic		= new TComPic*[iNumPic];
+	em_apcPicOfPOC	= new TComPic*[iNumPic];
+	em_aiRefCount	= new Int[iNumPic];
+	em_apcFree		= new TComPic*[iNumPic];
+	em_iFreeHead	= 0;
+	em_iNumFree		= 0;
+
+	for (Int i = 0; i < iNumPic; i++)
+	{
+		em_apcPic[i] = new TComPic;
+		em_apcPic[i]->create(iWidth, iHeight, uiMaxWidth, uiMaxHeight, uiMaxDepth, conformanceWindow, defaultDisplayWindow, numReorderPics);
+
+		em_apcPicOfPOC[i]	= nullptr;
+		em_aiRefCount[i]	= 0;
+		em_apcFree[em_iNumFree++] = em_apcPic[i];
+	}
+
+	em_iPOCBase = 0;
+	for (Int i = 0; i < iNumPic; i++)
+	{
+		TComPic* pcPic = ETRI_acquire(i);
+		if (!pcPic)	{ETRI_EXIT(EXIT_FAILURE);}		///< ETRI_acquire has printed the POC
+		pcListPic->pushBack(pcPic);
+	}
+}
+
+Void TEncPicPool::ETRI_destroy(TComList<TComPic*>* pcListPic)
+{
+	for (Int i = 0; i < em_iNumPic; i++)
+	{
+		em_apcPic[i]->destroy();
+		delete em_apcPic[i];
+	}
+	pcListPic->clear();
+
+	delete[] em_apcPic;			em_apcPic		= nullptr;
+	delete[] em_apcPicOfPOC;	em_apcPicOfPOC	= nullptr;
+	delete[] em_aiRefCount;		em_aiRefCount	= nullptr;
+	delete[] em_apcFree;		em_apcFree		= nullptr;
+	delete[] em_apcRec;			em_apcRec		= nullptr;
+	em_iNumPic	= 0;
+	em_iNumFree	= 0;
+	em_iNumRec	= 0;
+}
+
+// ====================================================================================================================
+// Acquire / release
+// ====================================================================================================================
+
+TComPic* TEncPicPool::ETRI_acquire(Int iPOC)
+{
+	Int iSlot = iPOC % em_iNumPic;
+
+	if (em_iNumFree == 0 || em_apcPicOfPOC[iSlot])
+	{
+		fprintf(stderr, "TEncPicPool: no picture for POC %d (%d pictures)\n", iPOC, em_iNumPic);
+		assert(0);
+		return nullptr;
+	}
+
+	TComPic* pcPic = em_apcFree[em_iFreeHead];
+	em_iFreeHead = (em_iFreeHead + 1) % em_iNumPic;
+	em_iNumFree--;
+
+	pcPic->getSlice(0)->setPOC(iPOC);
+	em_apcPicOfPOC[iSlot]	= pcPic;
+	em_aiRefCount[iSlot]	= 1;
+
+	return pcPic;
+}
+
+Void TEncPicPool::ETRI_addRef(Int iPOC)
+{
+	assert(ETRI_getPic(iPOC));
+	em_aiRefCount[iPOC % em_iNumPic]++;
+}
+
+Void TEncPicPool::ETRI_release(Int iPOC)
+{
+	Int iSlot = iPOC % em_iNumPic;
+
+	assert(ETRI_getPic(iPOC) && em_aiRefCount[iSlot] > 0);
+	if (--em_aiRefCount[iSlot] > 0)
+	{
+		return;
+	}
+
+	em_apcFree[(em_iFreeHead + em_iNumFree) % em_iNumPic] = em_apcPicOfPOC[iSlot];
+	em_iNumFree++;
+	em_apcPicOfPOC[iSlot] = nullptr;
+}
+
+/**
+	@brief	End of a batch : every picture of pcListPic is released and the list is refilled with iPOCBase, iPOCBase+1, ...
+			The picture of iPOCBase, if any, stays at the head of the list. The others are reused in their list order,
+			as by the former renumbering of the list (TEncTop::ETRI_xPocReArrayPicBuffer).
+*/
+Void TEncPicPool::ETRI_recycle(Int iPOCBase, TComList<TComPic*>* pcListPic)
+{
+	TComPic* pcPicBase = ETRI_getPic(iPOCBase);
+
+	if (pcPicBase)
+	{
+		ETRI_addRef(iPOCBase);
+	}
+	for (TComList<TComPic*>::iterator iterPic = pcListPic->begin(); iterPic != pcListPic->end(); iterPic++)
+	{
+		ETRI_release((*iterPic)->getPOC());
+	}
+	pcListPic->clear();
+
+	em_iPOCBase = iPOCBase;
+	if (pcPicBase)
+	{
+		pcListPic->pushBack(pcPicBase);
+	}
+	for (Int iPOC = iPOCBase + (Int)pcListPic->size(); (Int)pcListPic->size() < em_iNumPic; iPOC++)
+	{
+		TComPic* pcPic = ETRI_acquire(iPOC);
+		if (!pcPic)	{ETRI_EXIT(EXIT_FAILURE);}		///< ETRI_acquire has printed the POC
+		pcListPic->pushBack(pcPic);
+	}
+}
+/**
+	@brief	Index the reconstruction buffers by list position, so that ETRI_getRec does not walk pcListPicYuvRec
+*/
+Void TEncPicPool::ETRI_setRecList(TComList<TComPicYuv*>* pcListPicYuvRec)
+{
+	if (em_iNumRec != (Int)pcListPicYuvRec->size())
+	{
+		delete[] em_apcRec;
+		em_iNumRec	= (Int)pcListPicYuvRec->size();
+		em_apcRec	= new TComPicYuv*[em_iNumRec];
+	}
+
+	Int iIdx = 0;
+	for (TComList<TComPicYuv*>::iterator iterPicYuvRec = pcListPicYuvRec->begin(); iterPicYuvRec != pcListPicYuvRec->end(); iterPicYuvRec++)
+	{
+		em_apcRec[iIdx++] = *iterPicYuvRec;
+	}
+}
+//! \}
@@ -0,0 +1,90 @@
+/*
+*********************************************************************************************
+
+   Copyright (c) 2015 Electronics and Telecommunications Research Institute (ETRI) All Rights Reserved.
+
+   Following acts are STRICTLY PROHIBITED except when a specific prior written permission is obtained from 
+   ETRI or a separate written agreement with ETRI stipulates such permission specifically:
+
+      a) Selling, distributing, sublicensing, renting, leasing, transmitting, redistributing or otherwise transferring 
+          this software to a third party;
+      b) Copying, transforming, modifying, creating any derivatives of, reverse engineering, decompiling, 
+          disassembling, translating, making any attempt to discover the source code of, the whole or part of 
+          this software in source or binary form; 
+      c) Making any copy of the whole or part of this software other than one copy for backup purposes only; and 
+      d) Using the name, trademark or logo of ETRI or the names of contributors in order to endorse or promote 
+          products derived from this software.
+
+   This software is provided "AS IS," without a warranty of any kind. ALL EXPRESS OR IMPLIED CONDITIONS, 
+   REPRESENTATIONS AND WARRANTIES, INCLUDING ANY IMPLIED WARRANTY OF MERCHANTABILITY, FITNESS 
+   FOR A PARTICULAR PURPOSE OR NON-INFRINGEMENT, ARE HEREBY EXCLUDED. IN NO EVENT WILL ETRI 
+   (OR ITS LICENSORS, IF ANY) BE LIABLE FOR ANY LOST REVENUE, PROFIT OR DATA, OR FOR DIRECT, 
+   INDIRECT, SPECIAL, CONSEQUENTIAL, INCIDENTAL OR PUNITIVE DAMAGES, HOWEVER CAUSED AND 
+   REGARDLESS OF THE THEORY OF LIABILITY, ARISING FROM, OUT OF OR IN CONNECTION WITH THE USE 
+   OF OR INABILITY TO USE THIS SOFTWARE, EVEN IF ETRI HAS BEEN ADVISED OF THE POSSIBILITY OF 
+   SUCH DAMAGES.
+
+   Any permitted redistribution of this software must retain the copyright notice, conditions, and disclaimer 
+   as specified above.
+
+*********************************************************************************************
+*/
+/** 
+	\file   	TEncPicPool.h
+   	\brief    	Picture pool of the GOP-parallel encoder (header)
+*/
+
+#ifndef __TENCPICPOOL__
+#define __TENCPICPOOL__
+
+// Include files
+#include "TLibCommon/CommonDef.h"
+#include "TLibCommon/TComList.h"
+#include "TLibCommon/TComPic.h"
+
+//! \ingroup TLibEncoder
+//! \{
+
+/**
+	Pictures of the GOP-parallel encoder, allocated once and recycled from one intra period to the next.
+	Each picture of the list carries one reference while it belongs to the current batch. The picture
+	that ends a batch gets one more, since the next batch starts with it (ETRI_recycle). Each picture
+	referenced by a frame of TEncGOP::ETRI_compressGOP carries one more until the frames are done.
+*/
+class TEncPicPool
+{
+private:
+	Int 		em_iNumPic;
+	Int 		em_iPOCBase;			///< POC of the first picture of the list
+	TComPic**	em_apcPic;				///< [em_iNumPic] every picture, in the order of allocation
+	TComPic**	em_apcPicOfPOC;			///< [em_iNumPic] picture of a POC at POC % em_iNumPic
+	Int*		em_aiRefCount;			///< [em_iNumPic] references of em_apcPicOfPOC
+	TComPic**	em_apcFree;				///< [em_iNumPic] FIFO of the unused pictures
+	Int 		em_iFreeHead;
+	Int 		em_iNumFree;
+	TComPicYuv**	em_apcRec;			///< [em_iNumRec] reconstruction buffer of each list position
+	Int 		em_iNumRec;
+
+public:
+	TEncPicPool();
+	virtual ~TEncPicPool() {}
+
+	Void		ETRI_create		(Int iNumPic, Int iWidth, Int iHeight, UInt uiMaxWidth, UInt uiMaxHeight, UInt uiMaxDepth,
+								 Window &conformanceWindow, Window &defaultDisplayWindow, Int *numReorderPics, TComList<TComPic*>* pcListPic);
+	Void		ETRI_destroy	(TComList<TComPic*>* pcListPic);
+
+	TComPic*	ETRI_acquire	(Int iPOC);													///< Unused picture for iPOC with one reference, nullptr when the pool has none
+	Void		ETRI_addRef		(Int iPOC);
+	Void		ETRI_release	(Int iPOC);													///< Unused again with the last reference
+	Void		ETRI_recycle	(Int iPOCBase, TComList<TComPic*>* pcListPic);				///< Pictures of the batch from iPOCBase
+	Void		ETRI_setRecList	(TComList<TComPicYuv*>* pcListPicYuvRec);					///< Reconstruction buffers paired with the list positions
+
+	/// Picture of iPOC in the current list, NULL if none
+	TComPic*	ETRI_getPic		(Int iPOC)	{ TComPic* pcPic = em_apcPicOfPOC[iPOC % em_iNumPic]; return (pcPic && pcPic->getPOC() == iPOC) ? pcPic : NULL; }
+	Int 		ETRI_getIndex	(Int iPOC)	{ return iPOC - em_iPOCBase; }					///< Position of iPOC in the list
+	Int 		ETRI_getNumPic	()			{ return em_iNumPic; }
+	/// Reconstruction buffer of iPOC, NULL if none
+	TComPicYuv*	ETRI_getRec		(Int iPOC)	{ Int iIdx = ETRI_getIndex(iPOC); return (iIdx >= 0 && iIdx < em_iNumRec) ? em_apcRec[iIdx] : NULL; }
+};
+//! \}
+#endif
@@ -36,6 +36,9 @@
 */
 #include "TEncRateCtrl.h"
 #include "../TLibCommon/TComPic.h"
+#if ETRI_LOOKAHEAD
+#include "TEncLookahead.h"
+#endif
 
 #include <cmath>
 
@@ -47,6 +50,11 @@ TEncRateCtrl::TEncRateCtrl()
 // 	m_Pics = NULL;
 // 	m_picPara = NULL;
 // 	m_LCUPara = NULL;
+#if ETRI_LOOKAHEAD
+	m_costPOC = NULL;
+	m_CostGOP = NULL;
+	em_pcLookahead = NULL;
+#endif
 }
 
 TEncRateCtrl::~TEncRateCtrl()
@@ -416,6 +424,18 @@ Void TEncRateCtrl::init(Int numTileCol, Int numTileRow, Int* tileColWidth, Int*
 	  m_CostGOP[i] = 0;
   m_CostIDR = 0;
 
+#if ETRI_LOOKAHEAD
+  // bit ratios of the levels until the lookahead costs of the period are set (ETRI_setLookaheadCost)
+  em_iGOPSize = GOPSize;
+  for (Int i = 0; i < GOPSize; i++)
+	  em_aiPOCLevel[GOPList[i].m_POC % GOPSize] = Clip3(1, 4, GOPList[i].m_QPOffset);
+  for (Int i = 0; i < m_intraSize; i++)
+	  m_costPOC[i] = xGetLevelCost(i);
+  for (Int i = 0; i < m_intraSize; i++)
+	  m_CostIDR += m_costPOC[i];
+  for (Int i = 1; i < m_intraSize; i++)
+	  m_CostGOP[(i - 1) / GOPSize] += m_costPOC[i];
+#else
   int CodingOrder[32] = { 0, 8, 4, 2, 6, 1, 3, 5, 7, 16, 12, 10, 14, 9, 11, 13, 15, 24, 20, 18, 22, 17, 19, 21, 23, 28, 26, 30, 25, 27, 29, 31 };
   char rname[64] = { 0, };
   memcpy(rname, inputFile, 3);
@@ -504,10 +524,77 @@ Void TEncRateCtrl::init(Int numTileCol, Int numTileRow, Int* tileColWidth, Int*
 		  m_iSceneChange = testPOC[i];
   }
 #endif
+#endif
 
 #endif
 }
 
+#if ETRI_LOOKAHEAD
+/// Hierarchical level of a picture, taken from the QP offset of its GOP entry (RA GOP 8 : 1 for POC 8, 2 for POC 4, 3 for POC 2 and 6, 4 for odd POCs)
+Int TEncRateCtrl::xGetPOCLevel(Int iIDRModulus)
+{
+	return em_aiPOCLevel[iIDRModulus % em_iGOPSize];
+}
+
+/// Bit ratio of the level of a picture (the ratios of calcFrameTargetBit without the costs)
+Double TEncRateCtrl::xGetLevelCost(Int iIDRModulus)
+{
+	switch (xGetPOCLevel(iIDRModulus))
+	{
+	case 1:		return (Double)m_weight4bpp[2];
+	case 2:		return (Double)m_weight4bpp[4];
+	case 3:		return (Double)(m_weight4bpp[3] - m_weight4bpp[4]) / 3.0;
+	default:	return (Double)(m_weight4bpp[3] - m_weight4bpp[4]) / 12.0;
+	}
+}
+
+/**
+	Cost of each picture of the period : the bit ratio of its hierarchical level, scaled by its lookahead inter cost 
+	(SATD against the nearest reference of the GOP structure) relative to the mean of its level in the period. 
+	The ratio is compressed so that the pictures of low cost are not starved. 
+	Pictures the lookahead has not received yet keep the ratio of their level.
+*/
+Void TEncRateCtrl::ETRI_setLookaheadCost(TEncLookahead* pcLookahead)
+{
+	em_pcLookahead = pcLookahead;
+	if (!pcLookahead || !m_costPOC)	{return;}
+
+	Int iBasePOC = IDRnum * m_intraSize;
+	std::vector<Double> adCost(m_intraSize, 0.0);
+	Double adLevelSum[5] = {0.0, 0.0, 0.0, 0.0, 0.0};
+	Int aiLevelNum[5] = {0, 0, 0, 0, 0};
+	for (Int i = 1; i < m_intraSize; i++)
+	{
+		Int level = xGetPOCLevel(i);
+		if (pcLookahead->ETRI_getFrameCost(iBasePOC + i, false, adCost[i]))
+		{
+			adCost[i] = max(adCost[i], 1.0);
+			adLevelSum[level] += adCost[i];
+			aiLevelNum[level]++;
+		}
+	}
+
+	for (Int i = 1; i < m_intraSize; i++)
+	{
+		Int level = xGetPOCLevel(i);
+		m_costPOC[i] = xGetLevelCost(i);
+		if (adCost[i] > 0.0)
+		{
+			m_costPOC[i] *= pow(adCost[i] * aiLevelNum[level] / adLevelSum[level], g_RCLookaheadCostExp);
+		}
+	}
+
+	m_CostIDR = m_costPOC[0];
+	for (Int i = 0; i < m_intraSize / em_iGOPSize; i++)
+		m_CostGOP[i] = 0;
+	for (Int i = 1; i < m_intraSize; i++)
+	{
+		m_CostIDR += m_costPOC[i];
+		m_CostGOP[(i - 1) / em_iGOPSize] += m_costPOC[i];
+	}
+}
+#endif
+
 Int		TEncRateCtrl::xEstimateVirtualBuffer(Int iIDRModulus)
 {
 	Int estimatedCpbFullness = 0;
@@ -614,17 +701,21 @@ Int TRCPic::calcFrameTargetBit(Int iPOC)//GOP size 8, intra size 32
 	{
 		remainBits = m_pcRateCtrl->getTargetBitsForIDR();
 		if (remainBits < 0) remainBits = 0;
+#if ETRI_LOOKAHEAD
+		frameTargetBit = (Int)(remainBits / intraSize); // refined by the intra costs of the picture (getRefineBitsForIntra)
+#else
 		frameTargetBit = (Int)(remainBits * costPOC[0]/ CostIDR); // 1.0 by default
+#endif
 		return frameTargetBit;
 	}
 #endif
 
 
 	BSliceTargetBit = m_pcRateCtrl->getTargetBitsForIDR() - m_pcRateCtrl->m_sliceActualBits[0];
-	Int* weight4bpp = m_pcRateCtrl->getBitRatio();
 	
 	Int GOPtype = 0; // 0: include level 1, 1: not include level 1
 #if !KAIST_USEPREPS
+	Int* weight4bpp = m_pcRateCtrl->getBitRatio();
 	if (iIDRModulus > 24)
 	{
 		GOPTargetBit = (Int)((weight4bpp[3] * 1.0 / weight4bpp[0])*BSliceTargetBit);
@@ -932,6 +1023,14 @@ Double TRCPic::estimatePicLambda(SliceType eSliceType)
 	m_picLambda = estLambda;
 
 	Double totalWeight = 0.0;
+#if ETRI_LOOKAHEAD
+	// lookahead inter cost per pixel of each LCU relative to the picture, for the common model
+	TEncLookahead* pcLookahead = m_pcRateCtrl->em_pcLookahead;
+	Double picCostPerPixel = 0.0;
+	Bool bLookaheadWeight = (eSliceType != I_SLICE && !m_pcRateCtrl->getUseLCUSeparateModel() && pcLookahead
+		&& pcLookahead->ETRI_getNumCTU() == m_numberOfLCU && pcLookahead->ETRI_getFrameCost(m_POC, false, picCostPerPixel) && picCostPerPixel > 0.0);
+	picCostPerPixel /= (Double)m_pcRateCtrl->m_numberOfPixel;
+#endif
 	// initial BU bit allocation weight
 	for (Int i = 0; i < m_numberOfLCU; i++)
 	{
@@ -948,6 +1047,13 @@ Double TRCPic::estimatePicLambda(SliceType eSliceType)
 		}
 
 		m_LCUs[i].m_bitWeight = m_LCUs[i].m_numberOfPixel * pow(estLambda / alphaLCU, 1.0 / betaLCU);
+#if ETRI_LOOKAHEAD
+		Double LCUCost = 0.0;
+		if (bLookaheadWeight && pcLookahead->ETRI_getCTUCost(m_POC, i, false, LCUCost))
+		{
+			m_LCUs[i].m_bitWeight *= Clip3(0.25, 4.0, LCUCost / (Double)m_LCUs[i].m_numberOfPixel / picCostPerPixel);
+		}
+#endif
 
 		if (m_LCUs[i].m_bitWeight < 0.01)
 		{
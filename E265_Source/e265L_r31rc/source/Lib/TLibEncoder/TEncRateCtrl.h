@@ -68,11 +68,17 @@ const Double g_RCAlphaMinValue = 0.05;
 const Double g_RCAlphaMaxValue = 500.0;
 const Double g_RCBetaMinValue  = -3.0;
 const Double g_RCBetaMaxValue  = -0.1;
+#if ETRI_LOOKAHEAD
+const Double g_RCLookaheadCostExp = 0.6;		///< exponent of the lookahead cost ratio within a level (ETRI_setLookaheadCost)
+#endif
 
 #define ALPHA     6.7542;
 #define BETA1     1.2517
 #define BETA2     1.7860
 
+#if ETRI_LOOKAHEAD
+class TEncLookahead;
+#endif
 struct TRCLCU
 {
   Int m_actualBits;
@@ -168,6 +174,9 @@ public:
 	Void init(Int numTileCol, Int numTileRow, Int* tileColWidth, Int* tileRowHeight, Int totalFrames, Int targetBitrate, Int frameRate, Int picWidth, Int picHeight, Int LCUWidth, Int LCUHeight, Bool useLCUSeparateModel, Int intraSize, Int GOPSize, GOPEntry  GOPList[MAX_GOP]);
   Void destroy();
   Void initRCPic( Int frameLevel );
+#if ETRI_LOOKAHEAD
+  Void ETRI_setLookaheadCost(TEncLookahead* pcLookahead);		///< Picture costs of the intra period from the lookahead
+#endif
 
 public:
 	Int  getTotalFrames()                 { return m_totalFrames; }
@@ -203,6 +212,10 @@ public:
 
 
 	Int			xEstimateVirtualBuffer(Int iIDRModulus);
+#if ETRI_LOOKAHEAD
+	Int			xGetPOCLevel(Int iIDRModulus);
+	Double		xGetLevelCost(Int iIDRModulus);
+#endif
 
 #if (ETRI_DLL_INTERFACE)
 #if !KAIST_RC
@@ -263,6 +276,11 @@ public:
 	Double *m_costPOC;// [KAIST_NUM_FRAME_IDR];
 	Double m_CostIDR;
 	Double *m_CostGOP;
+#if ETRI_LOOKAHEAD
+	Int em_iGOPSize;
+	Int em_aiPOCLevel[MAX_GOP];		///< Hierarchical level (1..4) of each POC offset in the GOP, from the QP offset of its GOP entry
+	TEncLookahead* em_pcLookahead;
+#endif
 	//Int ****m_mv;// [KAIST_NUM_IDR_ENC][KAIST_NUM_FRAME_IDR][CTU][x/y];
 #if KAIST_SCENECHANGE
 	Int m_iSceneChange;
@@ -159,6 +159,24 @@ TEncSearch::TEncSearch()
 	m_puhQTTempTransformSkipFlag[2] = NULL;
 #endif
 	setWpScalingDistParam( NULL, -1, REF_PIC_LIST_X );
+#if ETRI_PYRAMID_ME
+	em_iPyramidPOC    = MAX_INT;
+	em_iPyramidCUAddr = -1;
+	for (Int iList = 0; iList < 2; iList++)
+	{
+		for (Int iIdx = 0; iIdx < MAX_NUM_REF; iIdx++)
+		{
+			em_aiPyramidRefPOC[iList][iIdx]     = MAX_INT;
+			em_aiPyramidLeftRefPOC[iList][iIdx] = MAX_INT;
+		}
+	}
+	em_bPyramidMv = false;
+#endif
+#if ETRI_MV_CACHE
+	em_uiMvCacheStamp = 1;
+	::memset( em_auiMvCacheStamp, 0, sizeof( em_auiMvCacheStamp ) );
+	em_iNumMvCache = 0;
+#endif
 }
 
 TEncSearch::~TEncSearch()
@@ -913,13 +931,9 @@ UInt TEncSearch::xPatternRefinement( TComPattern* pcPatternKey,
   
   const TComMv* pcMvRefine = (iFrac == 2 ? s_acMvRefineH : s_acMvRefineQ);
   
-#if ETRI_FME_HALFPEL_DIAMOND_ON
   UInt uiHalfNum = 9;
-  if (iFrac == 2) uiHalfNum = 5;
+  if (iFrac == 2 && m_pcEncCfg->ETRI_getHalfPelDiamond()) uiHalfNum = 5;
   for (UInt i = 0; i < uiHalfNum; i++)
-#else 
-  for (UInt i = 0; i < 9; i++)
-#endif 
   {
     TComMv cMvTest = pcMvRefine[i];
     cMvTest += baseRefMv;
@@ -4284,10 +4298,21 @@ TEncSearch::ETRI_xIntraCodingLumaBlk( TComDataCU* pcCU,
 	//--- set coded block flag ---
 	pcCU->setCbfSubParts          ( ( uiAbsSum ? 1 : 0 ) << uiTrDepth, TEXT_LUMA, uiAbsPartIdx, uiFullDepth );
 	//--- inverse transform ---
+#if ETRI_SIMD_AVX2 && ETRI_LOSSLESS_OPTIMIZATION
+	Bool bRecoDone = false;
+#endif
 	if( uiAbsSum )
 	{
 		Int scalingListType = 0 + g_eTTable[(Int)TEXT_LUMA];
 		assert(scalingListType < SCALING_LIST_NUM);
+#if ETRI_SIMD_AVX2 && ETRI_LOSSLESS_OPTIMIZATION
+		if (!useTransformSkip && m_pcTrQuant->ETRI_getTrUseAVX2())	///< Reconstruction by the fused AVX2 inverse transform (transquant bypass is off by ETRI_LOSSLESS_OPTIMIZATION). SSE levels keep the SIMD reconstruction below.
+		{
+			m_pcTrQuant->ETRI_invtransformNxNAddClip(TEXT_LUMA, pcCU->getLumaIntraDir(uiAbsPartIdx), pcCoeff, uiWidth, uiHeight, scalingListType, piPred, uiStride, piReco, uiStride);
+			bRecoDone = true;
+		}
+		else
+#endif
 #if ETRI_LOSSLESS_OPTIMIZATION
 		m_pcTrQuant->invtransformNxN(false, TEXT_LUMA, pcCU->getLumaIntraDir(uiAbsPartIdx), piResi, uiStride, pcCoeff, uiWidth, uiHeight, scalingListType, useTransformSkip);
 #else
@@ -4306,6 +4331,23 @@ TEncSearch::ETRI_xIntraCodingLumaBlk( TComDataCU* pcCU,
 	}
 
 	//===== reconstruction =====
+#if ETRI_SIMD_AVX2 && ETRI_LOSSLESS_OPTIMIZATION
+	if (bRecoDone)
+	{
+		Pel* pReco      = piReco;
+		Pel* pRecQt     = piRecQt;
+		Pel* pRecIPred  = piRecIPred;
+		for (UInt uiY = 0; uiY < uiHeight; uiY++)
+		{
+			memcpy(pRecQt,    pReco, sizeof(Pel) * uiWidth);
+			memcpy(pRecIPred, pReco, sizeof(Pel) * uiWidth);
+			pReco     += uiStride;
+			pRecQt    += uiRecQtStride;
+			pRecIPred += uiRecIPredStride;
+		}
+	}
+	else
+#endif
 	{
 	Pel* pPred      = piPred;
 	Pel* pResi      = piResi;
@@ -6463,11 +6505,7 @@ Void TEncSearch::ETRI_xMotionEstimation( TComDataCU* pcCU, TComYuv* pcYuvOrg, In
 	Int           iRoiWidth;
 	Int           iRoiHeight;
 
-#if ETRI_NOT_QUARTERPEL_ME
-	TComMv        cMvHalf;
-#else 
 	TComMv        cMvHalf, cMvQter;
-#endif 
 
 	TComMv        cMvSrchRngLT;
 	TComMv        cMvSrchRngRB;
@@ -6509,6 +6547,11 @@ Void TEncSearch::ETRI_xMotionEstimation( TComDataCU* pcCU, TComYuv* pcYuvOrg, In
 	if ( bBi )  xSetSearchRange   ( pcCU, rcMv   , iSrchRng, cMvSrchRngLT, cMvSrchRngRB );
 	else        xSetSearchRange   ( pcCU, cMvPred, iSrchRng, cMvSrchRngLT, cMvSrchRngRB );
 
+#if ETRI_FRAME_ROW_THREADING
+	/// The reference may still be encoded : wait for the search window, the zero vector and the taps of the fractional search
+	pcCU->getSlice()->getRefPic( eRefPicList, iRefIdxPred )->getPicYuvRec()->ETRI_waitRowReady( pcCU->getCUPelY() + g_auiRasterToPelY[g_auiZscanToRaster[pcCU->getZorderIdxInCU() + uiPartAddr]] + std::max<Int>(cMvSrchRngRB.getVer(), 0) + iRoiHeight + NTAPS_LUMA );
+#endif
+
 	/// Use SAD and no iADD @ 2015 10 1 by Seok
 	m_pcRdCost->getMotionCost ( 1, 0 );
 
@@ -6540,19 +6583,12 @@ Void TEncSearch::ETRI_xMotionEstimation( TComDataCU* pcCU, TComYuv* pcYuvOrg, In
 	m_pcRdCost->getMotionCost( 1, 0 );
 	m_pcRdCost->setCostScale ( 1 );
 
-#if ETRI_NOT_QUARTERPEL_ME
-	xPatternSearchFracDIF(pcCU, pcPatternKey, piRefY, iRefStride, &rcMv, cMvHalf, ruiCost, bBi);
-#else 
 	xPatternSearchFracDIF(pcCU, pcPatternKey, piRefY, iRefStride, &rcMv, cMvHalf, cMvQter, ruiCost, bBi);
-#endif 
 
 	m_pcRdCost->setCostScale(0);
 	rcMv <<= 2;
 	rcMv += (cMvHalf <<= 1);
-#if ETRI_NOT_QUARTERPEL_ME
-#else 
 	rcMv += cMvQter;
-#endif 
 
 	UInt uiMvBits = m_pcRdCost->getBits( rcMv.getHor(), rcMv.getVer() );
 
@@ -7987,11 +8023,7 @@ Void TEncSearch::xMotionEstimation( TComDataCU* pcCU, TComYuv* pcYuvOrg, Int iPa
 	Int           iRoiWidth;
 	Int           iRoiHeight;
 
-#if ETRI_NOT_QUARTERPEL_ME
-	TComMv        cMvHalf;
-#else 
 	TComMv        cMvHalf, cMvQter;
-#endif 
 	TComMv        cMvSrchRngLT;
 	TComMv        cMvSrchRngRB;
 
@@ -8032,6 +8064,31 @@ Void TEncSearch::xMotionEstimation( TComDataCU* pcCU, TComYuv* pcYuvOrg, Int iPa
 	if ( bBi )  xSetSearchRange   ( pcCU, rcMv   , iSrchRng, cMvSrchRngLT, cMvSrchRngRB );
 	else        xSetSearchRange   ( pcCU, cMvPred, iSrchRng, cMvSrchRngLT, cMvSrchRngRB );
 
+#if ETRI_PYRAMID_ME
+	/// The TZ search also refines around the pre-search vector of the CTU : the search window must contain it
+	em_bPyramidMv = false;
+	if ( m_iFastSearch && !bBi && m_pcEncCfg->ETRI_getPyramidME() )
+	{
+		em_bPyramidMv = ETRI_xGetPyramidMv( pcCU, eRefPicList, iRefIdxPred, em_cPyramidMv );
+		if ( em_bPyramidMv )
+		{
+			ETRI_xExtendSearchRange( pcCU, em_cPyramidMv, cMvSrchRngLT, cMvSrchRngRB );
+		}
+	}
+#endif
+#if ETRI_MV_CACHE
+	em_iNumMvCache = 0;
+	if ( m_iFastSearch && !bBi && m_pcEncCfg->ETRI_getMvCache() )
+	{
+		em_iNumMvCache = ETRI_xGetCachedMv( pcCU, uiPartAddr, iRoiWidth, iRoiHeight, eRefPicList, iRefIdxPred, em_acMvCacheCand );
+	}
+#endif
+
+#if ETRI_FRAME_ROW_THREADING
+	/// The reference may still be encoded : wait for the search window, the zero vector and the taps of the fractional search
+	pcCU->getSlice()->getRefPic( eRefPicList, iRefIdxPred )->getPicYuvRec()->ETRI_waitRowReady( pcCU->getCUPelY() + g_auiRasterToPelY[g_auiZscanToRaster[pcCU->getZorderIdxInCU() + uiPartAddr]] + std::max<Int>(cMvSrchRngRB.getVer(), 0) + iRoiHeight + NTAPS_LUMA );
+#endif
+
 	m_pcRdCost->getMotionCost ( 1, 0 );
 
 	m_pcRdCost->setPredictor  ( *pcMvPred );
@@ -8052,21 +8109,21 @@ Void TEncSearch::xMotionEstimation( TComDataCU* pcCU, TComYuv* pcYuvOrg, Int iPa
 	m_pcRdCost->getMotionCost( 1, 0 );
 	m_pcRdCost->setCostScale ( 1 );
 
-#if ETRI_NOT_QUARTERPEL_ME
-	xPatternSearchFracDIF( pcCU, pcPatternKey, piRefY, iRefStride, &rcMv, cMvHalf, ruiCost,bBi );
-#else 
 	xPatternSearchFracDIF( pcCU, pcPatternKey, piRefY, iRefStride, &rcMv, cMvHalf, cMvQter, ruiCost,bBi );
-#endif 
 
 	m_pcRdCost->setCostScale( 0 );
 	rcMv <<= 2;
 	rcMv += (cMvHalf <<= 1);
-#if ETRI_NOT_QUARTERPEL_ME
-#else 
 	rcMv += cMvQter;
-#endif 
 	UInt uiMvBits = m_pcRdCost->getBits( rcMv.getHor(), rcMv.getVer() );
 
+#if ETRI_MV_CACHE
+	if ( m_iFastSearch && !bBi && m_pcEncCfg->ETRI_getMvCache() )
+	{
+		ETRI_xSetCachedMv( pcCU, uiPartAddr, iRoiWidth, iRoiHeight, eRefPicList, iRefIdxPred, rcMv );
+	}
+#endif
+
 	ruiBits      += uiMvBits;
 	ruiCost       = (UInt)( floor( fWeight * ( (Double)ruiCost - (Double)m_pcRdCost->getCost( uiMvBits ) ) ) + (Double)m_pcRdCost->getCost( ruiBits ) );
 }
@@ -8136,6 +8193,255 @@ Void TEncSearch::xSetSearchRange ( TComDataCU* pcCU, TComMv& cMvPred, Int iSrchR
 	rcMvSrchRngRB >>= iMvShift;
 }
 
+#if ETRI_PYRAMID_ME
+/**
+------------------------------------------------------------------------------------------------------------------------------------------------
+	@brief	Pre-search vector of the CTU of pcCU to the reference (eRefPicList, iRefIdx) in integer samples.
+			The search runs once per CTU and reference on the 1/4 and 1/16 planes of the input pictures (TComPicYuv::ETRI_buildPyramid);
+			the other PUs of the CTU reuse the vector. The 1/16 vectors of a CTU are candidates of the next CTU on the right.
+	@return	false when the pictures have no pyramid or the CTU has no sample on the 1/16 plane 
+------------------------------------------------------------------------------------------------------------------------------------------------
+*/
+Bool TEncSearch::ETRI_xGetPyramidMv( TComDataCU* pcCU, RefPicList eRefPicList, Int iRefIdx, TComMv& rcMv )
+{
+	TComPicYuv*	pcCurYuv = pcCU->getPic()->getPicYuvOrg();
+	TComPicYuv*	pcRefYuv = pcCU->getSlice()->getRefPic( eRefPicList, iRefIdx )->getPicYuvOrg();
+	Int 		iPOC     = pcCU->getSlice()->getPOC();
+	Int 		iRefPOC  = pcCU->getSlice()->getRefPOC( eRefPicList, iRefIdx );
+	Int 		iCUAddr  = pcCU->getAddr();
+
+	if ( !pcCurYuv->ETRI_hasPyramid() || !pcRefYuv->ETRI_hasPyramid() || iRefIdx >= MAX_NUM_REF )
+	{
+		return false;
+	}
+
+	if ( iPOC != em_iPyramidPOC || iCUAddr != em_iPyramidCUAddr )
+	{
+		Bool bLeft = ( iPOC == em_iPyramidPOC ) && ( iCUAddr == em_iPyramidCUAddr + 1 ) && ( iCUAddr % pcCU->getPic()->getFrameWidthInCU() != 0 );
+
+		for ( Int iList = 0; iList < 2; iList++ )
+		{
+			for ( Int iIdx = 0; iIdx < MAX_NUM_REF; iIdx++ )
+			{
+				em_aiPyramidLeftRefPOC[iList][iIdx] = bLeft ? em_aiPyramidRefPOC[iList][iIdx] : MAX_INT;
+				em_acPyramidLeftMv[iList][iIdx]     = em_acPyramidMvL2[iList][iIdx];
+				em_aiPyramidRefPOC[iList][iIdx]     = MAX_INT;
+			}
+		}
+		em_iPyramidPOC    = iPOC;
+		em_iPyramidCUAddr = iCUAddr;
+	}
+
+	if ( em_aiPyramidRefPOC[eRefPicList][iRefIdx] != iRefPOC )
+	{
+		TComMv* pcLeftMv = ( em_aiPyramidLeftRefPOC[eRefPicList][iRefIdx] == iRefPOC ) ? &em_acPyramidLeftMv[eRefPicList][iRefIdx] : NULL;
+
+		if ( !ETRI_xPyramidSearch( pcCU, pcCurYuv, pcRefYuv, pcLeftMv, em_acPyramidMvL2[eRefPicList][iRefIdx], em_acPyramidMv[eRefPicList][iRefIdx] ) )
+		{
+			return false;
+		}
+		em_aiPyramidRefPOC[eRefPicList][iRefIdx] = iRefPOC;
+	}
+
+	rcMv = em_acPyramidMv[eRefPicList][iRefIdx];
+	return true;
+}
+
+/// Full search around the zero vector and the vector of the left CTU on the 1/16 plane, refinement on the 1/4 plane
+Bool TEncSearch::ETRI_xPyramidSearch( TComDataCU* pcCU, TComPicYuv* pcCurYuv, TComPicYuv* pcRefYuv, TComMv* pcLeftMv, TComMv& rcMvL2, TComMv& rcMv )
+{
+	Int 	iCUPelX = pcCU->getCUPelX();
+	Int 	iCUPelY = pcCU->getCUPelY();
+	UInt	uiCost;
+	TComMv	cMvL1;
+
+	rcMvL2.setZero();
+	uiCost = ETRI_xPyramidLevelSearch( pcCurYuv, pcRefYuv, 1, iCUPelX >> 2, iCUPelY >> 2, 0, 0, ETRI_PYRAMID_RANGE, rcMvL2, MAX_UINT );
+	if ( uiCost == MAX_UINT )
+	{
+		return false;
+	}
+
+	/// Motion beyond the range around the zero vector is followed from CTU to CTU, and found by a diamond search of large steps
+	if ( pcLeftMv )
+	{
+		uiCost = ETRI_xPyramidLevelSearch( pcCurYuv, pcRefYuv, 1, iCUPelX >> 2, iCUPelY >> 2, pcLeftMv->getHor(), pcLeftMv->getVer(), ETRI_PYRAMID_REFINE, rcMvL2, uiCost );
+	}
+
+	cMvL1 = rcMvL2;
+	uiCost = ETRI_xPyramidLevelSearch( pcCurYuv, pcRefYuv, 1, iCUPelX >> 2, iCUPelY >> 2, cMvL1.getHor(), cMvL1.getVer(), ETRI_PYRAMID_DIAMOND, rcMvL2, uiCost, true );
+	if ( rcMvL2 != cMvL1 )
+	{
+		ETRI_xPyramidLevelSearch( pcCurYuv, pcRefYuv, 1, iCUPelX >> 2, iCUPelY >> 2, rcMvL2.getHor(), rcMvL2.getVer(), ETRI_PYRAMID_REFINE, rcMvL2, uiCost );
+	}
+
+	cMvL1.set( rcMvL2.getHor() << 1, rcMvL2.getVer() << 1 );
+	ETRI_xPyramidLevelSearch( pcCurYuv, pcRefYuv, 0, iCUPelX >> 1, iCUPelY >> 1, cMvL1.getHor(), cMvL1.getVer(), ETRI_PYRAMID_REFINE, cMvL1, MAX_UINT );
+
+	rcMv.set( cMvL1.getHor() << 1, cMvL1.getVer() << 1 );
+	return true;
+}
+
+/**
+------------------------------------------------------------------------------------------------------------------------------------------------
+	@brief	Full search of the CTU block at (iBlkX, iBlkY) of the pyramid level iLevel in the window of iRange around (iCenterX, iCenterY),
+			or with bDiamond the 8 points of the diamonds of the steps 2, 4, ... iRange around it.
+			The positions are limited to the margin of the planes. The cost is the SAD and a small penalty on the length of the vector.
+	@return	the best cost; rcMv is updated when a position is better than uiBestCost 
+------------------------------------------------------------------------------------------------------------------------------------------------
+*/
+UInt TEncSearch::ETRI_xPyramidLevelSearch( TComPicYuv* pcCurYuv, TComPicYuv* pcRefYuv, Int iLevel, Int iBlkX, Int iBlkY, Int iCenterX, Int iCenterY, Int iRange, TComMv& rcMv, UInt uiBestCost, Bool bDiamond )
+{
+	Int 	iWidth  = pcCurYuv->ETRI_getPyramidWidth ( iLevel );
+	Int 	iHeight = pcCurYuv->ETRI_getPyramidHeight( iLevel );
+	Int 	iStride = pcCurYuv->ETRI_getPyramidStride( iLevel );
+	Int 	iBlkW   = std::min<Int>( g_uiMaxCUWidth  >> (iLevel + 1), iWidth  - iBlkX );
+	Int 	iBlkH   = std::min<Int>( g_uiMaxCUHeight >> (iLevel + 1), iHeight - iBlkY );
+
+	if ( iBlkW <= 0 || iBlkH <= 0 )
+	{
+		return uiBestCost;
+	}
+
+	Int 	iMinX   = -ETRI_PYRAMID_MARGIN - iBlkX;
+	Int 	iMaxX   = iWidth  + ETRI_PYRAMID_MARGIN - iBlkW - iBlkX;
+	Int 	iMinY   = -ETRI_PYRAMID_MARGIN - iBlkY;
+	Int 	iMaxY   = iHeight + ETRI_PYRAMID_MARGIN - iBlkH - iBlkY;
+
+	Pel*	piRef   = pcRefYuv->ETRI_getPyramidAddr( iLevel ) + iBlkY * iStride + iBlkX;
+	UInt	uiCost;
+
+	DistParam cDistParam;
+	m_pcRdCost->setDistParam( iBlkW, iBlkH, DF_SAD, cDistParam );
+	cDistParam.pOrg         = pcCurYuv->ETRI_getPyramidAddr( iLevel ) + iBlkY * iStride + iBlkX;
+	cDistParam.iStrideOrg   = iStride;
+	cDistParam.iStrideCur   = iStride;
+	cDistParam.iStep        = 1;
+	cDistParam.bitDepth     = g_bitDepthY;
+	cDistParam.bApplyWeight = false;
+	cDistParam.uiComp       = 0;
+
+	if ( bDiamond )
+	{
+		static const Int aiDiamond[8][2] = { {0, -2}, {-1, -1}, {1, -1}, {-2, 0}, {2, 0}, {-1, 1}, {1, 1}, {0, 2} };
+
+		for ( Int iDist = 2; iDist <= iRange; iDist <<= 1 )
+		{
+			for ( Int i = 0; i < 8; i++ )
+			{
+				Int x = iCenterX + ((aiDiamond[i][0] * iDist) >> 1);
+				Int y = iCenterY + ((aiDiamond[i][1] * iDist) >> 1);
+				if ( x < iMinX || x > iMaxX || y < iMinY || y > iMaxY )
+				{
+					continue;
+				}
+
+				cDistParam.pCur = piRef + y * iStride + x;
+				uiCost = cDistParam.DistFunc( &cDistParam ) + ( (abs(x) + abs(y)) << 2 );
+
+				if ( uiCost < uiBestCost )
+				{
+					uiBestCost = uiCost;
+					rcMv.set( x, y );
+				}
+			}
+		}
+		return uiBestCost;
+	}
+
+	for ( Int y = std::max<Int>( iCenterY - iRange, iMinY ); y <= std::min<Int>( iCenterY + iRange, iMaxY ); y++ )
+	{
+		for ( Int x = std::max<Int>( iCenterX - iRange, iMinX ); x <= std::min<Int>( iCenterX + iRange, iMaxX ); x++ )
+		{
+			cDistParam.pCur = piRef + y * iStride + x;
+			uiCost = cDistParam.DistFunc( &cDistParam ) + ( (abs(x) + abs(y)) << 2 );
+
+			if ( uiCost < uiBestCost )
+			{
+				uiBestCost = uiCost;
+				rcMv.set( x, y );
+			}
+		}
+	}
+
+	return uiBestCost;
+}
+
+/// Extend the integer search window to the pre-search vector rcMv and the uncertainty of its 1/4 plane refinement
+Void TEncSearch::ETRI_xExtendSearchRange( TComDataCU* pcCU, TComMv& rcMv, TComMv& rcMvSrchRngLT, TComMv& rcMvSrchRngRB )
+{
+	Int 	iRange = ETRI_PYRAMID_REFINE << 1;
+	TComMv	cMvLT( (rcMv.getHor() - iRange) << 2, (rcMv.getVer() - iRange) << 2 );
+	TComMv	cMvRB( (rcMv.getHor() + iRange) << 2, (rcMv.getVer() + iRange) << 2 );
+
+	pcCU->ETRI_clipMv( cMvLT );
+	pcCU->ETRI_clipMv( cMvRB );
+	cMvLT >>= 2;
+	cMvRB >>= 2;
+
+	rcMvSrchRngLT.set( std::min( rcMvSrchRngLT.getHor(), cMvLT.getHor() ), std::min( rcMvSrchRngLT.getVer(), cMvLT.getVer() ) );
+	rcMvSrchRngRB.set( std::max( rcMvSrchRngRB.getHor(), cMvRB.getHor() ), std::max( rcMvSrchRngRB.getVer(), cMvRB.getVer() ) );
+}
+#endif
+
+#if ETRI_MV_CACHE
+/**
+------------------------------------------------------------------------------------------------------------------------------------------------
+	@brief	Start points of the PU from the motion field of the current CTU (quarter-pel, up to 2) \
+			[1] : Vector of the same reference over the centre of the PU : enclosing CU or other partition searched before \
+			[2] : Vector of the previous reference over the centre of the PU, scaled by the POC distances
+------------------------------------------------------------------------------------------------------------------------------------------------
+*/
+Int TEncSearch::ETRI_xGetCachedMv( TComDataCU* pcCU, UInt uiPartAddr, Int iWidth, Int iHeight, RefPicList eRefPicList, Int iRefIdx, TComMv* pcMv )
+{
+	Int 	iNumPartInWidth = pcCU->getPic()->getNumPartInWidth();
+	UInt	uiRaster = g_auiZscanToRaster[pcCU->getZorderIdxInCU() + uiPartAddr];
+	Int 	iUnitX   = uiRaster % iNumPartInWidth + ( iWidth  / (Int)pcCU->getPic()->getMinCUWidth()  >> 1 );
+	Int 	iUnitY   = uiRaster / iNumPartInWidth + ( iHeight / (Int)pcCU->getPic()->getMinCUHeight() >> 1 );
+	Int 	iUnit    = iUnitY * iNumPartInWidth + iUnitX;
+	Int 	iNumMv   = 0;
+
+	if ( em_auiMvCacheStamp[eRefPicList][iRefIdx][iUnit] == em_uiMvCacheStamp )
+	{
+		pcMv[iNumMv++] = em_acMvCache[eRefPicList][iRefIdx][iUnit];
+	}
+
+	if ( iRefIdx > 0 && em_auiMvCacheStamp[eRefPicList][iRefIdx - 1][iUnit] == em_uiMvCacheStamp )
+	{
+		Int 	iPOC   = pcCU->getSlice()->getPOC();
+		Int 	iTDB   = Clip3( -128, 127, iPOC - pcCU->getSlice()->getRefPOC( eRefPicList, iRefIdx ) );
+		Int 	iTDD   = Clip3( -128, 127, iPOC - pcCU->getSlice()->getRefPOC( eRefPicList, iRefIdx - 1 ) );
+		Int 	iX     = ( 0x4000 + abs( iTDD / 2 ) ) / iTDD;
+		Int 	iScale = Clip3( -4096, 4095, ( iTDB * iX + 32 ) >> 6 );
+
+		pcMv[iNumMv++] = em_acMvCache[eRefPicList][iRefIdx - 1][iUnit].scaleMv( iScale );
+	}
+
+	return iNumMv;
+}
+
+/// Store the final vector (quarter-pel) of the PU over all its 4x4 units
+Void TEncSearch::ETRI_xSetCachedMv( TComDataCU* pcCU, UInt uiPartAddr, Int iWidth, Int iHeight, RefPicList eRefPicList, Int iRefIdx, TComMv& rcMv )
+{
+	Int 	iNumPartInWidth = pcCU->getPic()->getNumPartInWidth();
+	UInt	uiRaster = g_auiZscanToRaster[pcCU->getZorderIdxInCU() + uiPartAddr];
+	Int 	iUnitW   = iWidth  / (Int)pcCU->getPic()->getMinCUWidth();
+	Int 	iUnitH   = iHeight / (Int)pcCU->getPic()->getMinCUHeight();
+
+	assert( iNumPartInWidth * iNumPartInWidth <= ETRI_MV_CACHE_UNITS );
+
+	for ( Int y = 0; y < iUnitH; y++ )
+	{
+		Int iUnit = uiRaster + y * iNumPartInWidth;
+		for ( Int x = 0; x < iUnitW; x++, iUnit++ )
+		{
+			em_acMvCache      [eRefPicList][iRefIdx][iUnit] = rcMv;
+			em_auiMvCacheStamp[eRefPicList][iRefIdx][iUnit] = em_uiMvCacheStamp;
+		}
+	}
+}
+#endif
+
 Void TEncSearch::xPatternSearch( TComPattern* pcPatternKey, Pel* piRefY, Int iRefStride, TComMv* pcMvSrchRngLT, TComMv* pcMvSrchRngRB, TComMv& rcMv, UInt& ruiSAD )
 {
   Int   iSrchRngHorLeft   = pcMvSrchRngLT->getHor();
@@ -8254,6 +8560,28 @@ Void TEncSearch::xTZSearch( TComDataCU* pcCU, TComPattern* pcPatternKey, Pel* pi
     xTZSearchHelp( pcPatternKey, cStruct, 0, 0, 0, 0 );
   }
   
+#if ETRI_MV_CACHE
+  // test the vectors already found in the CTU : a good match of one of them only needs a local refinement
+  Bool bMvCacheHit = false;
+  for ( Int i = 0; i < em_iNumMvCache; i++ )
+  {
+    TComMv cMv = em_acMvCacheCand[i];
+    pcCU->ETRI_clipMv(cMv);
+    cMv >>= 2;
+    cMv.set( Clip3( iSrchRngHorLeft, iSrchRngHorRight, cMv.getHor() ), Clip3( iSrchRngVerTop, iSrchRngVerBottom, cMv.getVer() ) );
+    xTZSearchHelp( pcPatternKey, cStruct, cMv.getHor(), cMv.getVer(), 0, 0 );
+    if ( cStruct.iBestX == cMv.getHor() && cStruct.iBestY == cMv.getVer() )
+    {
+      UInt uiSad = cStruct.uiBestSad - m_pcRdCost->getCost( cStruct.iBestX, cStruct.iBestY );
+      bMvCacheHit = uiSad <= (UInt)( ( ( ETRI_MV_CACHE_SAD * pcPatternKey->getROIYWidth() * pcPatternKey->getROIYHeight() ) << ( g_bitDepthY - 8 ) ) >> DISTORTION_PRECISION_ADJUSTMENT( g_bitDepthY - 8 ) );
+    }
+  }
+  if ( bMvCacheHit )
+  {
+    uiSearchRange = ETRI_MV_CACHE_RANGE;
+  }
+#endif
+  
   // start search
   Int  iDist = 0;
   Int  iStartX = cStruct.iBestX;
@@ -8384,6 +8712,27 @@ Void TEncSearch::xTZSearch( TComDataCU* pcCU, TComPattern* pcPatternKey, Pel* pi
     }
   }
   
+#if ETRI_PYRAMID_ME
+  // refine around the coarse-to-fine pre-search vector of the CTU when the search converged elsewhere
+#if ETRI_MV_CACHE
+  if ( em_bPyramidMv && !bMvCacheHit )
+#else
+  if ( em_bPyramidMv )
+#endif
+  {
+    iStartX = Clip3( iSrchRngHorLeft, iSrchRngHorRight, em_cPyramidMv.getHor() );
+    iStartY = Clip3( iSrchRngVerTop, iSrchRngVerBottom, em_cPyramidMv.getVer() );
+    if ( abs( iStartX - cStruct.iBestX ) > 1 || abs( iStartY - cStruct.iBestY ) > 1 )
+    {
+      xTZSearchHelp( pcPatternKey, cStruct, iStartX, iStartY, 0, 0 );
+      for ( iDist = 1; iDist <= (ETRI_PYRAMID_REFINE << 1); iDist*=2 )
+      {
+        xTZ8PointDiamondSearch ( pcPatternKey, cStruct, pcMvSrchRngLT, pcMvSrchRngRB, iStartX, iStartY, iDist );
+      }
+    }
+  }
+#endif
+  
   // write out best match
   rcMv.set( cStruct.iBestX, cStruct.iBestY );
   ruiSAD = cStruct.uiBestSad - m_pcRdCost->getCost( cStruct.iBestX, cStruct.iBestY );
@@ -8400,9 +8749,7 @@ Void TEncSearch::xPatternSearchFracDIF(TComDataCU* pcCU,
 										Int iRefStride,
 										TComMv* pcMvInt,
 										TComMv& rcMvHalf,
-#if !ETRI_NOT_QUARTERPEL_ME
 										TComMv& rcMvQter,
-#endif 
                                        UInt&        ruiCost,
                                        Bool        biPred
 										)
@@ -8435,8 +8782,13 @@ Void TEncSearch::xPatternSearchFracDIF(TComDataCU* pcCU,
   ruiCost = xPatternRefinement( pcPatternKey, baseRefMv, 2, rcMvHalf   );
 #endif
   
-#if ETRI_NOT_QUARTERPEL_ME
-#else 
+  rcMvQter.setZero();
+  if ( !m_pcEncCfg->ETRI_getQuarterPelME() )
+  {
+    return;
+  }
+  
+  //  Quarter-pel refinement
   m_pcRdCost->setCostScale( 0 );
   
   xExtDIFUpSamplingQ(&cPatternRoi, rcMvHalf, biPred);
@@ -8458,7 +8810,6 @@ Void TEncSearch::xPatternSearchFracDIF(TComDataCU* pcCU,
 #else
   ruiCost = xPatternRefinement( pcPatternKey, baseRefMv, 1, rcMvQter );
 #endif
-#endif
   
 }
 
@@ -162,6 +162,24 @@ protected:
   TComMv          m_cSrchRngLT;
   TComMv          m_cSrchRngRB;
   TComMv          m_acMvPredictors[3];
+#if ETRI_PYRAMID_ME
+  Int             em_iPyramidPOC;                           ///< Picture and CTU of the pre-search vectors
+  Int             em_iPyramidCUAddr;
+  Int             em_aiPyramidRefPOC[2][MAX_NUM_REF];       ///< Reference POC of each pre-search vector (MAX_INT : not searched)
+  TComMv          em_acPyramidMv[2][MAX_NUM_REF];           ///< Pre-search vector in integer samples of full resolution
+  TComMv          em_acPyramidMvL2[2][MAX_NUM_REF];         ///< Pre-search vector on the 1/16 plane
+  Int             em_aiPyramidLeftRefPOC[2][MAX_NUM_REF];   ///< Reference POC and 1/16 vector of the left CTU
+  TComMv          em_acPyramidLeftMv[2][MAX_NUM_REF];
+  Bool            em_bPyramidMv;                            ///< xTZSearch also refines around em_cPyramidMv
+  TComMv          em_cPyramidMv;
+#endif
+#if ETRI_MV_CACHE
+  UInt            em_uiMvCacheStamp;                                          ///< Stamp of the current CTU
+  UInt            em_auiMvCacheStamp[2][MAX_NUM_REF][ETRI_MV_CACHE_UNITS];   ///< Stamp of the CTU which wrote each vector
+  TComMv          em_acMvCache[2][MAX_NUM_REF][ETRI_MV_CACHE_UNITS];         ///< Last vector found over each 4x4 unit (raster order in the CTU)
+  Int             em_iNumMvCache;                                             ///< xTZSearch also tests em_acMvCacheCand as start points
+  TComMv          em_acMvCacheCand[2];
+#endif
   
   // RD computation
   TEncSbac***     m_pppcRDSbacCoder;
@@ -200,6 +218,11 @@ public:
  /// This Function is very Important to prevent Memory Leak when Multiple Threads for Tile Application @ 2015 5 19 by Seok
  Void ETRI_destroy();	
 
+#if ETRI_MV_CACHE
+ /// Invalidate the motion field cache : called once per CTU before the CU analysis
+ Void ETRI_resetMvCache() { em_uiMvCacheStamp++; }
+#endif
+
  Void ETRI_IntraLumaPred 		( TComDataCU* pcCU, TComYuv* pcOrgYuv, TComYuv* pcPredYuv, UInt*& uiRdModeList);
  Void ETRI_IntraLumaPred_V2		( TComDataCU*& pcCU, TComYuv* pcOrgYuv, TComYuv*& pcPredYuv, UInt uiAbsPartIdx);
 
@@ -620,6 +643,55 @@ protected:
                                     TComMv&       rcMvSrchRngLT,
                                     TComMv&       rcMvSrchRngRB );
   
+#if ETRI_PYRAMID_ME
+  Bool ETRI_xGetPyramidMv         ( TComDataCU*   pcCU,
+                                    RefPicList    eRefPicList,
+                                    Int           iRefIdx,
+                                    TComMv&       rcMv );
+  
+  Bool ETRI_xPyramidSearch        ( TComDataCU*   pcCU,
+                                    TComPicYuv*   pcCurYuv,
+                                    TComPicYuv*   pcRefYuv,
+                                    TComMv*       pcLeftMv,
+                                    TComMv&       rcMvL2,
+                                    TComMv&       rcMv );
+  
+  UInt ETRI_xPyramidLevelSearch   ( TComPicYuv*   pcCurYuv,
+                                    TComPicYuv*   pcRefYuv,
+                                    Int           iLevel,
+                                    Int           iBlkX,
+                                    Int           iBlkY,
+                                    Int           iCenterX,
+                                    Int           iCenterY,
+                                    Int           iRange,
+                                    TComMv&       rcMv,
+                                    UInt          uiBestCost,
+                                    Bool          bDiamond = false );
+  
+  Void ETRI_xExtendSearchRange    ( TComDataCU*   pcCU,
+                                    TComMv&       rcMv,
+                                    TComMv&       rcMvSrchRngLT,
+                                    TComMv&       rcMvSrchRngRB );
+  
+#endif
+#if ETRI_MV_CACHE
+  Int  ETRI_xGetCachedMv          ( TComDataCU*   pcCU,
+                                    UInt          uiPartAddr,
+                                    Int           iWidth,
+                                    Int           iHeight,
+                                    RefPicList    eRefPicList,
+                                    Int           iRefIdx,
+                                    TComMv*       pcMv );
+  
+  Void ETRI_xSetCachedMv          ( TComDataCU*   pcCU,
+                                    UInt          uiPartAddr,
+                                    Int           iWidth,
+                                    Int           iHeight,
+                                    RefPicList    eRefPicList,
+                                    Int           iRefIdx,
+                                    TComMv&       rcMv );
+  
+#endif
   Void xPatternSearchFast         ( TComDataCU*   pcCU,
                                     TComPattern*  pcPatternKey,
                                     Pel*          piRefY,
@@ -643,9 +715,7 @@ protected:
 									Int           iRefStride,
 									TComMv*       pcMvInt,
 									TComMv&       rcMvHalf,
-#if !ETRI_NOT_QUARTERPEL_ME
 									TComMv&       rcMvQter,
-#endif 
                                     UInt&         ruiCost 
                                    ,Bool biPred
 									);
@@ -183,6 +183,9 @@ Void TEncSlice::init( TEncTop* pcEncTop, TEncFrame* pcEncFrame )
 
 	//ETRI Code :  2015 5 18 by Seok	
 	em_pcTileEncoder = pcEncFrame->ETRI_getTileEncoder();	///Get Tile Encoder @  2015 5 18 by Seok
+#if ETRI_WPP_PARALLEL
+	em_pcWPPEncoder = pcEncFrame->ETRI_getWPPEncoder();
+#endif
 	em_uiTileIdx		= 0;
 
 #if 0 //ETRI_E265_PH01
@@ -357,6 +360,9 @@ Void TEncSlice::initEncSlice( TComPic* pcPic, Int pocLast, Int pocCurr, Int iNum
 #else
 		eSliceType = (pocLast == 0 || (pocCurr - isField) % m_pcCfg->getIntraPeriod() == 0 || m_pcGOPEncoder->getGOPSize() == 0) ? I_SLICE : eSliceType;
 #endif
+#if ETRI_SCENECUT
+		eSliceType = m_pcGOPEncoder->ETRI_isSceneCutIRAP(pocCurr) ? I_SLICE : eSliceType;
+#endif
 #if EFFICIENT_FIELD_IRAP
 	}
 #endif
@@ -514,6 +520,9 @@ Void TEncSlice::initEncSlice( TComPic* pcPic, Int pocLast, Int pocCurr, Int iNum
 #else
 		eSliceType = (pocLast == 0 || (pocCurr - isField) % m_pcCfg->getIntraPeriod() == 0 || m_pcGOPEncoder->getGOPSize() == 0) ? I_SLICE : eSliceType;
 #endif
+#if ETRI_SCENECUT
+		eSliceType = m_pcGOPEncoder->ETRI_isSceneCutIRAP(pocCurr) ? I_SLICE : eSliceType;
+#endif
 #if EFFICIENT_FIELD_IRAP
 	}
 #endif // EFFICIENT_FIELD_IRAP
@@ -1570,6 +1579,12 @@ Void TEncSlice::ETRI_compressSlice( TComPic*& rpcPic, Bool bOperation)
 #if ETRI_MULTITHREAD
 	uiProcessingType = (ETRI_TILE_SERIAL_TEST)? PARALLEL_TILE_SERIAL: PARALLEL_TILE;
 #endif
+#if ETRI_WPP_PARALLEL
+	if (uiProcessingType == PARALLEL_TILE && em_pcWPPEncoder->ETRI_isActive(rpcPic, uiStartCUAddr, uiBoundingCUAddr))
+	{
+		uiProcessingType = PARALLEL_WPP;	///WaveFrontSynchro with a single slice : CTU rows are compressed as wavefront jobs
+	}
+#endif
 	
 	switch (uiProcessingType)
 	{
@@ -1609,6 +1624,35 @@ Void TEncSlice::ETRI_compressSlice( TComPic*& rpcPic, Bool bOperation)
 			tv.tv_sec = 0;
 			tv.tv_usec = 50; // 10 us
 
+#if ETRI_TILE_DYNAMIC_ASSIGN
+			/// A tile job claims the next tile when it finishes one, so that a few jobs compress many tiles 
+			/// and the large tiles do not wait behind the small ones assigned to the same thread.
+			pthread_mutex_t encMutex = PTHREAD_MUTEX_INITIALIZER;
+			pthread_cond_t  encCond = PTHREAD_COND_INITIALIZER;
+			int iEndCount = 0;
+			int iNextTile = 0;
+
+			EncTileInfo encInfo;
+			encInfo.endCount = &iEndCount;
+			encInfo.nextTile = &iNextTile;
+			encInfo.mutex = &encMutex;
+			encInfo.cond = &encCond;
+			encInfo.nTile = uiNumTile;
+			encInfo.nJob = std::min<int>(uiNumTile, MAX_THREAD_TILE);
+
+			for (i = 0; i < encInfo.nJob; i++)
+			{
+				encInfo.id = i;
+				threadpool->run(EncTileJob::createJob(this, encInfo));
+			}
+
+			pthread_mutex_lock(&encMutex);
+			while (iEndCount < encInfo.nJob)
+			{
+				pthread_cond_wait(&encCond, &encMutex);
+			}
+			pthread_mutex_unlock(&encMutex);
+#else
 			const int nJob = MAX_THREAD_TILE; //yhee 2016.09.21
 
 			EncTileJob* job[nJob];
@@ -1695,6 +1739,7 @@ Void TEncSlice::ETRI_compressSlice( TComPic*& rpcPic, Bool bOperation)
 			if(encInfo.endCount)
 				delete encInfo.endCount;
 			encInfo.endCount = NULL;
+#endif
 			
 #else
 			for (i = 0; i < uiNumTile; i++)
@@ -1854,8 +1899,43 @@ Void TEncSlice::ETRI_compressSlice( TComPic*& rpcPic, Bool bOperation)
 
 	case PARALLEL_WPP:
 		{
+#if ETRI_WPP_PARALLEL
+#if ETRI_DEBUG_CODE_CLEANUP
+			ESPRINTF((pcSlice->getPOC() == 0), stderr, "========== PARALLEL [WPP:THREAD] =========\n");
+#endif 
+			UInt uiNumJob = em_pcWPPEncoder->ETRI_getNumRowEncoder();
 
+			em_pcWPPEncoder->ETRI_initWPPCoders(rpcPic, pcSlice, m_pcRdCost, m_pcTrQuant, m_pcCavlcCoder, m_pcSbacCoder, m_pcBinCABAC
+#if KAIST_RC
+				, m_pcRateCtrl
+#endif
+				, pETRI_InfoofCU);
 
+			pthread_mutex_t encMutex = PTHREAD_MUTEX_INITIALIZER;
+			pthread_cond_t  encCond = PTHREAD_COND_INITIALIZER;
+			Int iEndCount = 0;
+
+			EncTileInfo encInfo;
+			encInfo.endCount = &iEndCount;
+			encInfo.mutex = &encMutex;
+			encInfo.cond = &encCond;
+			encInfo.nTile = uiNumJob;
+
+			for (UInt i = 0; i < uiNumJob; i++)
+			{
+				encInfo.id = i;
+				threadpool->run(EncWPPJob::createJob(em_pcWPPEncoder, encInfo));
+			}
+
+			pthread_mutex_lock(&encMutex);
+			while (iEndCount < uiNumJob)
+			{
+				pthread_cond_wait(&encCond, &encMutex);
+			}
+			pthread_mutex_unlock(&encMutex);
+
+			em_pcWPPEncoder->ETRI_getRDOResult(m_uiPicTotalBits, m_uiPicDist, m_dPicRdCost);
+#endif
 		}
 		break;
 
@@ -2913,6 +2993,26 @@ void EncTileJob::run(void *)
 {
 	EncTileInfo info = m_encInfo;
 
+#if ETRI_TILE_DYNAMIC_ASSIGN
+	while (1)
+	{
+		pthread_mutex_lock(info.mutex);
+		int iTileIdx = (*(info.nextTile))++;
+		pthread_mutex_unlock(info.mutex);
+
+		if (iTileIdx >= info.nTile)
+			break;
+
+		m_encSlice->ETRI_getTileEncoder()[iTileIdx].ETRI_CompressUnit();
+	}
+
+	pthread_mutex_lock(info.mutex);
+	if (++(*(info.endCount)) == info.nJob)
+	{
+		pthread_cond_broadcast(info.cond);
+	}
+	pthread_mutex_unlock(info.mutex);
+#else
 #if ETRI_THREAD_LOAD_BALANCING
 	if (info.nTile == 16)
 		m_encSlice->ETRI_getTileEncoder()[info.id].ETRI_CompressUnit(m_lbInfo);
@@ -2934,5 +3034,6 @@ void EncTileJob::run(void *)
 	(*(info.endCount))++;
 	pthread_mutex_unlock(info.mutex);
 #endif
+#endif
 }
 #endif
\ No newline at end of file
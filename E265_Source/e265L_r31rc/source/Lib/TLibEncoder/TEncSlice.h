@@ -68,6 +68,9 @@ class TEncGOP;
 #if ETRI_MULTITHREAD_2
 class TEncFrame;	// gplusplus
 #endif
+#if ETRI_WPP_PARALLEL
+class TEncWPP;
+#endif
 
 #if ETRI_THREADPOOL_OPT
 class EncTileJob;
@@ -138,6 +141,9 @@ private:
 	TEncFrame*			em_pcEncFrame;	// gplusplus
 	TEncTile*				em_pcTileEncoder;						///< Tile Encoder;	// quram : ysjeong 160804
 #endif
+#if ETRI_WPP_PARALLEL
+	TEncWPP*				em_pcWPPEncoder;						///< Wavefront CTU-row encoder of TEncFrame
+#endif
 
 #if !(_ETRI_WINDOWS_APPLICATION)
   //Tile pthread var. by yhee 2016.04.19
@@ -66,6 +66,9 @@ TEncTile::TEncTile()
 	em_uiTileIdx 					= 0;			///Index of Tile : 0 ~  em_uiNumTiles @ 2015 5 17 by Seok 
 	em_uiNumTiles					= 0;			///Total Number of Tiles @ 2015 5 17 by Seok
 
+#if ETRI_FRAME_ROW_THREADING
+	em_pcRowSync					= nullptr;
+#endif
 }
 
 TEncTile::~TEncTile()
@@ -497,6 +500,46 @@ Void TEncTile::ETRI_RestoreRateControl(TComDataCU*& pcCU)
 #endif
 
 
+/**
+=====================================================================================================================
+	@brief: Compression of one CTU with the current state of the RD coders (em_pppcTileRDSbacCoders[0][CI_CURR_BEST]).
+			The result is accumulated to em_pInfoCU. Used by the Tile and the WPP row compression.
+=====================================================================================================================
+*/
+Void TEncTile::ETRI_CompressCU(UInt uiCUAddr)
+{
+	///Indicate the Cu Address to all Functions : 2015 5 20 by Seok
+	*em_pInfoCU->uiCUAddr = uiCUAddr;				
+
+	// initialize CU encoder
+	TComDataCU*& pcCU = em_pcPic->getCU( uiCUAddr );
+	pcCU->initCU( em_pcPic, uiCUAddr );
+
+	///Initilization Entropy Coder (TEncSBAC for CU Compression,	m_pcRDGoOnSbacCoder) @ 2015 5 15 by Seok
+	ETRI_InitRDCoderForSubStream(pcCU);				
+	ETRI_InitRateControlSBACRD(pcCU);		///Initilization of Rate Control @ 2015 5 15 by Seok
+
+	// run CU encoder
+	em_pcTileCuEncoder->compressCU( pcCU );
+
+	// Restore CU encoder
+	ETRI_RestoreEntropyCoder(pcCU);	///Restore Entropy Coder to Initial Stage @ 2015 5 15 by Seok
+#if KAIST_RC
+	ETRI_RestoreRateControl(pcCU);		///Restore Rate Control State @ 2015 5 15 by Seok 
+#endif
+
+	em_pInfoCU->u64PicTotalBits 	+= pcCU->getTotalBits();
+	em_pInfoCU->u64PicDist		+= pcCU->getTotalDistortion();
+	em_pInfoCU->dPicRdCost		+= pcCU->getTotalCost();
+
+#if ETRI_FRAME_ROW_THREADING
+	if (em_pcRowSync)
+	{
+		em_pcRowSync->setCUDone(uiCUAddr);	///Deblocking and Publishing of the completed CTU rows 
+	}
+#endif
+}
+
 /**
 =====================================================================================================================
 	@brief: Main Tile Compression Function. If you want Multiprocessing, connect the MultiThread API or Thread Pool to this function. 
@@ -516,30 +559,7 @@ Void TEncTile::ETRI_CompressUnit()
 
 	for(uiEncCUOrder = ETRI_StartCUOrder; uiEncCUOrder < ETRI_FinalCUOrder; uiCUAddr = em_pcPic->getPicSym()->getCUOrderMap(++uiEncCUOrder) )
 	{
-		///Indicate the Cu Address to all Functions : 2015 5 20 by Seok
-		*em_pInfoCU->uiCUAddr = uiCUAddr;				
-
-		// initialize CU encoder
-		TComDataCU*& pcCU = em_pcPic->getCU( uiCUAddr );
-		pcCU->initCU( em_pcPic, uiCUAddr );
-
-		///Initilization Entropy Coder (TEncSBAC for CU Compression,	m_pcRDGoOnSbacCoder) @ 2015 5 15 by Seok
-		ETRI_InitRDCoderForSubStream(pcCU);				
-		ETRI_InitRateControlSBACRD(pcCU);		///Initilization of Rate Control @ 2015 5 15 by Seok
-
-		// run CU encoder
-		em_pcTileCuEncoder->compressCU( pcCU );
-
-		// Restore CU encoder
-		ETRI_RestoreEntropyCoder(pcCU);	///Restore Entropy Coder to Initial Stage @ 2015 5 15 by Seok
-#if KAIST_RC
-		ETRI_RestoreRateControl(pcCU);		///Restore Rate Control State @ 2015 5 15 by Seok 
-#endif
-
-		em_pInfoCU->u64PicTotalBits 	+= pcCU->getTotalBits();
-		em_pInfoCU->u64PicDist		+= pcCU->getTotalDistortion();
-		em_pInfoCU->dPicRdCost		+= pcCU->getTotalCost();
-
+		ETRI_CompressCU(uiCUAddr);
 	}
 #if !ETRI_MULTITHREAD_2
 	em_pcTileCuEncoder->ETRI_Final_onPictureSliceTile(em_pcSlice, em_uiTileIdx);
@@ -665,3 +685,114 @@ Void TEncTile::ETRI_CompressUnit(TileLoadBalanceInfo lbInfo)
 //! \}
 
 
+
+#if ETRI_FRAME_ROW_THREADING
+// ====================================================================================================================
+// CTU row synchronization for frame parallel encoding
+// ====================================================================================================================
+EncCTURowSync::EncCTURowSync()
+{
+	em_pcPic			= nullptr;
+	em_pcLoopFilter		= nullptr;
+	em_uiWidthInCU		= 0;
+	em_uiHeightInCU		= 0;
+	em_uiNumRowDone		= 0;
+	em_uiNumRowFiltered	= 0;
+	em_bFiltering		= false;
+	pthread_mutex_init(&em_mutex, NULL);
+}
+
+EncCTURowSync::~EncCTURowSync()
+{
+	pthread_mutex_destroy(&em_mutex);
+}
+
+Void EncCTURowSync::init(TComPic* pcPic, TComLoopFilter* pcLoopFilter)
+{
+	em_pcPic			= pcPic;
+	em_pcLoopFilter		= pcLoopFilter;
+	em_uiWidthInCU		= pcPic->getFrameWidthInCU();
+	em_uiHeightInCU		= pcPic->getFrameHeightInCU();
+	em_uiNumRowDone		= 0;
+	em_uiNumRowFiltered	= 0;
+	em_bFiltering		= false;
+	em_auiNumCUDone.assign(em_uiHeightInCU, 0);
+}
+
+Void EncCTURowSync::setCUDone(UInt uiCUAddr)
+{
+	pthread_mutex_lock(&em_mutex);
+
+	em_auiNumCUDone[uiCUAddr / em_uiWidthInCU]++;
+	while (em_uiNumRowDone < em_uiHeightInCU && em_auiNumCUDone[em_uiNumRowDone] == em_uiWidthInCU)
+	{
+		em_uiNumRowDone++;
+	}
+	xFilterRows();
+
+	pthread_mutex_unlock(&em_mutex);
+}
+
+Void EncCTURowSync::finish()
+{
+	pthread_mutex_lock(&em_mutex);
+
+	em_uiNumRowDone = em_uiHeightInCU;
+	xFilterRows();
+
+	pthread_mutex_unlock(&em_mutex);
+	assert(em_uiNumRowFiltered == em_uiHeightInCU);
+}
+
+/**
+	@brief: Deblock every row which can be filtered. Row k is filtered after row k+1 is compressed,
+			because the intra prediction of row k+1 uses the non-deblocked samples of row k.
+			Only one thread filters at a time; the others return and the filtering thread picks up their rows.
+			em_mutex is locked by the caller and released during the filtering.
+*/
+Void EncCTURowSync::xFilterRows()
+{
+	if (em_bFiltering)
+	{
+		return;
+	}
+
+	em_bFiltering = true;
+	while (em_uiNumRowFiltered < ((em_uiNumRowDone == em_uiHeightInCU) ? em_uiHeightInCU : ((em_uiNumRowDone > 0) ? em_uiNumRowDone - 1 : 0)))
+	{
+		UInt uiCURow = em_uiNumRowFiltered;
+
+		pthread_mutex_unlock(&em_mutex);
+		xFilterRow(uiCURow);
+		pthread_mutex_lock(&em_mutex);
+
+		em_uiNumRowFiltered++;
+	}
+	em_bFiltering = false;
+}
+
+/**
+	@brief: Deblock a CTU row. The row above is final after this, so its border is extended and it is published.
+			The last row publishes the whole picture including the bottom margin. 
+*/
+Void EncCTURowSync::xFilterRow(UInt uiCURow)
+{
+	TComPicYuv*	pcPicYuvRec	= em_pcPic->getPicYuvRec();
+	Int			iCUHeight	= (Int)g_uiMaxCUHeight;
+	Int			iHeight		= pcPicYuvRec->getHeight();
+
+	em_pcLoopFilter->ETRI_loopFilterCTURow(em_pcPic, uiCURow);
+
+	if (uiCURow > 0)
+	{
+		pcPicYuvRec->ETRI_extendPicBorderRows((uiCURow - 1) * iCUHeight, uiCURow * iCUHeight);
+		pcPicYuvRec->ETRI_setRowReady(uiCURow * iCUHeight);
+	}
+
+	if (uiCURow == em_uiHeightInCU - 1)
+	{
+		pcPicYuvRec->ETRI_extendPicBorderRows(uiCURow * iCUHeight, iHeight);
+		pcPicYuvRec->ETRI_setRowReady(pcPicYuvRec->ETRI_getRowReadyAllSamples());
+	}
+}
+#endif
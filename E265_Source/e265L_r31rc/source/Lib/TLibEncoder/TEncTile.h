@@ -42,6 +42,9 @@
 #include "TLibCommon/TComList.h"
 #include "TLibCommon/TComPic.h"
 #include "TLibCommon/TComPicYuv.h"
+#if ETRI_FRAME_ROW_THREADING
+#include "TLibCommon/TComLoopFilter.h"
+#endif
 #include "TEncSlice.h"
 #include "TEncCu.h"
 #include "TEncRateCtrl.h"
@@ -85,6 +88,38 @@ struct TileLoadBalanceInfo
 };
 #endif 
 
+#if ETRI_FRAME_ROW_THREADING
+/**
+	CTU row completion of a picture compressed by several tile encoders. 
+	A CTU row is deblocked as soon as it and the row below are compressed in every tile. 
+	The thread which completes a row deblocks the rows in raster order, extends their borders and publishes them
+	to the frames referencing this picture (TComPicYuv::ETRI_setRowReady). 
+*/
+class EncCTURowSync
+{
+public:
+	EncCTURowSync();
+	~EncCTURowSync();
+
+	Void	init			(TComPic* pcPic, TComLoopFilter* pcLoopFilter);
+	Void	setCUDone		(UInt uiCUAddr);			///< Called by the tile encoders after each CTU
+	Void	finish			();							///< Deblock the rows not filtered during the compression
+
+private:
+	Void	xFilterRows		();
+	Void	xFilterRow		(UInt uiCURow);
+
+	TComPic*			em_pcPic;
+	TComLoopFilter*		em_pcLoopFilter;
+	UInt				em_uiWidthInCU;
+	UInt				em_uiHeightInCU;
+	std::vector<UInt>	em_auiNumCUDone;			///< Compressed CTUs of each row
+	UInt				em_uiNumRowDone;			///< Rows compressed in every tile, from the top
+	UInt				em_uiNumRowFiltered;		///< Deblocked rows, from the top
+	Bool				em_bFiltering;				///< A thread is deblocking rows
+	pthread_mutex_t		em_mutex;
+};
+#endif
 
 class TEncTile
 {
@@ -121,6 +156,10 @@ private:
 	//Const Value
 	UInt   			em_uiNumTiles; 			///< Total Number of Tiles @ 2015 5 17 by Seok
 
+#if ETRI_FRAME_ROW_THREADING
+	EncCTURowSync*	em_pcRowSync;			///< NULL when the picture is deblocked after the compression
+#endif
+
 public:
 	TEncTile();
 	virtual ~TEncTile();
@@ -143,6 +182,9 @@ public:
 	// -------------------------------------------------------------------------------------------------------------------
 	Void 	ETRI_setTComPic 		(TComPic* pcPic)		{em_pcPic = pcPic;}
 	Void 	ETRI_setTComSlice 		(TComSlice* pcSlice)	{em_pcSlice = pcSlice;}
+#if ETRI_FRAME_ROW_THREADING
+	Void 	ETRI_setRowSync 		(EncCTURowSync* pcRowSync)	{em_pcRowSync = pcRowSync;}
+#endif
 #if KAIST_RC
 	Void 	ETRI_setTEncRateControl	(TEncRateCtrl* pcRateCtrl) {em_pcRateCtrl = pcRateCtrl;}
 #endif
@@ -178,6 +220,7 @@ public:
 	Void  	ETRI_RestoreRateControl			(TComDataCU*& pcCU);		///< Update Parameters of Rate Control after comress CU @ 2015 5 15 by Seok 					
 #endif
 
+	Void  	ETRI_CompressCU   				(UInt uiCUAddr);	///< One CTU with the current RD coders, result accumulated to em_pInfoCU
 	Void  	ETRI_CompressUnit   			();
 
 #if ETRI_THREAD_LOAD_BALANCING
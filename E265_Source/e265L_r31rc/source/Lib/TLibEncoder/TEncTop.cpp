@@ -81,6 +81,9 @@ TEncTop::TEncTop()
   m_pcRdCosts              = NULL;
 #else
   em_bReconFileOk = false;  // gplusplus_151102 memory optimizer
+#if ETRI_ZEROCOPY_IO
+  em_bZeroCopyInput = false;
+#endif
 #endif
 #if ETRI_DLL_INTERFACE
   em_bAnalyserClear		   = false;
@@ -105,6 +108,9 @@ Void TEncTop::create ()
   // create processing unit classes
 #if ETRI_MULTITHREAD_2
   m_cGOPEncoder.        create(this);
+#if ETRI_LOOKAHEAD
+  em_cLookahead.        create(this);
+#endif
 #else
   m_cGOPEncoder.        create();
   m_cSliceEncoder.      create( getSourceWidth(), getSourceHeight(), g_uiMaxCUWidth, g_uiMaxCUHeight, g_uiMaxCUDepth );
@@ -399,7 +405,13 @@ Void TEncTop::destroy ()
 	//------------------------------------------------------------------------	
 
 	// destroy processing unit classes
+#if ETRI_LOOKAHEAD
+	em_cLookahead.        destroy();	///< before the thread pool of the GOP encoder
+#endif
 	m_cGOPEncoder.        destroy();	ESPRINTF(ETRI_MODV2_DEBUG, stderr, "m_cGOPEncoder.destroy() : OK \n");
+#if ETRI_HUGE_PAGE
+	ETRI_PrintTLBCount();				///< The pool workers have exited, so their misses are in the counter
+#endif
 #if KAIST_RC
 // 	for (Int i = 0; i < m_vcRateCtrl.capacity(); i++)
 // 		m_vcRateCtrl[i].destroy();
@@ -519,6 +531,9 @@ Void TEncTop::init(Bool isFieldCoding)
 
   // initialize processing unit classes
   m_cGOPEncoder.  init( this );
+#if ETRI_LOOKAHEAD
+  em_cLookahead.  init();
+#endif
 #if !ETRI_MULTITHREAD_2
   m_cSliceEncoder.init( this );
   m_cCuEncoder.   init( this );
@@ -1583,6 +1598,10 @@ Void  TEncCfg::xCheckGSParameters()
 // gplusplus
 Void TEncTop::ETRI_xSetNewPicBuffer ( TComList<TComPic*>* pcListPic, int nCount )
 {
+#if ETRI_PICTURE_POOL
+	em_cPicPool.ETRI_create(nCount, m_iSourceWidth, m_iSourceHeight, g_uiMaxCUWidth, g_uiMaxCUHeight, g_uiMaxCUDepth,
+		m_conformanceWindow, m_defaultDisplayWindow, m_numReorderPics, pcListPic);
+#else
 	TComPic* rpcPic;
 
 //#if MAX_THREADPOOL_TOP
@@ -1624,10 +1643,19 @@ Void TEncTop::ETRI_xSetNewPicBuffer ( TComList<TComPic*>* pcListPic, int nCount
 		pcListPic->pushBack(rpcPic);
 	}
 //#endif
+#endif
+#if ETRI_HUGE_PAGE
+	///< every picture buffer of the encoding exists from here
+	if (ETRI_GetHugePage() != ETRI_HUGEPAGE_OFF)	{ETRI_PrintHugePageStatus();}
+	ETRI_StartTLBCount();
+#endif
 }
 
 Void TEncTop::ETRI_deletePicBuffer(TComList<TComPic*>* pcListPic)
 {
+#if ETRI_PICTURE_POOL
+	em_cPicPool.ETRI_destroy(pcListPic);
+#else
 	TComList<TComPic*>::iterator iterPic = pcListPic->begin();
 	Int iSize = Int(pcListPic->size());
 
@@ -1666,6 +1694,7 @@ Void TEncTop::ETRI_deletePicBuffer(TComList<TComPic*>* pcListPic)
 		pcPic = NULL;
 	}
 //#endif
+#endif
 }
 void TEncTop::threadTopProcessing(void *param, int num)
 {
@@ -1702,13 +1731,60 @@ void TEncTop::threadTopProcessing(void *param, int num)
 Void *TEncTop::copyToPicProc(void* Param)
 {
 	copyToPicInfo* copyInfo = (copyToPicInfo *)Param;
-	copyInfo->pcComPicYuv->qrCopyToPic(copyInfo->pcPicCurr->getPicYuvOrg(), copyInfo->nThread, copyInfo->index);
+	if (copyInfo->pcComPicYuv != copyInfo->pcPicCurr->getPicYuvOrg())
+	{
+		copyInfo->pcComPicYuv->qrCopyToPic(copyInfo->pcPicCurr->getPicYuvOrg(), copyInfo->nThread, copyInfo->index);
+	}
+#if ETRI_PYRAMID_ME
+	if (copyInfo->pcPicCurr->getPicYuvOrg()->ETRI_hasPyramid())
+	{
+		copyInfo->pcPicCurr->getPicYuvOrg()->ETRI_buildPyramid(copyInfo->pcComPicYuv->getLumaAddr(), copyInfo->pcComPicYuv->getStride(), copyInfo->nThread, copyInfo->index);
+	}
+#endif
 
 	return NULL;
 }
 
 #endif
 
+#if ETRI_COPYTOPIC_THREADPOOL
+CopyToPicJob::CopyToPicJob(TComPicYuv *pcPicYuvSrc, TComPicYuv *pcPicYuvDst, EncTileInfo info)
+{
+	m_encInfo = info;
+	m_pcPicYuvSrc = pcPicYuvSrc;
+	m_pcPicYuvDst = pcPicYuvDst;
+}
+
+void CopyToPicJob::run(void *)
+{
+	EncTileInfo info = m_encInfo;
+
+	if (m_pcPicYuvSrc != m_pcPicYuvDst)
+	{
+		m_pcPicYuvSrc->qrCopyToPic(m_pcPicYuvDst, info.nTile, info.id);
+	}
+#if ETRI_PYRAMID_ME
+	if (m_pcPicYuvDst->ETRI_hasPyramid())
+	{
+		m_pcPicYuvDst->ETRI_buildPyramid(m_pcPicYuvSrc->getLumaAddr(), m_pcPicYuvSrc->getStride(), info.nTile, info.id);
+	}
+#endif
+
+	pthread_mutex_lock(info.mutex);
+	if (++(*(info.endCount)) == info.nTile)
+	{
+		pthread_cond_broadcast(info.cond);
+	}
+	pthread_mutex_unlock(info.mutex);
+}
+
+CopyToPicJob* CopyToPicJob::createJob(TComPicYuv *pcPicYuvSrc, TComPicYuv *pcPicYuvDst, EncTileInfo info)
+{
+	CopyToPicJob *job = new CopyToPicJob(pcPicYuvSrc, pcPicYuvDst, info);
+	return job;
+}
+#endif
+
 #if (ETRI_PARALLEL_SEL == ETRI_GOP_PARALLEL)
 Void TEncTop::ETRI_encode(Bool flush, TComPicYuv* pcPicYuvOrg, TComList<TComPicYuv*>& rcListPicYuvRecOut, TComList<TComPic*>& rcListPic, AccessUnit_t* accessUnitsOut, Int& iNumEncoded )
 #else
@@ -1732,8 +1808,47 @@ Void TEncTop::ETRI_encode(Bool flush, TComPicYuv* pcPicYuvOrg, TComList<TComPicY
 #else
 		xGetNewPicBuffer(pcPicCurr);
 #endif
+#if ETRI_PYRAMID_ME
+		if (ETRI_getPyramidME())
+		{
+			pcPicCurr->getPicYuvOrg()->ETRI_createPyramid();
+		}
+#endif
+#if ETRI_ZEROCOPY_IO
+		if (em_bZeroCopyInput)
+		{
+			///< the caller reads the next input into the former planes of the picture, the copy below only builds the pyramid
+			pcPicYuvOrg->ETRI_swapPlanes(pcPicCurr->getPicYuvOrg());
+			pcPicYuvOrg = pcPicCurr->getPicYuvOrg();
+		}
+#endif
 
-#if ETRI_COPYTOPIC_MULTITHREAD
+#if ETRI_COPYTOPIC_THREADPOOL
+		const int nJob = 8;
+
+		pthread_mutex_t copyMutex = PTHREAD_MUTEX_INITIALIZER;
+		pthread_cond_t  copyCond = PTHREAD_COND_INITIALIZER;
+		int iEndCount = 0;
+
+		EncTileInfo copyInfo;
+		copyInfo.endCount = &iEndCount;
+		copyInfo.mutex = &copyMutex;
+		copyInfo.cond = &copyCond;
+		copyInfo.nTile = nJob;
+
+		for (int i = 0; i < nJob; i++)
+		{
+			copyInfo.id = i;
+			m_cGOPEncoder.m_qrThreadpool->run(CopyToPicJob::createJob(pcPicYuvOrg, pcPicCurr->getPicYuvOrg(), copyInfo));
+		}
+
+		pthread_mutex_lock(&copyMutex);
+		while (iEndCount < nJob)
+		{
+			pthread_cond_wait(&copyCond, &copyMutex);
+		}
+		pthread_mutex_unlock(&copyMutex);
+#elif ETRI_COPYTOPIC_MULTITHREAD
 		const int nThread = 4;
 		copyToPicInfo copyInfo[nThread];
 		pthread_t tempThread[nThread];
@@ -1753,7 +1868,16 @@ Void TEncTop::ETRI_encode(Bool flush, TComPicYuv* pcPicYuvOrg, TComList<TComPicY
 			pthread_join(tempThread[i], NULL);
 		}
 #else
-		pcPicYuvOrg->copyToPic(pcPicCurr->getPicYuvOrg());
+		if (pcPicYuvOrg != pcPicCurr->getPicYuvOrg())
+		{
+			pcPicYuvOrg->copyToPic(pcPicCurr->getPicYuvOrg());
+		}
+#if ETRI_PYRAMID_ME
+		if (pcPicCurr->getPicYuvOrg()->ETRI_hasPyramid())
+		{
+			pcPicCurr->getPicYuvOrg()->ETRI_buildPyramid(pcPicYuvOrg->getLumaAddr(), pcPicYuvOrg->getStride(), 1, 0);
+		}
+#endif
 #endif
 
 		// compute image characteristics
@@ -1761,6 +1885,12 @@ Void TEncTop::ETRI_encode(Bool flush, TComPicYuv* pcPicYuvOrg, TComList<TComPicY
 		{
 			m_cPreanalyzer.xPreanalyze(dynamic_cast<TEncPic*>(pcPicCurr));
 		}
+#if ETRI_LOOKAHEAD
+		if (em_cLookahead.ETRI_isActive())
+		{
+			em_cLookahead.ETRI_submit(pcPicCurr, m_cGOPEncoder.m_qrThreadpool);
+		}
+#endif
 	}
 
 #if (ETRI_PARALLEL_SEL == ETRI_GOP_PARALLEL)
@@ -1781,6 +1911,26 @@ Void TEncTop::ETRI_encode(Bool flush, TComPicYuv* pcPicYuvOrg, TComList<TComPicY
 #endif
 
 
+#if ETRI_LOOKAHEAD
+	if (em_cLookahead.ETRI_isActive())
+	{
+		em_cLookahead.ETRI_waitAll();
+		for (std::list<TEncRateCtrl>::iterator iterRC = m_lcRateCtrl.begin(); iterRC != m_lcRateCtrl.end(); iterRC++)
+		{
+			iterRC->ETRI_setLookaheadCost(&em_cLookahead);
+		}
+#if ETRI_SCENECUT
+		m_cGOPEncoder.ETRI_setSceneCutIRAP(&em_cLookahead, m_iPOCLast, m_iNumPicRcvd);
+#endif
+	}
+#endif
+
+#if ETRI_PICTURE_POOL
+	if (em_bReconFileOk)
+	{
+		em_cPicPool.ETRI_setRecList(&rcListPicYuvRecOut);
+	}
+#endif
 #if (ETRI_PARALLEL_SEL == ETRI_GOP_PARALLEL)
 	m_cGOPEncoder.ETRI_compressGOP(m_iPOCLast, m_iNumPicRcvd, rcListPic, rcListPicYuvRecOut, accessUnitsOut, false, false);
 #else
@@ -1832,6 +1982,9 @@ Void TEncTop::ETRI_encode(Bool flush, TComPicYuv* pcPicYuvOrg, TComList<TComPicY
 
 Void TEncTop::ETRI_xPocReArrayPicBuffer(TComList<TComPic*>* pcListPic, int nOffset)
 {
+#if ETRI_PICTURE_POOL
+	em_cPicPool.ETRI_recycle(nOffset, pcListPic);
+#else
 	TComPic* pcPic = NULL;
 	TComPic* pcPicCopy = NULL;
 	TComList<TComPic*>::iterator iterPicExtract;
@@ -1866,12 +2019,20 @@ Void TEncTop::ETRI_xPocReArrayPicBuffer(TComList<TComPic*>* pcListPic, int nOffs
 
 		pcPic->getSlice(0)->setPOC(nOffset + i);
 	}
+#endif
 }
 
 Void TEncTop::ETRI_xGetNewPicBuffer(TComPic*& rpcPic, TComList<TComPic*>* pcListPic)
 {
 	m_iPOCLast++;
 
+#if ETRI_PICTURE_POOL
+	rpcPic = em_cPicPool.ETRI_getPic(m_iPOCLast);
+	if (!rpcPic)
+	{
+		rpcPic = pcListPic->back();		///< as the former scan of the list
+	}
+#else
 	TComList<TComPic*>::iterator iterPic = pcListPic->begin();
 	while (iterPic != pcListPic->end())
 	{
@@ -1880,6 +2041,7 @@ Void TEncTop::ETRI_xGetNewPicBuffer(TComPic*& rpcPic, TComList<TComPic*>* pcList
 			break;
 		iterPic++;
 	}
+#endif
 
 	rpcPic->setReconMark(false);
 
@@ -59,6 +59,12 @@
 
 #include "TEncTile.h"
 #include "TEncFrame.h"
+#if ETRI_LOOKAHEAD
+#include "TEncLookahead.h"
+#endif
+#if ETRI_PICTURE_POOL
+#include "TEncPicPool.h"
+#endif
 
 #if KAIST_RC
 #include <list>
@@ -150,6 +156,9 @@ private:
 
   // quality control
   TEncPreanalyzer  			m_cPreanalyzer;                 ///< image characteristics analyzer for TM5-step3-like adaptive QP
+#if ETRI_LOOKAHEAD
+  TEncLookahead				em_cLookahead;					///< lowres costs of the received pictures
+#endif
 
   TComScalingList  			m_scalingList;                 ///< quantization matrix information
 
@@ -229,6 +238,9 @@ public:
   TEncSampleAdaptiveOffset* getSAO              () { return  &m_cEncSAO;              }
 #endif
   TEncGOP*                getGOPEncoder         () { return  &m_cGOPEncoder;          }
+#if ETRI_LOOKAHEAD
+  TEncLookahead*          ETRI_getLookahead     () { return  &em_cLookahead;          }
+#endif
 #if !ETRI_MULTITHREAD_2 // gplusplus_151005 TEncFrame move
   TEncSlice*              getSliceEncoder       () { return  &m_cSliceEncoder;        }
   TEncCu*                 getCuEncoder          () { return  &m_cCuEncoder;           }
@@ -302,6 +314,12 @@ private:
 	//int   em_nThreadCnt;
 	bool  em_bCreate;
 	bool em_bReconFileOk;  
+#if ETRI_PICTURE_POOL
+	TEncPicPool	em_cPicPool;					///< owner of the pictures of the list given to ETRI_encode
+#endif
+#if ETRI_ZEROCOPY_IO
+	Bool	em_bZeroCopyInput;						///< the planes of the input picture of ETRI_encode are swapped into the picture to be encoded, not copied
+#endif
 
 public:
 	static void threadTopProcessing(void *param, int num);
@@ -329,6 +347,13 @@ public:
 	// gplusplus_151102 memory optimizer
 	void ETRI_setReconFileOk(bool bSet) { em_bReconFileOk = bSet; }
 	bool ETRI_getReconFileOk() { return em_bReconFileOk; }
+#if ETRI_PICTURE_POOL
+	TEncPicPool* ETRI_getPicPool() { return &em_cPicPool; }
+#endif
+#if ETRI_ZEROCOPY_IO
+	void ETRI_setZeroCopyInput(Bool bSet) { em_bZeroCopyInput = bSet; }
+	Bool ETRI_getZeroCopyInput() { return em_bZeroCopyInput; }
+#endif
 
 #endif
 
@@ -30,8 +30,8 @@
 *********************************************************************************************
 */
 /** 
-	\file   	TEncTile.h
-   	\brief    	Tile encoder class (header)
+	\file   	TEncWPP.cpp
+   	\brief    	WPP encoder class
 */
 
 #include "TEncTop.h"
@@ -46,142 +46,266 @@
 
 TEncWPP::TEncWPP()
 {
+	em_pcCfg	= nullptr;
 	em_pcPic   	= nullptr;
-	em_pcSlice 	= nullptr;
-	
-	em_pcEncTop   			= nullptr;
-	em_pcEncSlice   			= nullptr;
-
-	em_pcWPPCuEncoder   		= nullptr;
-	em_pcWPPPredSearch 		= nullptr;
-	em_pcWPPTrQuant			= nullptr;
-	em_pcWPPRdCost 			= nullptr;
-#if KAIST_RC
-	em_pcWPPRateCtrl			= nullptr;	
-#endif
-	em_pcSbacCoders 			= nullptr;
-	em_pcBinCoderCABACs 		= nullptr;
-
-	em_pcWPPEntropyCoder  	= nullptr;
-	em_pcBitCounters 			= nullptr;   	/// @brief		code bit counters for RD optimization per substream endcode
-	em_pppcRDSbacCoders   	= nullptr;		/// @brief		temporal storage for RD computation per substream
-	em_pcRDGoOnSbacCoders	= nullptr; 	/// @brief		going on SBAC model for RD stage per substream
-	em_pppcBinCodersCABAC 	= nullptr;		/// @brief		temporal CABAC state storage for RD computation per substream
-	em_pcRDGoOnBinCodersCABAC = nullptr;	/// @brief		going on bin coder CABAC for RD stage per substream
 
-	em_iNumSubstreams 		= 0;			/// @brief		Number of top-level elements allocated.
+	em_pcRowEncoder 		= nullptr;
+	em_uiNumRowEncoder		= 0;
+	em_pcRowSbacCoders		= nullptr;
+	em_uiWidthInCU			= 0;
+	em_uiHeightInCU			= 0;
 
+	pthread_mutex_init(&em_mutex, NULL);
+	pthread_cond_init(&em_cond, NULL);
 }
 
 TEncWPP::~TEncWPP()
 {
-
+	pthread_cond_destroy(&em_cond);
+	pthread_mutex_destroy(&em_mutex);
 }
 
-// -------------------------------------------------------------------------------------------------------------------
-// Creation and Initilization 
-// -------------------------------------------------------------------------------------------------------------------
-#if FAST_BIT_EST
-#define	WPPBINCABAC	TEncBinCABACCounter
-#else
-#define	WPPBINCABAC	TEncBinCABAC
-#endif
-
 /**
  -------------------------------------------------------------------------------------------------------------------
- 	@brief	Create WPP Class with the including coders themselves, instead of coders from TEncTop.
- 	@author	jinwuk seok
+ 	@brief	Number of wavefront jobs : a CTU row runs 2 CTUs behind the row above, so that at most (Width+1)/2 rows 
+ 			are compressed at the same time. Every job blocks on the row above, so all the jobs of a picture must 
+ 			get a thread of the pool at the same time.
  -------------------------------------------------------------------------------------------------------------------
 */
-Void	TEncWPP::create	()
+UInt	TEncWPP::ETRI_getNumRowEncoder	(TEncCfg* pcCfg)
 {
-	/**  m_iWaveFrontSubstreams = m_iWaveFrontSynchro ? (m_iSourceHeight+m_uiMaxCUHeight-1) / m_uiMaxCUHeight : 1; */
-	em_iNumSubstreams = em_pcEncTop->getWaveFrontSubstreams();		
+	if (!pcCfg->getWaveFrontsynchro())	{return 0;}
 
-	em_pcWPPCuEncoder   		= new TEncCu;
-	em_pcWPPPredSearch 		= new TEncSearch;
-	em_pcWPPTrQuant			= new TComTrQuant;
-	em_pcWPPRdCost 			= new TComRdCost;
-#if KAIST_RC
-	em_pcWPPRateCtrl			= new TEncRateCtrl;	
-#endif
-	em_pcWPPEntropyCoder  	= new TEncEntropy;
-	em_pcSbacCoders 			= new TEncSbac;
-	em_pcRDGoOnSbacCoders    	= new TEncSbac;
-	em_pcBinCoderCABACs 		= new WPPBINCABAC;
-	em_pcRDGoOnBinCodersCABAC 	= new WPPBINCABAC;
-	em_pcBitCounters 			= new TComBitCounter ;
+	UInt	uiWidthInCU 	= (pcCfg->getSourceWidth()  + g_uiMaxCUWidth  - 1) / g_uiMaxCUWidth;
+	UInt	uiHeightInCU	= (pcCfg->getSourceHeight() + g_uiMaxCUHeight - 1) / g_uiMaxCUHeight;
 
-	em_pcRDGoOnSbacCoders = new TEncSbac;						
-	em_pcSbacCoders = new TEncSbac;
+	UInt	uiNumRowEncoder = std::min<UInt>(uiHeightInCU, (uiWidthInCU + 1) >> 1);
+	uiNumRowEncoder = std::min<UInt>(uiNumRowEncoder, MAX_THREAD_WPP);
+	uiNumRowEncoder = std::min<UInt>(uiNumRowEncoder, ETRI_THREADPOOL_OPT_MAX_THREAD - 1);
 
-	em_pppcRDSbacCoders  = new TEncSbac** [g_uiMaxCUDepth+1];
-	em_pppcBinCodersCABAC= new WPPBINCABAC** [g_uiMaxCUDepth+1];
+	return std::max<UInt>(uiNumRowEncoder, 1);
+}
 
-	for ( Int iDepth = 0; iDepth < g_uiMaxCUDepth+1; iDepth++ )
+/**
+ -------------------------------------------------------------------------------------------------------------------
+ 	@brief	Create the coders of the wavefront jobs and the context storage of the CTU rows.
+ -------------------------------------------------------------------------------------------------------------------
+*/
+Void	TEncWPP::create	(TEncTop* pcEncTop)
+{
+	em_uiNumRowEncoder = ETRI_getNumRowEncoder(pcEncTop);
+	if (em_uiNumRowEncoder == 0)	{return;}
+
+	em_uiHeightInCU = (pcEncTop->getSourceHeight() + g_uiMaxCUHeight - 1) / g_uiMaxCUHeight;
+	em_auiNumCUDone.assign(em_uiHeightInCU, 0);
+
+	em_pcRowEncoder 	= new TEncTile[em_uiNumRowEncoder];
+	em_pcRowSbacCoders	= new TEncSbac[em_uiHeightInCU];		///Only the contexts are stored. No bin coder is required
+
+	for (UInt uiIdx = 0; uiIdx < em_uiNumRowEncoder; uiIdx++)
 	{
-		em_pppcRDSbacCoders[iDepth]  = new TEncSbac*	 [CI_NUM];
-		em_pppcBinCodersCABAC[iDepth]= new WPPBINCABAC* [CI_NUM];
+		em_pcRowEncoder[uiIdx].ETRI_getTotalNumbetOfTile() = em_uiNumRowEncoder;
+		em_pcRowEncoder[uiIdx].create();
+	}
+}
 
-		for (Int iCIIdx = 0; iCIIdx < CI_NUM; iCIIdx ++ )
+Void	TEncWPP::destroy ()
+{
+	if (em_pcRowEncoder)
+	{
+		for (UInt uiIdx = 0; uiIdx < em_uiNumRowEncoder; uiIdx++)
 		{
-			em_pppcRDSbacCoders  [iDepth][iCIIdx] = new TEncSbac;
-			em_pppcBinCodersCABAC[iDepth][iCIIdx] = new WPPBINCABAC;
-			em_pppcRDSbacCoders  [iDepth][iCIIdx]->init( em_pppcBinCodersCABAC[iDepth][iCIIdx] );
+			em_pcRowEncoder[uiIdx].destroy(ETRI_MODIFICATION_V00);
 		}
+		delete [] em_pcRowEncoder;	em_pcRowEncoder = nullptr;
 	}
+	if (em_pcRowSbacCoders)	{delete [] em_pcRowSbacCoders; em_pcRowSbacCoders = nullptr;}
 
+	em_uiNumRowEncoder = 0;
+}
 
+Void	TEncWPP::init  (TEncTop* pcEncTop)
+{
+	em_pcCfg = pcEncTop;
 
+	for (UInt uiIdx = 0; uiIdx < em_uiNumRowEncoder; uiIdx++)
+	{
+		em_pcRowEncoder[uiIdx].init(pcEncTop, uiIdx, ETRI_MODIFICATION_V00);
+	}
 }
 
-Void	TEncWPP::destroy (Bool bOperation)
+/**
+ -------------------------------------------------------------------------------------------------------------------
+ 	@brief	Initialization of the coders of the wavefront jobs from the slice coders, as ETRI_initTileCoders does for tiles.
+ -------------------------------------------------------------------------------------------------------------------
+*/
+#if KAIST_RC
+Void	TEncWPP::ETRI_initWPPCoders (TComPic* pcPic, TComSlice* pcSlice, TComRdCost* pcRdCost, TComTrQuant* pcTrQuant, TEncCavlc*& pcCavlcCoder, TEncSbac*& pcSbacCoder, TEncBinCABAC*& pcBinCABAC, TEncRateCtrl*& pcRateCtrl, ETRI_InfoofCU& pETRI_InfoofCU)
+#else
+Void	TEncWPP::ETRI_initWPPCoders (TComPic* pcPic, TComSlice* pcSlice, TComRdCost* pcRdCost, TComTrQuant* pcTrQuant, TEncCavlc*& pcCavlcCoder, TEncSbac*& pcSbacCoder, TEncBinCABAC*& pcBinCABAC, ETRI_InfoofCU& pETRI_InfoofCU)
+#endif
 {
+	em_pcPic		= pcPic;
+	em_uiWidthInCU	= pcPic->getPicSym()->getFrameWidthInCU();
+	if (pcPic->getPicSym()->getFrameHeightInCU() != em_uiHeightInCU)
+	{
+		///The CTU size of the picture differs from g_uiMaxCUHeight at create()
+		delete [] em_pcRowSbacCoders;
+		em_uiHeightInCU 	= pcPic->getPicSym()->getFrameHeightInCU();
+		em_pcRowSbacCoders	= new TEncSbac[em_uiHeightInCU];
+		em_auiNumCUDone.assign(em_uiHeightInCU, 0);
+	}
 
-	if (em_pcWPPCuEncoder)	{delete em_pcWPPCuEncoder; em_pcWPPCuEncoder = nullptr;}
-	if (em_pcWPPPredSearch	)	{delete em_pcWPPPredSearch; em_pcWPPPredSearch = nullptr;}
-	if (em_pcWPPTrQuant) 		{delete em_pcWPPPredSearch; em_pcWPPPredSearch = nullptr;}
-	if (em_pcWPPRdCost)		{delete em_pcWPPRdCost; em_pcWPPRdCost = nullptr;}
+	for (UInt uiIdx = 0; uiIdx < em_uiNumRowEncoder; uiIdx++)
+	{
+		em_pcRowEncoder[uiIdx].ETRI_initTileCoders(pcPic, pcSlice, pcRdCost, pcTrQuant, pcCavlcCoder, pcSbacCoder, pcBinCABAC
 #if KAIST_RC
-	if (em_pcWPPRateCtrl)		{delete em_pcWPPRateCtrl; em_pcWPPRateCtrl = nullptr;}
+			, pcRateCtrl
 #endif
-	if (em_pcWPPEntropyCoder)	{delete em_pcWPPEntropyCoder; em_pcWPPEntropyCoder = nullptr;}
-	if (em_pcSbacCoders) 		{delete em_pcSbacCoders; em_pcSbacCoders = nullptr;}
-	if (em_pcBinCoderCABACs)	{delete em_pcBinCoderCABACs; em_pcBinCoderCABACs = nullptr;}
-	if (em_pcRDGoOnSbacCoders){delete em_pcRDGoOnSbacCoders; em_pcRDGoOnSbacCoders = nullptr;}
-	if (em_pcRDGoOnBinCodersCABAC) {delete em_pcRDGoOnBinCodersCABAC; em_pcRDGoOnBinCodersCABAC = nullptr;}
-	if (em_pcBitCounters)		{delete em_pcBitCounters; em_pcBitCounters = nullptr;}
+			);
+		em_pcRowEncoder[uiIdx].ETRI_setInfoofCUCopy(&pETRI_InfoofCU);
+
+		ETRI_InfoofCU*	pInfoCU = em_pcRowEncoder[uiIdx].ETRI_getInfoofCU();
+		pInfoCU->u64PicTotalBits	= 0;
+		pInfoCU->u64PicDist			= 0;
+		pInfoCU->dPicRdCost			= 0.0;
+	}
+
+	std::fill(em_auiNumCUDone.begin(), em_auiNumCUDone.end(), 0);
+}
+
+/**
+ -------------------------------------------------------------------------------------------------------------------
+ 	@brief	The wavefront compression is used when the picture is a single slice without tiles. 
+ 			Otherwise the slice is compressed by the tile encoders, as before.
+ -------------------------------------------------------------------------------------------------------------------
+*/
+Bool	TEncWPP::ETRI_isActive (TComPic* pcPic, UInt uiStartCUAddr, UInt uiBoundingCUAddr)
+{
+	return (em_uiNumRowEncoder > 0)
+		&& (pcPic->getPicSym()->getNumTiles() == 1)
+		&& (uiStartCUAddr == 0)
+		&& (uiBoundingCUAddr == pcPic->getNumCUsInFrame() * pcPic->getNumPartInCU());
+}
 
-	if (em_pcRDGoOnSbacCoders)	{delete em_pcRDGoOnSbacCoders; em_pcRDGoOnSbacCoders = nullptr;}
-	if (em_pcSbacCoders)			{delete em_pcSbacCoders; em_pcSbacCoders = nullptr;}
+#if ETRI_FRAME_ROW_THREADING
+Void	TEncWPP::ETRI_setRowSync (EncCTURowSync* pcRowSync)
+{
+	for (UInt uiIdx = 0; uiIdx < em_uiNumRowEncoder; uiIdx++)
+	{
+		em_pcRowEncoder[uiIdx].ETRI_setRowSync(pcRowSync);
+	}
+}
+#endif
 
-	for ( Int iDepth = 0; iDepth < g_uiMaxCUDepth+1; iDepth++ )
+Void	TEncWPP::ETRI_getRDOResult (UInt64& ruiPicTotalBits, UInt64& ruiPicDist, Double& rdPicRdCost)
+{
+	for (UInt uiIdx = 0; uiIdx < em_uiNumRowEncoder; uiIdx++)
 	{
-		for (Int iCIIdx = 0; iCIIdx < CI_NUM; iCIIdx ++ )
-		{
-			if (em_pppcRDSbacCoders  [iDepth][iCIIdx]) {delete [] em_pppcRDSbacCoders  [iDepth][iCIIdx]; em_pppcRDSbacCoders  [iDepth][iCIIdx] = nullptr;}
-			if (em_pppcBinCodersCABAC[iDepth][iCIIdx]){delete [] em_pppcBinCodersCABAC[iDepth][iCIIdx]; em_pppcBinCodersCABAC[iDepth][iCIIdx] = nullptr;}
-		}
-		if (em_pppcRDSbacCoders[iDepth])   {delete [] em_pppcRDSbacCoders [iDepth]; em_pppcRDSbacCoders [iDepth] = nullptr;}
-		if (em_pppcBinCodersCABAC[iDepth]){delete [] em_pppcBinCodersCABAC[iDepth]; em_pppcBinCodersCABAC[iDepth] = nullptr;}
+		ETRI_InfoofCU*	pInfoCU = em_pcRowEncoder[uiIdx].ETRI_getInfoofCU();
+		ruiPicTotalBits	+= pInfoCU->u64PicTotalBits;
+		ruiPicDist		+= pInfoCU->u64PicDist;
+		rdPicRdCost		+= pInfoCU->dPicRdCost;
 	}
+}
 
-	if (em_pppcRDSbacCoders)	{delete em_pppcRDSbacCoders; em_pppcRDSbacCoders = nullptr;}
-	if (em_pppcBinCodersCABAC)	{delete em_pppcBinCodersCABAC; em_pppcBinCodersCABAC = nullptr;}
+// ====================================================================================================================
+// Compression functions
+// ====================================================================================================================
+Void	TEncWPP::xWaitCUDone (UInt uiCURow, UInt uiNumCU)
+{
+	pthread_mutex_lock(&em_mutex);
+	while (em_auiNumCUDone[uiCURow] < uiNumCU)
+	{
+		pthread_cond_wait(&em_cond, &em_mutex);
+	}
+	pthread_mutex_unlock(&em_mutex);
+}
 
+Void	TEncWPP::xSetCUDone (UInt uiCURow, UInt uiNumCU)
+{
+	pthread_mutex_lock(&em_mutex);
+	em_auiNumCUDone[uiCURow] = uiNumCU;
+	pthread_cond_broadcast(&em_cond);
+	pthread_mutex_unlock(&em_mutex);
 }
 
-Void	TEncWPP::init  (TEncTop* pcEncTop, UInt uiTileIdx, Bool bOperation)
+/**
+=====================================================================================================================
+	@brief: Compression of the CTU rows uiJobIdx, uiJobIdx + N, ... of the picture with the coders of the job uiJobIdx. 
+			The CTU (x, y) starts after the CTU (x+1, y-1) is compressed. 
+			The row starts from the contexts after the CTU (1, y-1) like the WPP substreams, or from the slice initial state.
+=====================================================================================================================
+*/
+Void	TEncWPP::ETRI_CompressUnit (UInt uiJobIdx)
 {
+	TEncTile*	pcRowEncoder	= &em_pcRowEncoder[uiJobIdx];
+	TEncSbac*	pcRDSbacCoder	= pcRowEncoder->ETRI_getTileRDSbacCoders()[0][CI_CURR_BEST];
 
-	em_pcRDGoOnSbacCoders->init( em_pcRDGoOnBinCodersCABAC);
-	em_pcSbacCoders->init( em_pcBinCoderCABACs);
-}
+	pcRowEncoder->ETRI_getTileCuEncoder()->ETRI_Init_onPictureSliceTile(em_pcPic->getSlice(0));
 
+	for (UInt uiCURow = uiJobIdx; uiCURow < em_uiHeightInCU; uiCURow += em_uiNumRowEncoder)
+	{
+		for (UInt uiCol = 0; uiCol < em_uiWidthInCU; uiCol++)
+		{
+			if (uiCURow > 0)
+			{
+				xWaitCUDone(uiCURow - 1, std::min<UInt>(uiCol + 2, em_uiWidthInCU));
+			}
+
+			if (uiCol == 0)
+			{
+				if (uiCURow > 0 && em_uiWidthInCU > 1)
+				{
+					pcRDSbacCoder->loadContexts(&em_pcRowSbacCoders[uiCURow - 1]);
+				}
+				else
+				{
+					pcRowEncoder->ETRI_initTileSbacRD();
+				}
+			}
+
+			pcRowEncoder->ETRI_CompressCU(uiCURow * em_uiWidthInCU + uiCol);
+
+			if (uiCol == 1)
+			{
+				em_pcRowSbacCoders[uiCURow].loadContexts(pcRDSbacCoder);
+			}
+
+			xSetCUDone(uiCURow, uiCol + 1);
+		}
+	}
+}
 
+#if ETRI_WPP_PARALLEL
+// ====================================================================================================================
+// Wavefront job of the thread pool
+// ====================================================================================================================
+EncWPPJob::EncWPPJob(TEncWPP *pcWPPEncoder, EncTileInfo info)
+{
+	m_encInfo = info;
+	m_encWPP = pcWPPEncoder;
+}
 
+void EncWPPJob::run(void *)
+{
+	EncTileInfo info = m_encInfo;
 
+	m_encWPP->ETRI_CompressUnit(info.id);
 
+	pthread_mutex_lock(info.mutex);
+	if (++(*(info.endCount)) == info.nTile)
+	{
+		pthread_cond_broadcast(info.cond);
+	}
+	pthread_mutex_unlock(info.mutex);
+}
 
+EncWPPJob* EncWPPJob::createJob(TEncWPP *pcWPPEncoder, EncTileInfo info)
+{
+	EncWPPJob *job = new EncWPPJob(pcWPPEncoder, info);
+	return job;
+}
+#endif
 
 //! \}
@@ -43,9 +43,13 @@
 #include "TLibCommon/TComPic.h"
 #include "TLibCommon/TComPicYuv.h"
 #include "TEncSlice.h"
+#include "TEncTile.h"
 #include "TEncCu.h"
 #include "TEncRateCtrl.h"
 
+#include <vector>
+#include <pthread.h>
+
 //! \ingroup TLibEncoder
 //! \{
 
@@ -54,48 +58,33 @@ class TEncSlice;
 
 // ====================================================================================================================
 // Class definition  
-
-// TileEncBinCABAC***	em_pppcTileBinCodersCABAC;	///< temporal CABAC state storage for RD computation per tile. used : *[Depth][CI_IDX:Model] 
-// TileEncBinCABAC*	em_pcTileRDGoOnBinCodersCABAC;	///< going on bin coder CABAC for RD stage per tile 
-
 // ====================================================================================================================
+/**
+	Wavefront (WaveFrontSynchro) compression of a picture. 
+	Each wavefront job owns the RD/compression coders of a TEncTile and compresses the CTU rows r = job, job + N, ...
+	A CTU starts when the two CTUs above and above-right are compressed, and each row starts from the CABAC contexts 
+	stored after the 2nd CTU of the row above, as the bitstream writer (encodeSlice) does for the substreams. 
+	The row to job mapping is fixed, so that the result does not depend on the thread scheduling.
+*/
 class TEncWPP
 {
 
 private:
-
+	TEncCfg*				em_pcCfg;
 	TComPic*     			em_pcPic;
-	TComSlice*  			em_pcSlice;
-	
-	TEncTop*				em_pcEncTop;
-	TEncSlice*  			em_pcEncSlice;
-
-	TEncCu* 				em_pcWPPCuEncoder;
-	TComRdCost* 			em_pcWPPRdCost;			///< RD cost computation class per substream
-	TComTrQuant*     		em_pcWPPTrQuant;			///< transform & quantization class substream
-	TEncSearch* 			em_pcWPPPredSearch;
-#if KAIST_RC
-	TEncRateCtrl*			em_pcWPPRateCtrl;					///< Rate control manager
-#endif
-
-	TEncSbac*   			em_pcSbacCoders;			/// 2015 5 26 by Seok 
-	TEncBinCABAC*  		em_pcBinCoderCABACs;		/// 2015 5 26 by Seok 
 
-	TEncEntropy*  		em_pcWPPEntropyCoder;		///< EntropyCoder IF. used.
-	TComBitCounter* 		em_pcBitCounters;   			///< bit counters for RD optimization per substream
-	TEncSbac***			em_pppcRDSbacCoders;		///< temporal storage for RD computation per substream
-	TEncSbac*   			em_pcRDGoOnSbacCoders; 		///< going on SBAC model for RD stage per substream
+	TEncTile*				em_pcRowEncoder;			///< Coders of each wavefront job : [em_uiNumRowEncoder]
+	UInt					em_uiNumRowEncoder;
+	TEncSbac*				em_pcRowSbacCoders;			///< Contexts after the 2nd CTU of each CTU row : [em_uiHeightInCU]
+	UInt					em_uiWidthInCU;
+	UInt					em_uiHeightInCU;
 
-#if FAST_BIT_EST
-	TEncBinCABACCounter***		em_pppcBinCodersCABAC;		///< temporal CABAC state storage for RD computation per substream
-	TEncBinCABACCounter*   		em_pcRDGoOnBinCodersCABAC;	///< going on bin coder CABAC for RD stage per substream
-#else
-	TEncBinCABAC***		em_pppcBinCodersCABAC;		///< temporal CABAC state storage for RD computation per substream
-	TEncBinCABAC*   		em_pcRDGoOnBinCodersCABAC;	///< going on bin coder CABAC for RD stage per substream
-#endif
-
-	Int 					em_iNumSubstreams;			///< # of top-level elements allocated.
+	std::vector<UInt>		em_auiNumCUDone;			///< Compressed CTUs of each row
+	pthread_mutex_t			em_mutex;
+	pthread_cond_t			em_cond;
 
+	Void	xWaitCUDone				(UInt uiCURow, UInt uiNumCU);
+	Void	xSetCUDone				(UInt uiCURow, UInt uiNumCU);
 
 public:
 	TEncWPP();
@@ -104,21 +93,34 @@ public:
 	// -------------------------------------------------------------------------------------------------------------------
 	// Creation and Initilization 
 	// -------------------------------------------------------------------------------------------------------------------
+	static UInt	ETRI_getNumRowEncoder	(TEncCfg* pcCfg);		///< Number of wavefront jobs of a picture. 0 : WPP is not used
 
-	Void	create					();
-	Void	destroy 				(Bool bOperation);
-	Void	init  					(TEncTop* pcEncTop, UInt uiTileIdx, Bool bOperation);
+	Void	create					(TEncTop* pcEncTop);
+	Void	destroy 				();
+	Void	init  					(TEncTop* pcEncTop);
+#if KAIST_RC
+	Void	ETRI_initWPPCoders		(TComPic* pcPic, TComSlice* pcSlice, TComRdCost* pcRdCost, TComTrQuant* pcTrQuant, 
+									TEncCavlc*& pcCavlcCoder, TEncSbac*& pcSbacCoder, TEncBinCABAC*& pcBinCABAC, TEncRateCtrl*& pcRateCtrl, ETRI_InfoofCU& pETRI_InfoofCU);
+#else
+	Void	ETRI_initWPPCoders		(TComPic* pcPic, TComSlice* pcSlice, TComRdCost* pcRdCost, TComTrQuant* pcTrQuant, 
+									TEncCavlc*& pcCavlcCoder, TEncSbac*& pcSbacCoder, TEncBinCABAC*& pcBinCABAC, ETRI_InfoofCU& pETRI_InfoofCU);
+#endif
 
 	// -------------------------------------------------------------------------------------------------------------------
 	// member access functions
 	// -------------------------------------------------------------------------------------------------------------------
-
+	UInt	ETRI_getNumRowEncoder	()		{return em_uiNumRowEncoder;}
+	Bool	ETRI_isActive			(TComPic* pcPic, UInt uiStartCUAddr, UInt uiBoundingCUAddr);	///< WPP and the slice covers the picture
+#if ETRI_FRAME_ROW_THREADING
+	Void	ETRI_setRowSync 		(EncCTURowSync* pcRowSync);
+#endif
+	Void	ETRI_getRDOResult		(UInt64& ruiPicTotalBits, UInt64& ruiPicDist, Double& rdPicRdCost);
 
 	// -------------------------------------------------------------------------------------------------------------------
 	// Compression functions
 	// -------------------------------------------------------------------------------------------------------------------
 
-	Void  	ETRI_CompressUnit   			();
+	Void  	ETRI_CompressUnit   			(UInt uiJobIdx);
 
 
 };
@@ -41,6 +41,7 @@
 #include <stdio.h>
 #include <fstream>
 #include <iostream>
+#include <vector>
 #include "TLibCommon/CommonDef.h"
 #include "TLibCommon/TComPicYuv.h"
 #include "TLibCommon/TypeDef.h"
@@ -62,6 +63,15 @@ using namespace std;
 #if (ETRI_DLL_INTERFACE)
 #define	ETRI_memcpy	memcpy
 
+#if ETRI_STREAM_OUTPUT
+/// Element of the scatter-gather list of an output stream : the buffer of open() first, then the pooled chunks
+typedef struct ETRI_BitstreamChunkInfo
+{
+	unsigned char*	pData;
+	unsigned int	uiBytes;
+} ETRI_BitstreamChunk;
+#endif
+
 /// DLL file I/O class
 class ETRI_fstream
 {
@@ -78,9 +88,50 @@ private:
 
 	bool		bEOF;
 
+#if ETRI_STREAM_OUTPUT
+	std::vector<ETRI_BitstreamChunk>	em_cChunk;		///< [0] : buffer of open(), [1..] : chunks of ETRI_STREAM_CHUNK_SIZE kept for the next open()
+	int 			em_iNumChunk;					///< Elements of em_cChunk in use, 1 while the writes fit in the buffer of open()
+	unsigned long	em_ulSpillBytes;				///< Bytes written to the chunks
+
+	/// The rest of a write that does not fit in the buffer of open() goes to the chunks, taken from the pool or allocated
+	void	ETRI_writeChunk (char* s, unsigned int n)
+	{
+		unsigned int uiFit = (ptridx < ptrfinal)? (unsigned int)min((unsigned long)n, ptrfinal - ptridx) : 0;
+		ETRI_memcpy(e_ptr+ptridx, s, uiFit); ptridx += uiFit; s += uiFit; n -= uiFit;
+
+		while (n > 0)
+		{
+			if (em_iNumChunk == 1 || em_cChunk[em_iNumChunk - 1].uiBytes == ETRI_STREAM_CHUNK_SIZE)
+			{
+				if (em_iNumChunk == (int)em_cChunk.size())
+				{
+					ETRI_BitstreamChunk cChunk = {(unsigned char *)malloc(ETRI_STREAM_CHUNK_SIZE), 0};
+					if (cChunk.pData == NULL)	{fprintf(stderr, "ETRI_fstream : chunk allocation error \n"), ETRI_EXIT(0);}
+					em_cChunk.push_back(cChunk);
+				}
+				em_cChunk[em_iNumChunk++].uiBytes = 0;
+			}
+
+			ETRI_BitstreamChunk& rcChunk = em_cChunk[em_iNumChunk - 1];
+			unsigned int uiCopy = min(n, (unsigned int)ETRI_STREAM_CHUNK_SIZE - rcChunk.uiBytes);
+			ETRI_memcpy(rcChunk.pData + rcChunk.uiBytes, s, uiCopy);
+			rcChunk.uiBytes += uiCopy; em_ulSpillBytes += uiCopy; s += uiCopy; n -= uiCopy;
+		}
+	}
+#endif
+
 public:
+#if ETRI_STREAM_OUTPUT
+	ETRI_fstream()		{bEOF = false; e_ptr= NULL; em_cChunk.resize(1); em_iNumChunk = 1; em_ulSpillBytes = 0;}
+	virtual ~ETRI_fstream()	
+	{
+		e_ptr= NULL;
+		for (size_t k = 1; k < em_cChunk.size(); k++)	{free(em_cChunk[k].pData);}
+	}
+#else
 	ETRI_fstream()		{bEOF = false; e_ptr= NULL;}
 	virtual ~ETRI_fstream()	{e_ptr= NULL;}
+#endif
 	
 	void	open(unsigned char * ptrbuf, unsigned long _size)	//Instead of File Mode
 	{
@@ -96,10 +147,27 @@ public:
 
 			ptrfinal	= _size;
 			ptrfinal64	= _size;
+#if ETRI_STREAM_OUTPUT
+			em_iNumChunk	= 1;
+			em_ulSpillBytes	= 0;
+#endif
 		}
 	}
 
+#if ETRI_STREAM_OUTPUT
+	int 	Ftell	() 	{return (int)(ptridx + em_ulSpillBytes);}
+
+	/// Scatter-gather list of the bytes written since open(), valid until the next open()
+	ETRI_BitstreamChunk*	getChunkList	(int& iNumChunk)
+	{
+		em_cChunk[0].pData		= e_ptr;
+		em_cChunk[0].uiBytes	= (unsigned int)ptridx;
+		iNumChunk = em_iNumChunk;
+		return &em_cChunk[0];
+	}
+#else
 	int 	Ftell	() 	{return ptridx;}
+#endif
 	bool	fail	()	{return false;}
 	void	clear	()	{memset(e_ptr, 0, ptrfinal);}
 	bool	eof 	()	{return bEOF;}
@@ -131,7 +199,16 @@ public:
 	;}
 
 	void	read (void* s, unsigned int n)		{ETRI_memcpy(s, e_ptr+ptridx, n); ptridx += n; pseudoFilePointer += n;}
+#if ETRI_STREAM_OUTPUT
+	void	write (char* s, unsigned int n)		
+	{
+		pseudoFilePointer += n;
+		if (em_iNumChunk > 1 || ptridx + n > ptrfinal)	{ETRI_writeChunk(s, n); return;}
+		ETRI_memcpy(e_ptr+ptridx, s, n); ptridx += n;
+	}
+#else
 	void	write (char* s, unsigned int n)		{ETRI_memcpy(e_ptr+ptridx, s, n); ptridx += n; pseudoFilePointer += n;}
+#endif
 	Void	SetEOF (bool EOFvalue)				{bEOF = EOFvalue;}	
 
 	unsigned char*	getPTR		(int off)	{return (e_ptr + ptridx + off);}
@@ -19,6 +19,7 @@ QphotoThreadPool* g_other_thread_pool = NULL;
 //#define  E(x...)  __android_log_print(ANDROID_LOG_ERROR,"Qmage",x)
 #endif
 
+#ifndef THREAD_POOL_WORK_STEALING
 /**
  * This function inits a threadpool queue.
  *
@@ -693,6 +694,470 @@ int QphotoThreadPool::threadpool_add_job(QphotoThreadPool *pool, QphotoTask* Tas
 	return 0;
 }
 
+#else	// THREAD_POOL_WORK_STEALING
+
+/**
+ * Work-stealing deque (Chase-Lev, with the C11 memory orderings of Le et al.).
+ */
+threadpool_deque::threadpool_deque()
+{
+	top.store(0, std::memory_order_relaxed);
+	bottom.store(0, std::memory_order_relaxed);
+	array.store(new ring(THREAD_POOL_DEQUE_INIT_SIZE), std::memory_order_relaxed);
+}
+
+threadpool_deque::~threadpool_deque()
+{
+	for (size_t i = 0; i < retired.size(); i++) {
+		delete retired[i];
+	}
+	delete array.load(std::memory_order_relaxed);
+}
+
+threadpool_deque::ring* threadpool_deque::ring::grow(long b, long t)
+{
+	ring *next = new ring(capacity << 1);
+
+	for (long i = t; i < b; i++) {
+		next->put(i, get(i));
+	}
+
+	return next;
+}
+
+/**
+ * Owner only: pushes a task on the bottom end, doubling the ring when it is full.
+ */
+void threadpool_deque::push(QphotoTask* task)
+{
+	long b = bottom.load(std::memory_order_relaxed);
+	long t = top.load(std::memory_order_acquire);
+	ring *a = array.load(std::memory_order_relaxed);
+
+	if (b - t > a->capacity - 1) {
+		ring *next = a->grow(b, t);
+		/* a thief may still be reading the old ring */
+		retired.push_back(a);
+		array.store(next, std::memory_order_release);
+		a = next;
+	}
+
+	a->put(b, task);
+	bottom.store(b + 1, std::memory_order_release);
+}
+
+/**
+ * Owner only: pops the most recently pushed task (LIFO).
+ *
+ * @return A task, or NULL if the deque is empty or the last task was stolen.
+ */
+QphotoTask* threadpool_deque::pop()
+{
+	long b = bottom.load(std::memory_order_relaxed) - 1;
+	ring *a = array.load(std::memory_order_relaxed);
+	bottom.store(b, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	long t = top.load(std::memory_order_relaxed);
+	QphotoTask *task = NULL;
+
+	if (t <= b) {
+		task = a->get(b);
+		if (t == b) {
+			/* Last element: race against thieves. */
+			if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+				task = NULL;
+			}
+			bottom.store(b + 1, std::memory_order_relaxed);
+		}
+	}
+	else {
+		bottom.store(b + 1, std::memory_order_relaxed);
+	}
+
+	return task;
+}
+
+/**
+ * Any thread: takes the oldest task (FIFO) from the top end.
+ *
+ * @return A task, or NULL if the deque is empty or another thread won the race.
+ */
+QphotoTask* threadpool_deque::steal()
+{
+	long t = top.load(std::memory_order_acquire);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	long b = bottom.load(std::memory_order_acquire);
+
+	if (t < b) {
+		ring *a = array.load(std::memory_order_acquire);
+		QphotoTask *task = a->get(t);
+		if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+			return NULL;
+		}
+		return task;
+	}
+
+	return NULL;
+}
+
+bool threadpool_deque::is_empty()
+{
+	long t = top.load(std::memory_order_acquire);
+	long b = bottom.load(std::memory_order_acquire);
+
+	return (b <= t);
+}
+
+/**
+ * This function queues a job. Jobs submitted from a worker of this pool go to that worker's own deque,
+ * all others go to the injection queue. A parked worker is woken if there is one.
+ *
+ * @param task The job to be queued.
+ */
+void QphotoThreadPool::threadpool_push(QphotoTask *task)
+{
+	threadpool_worker *self = (threadpool_worker*)pthread_getspecific(worker_key);
+
+	if (self != NULL && self->pool == this) {
+		self->deque.push(task);
+	}
+	else {
+		pthread_mutex_lock(&inject_mutex);
+		inject_queue.push_back(task);
+		inject_size.fetch_add(1, std::memory_order_seq_cst);
+		pthread_mutex_unlock(&inject_mutex);
+	}
+
+	threadpool_wake_one();
+}
+
+/**
+ * This function removes and returns the oldest job of the injection queue.
+ *
+ * @return A job, or NULL if the injection queue is empty.
+ */
+QphotoTask* QphotoThreadPool::threadpool_inject_pop()
+{
+	QphotoTask *task = NULL;
+
+	if (inject_size.load(std::memory_order_acquire) == 0) {
+		return NULL;
+	}
+
+	pthread_mutex_lock(&inject_mutex);
+	if (inject_head < inject_queue.size()) {
+		task = inject_queue[inject_head++];
+		if (inject_head == inject_queue.size()) {
+			inject_queue.clear();
+			inject_head = 0;
+		}
+		inject_size.fetch_sub(1, std::memory_order_seq_cst);
+	}
+	pthread_mutex_unlock(&inject_mutex);
+
+	return task;
+}
+
+/**
+ * This function looks for a job in the order: own deque, injection queue, other workers' deques.
+ *
+ * @param self The calling worker.
+ * @return A job, or NULL if none was found after THREAD_POOL_SPIN_ROUNDS steal attempts.
+ */
+QphotoTask* QphotoThreadPool::threadpool_find_task(threadpool_worker *self)
+{
+	QphotoTask *task;
+	int round;
+	unsigned int k;
+
+	if ((task = self->deque.pop()) != NULL) {
+		return task;
+	}
+
+	for (round = 0; round < THREAD_POOL_SPIN_ROUNDS && !stop_flag; round++) {
+		bool contended = false;
+		unsigned int start;
+
+		if ((task = threadpool_inject_pop()) != NULL) {
+			return task;
+		}
+
+		/* xorshift victim selection so that thieves spread over the deques */
+		self->seed ^= self->seed << 13;
+		self->seed ^= self->seed >> 17;
+		self->seed ^= self->seed << 5;
+		start = self->seed % num_of_workers;
+
+		for (k = 0; k < num_of_workers; k++) {
+			threadpool_worker *victim = &workers[(start + k) % num_of_workers];
+			if (victim == self || victim->deque.is_empty()) {
+				continue;
+			}
+			if ((task = victim->deque.steal()) != NULL) {
+				return task;
+			}
+			contended = true;
+		}
+
+		if (!contended) {
+			break;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * This function checks whether any job is queued anywhere in the pool.
+ */
+bool QphotoThreadPool::threadpool_has_task()
+{
+	int i;
+
+	if (inject_size.load(std::memory_order_seq_cst) != 0) {
+		return true;
+	}
+
+	for (i = 0; i < num_of_workers; i++) {
+		if (!workers[i].deque.is_empty()) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * This function wakes one parked worker. The condvar is only touched when somebody is parked.
+ */
+void QphotoThreadPool::threadpool_wake_one()
+{
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	if (num_of_sleepers.load(std::memory_order_seq_cst) != 0) {
+		pthread_mutex_lock(&park_mutex);
+		pthread_cond_signal(&park_cond);
+		pthread_mutex_unlock(&park_mutex);
+	}
+}
+
+/**
+ * This function parks an idle worker until a job is queued or the pool is stopped.
+ * The sleeper count is raised before the final queue check, so a concurrent push either sees it
+ * and signals, or its job is seen by the check.
+ *
+ * @param self The calling worker.
+ */
+void QphotoThreadPool::threadpool_park(threadpool_worker *self)
+{
+	pthread_mutex_lock(&park_mutex);
+	num_of_sleepers.fetch_add(1, std::memory_order_seq_cst);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	if (!stop_flag && !threadpool_has_task()) {
+		if (pthread_cond_wait(&park_cond, &park_mutex)) {
+			perror("pthread_cond_wait: ");
+		}
+	}
+
+	num_of_sleepers.fetch_sub(1, std::memory_order_seq_cst);
+	pthread_mutex_unlock(&park_mutex);
+}
+
+/**
+ * This is the routine the worker threads do during their life.
+ *
+ * @param data Contains a pointer to the threadpool_worker structure.
+ * @return NULL.
+ */
+void* QphotoThreadPool::worker_thr_routine(void *data)
+{
+	threadpool_worker *self = (threadpool_worker*)data;
+	QphotoThreadPool *pool = self->pool;
+	QphotoTask *job;
+
+	pthread_setspecific(pool->worker_key, self);
+
+	while (!pool->stop_flag) {
+		if ((job = pool->threadpool_find_task(self)) == NULL) {
+			pool->threadpool_park(self);
+			continue;
+		}
+
+		job->run(NULL);
+
+		if (job->mIsVolatile() == true) {
+			delete job;
+			job = NULL;
+		}
+	}
+
+	return NULL;
+}
+
+void* QphotoThreadPool::stop_worker_thr_routines_cb(void *ptr)
+{
+	QphotoThreadPool *pool = (QphotoThreadPool*)ptr;
+
+	pool->stop_worker_thr_routines_cb();
+	delete (pool);
+
+	return NULL;
+}
+
+void QphotoThreadPool::stop_worker_thr_routines_cb()
+{
+	int i;
+
+	stop_flag = 1;
+
+	/* Wakeup all parked worker threads. */
+	pthread_mutex_lock(&park_mutex);
+	pthread_cond_broadcast(&park_cond);
+	pthread_mutex_unlock(&park_mutex);
+
+	/* Wait until all worker threads are done. */
+	for (i = 0; i < num_of_threads; i++) {
+		if (pthread_join(thr_arr[i],NULL)) {
+			perror("pthread_join: ");
+		}
+	}
+
+	/* Free all allocated memory. */
+	free(thr_arr);
+	thr_arr = NULL;
+	delete[] workers;
+	workers = NULL;
+	num_of_threads = 0;
+
+	pthread_key_delete(worker_key);
+	pthread_mutex_destroy(&inject_mutex);
+	pthread_mutex_destroy(&park_mutex);
+	pthread_cond_destroy(&park_cond);
+}
+
+QphotoThreadPool* QphotoThreadPool::createQphotoThreadPool(int num_of_threads)
+{
+	QphotoThreadPool *pool;
+	int i;
+
+	pool = new QphotoThreadPool();
+
+	pool->stop_flag = 0;
+	pool->inject_head = 0;
+	pool->inject_size = 0;
+	pool->num_of_sleepers = 0;
+	pool->num_of_threads = 0;
+	pool->num_of_workers = (unsigned short)num_of_threads;
+
+	if (pthread_mutex_init(&(pool->inject_mutex),NULL)) {
+		perror("pthread_mutex_init: ");
+		delete (pool);
+		return NULL;
+	}
+	if (pthread_mutex_init(&(pool->park_mutex),NULL)) {
+		perror("pthread_mutex_init: ");
+		delete (pool);
+		return NULL;
+	}
+	if (pthread_cond_init(&(pool->park_cond),NULL)) {
+		perror("pthread_cond_init: ");
+		delete (pool);
+		return NULL;
+	}
+	if (pthread_key_create(&(pool->worker_key),NULL)) {
+		perror("pthread_key_create: ");
+		delete (pool);
+		return NULL;
+	}
+
+	pool->inject_queue.reserve(THREAD_POOL_DEQUE_INIT_SIZE);
+
+	/* Create the workers and their deques. */
+	pool->workers = new threadpool_worker[num_of_threads];
+	for (i = 0; i < num_of_threads; i++) {
+		pool->workers[i].pool = pool;
+		pool->workers[i].id = i;
+		pool->workers[i].seed = 2463534242u + 0x9E3779B9u * (i + 1);
+	}
+
+	/* Create the thr_arr. */
+	if ((pool->thr_arr = (pthread_t *)malloc(sizeof(pthread_t) * num_of_threads)) == NULL) {
+		perror("malloc: ");
+		delete[] pool->workers;
+		delete (pool);
+		return NULL;
+	}
+
+	/* Start the worker threads. */
+	for (pool->num_of_threads = 0; pool->num_of_threads < num_of_threads; (pool->num_of_threads)++) {
+		if (pthread_create(&(pool->thr_arr[pool->num_of_threads]),NULL,worker_thr_routine,&(pool->workers[pool->num_of_threads]))) {
+			perror("pthread_create:");
+
+			QphotoThreadPool::destroyQphotoThreadPool(pool);
+
+			return NULL;
+		}
+	}
+
+	return pool;
+}
+
+void QphotoThreadPool::destroyQphotoThreadPool(QphotoThreadPool* pool) {
+	if(pool != NULL) {
+		pool->stop_worker_thr_routines_cb();
+		delete (pool);
+		pool = NULL;
+	}
+}
+
+int QphotoThreadPool::threadpool_add_task(QphotoThreadPool *pool, void (*routine)(void*), void *data, int blocking)
+{
+	/* Plain routines were never executed by this pool (only QphotoTask jobs are), keep the call a no-op. */
+	if (pool == NULL) {
+		REPORT_ERROR("The threadpool received as argument is NULL.");
+		return -1;
+	}
+
+	return 0;
+}
+
+int QphotoThreadPool::threadpool_add_job(QphotoThreadPool *pool, QphotoTask* Task, int blocking)
+{
+	if (pool == NULL) {
+		REPORT_ERROR("The threadpool received as argument is NULL.");
+		return -1;
+	}
+
+	/* The deques grow on demand, so the pool is never overloaded and blocking is irrelevant. */
+	pool->threadpool_push(Task);
+
+	return 0;
+}
+
+void QphotoThreadPool::waitAllThreads()
+{
+	int i;
+
+	stop_flag = 1;
+
+	/* Wakeup all parked worker threads. */
+	pthread_mutex_lock(&park_mutex);
+	pthread_cond_broadcast(&park_cond);
+	pthread_mutex_unlock(&park_mutex);
+
+	/* Wait until all worker threads are done. */
+	for (i = 0; i < num_of_threads; i++) {
+		if (pthread_join(thr_arr[i], NULL)) {
+			perror("pthread_join: ");
+		}
+	}
+
+	stop_flag = 0;
+}
+
+#endif	// THREAD_POOL_WORK_STEALING
+
 void QphotoThreadPool::threadpool_free(QphotoThreadPool *pool, int blocking)
 {
 	pthread_t thr;
@@ -711,6 +1176,39 @@ void QphotoThreadPool::threadpool_free(QphotoThreadPool *pool, int blocking)
 	}
 }
 
+int QphotoThreadPool::threadpool_get_num_of_threads()
+{
+	return num_of_threads;
+}
+
+int QphotoThreadPool::threadpool_set_affinity(int worker, const int *cpus, int num_of_cpus)
+{
+#if defined(__linux__)
+	cpu_set_t cpu_set;
+	int i;
+
+	if (worker < 0 || worker >= num_of_threads || cpus == NULL || num_of_cpus <= 0) {
+		REPORT_ERROR("Invalid worker or CPU list.");
+		return -1;
+	}
+
+	CPU_ZERO(&cpu_set);
+	for (i = 0; i < num_of_cpus; i++) {
+		if (cpus[i] >= 0 && cpus[i] < CPU_SETSIZE) {
+			CPU_SET(cpus[i], &cpu_set);
+		}
+	}
+
+	if (pthread_setaffinity_np(thr_arr[worker], sizeof(cpu_set), &cpu_set)) {
+		perror("pthread_setaffinity_np: ");
+		return -1;
+	}
+	return 0;
+#else
+	return -1;
+#endif
+}
+
 #ifdef _UES_GLOBAL_SINGLE_THREAD_POOL
 namespace QphotoGlobalThreadPool {
 
@@ -763,6 +1261,7 @@ void QphotoThreadPool::run ( QphotoTask * job, void * ptr, const bool del )
 }
 #endif
 
+#ifndef THREAD_POOL_WORK_STEALING
 void QphotoThreadPool::waitAllThreads()
 {
 	int i;
@@ -808,4 +1307,5 @@ void QphotoThreadPool::waitAllThreads()
 
 	/* Free all allocated memory. */
 	//free(thr_arr);
-}
\ No newline at end of file
+}
+#endif
@@ -16,8 +16,60 @@
 #endif /* THREAD_POOL_DEBUG */
 	#define THREAD_POOL_QUEUE_SIZE 10000
 
+/* Per-worker Chase-Lev deques with a global injection queue instead of one locked queue */
+#define THREAD_POOL_WORK_STEALING
+
+#ifdef THREAD_POOL_WORK_STEALING
+#include <atomic>
+#include <vector>
+#define THREAD_POOL_DEQUE_INIT_SIZE	256		/* initial capacity of a worker deque (power of 2) */
+#define THREAD_POOL_SPIN_ROUNDS		64		/* steal attempts before a worker parks */
+#endif
+
 class QphotoTask;
 
+#ifdef THREAD_POOL_WORK_STEALING
+/**
+ * Chase-Lev work-stealing deque.
+ * Only the owner worker calls push()/pop() on the bottom end; any thread may steal() from the top.
+ * Grown buffers are retired, not freed, until the deque is destroyed, so a concurrent thief never
+ * reads released memory.
+ */
+class threadpool_deque
+{
+public:
+	threadpool_deque();
+	~threadpool_deque();
+
+	void push(QphotoTask* task);
+	QphotoTask* pop();
+	QphotoTask* steal();
+	bool is_empty();
+
+private:
+	class ring
+	{
+	public:
+		ring(long cap) : capacity(cap), mask(cap - 1), cells(new std::atomic<QphotoTask*>[cap]) {}
+		~ring() { delete[] cells; }
+		QphotoTask* get(long i) { return cells[i & mask].load(std::memory_order_relaxed); }
+		void put(long i, QphotoTask* t) { cells[i & mask].store(t, std::memory_order_relaxed); }
+		ring* grow(long bottom, long top);
+
+		long capacity;
+		long mask;
+		std::atomic<QphotoTask*>* cells;
+	};
+
+	std::atomic<long> top;
+	std::atomic<long> bottom;
+	std::atomic<ring*> array;
+	std::vector<ring*> retired;
+};
+#endif
+
+#ifndef THREAD_POOL_WORK_STEALING
+
 class threadpool_task
 {
 public:
@@ -33,9 +85,53 @@ public:
 	void *cells[THREAD_POOL_QUEUE_SIZE];
 };
 
+#endif
+
 class QphotoThreadPool
 {
 private:
+#ifdef THREAD_POOL_WORK_STEALING
+	class threadpool_worker
+	{
+	public:
+		QphotoThreadPool *pool;
+		threadpool_deque deque;
+		unsigned int id;
+		unsigned int seed;
+	};
+
+	threadpool_worker *workers;
+
+	/* Injection queue for jobs submitted from outside the pool; workers push to their own deque */
+	std::vector<QphotoTask*> inject_queue;
+	size_t inject_head;
+	std::atomic<int> inject_size;
+	pthread_mutex_t inject_mutex;
+
+	/* Idle workers park here; submitters signal only when num_of_sleepers != 0 */
+	std::atomic<int> num_of_sleepers;
+	pthread_mutex_t park_mutex;
+	pthread_cond_t park_cond;
+
+	pthread_key_t worker_key;
+
+	pthread_t *thr_arr;
+
+	unsigned short num_of_threads;
+	unsigned short num_of_workers;		/* fixed before the first worker starts; used for victim selection */
+	std::atomic<unsigned short> stop_flag;
+
+private:
+	void threadpool_push(QphotoTask *task);
+	QphotoTask* threadpool_inject_pop();
+	QphotoTask* threadpool_find_task(threadpool_worker *self);
+	bool threadpool_has_task();
+	void threadpool_wake_one();
+	void threadpool_park(threadpool_worker *self);
+	static void* worker_thr_routine(void *data);
+	static void* stop_worker_thr_routines_cb(void *ptr);
+	void stop_worker_thr_routines_cb();
+#else
 	threadpool_queue tasks_queue;
 	threadpool_queue free_tasks_queue;
 
@@ -63,6 +159,7 @@ private:
 	static void* stop_worker_thr_routines_cb(void *ptr);
 	void stop_worker_thr_routines_cb();
 	void threadpool_task_init(threadpool_task *task);
+#endif
 
 public:
 
@@ -101,6 +198,19 @@ public:
 	void threadpool_free(QphotoThreadPool *pool, int blocking);
 	static void destroyQphotoThreadPool(QphotoThreadPool* pool);
 
+/**
+ * This function binds a worker thread to a set of CPUs (Linux only).
+ *
+ * @param worker The index of the worker thread.
+ * @param cpus The CPU numbers the worker may run on.
+ * @param num_of_cpus The number of CPUs in cpus.
+ *
+ * @return 0 on success.
+ * @return -1 on failure.
+ */
+	int threadpool_set_affinity(int worker, const int *cpus, int num_of_cpus);
+	int threadpool_get_num_of_threads();
+
 #ifdef _UES_GLOBAL_SINGLE_THREAD_POOL
 #else
 void  run       ( QphotoTask * job, void * ptr = NULL, const bool del = false );
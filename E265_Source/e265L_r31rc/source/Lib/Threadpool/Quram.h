@@ -6,6 +6,34 @@
 //#include "QphotoThreadPool/QphotoThreadManager.h"
 #include "QphotoThreadManager.h"
 
+#include <set>
+#include <vector>
+
+/**
+ * Completion and reference-ready events of the frame jobs dispatched by TEncGOP::ETRI_compressGOP.
+ * Frame jobs report the POC of each reconstructed picture and release their GOP thread slot on exit,
+ * so the dispatcher sleeps until something it is waiting for actually happened.
+ */
+class EncFrameSync
+{
+public:
+	EncFrameSync();
+	~EncFrameSync();
+
+	void reset();										///< forget reported POCs; all frame jobs must be done
+	int  acquireSlot(bool *bThreadRunning, int nSlot);	///< block until one of nSlot slots is free, mark it running
+	void releaseSlot(bool *bThreadRunning, int id);		///< called by the frame job when it is done
+	void setReconReady(int poc);						///< called by the frame job when poc can be referenced
+	void waitReconReady(const std::vector<int>& waitPOC);	///< block until one of waitPOC is ready or no job is running
+	void waitAllDone();
+
+private:
+	pthread_mutex_t m_mutex;
+	pthread_cond_t  m_cond;
+	int m_nRunning;
+	std::set<int> m_readyPOC;
+};
+
 #include "../Lib/TLibEncoder/TEncSlice.h"
 #include "../Lib/TLibEncoder/TEncGOP.h"
 #include "../Lib/TLibEncoder/TEncTile.h"
@@ -18,6 +46,10 @@ struct EncTileInfo
 	int id;
 	int nTile;
 	int *endCount;
+#if ETRI_TILE_DYNAMIC_ASSIGN
+	int nJob;			///< tile jobs of the picture, endCount counts the finished jobs
+	int *nextTile;		///< next tile to be claimed by a job, guarded by mutex
+#endif
 	pthread_mutex_t *mutex;
 	pthread_cond_t  *cond;
 };
@@ -52,25 +84,132 @@ private:
 #endif
 };
 
+#if ETRI_WPP_PARALLEL
+class TEncWPP;
+
+/// Wavefront job : the CTU rows info.id, info.id + info.nTile, ... of a picture (TEncWPP::ETRI_CompressUnit)
+class EncWPPJob : public QphotoTask {
+	EncWPPJob() {
+	};
+
+public:
+	EncWPPJob(TEncWPP *pcWPPEncoder, EncTileInfo info);
+	virtual ~EncWPPJob() {};
+
+	virtual void run(void *);
+	static EncWPPJob* createJob(TEncWPP *pcWPPEncoder, EncTileInfo info);
+
+private:
+
+	EncTileInfo m_encInfo;
+	TEncWPP *m_encWPP;
+};
+#endif
+
+#if ETRI_PICTURE_TASK_THREADPOOL
+enum EncPicTask
+{
+	ETRI_PICTASK_DEBLOCK_VER = 0,		///< vertical edges of the CTUs
+	ETRI_PICTASK_DEBLOCK_HOR,			///< horizontal edges of the CTUs
+	ETRI_PICTASK_COMPRESS_MOTION		///< motion field compression of the CTUs
+};
+
+/// Picture-level process for the CTU range info.id of info.nTile parts of the picture (TEncFrame::ETRI_runPictureTask)
+class EncPicTaskJob : public QphotoTask {
+	EncPicTaskJob() {
+	};
+
+public:
+	EncPicTaskJob(TComPic *pcPic, TComLoopFilter *pcLoopFilter, int iTask, EncTileInfo info);
+	virtual ~EncPicTaskJob() {};
+
+	virtual void run(void *);
+	static EncPicTaskJob* createJob(TComPic *pcPic, TComLoopFilter *pcLoopFilter, int iTask, EncTileInfo info);
+
+private:
+
+	EncTileInfo m_encInfo;
+	TComPic *m_pcPic;
+	TComLoopFilter *m_pcLoopFilter;
+	int m_iTask;
+};
+#endif
+
+#if ETRI_COPYTOPIC_THREADPOOL
+/// Copy of the lines info.id of info.nTile parts of an input picture (TComPicYuv::qrCopyToPic)
+class CopyToPicJob : public QphotoTask {
+	CopyToPicJob() {
+	};
+
+public:
+	CopyToPicJob(TComPicYuv *pcPicYuvSrc, TComPicYuv *pcPicYuvDst, EncTileInfo info);
+	virtual ~CopyToPicJob() {};
+
+	virtual void run(void *);
+	static CopyToPicJob* createJob(TComPicYuv *pcPicYuvSrc, TComPicYuv *pcPicYuvDst, EncTileInfo info);
+
+private:
+
+	EncTileInfo m_encInfo;
+	TComPicYuv *m_pcPicYuvSrc;
+	TComPicYuv *m_pcPicYuvDst;
+};
+#endif
+
+#if ETRI_LOOKAHEAD
+class TEncLookahead;
+
+/// Lowres picture and costs of an input picture (TEncLookahead::ETRI_CompressUnit)
+class EncLookaheadJob : public QphotoTask {
+	EncLookaheadJob() {
+	};
+
+public:
+	EncLookaheadJob(TEncLookahead *pcLookahead, TComPic *pcPic, int iPOC);
+	virtual ~EncLookaheadJob() {};
+
+	virtual void run(void *);
+	static EncLookaheadJob* createJob(TEncLookahead *pcLookahead, TComPic *pcPic, int iPOC);
+
+private:
+
+	TEncLookahead *m_pcLookahead;
+	TComPic *m_pcPic;
+	int m_iPOC;
+};
+#endif
+
 class EncGopJob : public QphotoTask {
 	EncGopJob() {
 	};
 
 public:
 
+#if ETRI_FRAME_EVENT_SYNC
+	EncGopJob(void *param, int id, EncFrameSync *frameSync, QphotoThreadPool *threadpool, bool *bThreadRunning);
+#else
 	EncGopJob(void *param, int id, pthread_mutex_t *mutex, pthread_cond_t *cond, int *bRefPicAvailable, QphotoThreadPool *threadpool, bool *bThreadRunning);
+#endif
 	//virtual ~EncGopJob() {};
 	virtual ~EncGopJob();
 
 	virtual void run(void *);
+#if ETRI_FRAME_EVENT_SYNC
+	static EncGopJob* createJob(void *param, int id, EncFrameSync *frameSync, QphotoThreadPool *threadpool, bool *bThreadRunning);
+#else
 	static EncGopJob* createJob(void *param, int id, pthread_mutex_t *mutex, pthread_cond_t *cond, int *bRefPicAvailable, QphotoThreadPool *threadpool, bool *bThreadRunning);
+#endif
 	static void destroyJob(EncGopJob* job);
 
 private:
 
+#if ETRI_FRAME_EVENT_SYNC
+	EncFrameSync *m_frameSync;
+#else
 	pthread_mutex_t *m_mutex;
 	pthread_cond_t *m_cond;
 	int *m_bRefPicAvailable;
+#endif
 
 	TEncGOP *m_encGOP;
 	TEncThreadGOP *m_encThreadGOP;